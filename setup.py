@@ -60,7 +60,7 @@ else:
 
     # Platform specific libraries and source files
     if platform.system() == "Windows":
-        ignore_subdirs = {"linux", "osx", "posix"}
+        ignore_subdirs = {"linux", "libusb1", "osx", "posix"}
         compile_opts = dict(
             define_macros=[("_WINDOWS", None)],
             include_dirs=[],
@@ -69,7 +69,7 @@ else:
         )
 
     elif platform.system() == "Darwin":
-        ignore_subdirs = {"linux", "winusb", "windows"}
+        ignore_subdirs = {"linux", "libusb1", "winusb", "windows"}
         compile_opts = dict(
             define_macros=[], include_dirs=[], libraries=[], library_dirs=[]
         )
@@ -87,11 +87,25 @@ else:
         try:
             import pkgconfig
         except ImportError:
+            pkgconfig = None
+
+        # prefer the libusb-1.0 backend, which can queue spectrum reads
+        use_libusb1 = (
+            pkgconfig is not None
+            and strtobool(os.getenv("CSEABREEZE_LIBUSB1", "1"))
+            and pkgconfig.exists("libusb-1.0")
+        )
+        if use_libusb1:
+            ignore_subdirs.add("linux")
+            compile_opts = pkgconfig.parse("libusb-1.0")
+        elif pkgconfig is not None:
+            ignore_subdirs.add("libusb1")
+            compile_opts = pkgconfig.parse("libusb")
+        else:
+            ignore_subdirs.add("libusb1")
             compile_opts = dict(
                 define_macros=[], include_dirs=[], libraries=["usb"], library_dirs=[]
             )
-        else:
-            compile_opts = pkgconfig.parse("libusb")
 
         if not strtobool(os.getenv("CSEABREEZE_DEBUG_INFO", "0")):
             # strip debug symbols
@@ -40,6 +40,8 @@
 #include <vector>
 #include <string>
 #include "common/devices/Device.h"
+#include "common/buses/DeviceLocatorInterface.h"
+#include "common/buses/DeviceHotplugListenerInterface.h"
 
 namespace seabreeze {
 
@@ -56,10 +58,40 @@ namespace seabreeze {
 
         std::vector<std::string> getSupportedModels();
 
+        /* Probes the USB bus once for every device type with known USB IDs,
+         * without creating any Device instances.  Returns a locator for each
+         * device found, and deviceTypeNames receives the name (as accepted
+         * by create()) of each one.  The caller must delete the vector and
+         * the locators in it.
+         */
+        std::vector<DeviceLocatorInterface *> *probeUSBDevices(
+                std::vector<std::string> &deviceTypeNames);
+
+        /* Starts telling the listener about USB devices of every type with
+         * known USB IDs as they are attached and detached.  Devices that are
+         * already attached are reported before this returns.  Returns false
+         * if this platform cannot report hotplug events or if a listener is
+         * already registered.
+         */
+        bool startUSBHotplug(DeviceHotplugListenerInterface *listener);
+        void stopUSBHotplug();
+
     private:
         typedef Device *(*creatorFunction)(void);
         DeviceFactory();
+        void addUSBDeviceType(const std::string &name, int vendorID, int productID);
+        static void usbHotplugCallback(int event, unsigned long deviceID,
+                int match, void *context);
         std::map<std::string, creatorFunction> nameToCreator;
+
+        /* The USB IDs of each device type, stored as parallel vectors since
+         * that is the form in which they are handed to the native layer.
+         */
+        std::vector<std::string> usbDeviceNames;
+        std::vector<int> usbVendorIDs;
+        std::vector<int> usbProductIDs;
+
+        DeviceHotplugListenerInterface *hotplugListener;
     };
 
 }
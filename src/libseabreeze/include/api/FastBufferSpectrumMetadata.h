@@ -0,0 +1,53 @@
+/***************************************************//**
+ * @file    FastBufferSpectrumMetadata.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This provides a structure holding the metadata that precedes
+ * each spectrum read from the fast buffer of a spectrometer
+ * (e.g. the Flame-X), decoded into host byte order.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef FASTBUFFERSPECTRUMMETADATA_H
+#define FASTBUFFERSPECTRUMMETADATA_H
+
+/* The fields are laid out with natural alignment so that the
+ * structure can be mirrored by an aligned numpy dtype.
+ */
+typedef struct FastBufferSpectrumMetadata {
+    unsigned short      metadataProtocolVersion;
+    unsigned short      metadataLength;
+    unsigned int        pixelDataLength;
+    unsigned long long  microsecondCounter;
+    unsigned int        integrationTimeMicros;
+    unsigned int        pixelDataFormat;    /* FAST_BUFFER_PIXEL_FORMAT_* */
+    unsigned int        spectrumCount;
+    unsigned int        lastSpectrumCount;
+    unsigned long long  lastMicrosecondCount;
+    unsigned short      scansToAverage;
+} FastBufferSpectrumMetadata;
+
+#endif /* FASTBUFFERSPECTRUMMETADATA_H */
@@ -55,6 +55,9 @@ namespace seabreeze {
             unsigned long getBufferCapacityMaximum(int *errorCode);
             unsigned long getBufferCapacityMinimum(int *errorCode);
             void setBufferCapacity(int *errorCode, unsigned long capacity);
+            int getBufferedSpectrumLength(int *errorCode);
+            int readBufferedSpectra(int *errorCode, unsigned int numberOfSpectra,
+                    unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
         };
 
     } /* end namespace api */
@@ -77,6 +77,11 @@ namespace seabreeze {
             int open(int *errorCode);
             void close();
 
+            /* Abort transfers blocked on the device, even in other threads.
+             * This deliberately bypasses the bus lock the blocked call holds.
+             */
+            void cancelTransfers(int *errorCode);
+
             DeviceLocatorInterface *getLocation();
 
             /* An for weak association to this object */
@@ -112,14 +117,57 @@ namespace seabreeze {
             unsigned long spectrometerGetMinimumIntegrationTimeMicros(long spectrometerFeatureID, int *errorCode);
             unsigned long spectrometerGetMaximumIntegrationTimeMicros(long spectrometerFeatureID, int *errorCode);
             double spectrometerGetMaximumIntensity(long spectrometerFeatureID, int *errorCode);
+
+            /* Transfer timeouts in milliseconds; 0 waits indefinitely and -1 is automatic */
+            void spectrometerSetTransferTimeouts(long spectrometerFeatureID, int *errorCode, long spectrumTimeoutMillis, long controlTimeoutMillis);
+            long spectrometerGetSpectrumTimeoutMillis(long spectrometerFeatureID, int *errorCode);
+            long spectrometerGetControlTimeoutMillis(long spectrometerFeatureID, int *errorCode);
+
+            void spectrometerSetSpectrumCorrection(long spectrometerFeatureID, int *errorCode, int correctDarkCounts, int correctNonlinearity, int correctStrayLight);
+            void spectrometerSetCorrectionCoefficients(long spectrometerFeatureID, int *errorCode, const double *nonlinearity, int nonlinearityCount, const double *strayLight, int strayLightCount);
+            void spectrometerSetIrradianceOutput(long spectrometerFeatureID, int *errorCode, int enable, float collectionArea);
+            void spectrometerSetResampleGrid(long spectrometerFeatureID, int *errorCode, const double *grid, int gridLength, int method);
+            int spectrometerGetResampleGridLength(long spectrometerFeatureID, int *errorCode);
+            int spectrometerGetResampledSpectrum(long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength);
+            int spectrometerResampleSpectra(long spectrometerFeatureID, int *errorCode, const double *spectra, int count, int stride, double *buffer, int bufferStride);
+            void spectrometerSetPixelRanges(long spectrometerFeatureID, int *errorCode, const unsigned int *pixelIndexPairs, int length);
+            int spectrometerGetPixelRanges(long spectrometerFeatureID, int *errorCode, unsigned int *pixelIndexPairs, int length);
+            int spectrometerGetPixelRangeLength(long spectrometerFeatureID, int *errorCode);
+            int spectrometerGetPixelRangeSpectrum(long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength);
+            int spectrometerGetPixelRangeWavelengths(long spectrometerFeatureID, int *errorCode, double *wavelengths, int length);
             int spectrometerGetUnformattedSpectrumLength(long spectrometerFeatureID, int *errorCode);
             int spectrometerGetUnformattedSpectrum(long spectrometerFeatureID,int *errorCode, unsigned char *buffer, int bufferLength);
 			int spectrometerGetFastBufferSpectrum(long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
+            int spectrometerGetFastBufferSpectra(long spectrometerFeatureID, int *errorCode, unsigned int numberOfSamplesToRetrieve, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
 			int spectrometerGetFormattedSpectrumLength(long spectrometerFeatureID, int *errorCode);
             int spectrometerGetFormattedSpectrum(long spectrometerFeatureID, int *errorCode,double *buffer, int bufferLength);
+
+            /* Formatted spectra at the native width of the device (SPECTRUM_SAMPLE_TYPE_*) */
+            int spectrometerGetFormattedSampleType(long spectrometerFeatureID, int *errorCode);
+            int spectrometerGetFormattedSpectrumUInt16(long spectrometerFeatureID, int *errorCode, unsigned short *buffer, int bufferLength);
+            int spectrometerGetFormattedSpectrumUInt32(long spectrometerFeatureID, int *errorCode, unsigned int *buffer, int bufferLength);
+            int spectrometerGetFormattedSpectrumFloat(long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength);
+            int spectrometerGetProcessedSpectrumFloat(long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength);
+
+            /* Back-to-back formatted spectra into rows of stride doubles, with host timestamps */
+            int spectrometerGetFormattedSpectra(long spectrometerFeatureID, int *errorCode, int count, double *buffer, int stride, unsigned long long *timestampsMicros);
+
             int spectrometerGetWavelengths(long spectrometerFeatureID, int *errorCode,double *wavelengths, int length);
             int spectrometerGetElectricDarkPixelCount(long spectrometerFeatureID, int *errorCode);
             int spectrometerGetElectricDarkPixelIndices(long spectrometerFeatureID, int *errorCode, int *indices, int length);
+            void spectrometerStartContinuousAcquisition(long spectrometerFeatureID, int *errorCode, int ringDepth, int pipelined);
+            void spectrometerStopContinuousAcquisition(long spectrometerFeatureID, int *errorCode);
+            int spectrometerIsContinuousAcquisitionRunning(long spectrometerFeatureID, int *errorCode);
+            int spectrometerGetContinuousAcquisitionDepth(long spectrometerFeatureID, int *errorCode);
+            int spectrometerReadContinuousSpectrum(long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, unsigned long long *timestampMicros);
+            void spectrometerGetContinuousAcquisitionStatistics(long spectrometerFeatureID, int *errorCode, unsigned long long *framesAcquired, unsigned long long *framesDropped, unsigned long long *overruns, unsigned long long *transferErrors);
+
+            /* Continuous draining of the fast buffer into a host queue */
+            void spectrometerStartFastBufferDrain(long spectrometerFeatureID, int *errorCode, int queueDepth, int maxBatch, int pollIntervalMicros);
+            void spectrometerStopFastBufferDrain(long spectrometerFeatureID, int *errorCode);
+            int spectrometerIsFastBufferDrainRunning(long spectrometerFeatureID, int *errorCode);
+            int spectrometerReadFastBufferDrain(long spectrometerFeatureID, int *errorCode, int maxSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
+            void spectrometerGetFastBufferDrainStatistics(long spectrometerFeatureID, int *errorCode, unsigned long long *spectraReceived, unsigned long long *spectraMissed, unsigned long long *sequenceGaps, unsigned long long *spectraDropped, unsigned long long *transferErrors);
 
 
             /* Get one or more pixel binning features */
@@ -328,6 +376,8 @@ namespace seabreeze {
             unsigned long dataBufferGetBufferCapacityMaximum(long featureID, int *errorCode);
             unsigned long dataBufferGetBufferCapacityMinimum(long featureID, int *errorCode);
             void dataBufferSetBufferCapacity(long featureID, int *errorCode, unsigned long capacity);
+            int dataBufferGetBufferedSpectrumLength(long featureID, int *errorCode);
+            int dataBufferReadBufferedSpectra(long featureID, int *errorCode, unsigned int numberOfSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
 
 			/* Get one or more fast buffer features */
 			int getNumberOfFastBufferFeatures();
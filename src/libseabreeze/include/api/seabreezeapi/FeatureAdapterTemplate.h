@@ -68,6 +68,7 @@ namespace seabreeze {
             }
             virtual ~FeatureAdapterTemplate() { /* Do nothing -- others delete feature */ }
             T *getFeature() { return this->feature; }
+            Protocol *getProtocol() { return this->protocol; }
 
             virtual FeatureFamily &getFeatureFamily() { return this->family; }
 
@@ -38,6 +38,12 @@
 
 // #include "api/DllDecl.h"
 #include "api/USBEndpointTypes.h"
+#include "api/FastBufferSpectrumMetadata.h"
+
+/* Called as a probed device is attached (arrived is 1) or detached (arrived
+ * is 0).  See SeaBreezeAPI::addHotplugCallback().
+ */
+typedef void (*SeaBreezeHotplugCallback)(long deviceID, int arrived, void *context);
 
 /*!
     @brief  This is an interface to SeaBreeze that allows
@@ -102,6 +108,31 @@ public:
      */
     virtual int getDeviceIDs(long *ids, unsigned long maxLength) = 0;
 
+    /**
+     * This registers a function to call whenever a USB device arrives or
+     * leaves.  The first registration starts watching for hotplug events, and
+     * from then on the list of probed devices is kept up to date as events
+     * arrive, so probeDevices() no longer rescans the bus.  Devices that are
+     * already attached are listed before this returns, but callbacks are only
+     * told about later changes.  Callbacks are called from a background
+     * thread and may call other functions of this API.  A device that left is
+     * no longer listed, but its ID stays valid until probeDevices() is next
+     * called so that it can still be closed.  Returns 0 on success; sets
+     * ERROR_NOT_IMPLEMENTED if this platform cannot report hotplug events.
+     */
+    virtual int addHotplugCallback(SeaBreezeHotplugCallback callback, void *context,
+        int *errorCode) = 0;
+
+    /**
+     * This unregisters a function given to addHotplugCallback() with the same
+     * context.  Watching for hotplug events continues until this object is
+     * destroyed since the list of probed devices depends on it.  The callback
+     * is not called again once this returns, unless this is called from
+     * within a callback.
+     */
+    virtual int removeHotplugCallback(SeaBreezeHotplugCallback callback, void *context,
+        int *errorCode) = 0;
+
     // quick and dirty support for returning supported models...
     virtual int getNumberOfSupportedModels() = 0;
     virtual int getSupportedModelName(int index, int *errorCode, char* buffer, int bufferLength) = 0;
@@ -117,6 +148,13 @@ public:
      */
     virtual void closeDevice(long id, int *errorCode) = 0;
 
+    /**
+     * This will abort any transfer that is blocked on the device with the given
+     * ID, including one in another thread, which then fails with
+     * ERROR_TRANSFER_TIMEOUT.  The device stays open.
+     */
+    virtual void cancelTransfers(long id, int *errorCode) = 0;
+
     /* Get a string that describes the type of device */
     virtual int getDeviceType(long id, int *errorCode, char *buffer, unsigned int length) = 0;
 
@@ -143,15 +181,106 @@ public:
     virtual unsigned long spectrometerGetMinimumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual unsigned long spectrometerGetMaximumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual double spectrometerGetMaximumIntensity(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+
+    /* Transfer timeouts in milliseconds; 0 waits indefinitely and -1 is automatic */
+    virtual void spectrometerSetTransferTimeouts(long deviceID, long spectrometerFeatureID, int *errorCode, long spectrumTimeoutMillis, long controlTimeoutMillis) = 0;
+    virtual long spectrometerGetSpectrumTimeoutMillis(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual long spectrometerGetControlTimeoutMillis(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+
+    /* Enables dark, nonlinearity and stray light correction of the spectra
+     * returned as doubles.  The coefficients are read from the device's
+     * nonlinearity and stray light coefficient features the first time
+     * they are needed.
+     */
+    virtual void spectrometerSetSpectrumCorrection(long deviceID, long spectrometerFeatureID, int *errorCode, int correctDarkCounts, int correctNonlinearity, int correctStrayLight) = 0;
+    /* Supplies the coefficients that spectrometerSetSpectrumCorrection()
+     * would otherwise read from the device, e.g. from a cache.  A count of
+     * zero leaves that set of coefficients unchanged.
+     */
+    virtual void spectrometerSetCorrectionCoefficients(long deviceID, long spectrometerFeatureID, int *errorCode, const double *nonlinearity, int nonlinearityCount, const double *strayLight, int strayLightCount) = 0;
+    /* Scales the spectra returned as doubles to irradiance (uW/cm^2/nm).
+     * The calibration is read from the device's irradiance calibration
+     * feature on first use.  A collectionArea (cm^2) of zero uses the area
+     * stored on the device.  The integration time must already be set.
+     */
+    virtual void spectrometerSetIrradianceOutput(long deviceID, long spectrometerFeatureID, int *errorCode, int enable, float collectionArea) = 0;
+    /* Resampling onto a common wavelength grid (nm).  The source pixels
+     * and weights for each grid point are computed once from the
+     * wavelength calibration.  method is 1 for linear or 2 for cubic
+     * interpolation; a gridLength of zero turns resampling off.  Grid
+     * points outside the calibrated range take the value of the nearest
+     * end pixel.  Resampled spectra include any enabled corrections, and
+     * spectrometerResampleSpectra() resamples spectra already acquired,
+     * with rows stride (input) and bufferStride (output) values apart.
+     */
+    virtual void spectrometerSetResampleGrid(long deviceID, long spectrometerFeatureID, int *errorCode, const double *grid, int gridLength, int method) = 0;
+    virtual int spectrometerGetResampleGridLength(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerGetResampledSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength) = 0;
+    virtual int spectrometerResampleSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, const double *spectra, int count, int stride, double *buffer, int bufferStride) = 0;
+    /* Readout of selected pixel ranges, given as length values forming
+     * pairs of first and last pixel (inclusive).  A length of zero selects
+     * the active pixels, or every pixel that is not a dark pixel when the
+     * device does not report them; this is also the default.  The spectrum
+     * holds the pixels of the ranges in order, with only those pixels
+     * decoded when no corrections are enabled, and the wavelengths of the
+     * selected pixels are cached with the full calibration.
+     */
+    virtual void spectrometerSetPixelRanges(long deviceID, long spectrometerFeatureID, int *errorCode, const unsigned int *pixelIndexPairs, int length) = 0;
+    virtual int spectrometerGetPixelRanges(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *pixelIndexPairs, int length) = 0;
+    virtual int spectrometerGetPixelRangeLength(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerGetPixelRangeSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength) = 0;
+    virtual int spectrometerGetPixelRangeWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length) = 0;
     virtual int spectrometerGetUnformattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual int spectrometerGetUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength) = 0;
 	virtual int spectrometerGetFastBufferSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *dataBuffer, int dataMaxLength, unsigned int numberOfSampleToRetrieve) = 0; // currently 15 max
+    virtual int spectrometerGetFastBufferSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int numberOfSamplesToRetrieve, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) = 0;
 	virtual int spectrometerGetFormattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength) = 0;
+
+    /* Formatted spectra at the native width of the device (SPECTRUM_SAMPLE_TYPE_*) */
+    virtual int spectrometerGetFormattedSampleType(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerGetFormattedSpectrumUInt16(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned short *buffer, int bufferLength) = 0;
+    virtual int spectrometerGetFormattedSpectrumUInt32(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *buffer, int bufferLength) = 0;
+    virtual int spectrometerGetFormattedSpectrumFloat(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength) = 0;
+
+    /* Formatted spectrum as floats, including any scan averaging and boxcar
+     * smoothing done on the host for devices without on-board processing
+     */
+    virtual int spectrometerGetProcessedSpectrumFloat(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength) = 0;
+
+    /* Back-to-back formatted spectra into rows of stride doubles, with host timestamps */
+    virtual int spectrometerGetFormattedSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, int count, double *buffer, int stride, unsigned long long *timestampsMicros) = 0;
+
     virtual int spectrometerGetWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length) = 0;
     virtual int spectrometerGetElectricDarkPixelCount(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual int spectrometerGetElectricDarkPixelIndices(long deviceID, long spectrometerFeatureID, int *errorCode, int *indices, int length) = 0;
 
+    /* Continuous acquisition: a background thread keeps reading spectra into
+     * a ring of the given depth, which spectrometerReadContinuousSpectrum()
+     * drains without blocking.  It returns 0 when no spectrum is queued.
+     * If pipelined is nonzero, each spectrum is requested before the previous
+     * one is decoded so that the device is never left idle.
+     */
+    virtual void spectrometerStartContinuousAcquisition(long deviceID, long spectrometerFeatureID, int *errorCode, int ringDepth, int pipelined) = 0;
+    virtual void spectrometerStopContinuousAcquisition(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerIsContinuousAcquisitionRunning(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerGetContinuousAcquisitionDepth(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerReadContinuousSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, unsigned long long *timestampMicros) = 0;
+    virtual void spectrometerGetContinuousAcquisitionStatistics(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long long *framesAcquired, unsigned long long *framesDropped, unsigned long long *overruns, unsigned long long *transferErrors) = 0;
+
+    /* Continuous draining of the fast buffer into a host queue: a background
+     * thread polls the occupancy of the device's data buffer and requests up
+     * to maxBatch spectra at a time.  spectrometerReadFastBufferDrain() pops
+     * parsed spectra as with spectrometerGetFastBufferSpectra() and returns 0
+     * when none are queued.  Spectra the device discarded are detected from
+     * gaps in the spectrum counter and reported in spectraMissed.
+     */
+    virtual void spectrometerStartFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode, int queueDepth, int maxBatch, int pollIntervalMicros) = 0;
+    virtual void spectrometerStopFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerIsFastBufferDrainRunning(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerReadFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode, int maxSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) = 0;
+    virtual void spectrometerGetFastBufferDrainStatistics(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long long *spectraReceived, unsigned long long *spectraMissed, unsigned long long *sequenceGaps, unsigned long long *spectraDropped, unsigned long long *transferErrors) = 0;
+
     /* Pixel binning capabilities */
     virtual int getNumberOfPixelBinningFeatures(long id, int *errorCode) = 0;
     virtual int getPixelBinningFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength) = 0;
@@ -345,6 +474,14 @@ public:
 	virtual unsigned long dataBufferGetBufferCapacityMaximum(long deviceID, long featureID, int *errorCode) = 0;
     virtual unsigned long dataBufferGetBufferCapacityMinimum(long deviceID, long featureID, int *errorCode) = 0;
     virtual void dataBufferSetBufferCapacity(long deviceID, long featureID, int *errorCode, unsigned long capacity) = 0;
+    /* Reads and removes up to numberOfSpectra of the oldest buffered spectra
+     * with their metadata, laid out as for spectrometerGetFastBufferSpectra().
+     * Only as many spectra as the buffer holds are read, so this does not wait
+     * for new acquisitions.  Devices that cannot do this report a spectrum
+     * length of 0 and ERROR_NOT_IMPLEMENTED.
+     */
+    virtual int dataBufferGetBufferedSpectrumLength(long deviceID, long featureID, int *errorCode) = 0;
+    virtual int dataBufferReadBufferedSpectra(long deviceID, long featureID, int *errorCode, unsigned int numberOfSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) = 0;
 
 	/* Fast Buffer capabilities*/
 	virtual int getNumberOfFastBufferFeatures(long deviceID, int *errorCode) = 0;
@@ -53,5 +53,18 @@
 #define ERROR_VALUE_NOT_FOUND           10
 #define ERROR_VALUE_NOT_EXPECTED		11
 #define ERROR_INVALID_TRIGGER_MODE		12
+#define ERROR_TRANSFER_TIMEOUT          13
+
+/* Sample types of formatted spectra */
+#define SPECTRUM_SAMPLE_TYPE_UINT16     1
+#define SPECTRUM_SAMPLE_TYPE_UINT32     2
+#define SPECTRUM_SAMPLE_TYPE_FLOAT      3
+#define SPECTRUM_SAMPLE_TYPE_DOUBLE     4
+
+/* Pixel formats of fast buffer spectra (FastBufferSpectrumMetadata) */
+#define FAST_BUFFER_PIXEL_FORMAT_UINT16 1
+#define FAST_BUFFER_PIXEL_FORMAT_UINT24 2
+#define FAST_BUFFER_PIXEL_FORMAT_UINT32 3
+#define FAST_BUFFER_PIXEL_FORMAT_FLOAT  4
 
 #endif /* SEABREEZEAPICONSTANTS_H */
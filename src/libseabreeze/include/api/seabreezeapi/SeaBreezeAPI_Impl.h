@@ -40,8 +40,14 @@
 
 #include "api/seabreezeapi/SeaBreezeAPI.h"
 #include "api/seabreezeapi/DeviceAdapter.h"
+#include "common/buses/DeviceHotplugListenerInterface.h"
 
-class SeaBreezeAPI_Impl : SeaBreezeAPI {
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class SeaBreezeAPI_Impl : SeaBreezeAPI, seabreeze::DeviceHotplugListenerInterface {
 public:
     virtual ~SeaBreezeAPI_Impl();
 
@@ -52,8 +58,13 @@ public:
 
     virtual int getNumberOfDeviceIDs();
     virtual int getDeviceIDs(long *ids, unsigned long maxLength);
+    virtual int addHotplugCallback(SeaBreezeHotplugCallback callback, void *context,
+        int *errorCode);
+    virtual int removeHotplugCallback(SeaBreezeHotplugCallback callback, void *context,
+        int *errorCode);
     virtual int openDevice(long id, int *errorCode);
     virtual void closeDevice(long id, int *errorCode);
+    virtual void cancelTransfers(long id, int *errorCode);
 
     virtual int getDeviceType(long id, int *errorCode, char *buffer, unsigned int length);
 
@@ -83,14 +94,61 @@ public:
     virtual unsigned long spectrometerGetMinimumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual unsigned long spectrometerGetMaximumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual double spectrometerGetMaximumIntensity(long deviceID, long spectrometerFeatureID, int *errorCode);
+
+    /* Transfer timeouts in milliseconds; 0 waits indefinitely and -1 is automatic */
+    virtual void spectrometerSetTransferTimeouts(long deviceID, long spectrometerFeatureID, int *errorCode, long spectrumTimeoutMillis, long controlTimeoutMillis);
+    virtual long spectrometerGetSpectrumTimeoutMillis(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual long spectrometerGetControlTimeoutMillis(long deviceID, long spectrometerFeatureID, int *errorCode);
+
+    virtual void spectrometerSetSpectrumCorrection(long deviceID, long spectrometerFeatureID, int *errorCode, int correctDarkCounts, int correctNonlinearity, int correctStrayLight);
+    virtual void spectrometerSetCorrectionCoefficients(long deviceID, long spectrometerFeatureID, int *errorCode, const double *nonlinearity, int nonlinearityCount, const double *strayLight, int strayLightCount);
+    virtual void spectrometerSetIrradianceOutput(long deviceID, long spectrometerFeatureID, int *errorCode, int enable, float collectionArea);
+    virtual void spectrometerSetResampleGrid(long deviceID, long spectrometerFeatureID, int *errorCode, const double *grid, int gridLength, int method);
+    virtual int spectrometerGetResampleGridLength(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerGetResampledSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength);
+    virtual int spectrometerResampleSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, const double *spectra, int count, int stride, double *buffer, int bufferStride);
+    virtual void spectrometerSetPixelRanges(long deviceID, long spectrometerFeatureID, int *errorCode, const unsigned int *pixelIndexPairs, int length);
+    virtual int spectrometerGetPixelRanges(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *pixelIndexPairs, int length);
+    virtual int spectrometerGetPixelRangeLength(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerGetPixelRangeSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength);
+    virtual int spectrometerGetPixelRangeWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length);
     virtual int spectrometerGetUnformattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual int spectrometerGetUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength);
 	virtual int spectrometerGetFastBufferSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
+    virtual int spectrometerGetFastBufferSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int numberOfSamplesToRetrieve, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
 	virtual int spectrometerGetFormattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength);
+
+    /* Formatted spectra at the native width of the device (SPECTRUM_SAMPLE_TYPE_*) */
+    virtual int spectrometerGetFormattedSampleType(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerGetFormattedSpectrumUInt16(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned short *buffer, int bufferLength);
+    virtual int spectrometerGetFormattedSpectrumUInt32(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *buffer, int bufferLength);
+    virtual int spectrometerGetFormattedSpectrumFloat(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength);
+
+    /* Formatted spectrum as floats, including any scan averaging and boxcar
+     * smoothing done on the host for devices without on-board processing
+     */
+    virtual int spectrometerGetProcessedSpectrumFloat(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength);
+
+    /* Back-to-back formatted spectra into rows of stride doubles, with host timestamps */
+    virtual int spectrometerGetFormattedSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, int count, double *buffer, int stride, unsigned long long *timestampsMicros);
+
     virtual int spectrometerGetWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length);
     virtual int spectrometerGetElectricDarkPixelCount(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual int spectrometerGetElectricDarkPixelIndices(long deviceID, long spectrometerFeatureID, int *errorCode, int *indices, int length);
+    virtual void spectrometerStartContinuousAcquisition(long deviceID, long spectrometerFeatureID, int *errorCode, int ringDepth, int pipelined);
+    virtual void spectrometerStopContinuousAcquisition(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerIsContinuousAcquisitionRunning(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerGetContinuousAcquisitionDepth(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerReadContinuousSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, unsigned long long *timestampMicros);
+    virtual void spectrometerGetContinuousAcquisitionStatistics(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long long *framesAcquired, unsigned long long *framesDropped, unsigned long long *overruns, unsigned long long *transferErrors);
+
+    /* Continuous draining of the fast buffer into a host queue */
+    virtual void spectrometerStartFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode, int queueDepth, int maxBatch, int pollIntervalMicros);
+    virtual void spectrometerStopFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerIsFastBufferDrainRunning(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerReadFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode, int maxSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
+    virtual void spectrometerGetFastBufferDrainStatistics(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long long *spectraReceived, unsigned long long *spectraMissed, unsigned long long *sequenceGaps, unsigned long long *spectraDropped, unsigned long long *transferErrors);
 
     /* Pixel binning capabilities */
     virtual int getNumberOfPixelBinningFeatures(long id, int *errorCode);
@@ -302,6 +360,8 @@ public:
     virtual unsigned long dataBufferGetBufferCapacityMaximum(long deviceID, long featureID, int *errorCode);
     virtual unsigned long dataBufferGetBufferCapacityMinimum(long deviceID, long featureID, int *errorCode);
     virtual void dataBufferSetBufferCapacity(long deviceID, long featureID, int *errorCode, unsigned long capacity);
+    virtual int dataBufferGetBufferedSpectrumLength(long deviceID, long featureID, int *errorCode);
+    virtual int dataBufferReadBufferedSpectra(long deviceID, long featureID, int *errorCode, unsigned int numberOfSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
 
 	/* Fast Buffer capabilities*/
 	virtual int getNumberOfFastBufferFeatures(long deviceID, int *errorCode);
@@ -337,9 +397,48 @@ private:
 
     seabreeze::api::DeviceAdapter *getDeviceByID(unsigned long id);
 
+    /* DeviceHotplugListenerInterface.  These only queue the event; it is
+     * applied by the hotplug thread so that the USB event thread never
+     * waits on the device list or on user callbacks.
+     */
+    virtual void deviceArrived(const seabreeze::DeviceLocatorInterface &location,
+        const std::string &deviceTypeName);
+    virtual void deviceLeft(const seabreeze::DeviceLocatorInterface &location);
+
+    struct HotplugEvent {
+        seabreeze::DeviceLocatorInterface *location;
+        std::string deviceTypeName;     /* empty if the device left */
+    };
+
+    /* Updates probedDevices for one event and returns the ID of the device
+     * that arrived or left, or 0 if the list did not change.
+     */
+    long applyHotplugEvent(HotplugEvent &event);
+    void runHotplug();
+
     std::vector<seabreeze::api::DeviceAdapter *> probedDevices;
     std::vector<seabreeze::api::DeviceAdapter *> specifiedDevices;
 
+    /* Devices that left while hotplug was active.  Their IDs remain valid so
+     * they can be closed, and they are deleted by the next probeDevices().
+     */
+    std::vector<seabreeze::api::DeviceAdapter *> departedDevices;
+    std::mutex deviceListMutex;
+
+    /* Serializes starting hotplug and guards the callback list against the
+     * hotplug thread while it is calling them.  Recursive so callbacks may
+     * add and remove callbacks.
+     */
+    std::recursive_mutex hotplugCallbackMutex;
+    std::vector<std::pair<SeaBreezeHotplugCallback, void *> > hotplugCallbacks;
+    bool hotplugActive;
+
+    std::mutex hotplugQueueMutex;
+    std::condition_variable hotplugQueueCondition;
+    std::deque<HotplugEvent> hotplugQueue;
+    bool hotplugStopRequested;
+    std::thread hotplugThread;
+
 friend class SeaBreezeAPI;
 
 };
@@ -33,10 +33,19 @@
 #ifndef SEABREEZE_SPECTROMETER_FEATURE_ADAPTER_H
 #define SEABREEZE_SPECTROMETER_FEATURE_ADAPTER_H
 
+#include <mutex>
+#include <vector>
+#include "api/FastBufferSpectrumMetadata.h"
 #include "api/seabreezeapi/FeatureAdapterTemplate.h"
+#include "common/SpectrumAccumulator.h"
+#include "common/WavelengthResampler.h"
 #include "common/buses/Bus.h"
 #include "common/protocols/Protocol.h"
 #include "vendors/OceanOptics/features/spectrometer/OOISpectrometerFeatureInterface.h"
+#include "vendors/OceanOptics/features/spectrometer/ContinuousAcquisition.h"
+#include "vendors/OceanOptics/features/spectrometer/FastBufferDrain.h"
+#include "vendors/OceanOptics/features/data_buffer/DataBufferFeatureInterface.h"
+#include "vendors/OceanOptics/features/spectrum_processing/HostSpectrumProcessingFeature.h"
 
 namespace seabreeze {
     namespace api {
@@ -52,7 +61,16 @@ namespace seabreeze {
             /* Spectrometer commands */
             int getUnformattedSpectrum(int *errorCode,unsigned char *buffer, int bufferLength);
 			int getFastBufferSpectrum(int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
+            int getFastBufferSpectra(int *errorCode, unsigned int numberOfSamplesToRetrieve,
+                    unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
             int getFormattedSpectrum(int *errorCode,double* buffer, int bufferLength);
+            int getFormattedSampleType(int *errorCode);
+            int getFormattedSpectrumUInt16(int *errorCode, unsigned short *buffer, int bufferLength);
+            int getFormattedSpectrumUInt32(int *errorCode, unsigned int *buffer, int bufferLength);
+            int getFormattedSpectrumFloat(int *errorCode, float *buffer, int bufferLength);
+            int getProcessedSpectrumFloat(int *errorCode, float *buffer, int bufferLength);
+            int getFormattedSpectra(int *errorCode, int count, double *buffer, int stride,
+                    unsigned long long *timestampsMicros);
             int getUnformattedSpectrumLength(int *errorCode);
             int getFormattedSpectrumLength(int *errorCode);
             void setTriggerMode(int *errorCode, int mode);
@@ -69,6 +87,133 @@ namespace seabreeze {
             long getMinimumIntegrationTimeMicros(int *errorCode);
             long getMaximumIntegrationTimeMicros(int *errorCode);
             double getMaximumIntensity(int *errorCode);
+
+            /* Limits on how long a transfer may block, in milliseconds.  The
+             * spectrum timeout applies to spectrum readouts and the control
+             * timeout to everything else on the bus.  0 waits indefinitely,
+             * and -1 (the default) picks a limit automatically: for spectra
+             * this follows the integration time, or waits indefinitely while
+             * an external trigger mode is set.  A transfer that runs out of
+             * time fails with ERROR_TRANSFER_TIMEOUT.
+             */
+            void setTransferTimeouts(int *errorCode, long spectrumTimeoutMillis,
+                    long controlTimeoutMillis);
+            long getSpectrumTimeoutMillis(int *errorCode);
+            long getControlTimeoutMillis(int *errorCode);
+
+            /* Dark, nonlinearity and stray light correction of formatted spectra */
+            void setNonlinearityCoefficients(int *errorCode,
+                    const double *coefficients, int count);
+            int hasNonlinearityCoefficients(int *errorCode);
+            void setStrayLightCoefficients(int *errorCode,
+                    const double *coefficients, int count);
+            int hasStrayLightCoefficients(int *errorCode);
+            void setSpectrumCorrection(int *errorCode, int correctDarkCounts,
+                    int correctNonlinearity, int correctStrayLight);
+
+            /* Irradiance output (uW/cm^2/nm) of formatted spectra */
+            void setIrradianceCalibration(int *errorCode,
+                    const float *calibration, int count);
+            int hasIrradianceCalibration(int *errorCode);
+            void setIrradianceOutput(int *errorCode, int enable, float collectionArea);
+
+            /* Resampling of formatted spectra onto a common wavelength grid.
+             * The weights are computed from the cached wavelengths when the
+             * grid is set, and again if the number of pixels changes.
+             */
+            void setResampleGrid(int *errorCode, const double *grid,
+                    int gridLength, int method);
+            int getResampleGridLength(int *errorCode);
+            int getResampledSpectrum(int *errorCode, double *buffer, int bufferLength);
+            int resampleSpectra(int *errorCode, const double *spectra, int count,
+                    int stride, double *buffer, int bufferStride);
+
+            /* Readout of selected pixel ranges, as pairs of first and last
+             * pixel.  Setting no ranges selects the active pixels.
+             */
+            void setPixelRanges(int *errorCode, const unsigned int *pixelIndexPairs,
+                    int length);
+            int getPixelRanges(int *errorCode, unsigned int *pixelIndexPairs, int length);
+            int getPixelRangeLength(int *errorCode);
+            int getPixelRangeSpectrum(int *errorCode, double *buffer, int bufferLength);
+            int getPixelRangeWavelengths(int *errorCode, double *wavelengths, int length);
+
+            /* Scan averaging and boxcar smoothing done on the host.  Once
+             * either is set, getFormattedSpectrum() returns processed
+             * spectra.  The device adapter exposes this as a spectrum
+             * processing feature when the device has none of its own.
+             */
+            HostSpectrumProcessingFeature *getHostSpectrumProcessingFeature();
+
+            /* Continuous acquisition into a ring buffer */
+            void startContinuousAcquisition(int *errorCode, int ringDepth, int pipelined);
+            void stopContinuousAcquisition(int *errorCode);
+            int isContinuousAcquisitionRunning(int *errorCode);
+            int getContinuousAcquisitionDepth(int *errorCode);
+            int readContinuousSpectrum(int *errorCode, double *buffer,
+                    int bufferLength, unsigned long long *timestampMicros);
+            void getContinuousAcquisitionStatistics(int *errorCode,
+                    unsigned long long *framesAcquired,
+                    unsigned long long *framesDropped,
+                    unsigned long long *overruns,
+                    unsigned long long *transferErrors);
+
+            /* Continuous draining of the device's fast buffer into a host queue */
+            void setDataBufferFeature(DataBufferFeatureInterface *dataBuffer);
+            void startFastBufferDrain(int *errorCode, int queueDepth, int maxBatch,
+                    int pollIntervalMicros);
+            void stopFastBufferDrain(int *errorCode);
+            int isFastBufferDrainRunning(int *errorCode);
+            int readFastBufferDrain(int *errorCode, int maxSpectra,
+                    unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata);
+            void getFastBufferDrainStatistics(int *errorCode,
+                    unsigned long long *spectraReceived,
+                    unsigned long long *spectraMissed,
+                    unsigned long long *sequenceGaps,
+                    unsigned long long *spectraDropped,
+                    unsigned long long *transferErrors);
+
+        protected:
+            template <typename T>
+            int getNativeFormattedSpectrum(int *errorCode,
+                    FormattedSpectrumTransferInterface::SampleType type,
+                    T *buffer, int bufferLength);
+            template <typename T>
+            int getProcessedSpectrum(int *errorCode, T *buffer, int bufferLength);
+            template <typename T>
+            void accumulateSpectrum(std::vector<T> &scan);
+            /* The caller must hold resampleMutex */
+            bool configureResampler(int *errorCode);
+            bool applyTransferTimeouts();
+
+            ContinuousAcquisition *acquisition;
+            FastBufferDrain *drain;
+            HostSpectrumProcessingFeature hostProcessing;
+
+            /* Scratch space for host processing, kept between spectra */
+            SpectrumAccumulator accumulator;
+            std::vector<unsigned short> scanUInt16;
+            std::vector<unsigned int> scanUInt32;
+            std::vector<float> scanFloat;
+            std::vector<double> scanDouble;
+
+            /* resampleMutex guards the resampler and its inputs, so a new
+             * grid cannot be configured while another thread resamples.
+             */
+            std::mutex resampleMutex;
+            WavelengthResampler resampler;
+            std::vector<double> resampleGrid;
+            WavelengthResampler::Method resampleMethod;
+            std::vector<double> resampleSource;
+            std::vector<double> pixelRangeSource;
+
+            /* Configured transfer timeouts, or -1 for automatic, and the
+             * settings the automatic spectrum timeout follows.
+             */
+            long spectrumTimeoutMillis;
+            long controlTimeoutMillis;
+            unsigned long integrationTimeMicros;
+            int triggerMode;
         };
 
     }
@@ -0,0 +1,111 @@
+/***************************************************//**
+ * @file    PixelDecoder.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Decoders for the pixel formats that spectrometers send over
+ * the bus.  Each decoder converts a run of little-endian device
+ * bytes into host integers or floating point values.  SIMD
+ * kernels (SSE2, AVX2) are selected once at runtime according
+ * to what the CPU supports, with a portable scalar version as
+ * the fallback and reference.  Other architectures use the
+ * scalar kernels.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_PIXELDECODER_H
+#define SEABREEZE_PIXELDECODER_H
+
+namespace seabreeze {
+
+    class PixelDecoder {
+    public:
+        enum Implementation {
+            IMPL_AUTO = 0,
+            IMPL_SCALAR,
+            IMPL_SSE2,
+            IMPL_AVX2
+        };
+
+        /* 16-bit little-endian pixels.  Each pixel is XORed with xorMask
+         * after assembly; some detectors report with one bit inverted
+         * (e.g. 0x8000 for the QE65000, 0x2000 for the HR4000).
+         */
+        static void decodeU16(const unsigned char *in, unsigned short xorMask,
+                unsigned short *out, unsigned int count);
+        static void decodeU16(const unsigned char *in, unsigned short xorMask,
+                double *out, unsigned int count);
+        static void decodeU16(const unsigned char *in, unsigned short xorMask,
+                float *out, unsigned int count);
+
+        /* 16-bit pixels as above, gain-adjusted in the same pass:
+         * out = min(pixel * scale, limit).  Float output is computed in
+         * single precision.
+         */
+        static void decodeU16Scaled(const unsigned char *in,
+                unsigned short xorMask, double scale, double limit,
+                double *out, unsigned int count);
+        static void decodeU16Scaled(const unsigned char *in,
+                unsigned short xorMask, double scale, double limit,
+                float *out, unsigned int count);
+
+        /* 12-bit pixels in the USB2000/HR2000 layout: alternating 64-byte
+         * packets of LSBs and MSBs, of which only the low 4 bits of each
+         * MSB are valid.
+         */
+        static void decodeOOI2K(const unsigned char *in, unsigned short *out,
+                unsigned int count);
+        static void decodeOOI2K(const unsigned char *in, double *out,
+                unsigned int count);
+        static void decodeOOI2K(const unsigned char *in, float *out,
+                unsigned int count);
+
+        /* 32-bit little-endian pixels */
+        static void decodeU32(const unsigned char *in, unsigned int *out,
+                unsigned int count);
+        static void decodeU32(const unsigned char *in, double *out,
+                unsigned int count);
+        static void decodeU32(const unsigned char *in, float *out,
+                unsigned int count);
+
+        /* Widening of already decoded pixels */
+        static void widen(const unsigned short *in, double *out, unsigned int count);
+        static void widen(const unsigned short *in, float *out, unsigned int count);
+        static void widen(const unsigned int *in, double *out, unsigned int count);
+        static void widen(const unsigned int *in, float *out, unsigned int count);
+
+        /* Forces a particular set of kernels, mainly for testing and
+         * benchmarking.  Returns false (and changes nothing) if the CPU or
+         * this build does not support it.  IMPL_AUTO restores the default.
+         * This must not be called while other threads are decoding.
+         */
+        static bool setImplementation(Implementation impl);
+        static Implementation getImplementation();
+        static const char *getImplementationName();
+    };
+
+}
+
+#endif /* SEABREEZE_PIXELDECODER_H */
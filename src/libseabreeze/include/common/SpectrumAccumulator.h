@@ -0,0 +1,101 @@
+/***************************************************//**
+ * @file    SpectrumAccumulator.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This sums spectra on the host and reduces the sums to an
+ * averaged, boxcar-smoothed spectrum.  It stands in for the
+ * scan averaging and boxcar filtering that some spectrometers
+ * perform on board.  Integer spectra are summed exactly in
+ * 32 bits when that cannot overflow and in 64 bits otherwise.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_SPECTRUMACCUMULATOR_H
+#define SEABREEZE_SPECTRUMACCUMULATOR_H
+
+#include <vector>
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
+
+namespace seabreeze {
+
+    class SpectrumAccumulator {
+    public:
+        SpectrumAccumulator();
+        virtual ~SpectrumAccumulator();
+
+        /* Discard any sums and prepare for up to maxScans spectra of the
+         * given length and sample type.  Storage is kept between calls.
+         */
+        void reset(unsigned int length,
+                FormattedSpectrumTransferInterface::SampleType type,
+                unsigned int maxScans);
+
+        /* Add one spectrum of getLength() samples.  Only the overloads
+         * matching the sample type given to reset() may be used.
+         */
+        void add(const unsigned short *spectrum);
+        void add(const unsigned int *spectrum);
+        void add(const float *spectrum);
+        void add(const double *spectrum);
+
+        unsigned int getLength() const;
+        unsigned int getCount() const;
+
+        /* Write the mean of the added spectra, with each pixel averaged over
+         * itself and up to boxcarWidth neighbours on either side, into
+         * getLength() values of out.  The window is clipped at the ends of
+         * the spectrum, and its cost does not depend on its width.
+         */
+        void finish(unsigned int boxcarWidth, double *out) const;
+        void finish(unsigned int boxcarWidth, float *out) const;
+
+    private:
+        template <typename S, typename T>
+        static void addInto(std::vector<S> &sums, const T *spectrum,
+                unsigned int length);
+        template <typename W, typename S, typename T>
+        void finishFrom(const std::vector<S> &sums, unsigned int boxcarWidth,
+                T *out) const;
+        template <typename T>
+        void finishInto(unsigned int boxcarWidth, T *out) const;
+
+        enum SumWidth {
+            SUM_UINT32,
+            SUM_UINT64,
+            SUM_DOUBLE
+        };
+
+        unsigned int length;
+        unsigned int count;
+        SumWidth width;
+        std::vector<unsigned int> sums32;
+        std::vector<unsigned long long> sums64;
+        std::vector<double> sumsDouble;
+    };
+
+}
+
+#endif /* SEABREEZE_SPECTRUMACCUMULATOR_H */
@@ -0,0 +1,101 @@
+/***************************************************//**
+ * @file    SpectrumRingBuffer.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is a fixed-size, single-producer/single-consumer queue
+ * of spectra.  All storage is allocated up front so that the
+ * producer (normally an acquisition thread) never allocates
+ * and never waits on the consumer.  One extra slot beyond the
+ * requested depth is kept so that the producer always has a
+ * free frame to read the next spectrum into; if the queue is
+ * still full once that frame is complete, it is dropped.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_SPECTRUMRINGBUFFER_H
+#define SEABREEZE_SPECTRUMRINGBUFFER_H
+
+#include <atomic>
+#include <vector>
+
+namespace seabreeze {
+
+    class SpectrumRingBuffer {
+    public:
+        SpectrumRingBuffer(unsigned int depth, unsigned int frameLength);
+        virtual ~SpectrumRingBuffer();
+
+        /* Producer side.  getWriteFrame() returns storage for
+         * getFrameLength() doubles that is not visible to the consumer.
+         * commitWriteFrame() publishes it, returning false (and counting
+         * a dropped frame) if the consumer has not made room.
+         */
+        double *getWriteFrame();
+        bool commitWriteFrame(unsigned int length, unsigned long long timestampMicros);
+
+        /* Consumer side.  Copies the oldest frame into buffer and returns the
+         * number of values copied, or 0 if no frame is available.
+         */
+        unsigned int pop(double *buffer, unsigned int bufferLength,
+                unsigned long long *timestampMicros);
+
+        unsigned int getDepth() const;
+        unsigned int getFrameLength() const;
+        unsigned int getAvailableFrames() const;
+
+        unsigned long long getCommittedFrameCount() const;
+        unsigned long long getDroppedFrameCount() const;
+
+        /* Number of distinct episodes where the queue was full, i.e. runs
+         * of one or more consecutive dropped frames.
+         */
+        unsigned long long getOverrunCount() const;
+
+        /* Discards any queued frames and zeroes the counters so the storage
+         * can be reused.  Neither the producer nor the consumer may be using
+         * the ring while this runs.
+         */
+        void reset();
+
+    private:
+        unsigned int slots;
+        unsigned int frameLength;
+        std::vector<double> frames;
+        std::vector<unsigned int> lengths;
+        std::vector<unsigned long long> timestamps;
+
+        std::atomic<unsigned int> head;   /* written only by the producer */
+        std::atomic<unsigned int> tail;   /* written only by the consumer */
+
+        std::atomic<unsigned long long> committed;
+        std::atomic<unsigned long long> dropped;
+        std::atomic<unsigned long long> overruns;
+        bool overrunInProgress;           /* producer-private */
+    };
+
+}
+
+#endif /* SEABREEZE_SPECTRUMRINGBUFFER_H */
@@ -0,0 +1,96 @@
+/***************************************************//**
+ * @file    WavelengthResampler.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This resamples spectra from a spectrometer's own wavelength
+ * calibration onto a common wavelength grid.  The source pixel
+ * indices and interpolation weights for every grid point are
+ * computed once, so that resampling a spectrum is a weighted
+ * gather that can be done with vector instructions.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_WAVELENGTHRESAMPLER_H
+#define SEABREEZE_WAVELENGTHRESAMPLER_H
+
+#include <vector>
+
+namespace seabreeze {
+
+    class WavelengthResampler {
+    public:
+        enum Method {
+            METHOD_LINEAR = 1,
+            METHOD_CUBIC
+        };
+
+        WavelengthResampler();
+        virtual ~WavelengthResampler();
+
+        /* Precompute the weights that map a spectrum sampled at the given
+         * (strictly increasing) source wavelengths onto the grid.  Linear
+         * interpolation uses the two neighbouring pixels; cubic uses the
+         * Lagrange polynomial through the four nearest pixels.  Grid points
+         * outside the source range take the value of the nearest end pixel.
+         * This throws an IllegalArgumentException if the wavelengths are not
+         * increasing or there are fewer than two of them.
+         */
+        void configure(const double *sourceWavelengths, unsigned int sourceLength,
+                const double *grid, unsigned int gridLength, Method method);
+        void clear();
+
+        bool isConfigured() const;
+        unsigned int getSourceLength() const;
+        unsigned int getGridLength() const;
+        Method getMethod() const;
+
+        /* Resample one spectrum of getSourceLength() values into
+         * getGridLength() values of out.
+         */
+        void apply(const double *spectrum, double *out) const;
+
+        /* Resample count spectra whose rows start inStride and outStride
+         * values apart.
+         */
+        void apply(const double *spectra, unsigned int count, unsigned int inStride,
+                double *out, unsigned int outStride) const;
+
+    private:
+        unsigned int sourceLength;
+        unsigned int gridLength;
+        unsigned int taps;
+        Method method;
+
+        /* First source pixel of each grid point, and the weight of tap t for
+         * grid point k at weights[t * gridLength + k].
+         */
+        std::vector<int> index;
+        std::vector<double> weights;
+    };
+
+}
+
+#endif /* SEABREEZE_WAVELENGTHRESAMPLER_H */
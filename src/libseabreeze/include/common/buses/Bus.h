@@ -58,6 +58,18 @@ namespace seabreeze {
         virtual bool open() = 0;
         virtual void close() = 0;
         virtual DeviceLocatorInterface *getLocation() = 0;
+
+        /* Limit how long any single transfer on this bus may block, in
+         * milliseconds, with 0 meaning no limit.  Returns false if the bus
+         * cannot enforce a timeout, which is the default.
+         */
+        virtual bool setTransferTimeout(unsigned int timeoutMillis);
+
+        /* Abort any transfer that is blocked on this bus, which may be in
+         * another thread.  The aborted transfer fails as though it had timed
+         * out.  Returns false if the bus cannot do this, which is the default.
+         */
+        virtual bool cancelTransfers();
     };
 
 }
@@ -0,0 +1,66 @@
+/***************************************************//**
+ * @file    DeviceHotplugListenerInterface.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * DeviceHotplugListenerInterface is implemented by classes
+ * that want to be told as devices are attached to or
+ * detached from a bus, instead of probing for them.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef DEVICEHOTPLUGLISTENERINTERFACE_H
+#define DEVICEHOTPLUGLISTENERINTERFACE_H
+
+#include <string>
+#include "common/buses/DeviceLocatorInterface.h"
+
+namespace seabreeze {
+
+    class DeviceHotplugListenerInterface {
+    public:
+        virtual ~DeviceHotplugListenerInterface() = 0;
+
+        /* A device of the named type (as accepted by DeviceFactory::create())
+         * was attached at the given location.  The location is only valid
+         * for the duration of the call.  This may be called from a
+         * bus-specific background thread, so it must not block.
+         */
+        virtual void deviceArrived(const DeviceLocatorInterface &location,
+                const std::string &deviceTypeName) = 0;
+
+        /* The device at the given location was detached */
+        virtual void deviceLeft(const DeviceLocatorInterface &location) = 0;
+
+    protected:
+        DeviceHotplugListenerInterface();
+    };
+
+    /* Default implementation for (otherwise) pure virtual destructor */
+    inline DeviceHotplugListenerInterface::~DeviceHotplugListenerInterface() {}
+
+}
+
+#endif /* DEVICEHOTPLUGLISTENERINTERFACE_H */
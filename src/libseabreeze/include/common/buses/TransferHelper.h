@@ -49,6 +49,19 @@ namespace seabreeze {
         virtual ~TransferHelper();
         virtual int receive(std::vector<unsigned char> &buffer, unsigned int length) = 0;
         virtual int send(const std::vector<unsigned char> &buffer, unsigned int length) const = 0;
+
+        /* Whether several requests may be sent before the first reply is
+         * read.  Links without buffering (e.g. RS232) must be driven one
+         * request at a time, which is the default.
+         */
+        virtual bool canQueueRequests() const;
+
+        /* Limit how long each subsequent receive() and send() may block, in
+         * milliseconds, with 0 meaning no limit.  A transfer that runs out of
+         * time throws BusTimeoutException.  Returns false if this kind of
+         * link cannot enforce a timeout, which is the default.
+         */
+        virtual bool setTimeout(unsigned int timeoutMillis);
     };
 
 }
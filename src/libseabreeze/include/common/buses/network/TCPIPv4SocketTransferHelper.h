@@ -41,6 +41,7 @@ namespace seabreeze {
 
         virtual int receive(std::vector<unsigned char> &buffer, unsigned int length);
         virtual int send(const std::vector<unsigned char> &buffer, unsigned int length) const;
+        virtual bool canQueueRequests() const;
 
     protected:
         Socket *socket;
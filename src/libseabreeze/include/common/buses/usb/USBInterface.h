@@ -53,6 +53,7 @@ namespace seabreeze {
         virtual BusFamily getBusFamily() const;
         virtual bool open() = 0;
         virtual void close() = 0;
+        virtual bool cancelTransfers();
 
     protected:
         USB *usb;
@@ -52,11 +52,19 @@ namespace seabreeze {
 
         virtual int receive(std::vector<unsigned char> &buffer, unsigned int length);
         virtual int send(const std::vector<unsigned char> &buffer, unsigned int length) const;
+        virtual bool canQueueRequests() const;
+        virtual bool setTimeout(unsigned int timeoutMillis);
 
     protected:
+        /* Throws BusTimeoutException or BusTransferException for a failed
+         * USB::read() or USB::write() result.
+         */
+        void throwTransferError(int result, const std::string &error) const;
+
         USB *usb;
         int sendEndpoint;
         int receiveEndpoint;
+        unsigned int timeoutMillis;
     };
 
 }
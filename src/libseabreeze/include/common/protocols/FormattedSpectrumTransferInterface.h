@@ -0,0 +1,114 @@
+/***************************************************//**
+ * @file    FormattedSpectrumTransferInterface.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is an interface that spectrum read exchanges may
+ * implement in addition to Transfer so that a formatted
+ * spectrum can be decoded straight from the bus receive
+ * buffer into a caller-supplied array.  This avoids the
+ * intermediate Data objects (and their copies) produced
+ * by Transfer::transfer().
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_FORMATTEDSPECTRUMTRANSFERINTERFACE_H
+#define SEABREEZE_FORMATTEDSPECTRUMTRANSFERINTERFACE_H
+
+#include "common/buses/TransferHelper.h"
+#include "common/exceptions/ProtocolException.h"
+
+namespace seabreeze {
+
+    class FormattedSpectrumTransferInterface {
+    public:
+        /* The type that holds a formatted pixel without loss */
+        enum SampleType {
+            SAMPLE_UINT16 = 1,
+            SAMPLE_UINT32,
+            SAMPLE_FLOAT,
+            SAMPLE_DOUBLE
+        };
+
+        virtual ~FormattedSpectrumTransferInterface() = 0;
+
+        /* Read a spectrum from the device and write at most bufferLength
+         * formatted pixel values into buffer.  Returns the number of values
+         * written.  This may throw a ProtocolException.
+         */
+        virtual unsigned int transferFormatted(TransferHelper *helper,
+                double *buffer, unsigned int bufferLength) {
+            receiveFormatted(helper);
+            return decodeFormatted(buffer, bufferLength);
+        }
+
+        /* The two halves of transferFormatted().  receiveFormatted() reads a
+         * spectrum into the exchange's own buffer and validates it, and
+         * decodeFormatted() later formats it into the caller's array.  This
+         * lets the next spectrum be requested before the last one is decoded.
+         */
+        virtual void receiveFormatted(TransferHelper *helper) = 0;
+        virtual unsigned int decodeFormatted(double *buffer,
+                unsigned int bufferLength) = 0;
+
+        /* Decode only the pixels starting at firstPixel from the received
+         * spectrum, writing at most bufferLength values.  Unlike
+         * decodeFormatted() this may be called repeatedly for different
+         * ranges of the same spectrum.  Exchanges whose pixels cannot be
+         * addressed individually return false from canDecodeFormattedRange()
+         * and throw ProtocolException here.
+         */
+        virtual bool canDecodeFormattedRange() const {
+            return false;
+        }
+        virtual unsigned int decodeFormattedRange(unsigned int /* firstPixel */,
+                double * /* buffer */, unsigned int /* bufferLength */) {
+            throw ProtocolException("Spectrum pixels cannot be decoded by range");
+        }
+
+        /* Decoding at the native width of the device.  Only the overload
+         * matching getNativeSampleType() is meaningful; the others throw.
+         */
+        virtual SampleType getNativeSampleType() const = 0;
+        virtual unsigned int decodeFormatted(unsigned short * /* buffer */,
+                unsigned int /* bufferLength */) {
+            throw ProtocolException("Spectrum samples are not 16-bit integers");
+        }
+        virtual unsigned int decodeFormatted(unsigned int * /* buffer */,
+                unsigned int /* bufferLength */) {
+            throw ProtocolException("Spectrum samples are not 32-bit integers");
+        }
+        virtual unsigned int decodeFormatted(float * /* buffer */,
+                unsigned int /* bufferLength */) {
+            throw ProtocolException("Spectrum samples are not single-precision floats");
+        }
+    };
+
+    /* Default implementation for (otherwise) pure virtual destructor */
+    inline FormattedSpectrumTransferInterface::~FormattedSpectrumTransferInterface() {}
+
+}
+
+#endif /* SEABREEZE_FORMATTEDSPECTRUMTRANSFERINTERFACE_H */
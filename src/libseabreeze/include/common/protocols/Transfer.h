@@ -91,6 +91,9 @@ namespace seabreeze {
         Transfer();
         void checkBufferSize();
 
+        /* Receive this->length bytes into this->buffer without making a copy */
+        void receiveIntoBuffer(TransferHelper *helper);
+
         unsigned int length;
         std::vector<unsigned char> *buffer;
         direction_t direction;
@@ -0,0 +1,56 @@
+/***************************************************//**
+ * @file    UnformattedSpectrumTransferInterface.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is an interface that unformatted spectrum read
+ * exchanges may implement in addition to Transfer so that
+ * the number of bytes they return can be known without
+ * acquiring a spectrum.  The length follows from the
+ * readout length the exchange was constructed with.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_UNFORMATTEDSPECTRUMTRANSFERINTERFACE_H
+#define SEABREEZE_UNFORMATTEDSPECTRUMTRANSFERINTERFACE_H
+
+namespace seabreeze {
+
+    class UnformattedSpectrumTransferInterface {
+    public:
+        virtual ~UnformattedSpectrumTransferInterface() = 0;
+
+        /* The number of bytes in the Data returned by transfer(), which may
+         * be less than the readout length if framing is stripped off.
+         */
+        virtual unsigned int getUnformattedSpectrumLength() const = 0;
+    };
+
+    /* Default implementation for (otherwise) pure virtual destructor */
+    inline UnformattedSpectrumTransferInterface::~UnformattedSpectrumTransferInterface() {}
+
+}
+
+#endif /* SEABREEZE_UNFORMATTEDSPECTRUMTRANSFERINTERFACE_H */
@@ -53,6 +53,8 @@ extern "C" {
 #define ABORT_FAILED    		-1
 #define RESET_OK         		0
 #define RESET_FAILED    		-1
+#define TRANSFER_TIMEOUT		-2
+#define TRANSFER_CANCELLED		-3
 
 struct USBConfigurationDescriptor {
     unsigned char bLength;
@@ -121,6 +123,67 @@ int
 USBProbeDevices(int vendorID, int productID, unsigned long *output,
         int max_devices);
 
+//------------------------------------------------------------------------------
+// This function attempts to discover all devices that match any of a table
+// of product and vendor IDs.  The bus is only enumerated once no matter how
+// many entries the table has, so this should be preferred over calling
+// USBProbeDevices() for each known device type.
+//
+// PARAMETERS:
+// vendorIDs:  The vendor IDs to match with devices on the bus
+// productIDs: The product IDs to match with devices on the bus.  Entry i of
+//             this and vendorIDs together make up one VID/PID pair.
+// num_ids:    The number of entries in vendorIDs and productIDs
+// output:     A buffer of longs that will be populated with unique IDs for each
+//             device found that matches any of the VID/PID pairs
+// matches:    A buffer that will be populated with the table index of the pair
+//             that each device in output matched.  This may be NULL.
+// max_devices: A limit on how many IDs can be put into the output buffer
+//
+// RETURN VALUE:
+// The number of devices successfully found, or -1 if there was an error.
+int
+USBProbeDeviceTable(const int *vendorIDs, const int *productIDs, int num_ids,
+        unsigned long *output, int *matches, int max_devices);
+
+//------------------------------------------------------------------------------
+// Events passed to a USBHotplugCallback
+#define USB_HOTPLUG_ARRIVED 1
+#define USB_HOTPLUG_LEFT    2
+
+// event:     USB_HOTPLUG_ARRIVED or USB_HOTPLUG_LEFT
+// deviceID:  The same ID that USBProbeDeviceTable() reports for the device
+// match:     The index of the VID/PID pair in the table that the device matched
+// context:   The pointer that was given to USBHotplugStart()
+typedef void (*USBHotplugCallback)(int event, unsigned long deviceID, int match,
+        void *context);
+
+//------------------------------------------------------------------------------
+// This function starts watching for devices that match any of a table of
+// product and vendor IDs being attached or detached.  Devices that are already
+// attached are reported as having arrived before this returns.  The callback
+// is called from a background thread that also services USB events, so it must
+// return quickly and must not call any other function in this file.
+//
+// PARAMETERS:
+// vendorIDs, productIDs, num_ids: The table of VID/PID pairs, as for
+//            USBProbeDeviceTable().  The table is copied.
+// callback:  The function to call as devices arrive and leave
+// context:   Passed through to the callback
+//
+// RETURN VALUE:
+// 0 on success, or -1 if hotplug events are not supported by this platform
+// or are already being watched.
+int
+USBHotplugStart(const int *vendorIDs, const int *productIDs, int num_ids,
+        USBHotplugCallback callback, void *context);
+
+//------------------------------------------------------------------------------
+// This function stops watching for hotplug events.  Once it returns, the
+// callback given to USBHotplugStart() will not be called again.
+void
+USBHotplugStop(void);
+
 //------------------------------------------------------------------------------
 // This function attempts to open a device with the given product and vendor
 // ID's at the specified index.
@@ -193,6 +256,25 @@ USBWrite(void *handle, unsigned char endpoint, char * data, int numberOfBytes);
 int
 USBRead(void *handle, unsigned char endpoint, char * data, int numberOfBytes);
 
+//------------------------------------------------------------------------------
+// These functions behave like USBWrite() and USBRead() but give up once the
+// transfer has taken longer than the given number of milliseconds.  A timeout
+// of 0 waits indefinitely, as USBWrite() and USBRead() do.
+//
+// RETURN VALUE:
+// As for USBWrite() and USBRead(), except that TRANSFER_TIMEOUT is returned if
+// the device did not complete the transfer in time, and TRANSFER_CANCELLED if
+// USBCancel() was called while the transfer was in progress.  Platforms that
+// cannot cancel a transfer never return TRANSFER_CANCELLED.
+//------------------------------------------------------------------------------
+int
+USBWriteTimeout(void *handle, unsigned char endpoint, char * data, int numberOfBytes,
+        unsigned int timeoutMillis);
+
+int
+USBReadTimeout(void *handle, unsigned char endpoint, char * data, int numberOfBytes,
+        unsigned int timeoutMillis);
+
 //------------------------------------------------------------------------------
 // This function attempts to clear any stall on the given endpoint.
 //
@@ -206,6 +288,39 @@ USBRead(void *handle, unsigned char endpoint, char * data, int numberOfBytes);
 void
 USBClearStall(void *handle, unsigned char endpoint);
 
+//------------------------------------------------------------------------------
+// This function keeps a number of bulk reads submitted on the given IN
+// endpoint at all times, so that data streamed by the device does not wait
+// for the host to ask for it.  Subsequent calls to USBRead() on the endpoint
+// are served from the queue and still return whole messages.
+//
+// PARAMETERS:
+// handle: The device handle obtained via the open() function.
+// endpoint: The IN endpoint on the device to queue reads on.
+// depth: The number of reads to keep submitted, or 0 to stop queueing.
+//
+// RETURN VALUE:
+// Returns 0 on success, or -1 if queued reads are not supported on this
+// platform or could not be set up (in which case reads stay synchronous).
+//------------------------------------------------------------------------------
+int
+USBSetReadQueue(void *handle, unsigned char endpoint, int depth);
+
+//------------------------------------------------------------------------------
+// This function aborts any reads or writes that other threads are waiting on
+// for the given device.  Those calls return TRANSFER_CANCELLED.  Transfers that
+// start after this returns are not affected.
+//
+// PARAMETERS:
+// handle: The device handle obtained via the open() function.
+//
+// RETURN VALUE:
+// Returns 0 on success, or -1 if transfers cannot be cancelled on this
+// platform.
+//------------------------------------------------------------------------------
+int
+USBCancel(void *handle);
+
 int
 USBGetDeviceDescriptor(void *handle, struct USBDeviceDescriptor *desc);
 
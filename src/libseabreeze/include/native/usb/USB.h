@@ -47,9 +47,32 @@ namespace seabreeze {
         bool close();
         int write(int endpoint, void *data, unsigned int length_bytes);
         int read(int endpoint, void *data, unsigned int length_bytes);
+        /* As above, but giving up after timeoutMillis (0 waits indefinitely).
+         * These return TRANSFER_TIMEOUT or TRANSFER_CANCELLED (see
+         * NativeUSB.h) if the transfer ran out of time or was cancelled.
+         */
+        int write(int endpoint, void *data, unsigned int length_bytes,
+                unsigned int timeoutMillis);
+        int read(int endpoint, void *data, unsigned int length_bytes,
+                unsigned int timeoutMillis);
         void clearStall(int endpoint);
 
+        /* Abort any read or write that is blocked on this device, including
+         * those in other threads.  Returns false if the native USB
+         * implementation cannot do this.
+         */
+        bool cancelTransfers();
+
+        /* Keep depth bulk reads submitted on the given IN endpoint so that
+         * streamed data never waits for the host.  Returns false if the native
+         * USB implementation cannot do this, in which case reads stay
+         * synchronous.  A depth of 0 turns queueing off.
+         */
+        bool setReadQueueDepth(int endpoint, int depth);
+
         static void setVerbose(bool v);
+        static void setDefaultReadQueueDepth(int depth);
+        static int getDefaultReadQueueDepth();
 
         int getDeviceDescriptor(struct USBDeviceDescriptor *desc);
         int getInterfaceDescriptor(struct USBInterfaceDescriptor *desc);
@@ -76,6 +99,7 @@ namespace seabreeze {
         void *descriptor;
         bool opened;
         static bool verbose;
+        static int defaultReadQueueDepth;
         unsigned long deviceID;
     };
 
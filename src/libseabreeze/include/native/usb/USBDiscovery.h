@@ -30,6 +30,7 @@
 #define USBDISCOVERY_H
 
 #include "native/usb/USB.h"
+#include "native/usb/NativeUSB.h"
 #include <vector>
 
 namespace seabreeze {
@@ -52,6 +53,31 @@ namespace seabreeze {
          */
         std::vector<unsigned long> *probeDevices(int vendorID, int productID);
 
+        /**
+         * Probes the bus once for devices matching any of the given VID/PID
+         * pairs (entry i of vendorIDs and productIDs together make up a pair)
+         * and returns a vector of identifiers as for the single pair version.
+         * On return, matches holds the index of the pair that each identifier
+         * matched.
+         */
+        std::vector<unsigned long> *probeDevices(const std::vector<int> &vendorIDs,
+                const std::vector<int> &productIDs, std::vector<int> &matches);
+
+        /**
+         * Starts reporting devices matching any of the given VID/PID pairs as
+         * they are attached and detached, as described for USBHotplugStart().
+         * Returns false if this platform cannot report hotplug events.
+         */
+        bool startHotplug(const std::vector<int> &vendorIDs,
+                const std::vector<int> &productIDs, USBHotplugCallback callback,
+                void *context);
+
+        /**
+         * Stops reporting hotplug events.  The callback given to
+         * startHotplug() is not called again once this returns.
+         */
+        void stopHotplug();
+
         /**
          * Given an identifier from probeDevices(), create a USB interface to
          * the device that can be used to open/write/read/close the device.
@@ -51,7 +51,19 @@ namespace seabreeze {
         virtual int send(const std::vector<unsigned char> &buffer, unsigned int length) const;
 
     private:
+        /* Rounds length up to a whole number of words */
+        static unsigned int getPaddedLength(unsigned int length);
+
         static const int WORD_SIZE_BYTES;
+        static const unsigned int INITIAL_SCRATCH_BYTES;
+
+        /* Messages that are not word-aligned are padded through these so that
+         * no transfer allocates once the largest message has been seen.
+         * Sending has its own buffer since the next request may be written
+         * while a reply is still being read.
+         */
+        std::vector<unsigned char> receiveScratch;
+        mutable std::vector<unsigned char> sendScratch;
     };
 
 }
@@ -52,6 +52,7 @@ namespace seabreeze {
         virtual void setLocation(const DeviceLocatorInterface &location);
         virtual bool open();
         virtual void close();
+        virtual bool setTransferTimeout(unsigned int timeoutMillis);
 
         /* Inherited from DeviceLocationProberInterface */
         virtual std::vector<DeviceLocatorInterface *> *probeDevices();
@@ -63,6 +64,9 @@ namespace seabreeze {
         int vendorID;
         int productID;
 
+        /* Applied to helpers as they are added, since open() recreates them */
+        unsigned int transferTimeoutMillis;
+
         /* These vectors should really be in a map, but that didn't want to
          * work easily.  Since there will likely be about 2 entries in here,
          * storing in a pair of vectors for now won't hurt anything.
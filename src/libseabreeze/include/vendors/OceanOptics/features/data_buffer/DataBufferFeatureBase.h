@@ -62,12 +62,25 @@ namespace seabreeze {
         virtual void setBufferCapacity(const Protocol &protocol, const Bus &bus,
                 const DataBufferIndex_t bufferIndex,
                 const DataBufferElementCount_t bufferSize);
+        virtual unsigned int getBufferedSpectrumLength();
+
+        /* Reads up to numberOfSpectra of the oldest spectra, removing them
+         * from the buffer.  No more spectra are requested than the buffer
+         * holds, so this never waits for a new acquisition.
+         */
+        virtual unsigned int readBufferedSpectra(const Protocol &protocol,
+                const Bus &bus, const DataBufferIndex_t bufferIndex,
+                const unsigned int numberOfSpectra, unsigned int *pixels,
+                const unsigned int stride, FastBufferSpectrumMetadata *metadata);
 
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
 
     protected:
         DataBufferIndex_t numberOfBuffers;
+
+        /* Pixels per buffered spectrum, or 0 if they cannot be read here */
+        unsigned int bufferedSpectrumLength;
     };
 
 } /* end namespace */
@@ -30,6 +30,7 @@
 #ifndef DATABUFFERFEATUREINTERFACE_H
 #define DATABUFFERFEATUREINTERFACE_H
 
+#include "api/FastBufferSpectrumMetadata.h"
 #include "common/protocols/Protocol.h"
 #include "common/buses/Bus.h"
 #include "common/exceptions/FeatureException.h"
@@ -63,6 +64,15 @@ namespace seabreeze {
         virtual void setBufferCapacity(const Protocol &protocol, const Bus &bus,
                 const DataBufferIndex_t bufferIndex,
                 const DataBufferElementCount_t bufferSize) = 0;
+
+        /* Bulk readout of buffered spectra.  The spectrum length is 0 if the
+         * device cannot read spectra through its data buffer.
+         */
+        virtual unsigned int getBufferedSpectrumLength() = 0;
+        virtual unsigned int readBufferedSpectra(const Protocol &protocol,
+                const Bus &bus, const DataBufferIndex_t bufferIndex,
+                const unsigned int numberOfSpectra, unsigned int *pixels,
+                const unsigned int stride, FastBufferSpectrumMetadata *metadata) = 0;
     };
 
     /* Default implementation for (otherwise) pure virtual destructor */
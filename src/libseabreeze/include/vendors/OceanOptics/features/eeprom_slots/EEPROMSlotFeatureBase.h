@@ -56,6 +56,13 @@ namespace seabreeze {
         virtual int writeEEPROMSlot(const Protocol &protocol,
                 const Bus &bus, unsigned int slot, const std::vector<unsigned char> &data);
 
+        /* Reads several slots in one batch where the bus allows it.  The
+         * caller owns the returned vectors.
+         */
+        virtual std::vector<std::vector<unsigned char> *> *readEEPROMSlots(
+                const Protocol &protocol, const Bus &bus,
+                const std::vector<int> &slots);
+
         /* This is a utility function that reads out the given EEPROM slot and
          * parses it into a double value.  If for some reason the parse fails,
          * this will throw a NumberFormatException.
@@ -63,10 +70,20 @@ namespace seabreeze {
         double readDouble(const Protocol &protocol, const Bus &bus,
                 unsigned int slot);
 
+        /* As with readDouble(), but reads count consecutive slots starting
+         * at firstSlot in one batch.  If any slot fails to parse, this will
+         * throw a NumberFormatException after all have been read.
+         */
+        std::vector<double> readDoubles(const Protocol &protocol, const Bus &bus,
+                unsigned int firstSlot, unsigned int count);
+
         /* As with readDouble(), this will read a slot and parse into an integer */
         long readLong(const Protocol &protocol, const Bus &bus,
                 unsigned int slot);
 
+    private:
+        static bool parseDouble(const std::vector<unsigned char> &slot, double &value);
+
     };
 
 }
@@ -0,0 +1,144 @@
+/***************************************************//**
+ * @file    ContinuousAcquisition.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This runs a dedicated thread that repeatedly requests and
+ * reads formatted spectra from a spectrometer feature and
+ * pushes them, timestamped, into a SpectrumRingBuffer.  A
+ * consumer can then pop spectra at its own pace without
+ * holding up the bus.
+ *
+ * Other traffic on the same spectrometer should be bracketed
+ * with lockBus()/unlockBus() so that it is never interleaved
+ * with a request/read cycle of the acquisition thread.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_CONTINUOUSACQUISITION_H
+#define SEABREEZE_CONTINUOUSACQUISITION_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "common/SpectrumRingBuffer.h"
+#include "common/buses/Bus.h"
+#include "common/protocols/Protocol.h"
+#include "vendors/OceanOptics/features/spectrometer/OOISpectrometerFeatureInterface.h"
+
+namespace seabreeze {
+
+    class ContinuousAcquisition {
+    public:
+        ContinuousAcquisition(OOISpectrometerFeatureInterface *feature,
+                Protocol *protocol, Bus *bus);
+        virtual ~ContinuousAcquisition();
+
+        /* Allocates a ring of the given depth and starts the acquisition
+         * thread.  Throws IllegalArgumentException for a zero depth and
+         * FeatureControlException if acquisition is already running.  If
+         * pipelined is true, the request for each spectrum is written before
+         * the previous one is decoded so the device never sits idle.
+         */
+        void start(unsigned int depth, bool pipelined);
+
+        /* Stops the acquisition thread and waits for it to exit.  Frames
+         * that were already queued remain available to readSpectrum().
+         */
+        void stop();
+
+        bool isRunning() const;
+
+        /* Pops the oldest queued spectrum without blocking.  Returns the
+         * number of values copied or 0 if nothing is queued.  The timestamp
+         * is the host time in microseconds since the UNIX epoch at which
+         * the readout completed.
+         */
+        unsigned int readSpectrum(double *buffer, unsigned int bufferLength,
+                unsigned long long *timestampMicros);
+
+        /* These return 0 if acquisition has never been started */
+        unsigned int getDepth();
+        unsigned long long getAcquiredFrameCount();
+        unsigned long long getDroppedFrameCount();
+        unsigned long long getOverrunCount();
+
+        /* Number of acquisitions that failed with an exception.  The thread
+         * stops after a failure, so this is at most 1 per start().
+         */
+        unsigned long long getErrorCount() const;
+
+        /* Serializes access to the bus with the acquisition thread.  If a
+         * pipelined spectrum request is outstanding, lockBus() reads it
+         * back and discards it so that the caller starts with an idle bus.
+         */
+        void lockBus();
+        void unlockBus();
+
+        /* True while another thread is waiting in lockBus().  Threads that
+         * take the bus in a loop should back off while this is set.
+         */
+        bool hasBusWaiters() const;
+
+    protected:
+        void run();
+
+        OOISpectrometerFeatureInterface *feature;
+        Protocol *protocol;
+        Bus *bus;
+
+        /* The acquisition thread uses the ring without locking, since it is
+         * only replaced while that thread is stopped.  Consumers hold
+         * ringMutex so that start() cannot replace it under them.
+         */
+        SpectrumRingBuffer *ring;
+        std::mutex ringMutex;
+        std::thread worker;
+        std::mutex busMutex;
+        std::atomic<int> busWaiters;
+        std::atomic<bool> stopRequested;
+        std::atomic<bool> running;
+        std::atomic<unsigned long long> errors;
+        bool pipelined;
+    };
+
+    /* Holds the bus lock of a ContinuousAcquisition for its own lifetime */
+    class ContinuousAcquisitionBusLock {
+    public:
+        ContinuousAcquisitionBusLock(ContinuousAcquisition *acquisition) {
+            this->acquisition = acquisition;
+            this->acquisition->lockBus();
+        }
+        ~ContinuousAcquisitionBusLock() {
+            this->acquisition->unlockBus();
+        }
+
+    private:
+        ContinuousAcquisition *acquisition;
+    };
+
+}
+
+#endif /* SEABREEZE_CONTINUOUSACQUISITION_H */
@@ -0,0 +1,156 @@
+/***************************************************//**
+ * @file    FastBufferDrain.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This runs a dedicated thread that keeps the fast buffer of a
+ * spectrometer (e.g. the Flame-X) drained.  It polls the number
+ * of spectra held by the device's data buffer, requests them in
+ * batches of up to the largest size the device accepts, and
+ * queues the parsed spectra and their metadata on the host.
+ *
+ * The spectrum counter in each spectrum's metadata is checked
+ * for continuity so that spectra the device discarded before
+ * they could be read are counted rather than silently lost.
+ *
+ * Bus access is arbitrated through the lock of a
+ * ContinuousAcquisition on the same spectrometer, which must
+ * not be acquiring at the same time.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_FASTBUFFERDRAIN_H
+#define SEABREEZE_FASTBUFFERDRAIN_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "api/FastBufferSpectrumMetadata.h"
+#include "common/buses/Bus.h"
+#include "common/protocols/Protocol.h"
+#include "vendors/OceanOptics/features/data_buffer/DataBufferFeatureInterface.h"
+#include "vendors/OceanOptics/features/spectrometer/ContinuousAcquisition.h"
+#include "vendors/OceanOptics/features/spectrometer/OOISpectrometerFeatureInterface.h"
+
+namespace seabreeze {
+
+    class FastBufferDrain {
+    public:
+        FastBufferDrain(OOISpectrometerFeatureInterface *feature,
+                DataBufferFeatureInterface *dataBuffer,
+                ContinuousAcquisition *busOwner,
+                Protocol *protocol, Bus *bus);
+        virtual ~FastBufferDrain();
+
+        /* Allocates a host queue of the given depth and starts the drain
+         * thread.  Each request asks for at most maxBatch spectra; when the
+         * device buffer is empty the thread sleeps for pollIntervalMicros.
+         * Throws IllegalArgumentException for a zero depth or batch size and
+         * FeatureControlException if there is no data buffer feature or if
+         * the drain or a continuous acquisition is already running.
+         */
+        void start(unsigned int depth, unsigned int maxBatch,
+                unsigned int pollIntervalMicros);
+
+        /* Stops the drain thread and waits for it to exit.  Spectra that
+         * were already queued remain available to read().
+         */
+        void stop();
+
+        bool isRunning() const;
+
+        /* Pops up to maxSpectra of the oldest queued spectra without
+         * blocking, into rows of stride pixels (as FastBufferSpectrumParser
+         * writes them) and one metadata record each.  Returns the number of
+         * spectra copied, which is 0 if nothing is queued.
+         */
+        unsigned int read(unsigned int maxSpectra, unsigned int *pixels,
+                unsigned int stride, FastBufferSpectrumMetadata *metadata);
+
+        /* Spectra parsed from the device, including those dropped on the host */
+        unsigned long long getReceivedCount() const;
+
+        /* Spectra missing from the counter sequence, i.e. discarded by the
+         * device, and the number of separate gaps they fell into.  A counter
+         * that goes backwards (the device was reset) counts as a gap of 0.
+         */
+        unsigned long long getMissedCount() const;
+        unsigned long long getGapCount() const;
+
+        /* Spectra discarded because the host queue was full */
+        unsigned long long getDroppedCount() const;
+
+        /* Number of drain cycles that failed with an exception.  The thread
+         * stops after a failure, so this is at most 1 per start().
+         */
+        unsigned long long getErrorCount() const;
+
+    protected:
+        void run();
+        void checkSequence(const FastBufferSpectrumMetadata &metadata);
+        void enqueue(unsigned int count);
+
+        OOISpectrometerFeatureInterface *feature;
+        DataBufferFeatureInterface *dataBuffer;
+        ContinuousAcquisition *busOwner;
+        Protocol *protocol;
+        Bus *bus;
+
+        unsigned int maxBatch;
+        unsigned int pollIntervalMicros;
+        unsigned int frameLength;
+
+        /* Parser output for one batch, owned by the drain thread */
+        std::vector<unsigned int> batchPixels;
+        std::vector<FastBufferSpectrumMetadata> batchMetadata;
+
+        /* Host queue of depth frames, guarded by queueMutex.  Whole batches
+         * are pushed under one lock so contention is per batch, not per
+         * spectrum.
+         */
+        std::mutex queueMutex;
+        std::vector<unsigned int> queuePixels;
+        std::vector<FastBufferSpectrumMetadata> queueMetadata;
+        unsigned int depth;
+        unsigned int queueHead;
+        unsigned int queueCount;
+
+        bool haveLastSpectrumCount;
+        unsigned int lastSpectrumCount;
+
+        std::thread worker;
+        std::atomic<bool> stopRequested;
+        std::atomic<bool> running;
+        std::atomic<unsigned long long> received;
+        std::atomic<unsigned long long> missed;
+        std::atomic<unsigned long long> gaps;
+        std::atomic<unsigned long long> dropped;
+        std::atomic<unsigned long long> errors;
+    };
+
+}
+
+#endif /* SEABREEZE_FASTBUFFERDRAIN_H */
@@ -0,0 +1,65 @@
+/***************************************************//**
+ * @file    FastBufferSpectrumParser.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This splits the payload returned by a fast buffer read (a run
+ * of metadata blocks, each followed by its pixels and a 4-byte
+ * checksum) into one row of 32-bit pixels and one decoded
+ * FastBufferSpectrumMetadata record per spectrum.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_FASTBUFFERSPECTRUMPARSER_H
+#define SEABREEZE_FASTBUFFERSPECTRUMPARSER_H
+
+#include "api/FastBufferSpectrumMetadata.h"
+
+namespace seabreeze {
+
+    class FastBufferSpectrumParser {
+    public:
+        /* Parses at most maxSpectra spectra out of data into consecutive
+         * rows of stride values in pixels and one record each in metadata.
+         * Pixels are widened to 32 bits: the 16-, 24- and 32-bit integer
+         * formats are zero-extended and floats keep their IEEE-754 bit
+         * pattern.  A row is truncated to stride values or padded with
+         * zeros.  Returns the number of spectra parsed, which is less than
+         * maxSpectra only if data ends on a spectrum boundary.  Throws
+         * IllegalArgumentException for truncated data or an unknown
+         * pixel format.
+         */
+        static unsigned int parse(const unsigned char *data,
+                unsigned int dataLength, unsigned int maxSpectra,
+                unsigned int *pixels, unsigned int stride,
+                FastBufferSpectrumMetadata *metadata);
+
+        /* Bytes per pixel of a FAST_BUFFER_PIXEL_FORMAT_*, or 0 if unknown */
+        static unsigned int getBytesPerPixel(unsigned int pixelDataFormat);
+    };
+
+}
+
+#endif /* SEABREEZE_FASTBUFFERSPECTRUMPARSER_H */
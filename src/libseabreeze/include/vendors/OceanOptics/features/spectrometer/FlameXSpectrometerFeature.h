@@ -40,7 +40,7 @@ namespace seabreeze {
         virtual ~FlameXSpectrometerFeature();
 
         /* Using OBP wavelength coefficient commands */
-        virtual std::vector<double> *getWavelengths(const Protocol &protocol, const Bus &bus);
+        virtual std::vector<double> *readWavelengths(const Protocol &protocol, const Bus &bus);
 		virtual bool initialize(const Protocol &protocol, const Bus &bus);
 
 	private:
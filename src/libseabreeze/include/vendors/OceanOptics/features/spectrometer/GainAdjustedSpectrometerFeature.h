@@ -41,13 +41,25 @@ namespace seabreeze {
                 ProgrammableSaturationFeature *saturationFeature);
         virtual ~GainAdjustedSpectrometerFeature();
 
+        /* The saturation level is resolved once, at initialization, so
+         * these are cheap enough to call for every spectrum.
+         */
         virtual unsigned int getSaturationLevel();
 
+        /* The gain adjustment factor, maxIntensity / saturation level */
+        double getGainScale();
+
         /* Inherited from Feature */
         virtual bool initialize(const Protocol &protocol, const Bus &bus);
 
     protected:
         ProgrammableSaturationFeature *saturation;
+
+    private:
+        void resolveSaturationLevel();
+
+        unsigned int saturationLevel;
+        double gainScale;
     };
 
 }
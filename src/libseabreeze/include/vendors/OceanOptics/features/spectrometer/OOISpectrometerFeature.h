@@ -31,6 +31,7 @@
 #define OOISPECTROMETERFEATURE_H
 
 #include <vector>
+#include <mutex>
 #include "common/features/FeatureImpl.h"
 #include "common/protocols/Protocol.h"
 #include "common/buses/Bus.h"
@@ -38,6 +39,7 @@
 #include "common/exceptions/IllegalArgumentException.h"
 #include "vendors/OceanOptics/features/spectrometer/SpectrometerTriggerMode.h"
 #include "vendors/OceanOptics/features/spectrometer/OOISpectrometerFeatureInterface.h"
+#include "vendors/OceanOptics/features/spectrometer/SpectrumCorrector.h"
 #include "vendors/OceanOptics/features/introspection/IntrospectionFeature.h"
 #include "vendors/OceanOptics/features/fast_buffer/FlameXFastBufferFeature.h"
 
@@ -53,18 +55,51 @@ namespace seabreeze {
         /* Request and read out a spectrum formatted into intensity (A/D counts) */
         virtual std::vector<double> *getFormattedSpectrum(const Protocol &protocol,
                 const Bus &bus);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength);
+
+        virtual unsigned int getUncorrectedFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength);
+
+        /* Formatted spectra at the native width of the device */
+        virtual FormattedSpectrumTransferInterface::SampleType getFormattedSampleType(
+                const Protocol &protocol);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned short *buffer, unsigned int bufferLength);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned int *buffer, unsigned int bufferLength);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, float *buffer, unsigned int bufferLength);
+
+        /* Pipelined formatted spectra: read N, request N+1, then decode N */
+        virtual void beginPipelinedFormattedSpectra(const Protocol &protocol,
+                const Bus &bus);
+        virtual unsigned int getPipelinedFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength);
+        virtual void endPipelinedFormattedSpectra(const Protocol &protocol,
+                const Bus &bus);
 
         /* Request and read out the raw spectrum data stream */
         virtual std::vector<unsigned char> *getUnformattedSpectrum(const Protocol &protocol,
                 const Bus &bus);
+        virtual unsigned int getUnformattedSpectrumLength(const Protocol &protocol);
 
 		virtual std::vector<unsigned char> *getFastBufferSpectrum(const Protocol &protocol,
 			const Bus &bus, unsigned int numberOfSamplesToRetrieve);
 
-        /* Request and read out the wavelengths in nanometers as a vector of doubles */
+        /* Request and read out the wavelengths in nanometers as a vector of doubles.
+         * They are read from the device once and cached until the feature is
+         * initialized again or invalidateWavelengths() is called.
+         */
         virtual std::vector<double> *getWavelengths(const Protocol &protocol,
                 const Bus &bus);
 
+        /* Read the wavelengths from the device, bypassing the cache.  Derived
+         * classes override this rather than getWavelengths().
+         */
+        virtual std::vector<double> *readWavelengths(const Protocol &protocol,
+                const Bus &bus);
+
         /* Read the raw spectrum data stream.  No request is made first. */
         virtual std::vector<unsigned char> *readUnformattedSpectrum(const Protocol &protocol,
                 const Bus &bus);
@@ -92,6 +127,9 @@ namespace seabreeze {
         virtual void setTriggerMode(const Protocol &protocol,
                 const Bus &bus, SpectrometerTriggerMode &mode);
 
+        virtual bool setSpectrumTimeout(const Protocol &protocol,
+                const Bus &bus, unsigned int timeoutMillis);
+
 		virtual std::vector<SpectrometerTriggerMode *> getTriggerModes() const;
 
 		virtual std::vector<unsigned int> getActivePixelIndices() const;
@@ -105,10 +143,56 @@ namespace seabreeze {
         virtual unsigned short getNumberOfPixels() const;
         virtual int getMaximumIntensity() const;
 
+        virtual void setNonlinearityCoefficients(const std::vector<double> &coefficients,
+                unsigned int maxCount);
+        virtual bool hasNonlinearityCoefficients() const;
+        virtual void setStrayLightCoefficients(const std::vector<double> &coefficients);
+        virtual bool hasStrayLightCoefficients() const;
+        virtual void setSpectrumCorrection(bool correctDarkCounts,
+                bool correctNonlinearity, bool correctStrayLight);
+        virtual void setIrradianceCalibration(const std::vector<double> &calibration,
+                const std::vector<double> &wavelengths);
+        virtual bool hasIrradianceCalibration() const;
+        virtual void setIrradianceOutput(bool enable, double collectionArea);
+        virtual void applySpectrumCorrection(double *buffer,
+                unsigned int length) const;
+
+        virtual void setPixelRanges(const std::vector<unsigned int> &ranges);
+        virtual void clearPixelRanges();
+        virtual std::vector<unsigned int> getPixelRanges();
+        virtual unsigned int getPixelRangeLength();
+        virtual unsigned int getPixelRangeSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength);
+        virtual std::vector<double> *getPixelRangeWavelengths(const Protocol &protocol,
+                const Bus &bus);
+        virtual unsigned int gatherPixelRanges(const double *spectrum,
+                unsigned int length, double *buffer, unsigned int bufferLength);
+
         /* Overriding from Feature */
+        virtual bool initialize(const Protocol &protocol, const Bus &bus);
         virtual FeatureFamily getFeatureFamily();
 
     protected:
+        /* Discards the cached wavelengths, e.g. when pixel binning changes */
+        void invalidateWavelengths();
+
+        /* The pixel ranges in effect, resolving the default ranges from the
+         * active or dark pixels the first time they are needed.  The caller
+         * must hold wavelengthLock, which also guards the ranges.
+         */
+        const std::vector<unsigned int> &resolvePixelRanges();
+        std::vector<unsigned int> getDefaultPixelRanges() const;
+        static unsigned int countPixelRanges(const std::vector<unsigned int> &ranges);
+        static unsigned int gatherRanges(const std::vector<unsigned int> &ranges,
+                const double *spectrum, unsigned int length, double *buffer,
+                unsigned int bufferLength);
+
+        /* Request (unless the pipeline already has) and read one formatted
+         * spectrum, decoding it into a buffer of any supported type.
+         */
+        template <typename T>
+        unsigned int readFormattedSpectrumInto(const Protocol &protocol,
+                const Bus &bus, T *buffer, unsigned int bufferLength);
 
 		/* introspection feature */
 		IntrospectionFeature *myIntrospection;
@@ -129,6 +213,33 @@ namespace seabreeze {
         std::vector<unsigned int> electricDarkPixelIndices;
 		std::vector<unsigned int> opticalDarkPixelIndices;
 		std::vector<unsigned int> activePixelIndices;
+
+        /* True while a pipelined spectrum request has not been read back */
+        bool pipelinedRequestOutstanding;
+
+        /* Applied to every spectrum returned as doubles */
+        SpectrumCorrector corrector;
+
+        /* Pixel ranges as set by the caller (empty for the default ranges)
+         * and as resolved against the current detector.  The full spectrum
+         * is decoded into pixelRangeSource when corrections need every pixel.
+         */
+        std::vector<unsigned int> pixelRanges;
+        std::vector<unsigned int> resolvedPixelRanges;
+        bool pixelRangesResolved;
+        std::vector<double> pixelRangeSource;
+
+    private:
+        /* Reads the wavelengths into the cache unless they are there already.
+         * The caller must hold wavelengthLock.
+         */
+        bool loadWavelengths(const Protocol &protocol, const Bus &bus);
+
+        std::mutex wavelengthLock;
+        std::vector<double> wavelengths;
+        bool wavelengthsValid;
+        std::vector<double> pixelRangeWavelengths;
+        bool pixelRangeWavelengthsValid;
     };
 
 }
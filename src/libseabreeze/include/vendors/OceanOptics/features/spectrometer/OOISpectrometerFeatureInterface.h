@@ -33,6 +33,7 @@
 #include <vector>
 #include "common/protocols/Protocol.h"
 #include "common/buses/Bus.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 #include "common/exceptions/FeatureException.h"
 #include "common/exceptions/IllegalArgumentException.h"
 #include "vendors/OceanOptics/features/spectrometer/SpectrometerTriggerMode.h"
@@ -47,10 +48,55 @@ namespace seabreeze {
         virtual std::vector<double> *getFormattedSpectrum(const Protocol &protocol,
                 const Bus &bus) = 0;
 
+        /* Request and read out a formatted spectrum directly into the given
+         * buffer.  Returns the number of values written.
+         */
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength) = 0;
+
+        /* As above, but without the corrections that getFormattedSpectrum()
+         * applies, for callers that apply them with applySpectrumCorrection()
+         * after combining several spectra.
+         */
+        virtual unsigned int getUncorrectedFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength) = 0;
+
+        /* The narrowest type that holds a formatted pixel without loss, and
+         * formatted spectra read out at that width.  The overloads for the
+         * other types throw FeatureControlException.
+         */
+        virtual FormattedSpectrumTransferInterface::SampleType getFormattedSampleType(
+                const Protocol &protocol) = 0;
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned short *buffer, unsigned int bufferLength) = 0;
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned int *buffer, unsigned int bufferLength) = 0;
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, float *buffer, unsigned int bufferLength) = 0;
+
+        /* Pipelined formatted spectra.  beginPipelinedFormattedSpectra()
+         * requests the first spectrum; each getPipelinedFormattedSpectrum()
+         * then reads the outstanding spectrum, requests the next one, and
+         * decodes into the buffer while the device is busy acquiring.
+         * endPipelinedFormattedSpectra() reads and discards the last request.
+         */
+        virtual void beginPipelinedFormattedSpectra(const Protocol &protocol,
+                const Bus &bus) = 0;
+        virtual unsigned int getPipelinedFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength) = 0;
+        virtual void endPipelinedFormattedSpectra(const Protocol &protocol,
+                const Bus &bus) = 0;
+
         /* Request and read out the raw spectrum data stream */
         virtual std::vector<unsigned char> *getUnformattedSpectrum(const Protocol &protocol,
                 const Bus &bus) = 0;
 
+        /* Length of the raw spectrum data stream, determined without
+         * acquiring a spectrum.  Throws FeatureControlException if the
+         * protocol cannot tell.
+         */
+        virtual unsigned int getUnformattedSpectrumLength(const Protocol &protocol) = 0;
+
 		virtual std::vector<unsigned char> *getFastBufferSpectrum(const Protocol &protocol,
 			const Bus &bus, unsigned int numberOfSamplesToRetrieve) = 0;
 
@@ -85,6 +131,13 @@ namespace seabreeze {
         virtual void setTriggerMode(const Protocol &protocol,
                 const Bus &bus, SpectrometerTriggerMode &mode) = 0;
 
+        /* Limit how long each spectrum readout may block, in milliseconds,
+         * with 0 meaning no limit.  A readout that runs out of time throws
+         * FeatureTimeoutException.  Returns false if the bus cannot do this.
+         */
+        virtual bool setSpectrumTimeout(const Protocol &protocol,
+                const Bus &bus, unsigned int timeoutMillis) = 0;
+
         virtual std::vector<SpectrometerTriggerMode *> getTriggerModes() const = 0;
 
         virtual std::vector<unsigned int> getElectricDarkPixelIndices() const = 0;
@@ -98,6 +151,63 @@ namespace seabreeze {
         virtual unsigned short getNumberOfPixels() const = 0;
         virtual int getMaximumIntensity() const = 0;
 
+        /* Optional dark, nonlinearity and stray light correction of
+         * formatted spectra read as doubles.  It is off until enabled, and
+         * the nonlinearity and stray light corrections have no effect until
+         * their coefficients (ascending order) have been set.  A nonzero
+         * maxCount tabulates the nonlinearity correction for integer counts.
+         */
+        virtual void setNonlinearityCoefficients(const std::vector<double> &coefficients,
+                unsigned int maxCount) = 0;
+        virtual bool hasNonlinearityCoefficients() const = 0;
+        virtual void setStrayLightCoefficients(const std::vector<double> &coefficients) = 0;
+        virtual bool hasStrayLightCoefficients() const = 0;
+        virtual void setSpectrumCorrection(bool correctDarkCounts,
+                bool correctNonlinearity, bool correctStrayLight) = 0;
+
+        /* Optional conversion of the corrected spectra into irradiance
+         * (uW/cm^2/nm) using a calibration in uJ/count, the given collection
+         * area in cm^2 and the integration time last set through
+         * setIntegrationTimeMicros().  setIrradianceOutput() throws
+         * IllegalArgumentException if enabled before any integration time
+         * has been set.
+         */
+        virtual void setIrradianceCalibration(const std::vector<double> &calibration,
+                const std::vector<double> &wavelengths) = 0;
+        virtual bool hasIrradianceCalibration() const = 0;
+        virtual void setIrradianceOutput(bool enable, double collectionArea) = 0;
+
+        /* Apply the enabled corrections to a spectrum formatted elsewhere,
+         * e.g. one averaged on the host from native-width readouts.
+         */
+        virtual void applySpectrumCorrection(double *buffer,
+                unsigned int length) const = 0;
+
+        /* Readout of selected pixel ranges, given as pairs of first and last
+         * pixel (inclusive) in the layout of getActivePixelIndices().  Until
+         * set, and after clearPixelRanges(), these are the active pixels or,
+         * if the device does not report them, every pixel that is neither an
+         * electric nor an optical dark pixel.  getPixelRangeSpectrum() only
+         * decodes these pixels, concatenated in the order given, and
+         * getPixelRangeWavelengths() returns the matching wavelengths.
+         * setPixelRanges() throws IllegalArgumentException for a range
+         * outside the detector.
+         */
+        virtual void setPixelRanges(const std::vector<unsigned int> &ranges) = 0;
+        virtual void clearPixelRanges() = 0;
+        virtual std::vector<unsigned int> getPixelRanges() = 0;
+        virtual unsigned int getPixelRangeLength() = 0;
+        virtual unsigned int getPixelRangeSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength) = 0;
+        virtual std::vector<double> *getPixelRangeWavelengths(const Protocol &protocol,
+                const Bus &bus) = 0;
+
+        /* Copy the selected pixel ranges out of a full spectrum, e.g. one
+         * processed on the host.  Returns the number of values written.
+         */
+        virtual unsigned int gatherPixelRanges(const double *spectrum,
+                unsigned int length, double *buffer, unsigned int bufferLength) = 0;
+
     };
 
     /* Default implementation for (otherwise) pure virtual destructor */
@@ -54,7 +54,7 @@ namespace seabreeze {
         void setPixelBinningFactor(unsigned char binningFactor);
 
 		/* Using OBP wavelength coefficient commands */
-		virtual std::vector<double> *getWavelengths(const Protocol &protocol,
+		virtual std::vector<double> *readWavelengths(const Protocol &protocol,
             const Bus &bus);
 
     private:
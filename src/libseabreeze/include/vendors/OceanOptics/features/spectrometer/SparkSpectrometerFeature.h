@@ -47,7 +47,7 @@ namespace seabreeze {
         virtual ~SparkSpectrometerFeature();
 
 		/* Using OBP wavelength coefficient commands */
-		virtual std::vector<double> *getWavelengths(const Protocol &protocol,
+		virtual std::vector<double> *readWavelengths(const Protocol &protocol,
             const Bus &bus);
 
     private:
@@ -0,0 +1,120 @@
+/***************************************************//**
+ * @file    SpectrumCorrector.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This applies electric dark and nonlinearity correction to a
+ * formatted spectrum in place, as an optional last stage of
+ * spectrum readout.  The dark level is the mean of the electric
+ * dark pixels, and each dark-corrected count x is divided by
+ * the nonlinearity polynomial P(x).
+ *
+ * For detectors that report integer counts, 1/P is tabulated
+ * once for every count up to the maximum intensity so that the
+ * per-pixel cost is a table lookup instead of a polynomial.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_SPECTRUMCORRECTOR_H
+#define SEABREEZE_SPECTRUMCORRECTOR_H
+
+#include <vector>
+
+namespace seabreeze {
+
+    class SpectrumCorrector {
+    public:
+        SpectrumCorrector();
+        virtual ~SpectrumCorrector();
+
+        void setDarkPixelIndices(const std::vector<unsigned int> &indices);
+
+        /* Coefficients in ascending order, i.e. c0 + c1*x + c2*x^2 + ...
+         * If maxCount is nonzero, 1/P is tabulated for 0..maxCount and
+         * interpolated between counts; outside that range P is evaluated.
+         */
+        void setNonlinearityCoefficients(const std::vector<double> &coefficients,
+                unsigned int maxCount);
+        bool hasNonlinearityCoefficients() const;
+
+        /* Stray light is modelled as a fraction of the mean signal that
+         * reaches each pixel, with the fraction a polynomial in the pixel
+         * index (ascending order; a single coefficient is a constant).
+         * The fraction is tabulated here for the given number of pixels so
+         * that apply() only needs one multiply and subtract per pixel.
+         */
+        void setStrayLightCoefficients(const std::vector<double> &coefficients,
+                unsigned int length);
+        bool hasStrayLightCoefficients() const;
+
+        /* As with the python implementation, a nonlinearity correction
+         * without dark correction removes the dark level before linearizing
+         * and adds it back afterwards.  The same applies to stray light,
+         * which is estimated after linearizing.
+         */
+        void setEnabled(bool correctDarkCounts, bool correctNonlinearity,
+                bool correctStrayLight);
+        bool isEnabled() const;
+
+        /* Irradiance output scales each corrected pixel by
+         * calibration / (integration time * collection area * bin width),
+         * turning counts into uW/cm^2/nm for a calibration in uJ/count.
+         * The bin widths come from the wavelengths given here, and the
+         * per-pixel factors are recomputed only when the integration time
+         * or collection area (cm^2) changes.
+         */
+        void setIrradianceCalibration(const std::vector<double> &calibration,
+                const std::vector<double> &wavelengths);
+        bool hasIrradianceCalibration() const;
+        void setIrradianceOutput(bool enable, double collectionArea);
+        void setIntegrationTimeMicros(unsigned long integrationTimeMicros);
+        unsigned long getIntegrationTimeMicros() const;
+
+        void apply(double *spectrum, unsigned int length) const;
+
+    protected:
+        double evaluate(double x) const;
+        double getReciprocal(double x) const;
+        void subtractStrayLight(double *spectrum, unsigned int length) const;
+        void updateIrradianceFactors();
+        void scaleToIrradiance(double *spectrum, unsigned int length) const;
+
+        std::vector<unsigned int> darkPixelIndices;
+        std::vector<double> coefficients;
+        std::vector<double> reciprocalTable;
+        std::vector<double> strayLightFractions;
+        std::vector<double> irradiancePerBin;      /* calibration / bin width */
+        std::vector<double> irradianceFactors;     /* ... / (time * area) */
+        double collectionArea;
+        unsigned long integrationTimeMicros;
+        bool irradianceOutput;
+        bool correctDarkCounts;
+        bool correctNonlinearity;
+        bool correctStrayLight;
+    };
+
+}
+
+#endif /* SEABREEZE_SPECTRUMCORRECTOR_H */
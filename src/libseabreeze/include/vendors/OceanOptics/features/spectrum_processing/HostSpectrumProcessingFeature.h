@@ -0,0 +1,71 @@
+/***************************************************//**
+ * @file    HostSpectrumProcessingFeature.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Scan averaging and boxcar smoothing settings for
+ * spectrometers that cannot do either on board.  The settings
+ * are held on the host and applied by the spectrometer
+ * feature adapter (see SpectrumAccumulator), so nothing here
+ * touches the device and the protocol and bus are ignored.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef HOSTSPECTRUMPROCESSINGFEATURE_H
+#define HOSTSPECTRUMPROCESSINGFEATURE_H
+
+#include <atomic>
+
+#include "vendors/OceanOptics/features/spectrum_processing/SpectrumProcessingFeatureInterface.h"
+
+namespace seabreeze {
+
+    class HostSpectrumProcessingFeature : public SpectrumProcessingFeatureInterface {
+    public:
+        HostSpectrumProcessingFeature();
+        virtual ~HostSpectrumProcessingFeature();
+        virtual unsigned char readSpectrumProcessingBoxcarWidth(
+                const Protocol &protocol, const Bus &bus);
+        virtual unsigned short int readSpectrumProcessingScansToAverage(
+                const Protocol &protocol, const Bus &bus);
+        virtual void writeSpectrumProcessingBoxcarWidth(const Protocol &protocol,
+                const Bus &bus, unsigned char boxcarWidth);
+        virtual void writeSpectrumProcessingScansToAverage(const Protocol &protocol,
+                const Bus &bus, unsigned short int scansToAverage);
+
+        unsigned char getBoxcarWidth() const;
+        unsigned short int getScansToAverage() const;
+
+        /* True if spectra need more than a single plain readout */
+        bool isActive() const;
+
+    private:
+        std::atomic<unsigned char> boxcarWidth;
+        std::atomic<unsigned short> scansToAverage;
+    };
+
+}
+
+#endif /* HOSTSPECTRUMPROCESSINGFEATURE_H */
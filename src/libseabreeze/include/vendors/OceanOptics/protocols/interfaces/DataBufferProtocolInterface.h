@@ -35,6 +35,7 @@
 #ifndef DATABUFFERPROTOCOLINTERFACE_H
 #define DATABUFFERPROTOCOLINTERFACE_H
 
+#include "api/FastBufferSpectrumMetadata.h"
 #include "common/buses/Bus.h"
 #include "common/exceptions/ProtocolException.h"
 #include "common/protocols/ProtocolHelper.h"
@@ -66,6 +67,18 @@ namespace seabreeze {
                 unsigned char bufferIndex,
                 const unsigned long capacity) = 0;
 
+        /* Reads and removes the numberOfSpectra oldest spectra of
+         * numberOfPixels 32-bit pixels each, in the order that
+         * removeOldestSpectraFromBuffer() would discard them.  Row i of
+         * pixels starts at pixels + i * stride.  Returns the number of
+         * spectra read, which is only less than numberOfSpectra if a transfer
+         * failed after at least one spectrum had been removed.
+         */
+        virtual unsigned int readBufferedSpectra(const Bus &bus,
+                unsigned char bufferIndex, unsigned int numberOfSpectra,
+                unsigned int numberOfPixels, unsigned int *pixels,
+                unsigned int stride, FastBufferSpectrumMetadata *metadata) = 0;
+
     };
 
 } /* end namespace */
@@ -55,6 +55,14 @@ namespace seabreeze {
         virtual std::vector<unsigned char> *readEEPROMSlot(const Bus &bus, int slot) = 0;
         virtual int writeEEPROMSlot(const Bus &bus, int slot,
                 const std::vector<unsigned char> &data) = 0;
+
+        /* Reads several slots, returning their contents in the same order.
+         * This reads one slot at a time; implementations may instead queue
+         * all of the requests where the bus allows it.  The caller owns the
+         * returned vectors.
+         */
+        virtual std::vector<std::vector<unsigned char> *> *readEEPROMSlots(
+                const Bus &bus, const std::vector<int> &slots);
     };
 
 }
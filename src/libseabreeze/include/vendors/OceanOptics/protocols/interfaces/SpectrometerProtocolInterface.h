@@ -39,6 +39,8 @@
 #include "common/buses/Bus.h"
 #include "common/exceptions/ProtocolException.h"
 #include "common/protocols/ProtocolHelper.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
+#include "common/protocols/UnformattedSpectrumTransferInterface.h"
 #include "vendors/OceanOptics/features/spectrometer/SpectrometerTriggerMode.h"
 #include <vector>
 
@@ -50,12 +52,49 @@ namespace seabreeze {
         virtual ~SpectrometerProtocolInterface();
 		virtual void requestFormattedSpectrum(const Bus &bus) = 0;
         virtual std::vector<double> *readFormattedSpectrum(const Bus &bus) = 0;
+        virtual unsigned int readFormattedSpectrum(const Bus &bus, double *buffer,
+                unsigned int bufferLength) = 0;
+        /* readFormattedSpectrum() split in two so that the next spectrum can
+         * be requested between receiving one spectrum and decoding it.
+         */
+        virtual void receiveFormattedSpectrum(const Bus &bus) = 0;
+        virtual unsigned int decodeFormattedSpectrum(double *buffer,
+                unsigned int bufferLength) = 0;
+        /* Decode only the pixels starting at firstPixel from the received
+         * spectrum.  This may be repeated for several ranges of the same
+         * spectrum, but only if canDecodeFormattedSpectrumRange() is true;
+         * otherwise it throws ProtocolException.
+         */
+        virtual bool canDecodeFormattedSpectrumRange() = 0;
+        virtual unsigned int decodeFormattedSpectrumRange(unsigned int firstPixel,
+                double *buffer, unsigned int bufferLength) = 0;
+        /* The narrowest type that holds a formatted pixel without loss.  The
+         * decodeFormattedSpectrum() overload for that type may be used as
+         * well as the double one; the others throw ProtocolException.
+         */
+        virtual FormattedSpectrumTransferInterface::SampleType getFormattedSampleType() = 0;
+        virtual unsigned int decodeFormattedSpectrum(unsigned short *buffer,
+                unsigned int bufferLength) = 0;
+        virtual unsigned int decodeFormattedSpectrum(unsigned int *buffer,
+                unsigned int bufferLength) = 0;
+        virtual unsigned int decodeFormattedSpectrum(float *buffer,
+                unsigned int bufferLength) = 0;
 		virtual void requestUnformattedSpectrum(const Bus &bus) = 0;
 		virtual std::vector<unsigned char> *readUnformattedSpectrum(const Bus &bus) = 0;
+        /* Number of bytes readUnformattedSpectrum() returns, known without any
+         * bus traffic.  Throws ProtocolException if the exchange cannot tell.
+         */
+        virtual unsigned int getUnformattedSpectrumLength() = 0;
 		virtual void requestFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve) = 0;
 		virtual std::vector<unsigned char> *readFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve) = 0;
         virtual void setIntegrationTimeMicros(const Bus &bus, unsigned long time_usec) = 0;
         virtual void setTriggerMode(const Bus &bus,SpectrometerTriggerMode &mode) = 0;
+        /* Limit how long each spectrum readout may block, in milliseconds,
+         * with 0 meaning no limit.  This overrides Bus::setTransferTimeout()
+         * for the bus helpers that carry spectra.  Returns false if the bus
+         * cannot enforce a timeout.
+         */
+        virtual bool setSpectrumTimeout(const Bus &bus, unsigned int timeoutMillis) = 0;
     };
 
 }
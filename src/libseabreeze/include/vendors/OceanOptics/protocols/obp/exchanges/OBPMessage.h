@@ -53,6 +53,15 @@ namespace seabreeze {
         static OBPMessage *parseHeaderFromByteStream(std::vector<unsigned char> *stream);
         static OBPMessage *parseByteStream(std::vector<unsigned char> *stream);
 
+        /* Validates the header and footer of a complete message held in
+         * stream and returns the offset of its payload without copying it.
+         * The message type and payload length are stored through the
+         * given pointers.
+         */
+        static unsigned int findPayloadInByteStream(
+                const std::vector<unsigned char> *stream,
+                unsigned int *messageType, unsigned int *payloadLength);
+
         std::vector<unsigned char> *toByteStream();
         std::vector<unsigned char> *getData();
         unsigned int getBytesRemaining();
@@ -43,6 +43,14 @@ namespace seabreeze {
             using OBPTransaction::queryDevice;
             virtual std::vector<unsigned char> *queryDevice(TransferHelper *helper) ;
 
+            /* Issues this query once per payload, pipelined where the bus
+             * allows it.  See OBPTransaction::queryDevicePipelined().
+             */
+            using OBPTransaction::queryDevicePipelined;
+            virtual std::vector<std::vector<unsigned char> *> *queryDevicePipelined(
+                    TransferHelper *helper,
+                    const std::vector<std::vector<unsigned char> > &payloads);
+
         protected:
             int messageType;
             std::vector<unsigned char> payload;
@@ -34,11 +34,14 @@
 #ifndef OBPREADRAWSPECTRUM32ANDMETADATAEXCHANGE_H
 #define OBPREADRAWSPECTRUM32ANDMETADATAEXCHANGE_H
 
+#include "api/FastBufferSpectrumMetadata.h"
 #include "common/protocols/Transfer.h"
+#include "common/protocols/UnformattedSpectrumTransferInterface.h"
 
 namespace seabreeze {
     namespace oceanBinaryProtocol {
-        class OBPReadRawSpectrum32AndMetadataExchange : public Transfer {
+        class OBPReadRawSpectrum32AndMetadataExchange : public Transfer,
+                public UnformattedSpectrumTransferInterface {
         public:
             OBPReadRawSpectrum32AndMetadataExchange(unsigned int numberOfPixels);
             virtual ~OBPReadRawSpectrum32AndMetadataExchange();
@@ -48,10 +51,28 @@ namespace seabreeze {
             /* Inherited */
             virtual Data *transfer(TransferHelper *helper);
 
+            /* Inherited from UnformattedSpectrumTransferInterface */
+            virtual unsigned int getUnformattedSpectrumLength() const;
+
+            /* Fills metadata from the block that precedes the pixels of the
+             * last spectrum received.  Fields that the QE-PRO does not report
+             * are set to zero.  Throws ProtocolException if nothing has been
+             * received.
+             */
+            void decodeMetadata(FastBufferSpectrumMetadata *metadata) const;
+
         protected:
+            /* Receives a spectrum message into this->buffer and returns a pointer
+             * to the first pixel within it, without copying the payload.
+             */
+            const unsigned char *receivePixelData(TransferHelper *helper);
+
             unsigned int isLegalMessageType(unsigned int t);
             unsigned int numberOfPixels;
             unsigned int metadataLength;
+
+            /* Pixels of the last message received by receivePixelData() */
+            const unsigned char *pixelData;
         };
     }
 }
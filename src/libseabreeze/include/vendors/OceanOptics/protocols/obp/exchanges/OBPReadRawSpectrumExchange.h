@@ -31,10 +31,12 @@
 #define OBPREADRAWSPECTRUMEXCHANGE_H
 
 #include "common/protocols/Transfer.h"
+#include "common/protocols/UnformattedSpectrumTransferInterface.h"
 
 namespace seabreeze {
   namespace oceanBinaryProtocol {
-    class OBPReadRawSpectrumExchange : public Transfer {
+    class OBPReadRawSpectrumExchange : public Transfer,
+            public UnformattedSpectrumTransferInterface {
     public:
         OBPReadRawSpectrumExchange(unsigned int readoutLength, unsigned int numberOfPixels);
         virtual ~OBPReadRawSpectrumExchange();
@@ -45,9 +47,20 @@ namespace seabreeze {
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper);
 
+        /* Inherited from UnformattedSpectrumTransferInterface */
+        virtual unsigned int getUnformattedSpectrumLength() const;
+
     protected:
+        /* Receives a spectrum message into this->buffer and returns a pointer
+         * to the first pixel within it, without copying the payload.
+         */
+        const unsigned char *receivePixelData(TransferHelper *helper);
+
         unsigned int isLegalMessageType(unsigned int t);
         unsigned int numberOfPixels;
+
+        /* Pixels of the last message received by receivePixelData() */
+        const unsigned char *pixelData;
     };
   }
 }
@@ -35,11 +35,13 @@
 #define OBPREADSPECTRUM32ANDMETADATAEXCHANGE_H
 
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadRawSpectrum32AndMetadataExchange.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 
 namespace seabreeze {
     namespace oceanBinaryProtocol {
         class OBPReadSpectrum32AndMetadataExchange
-                : public OBPReadRawSpectrum32AndMetadataExchange {
+                : public OBPReadRawSpectrum32AndMetadataExchange,
+                  public FormattedSpectrumTransferInterface {
 
         public:
             OBPReadSpectrum32AndMetadataExchange(unsigned int numberOfPixels);
@@ -47,6 +49,15 @@ namespace seabreeze {
 
             /* Inherited */
             virtual Data *transfer(TransferHelper *helper);
+
+            /* Inherited from FormattedSpectrumTransferInterface */
+            virtual void receiveFormatted(TransferHelper *helper);
+            virtual unsigned int decodeFormatted(double *buffer, unsigned int bufferLength);
+            virtual bool canDecodeFormattedRange() const;
+            virtual unsigned int decodeFormattedRange(unsigned int firstPixel,
+                    double *buffer, unsigned int bufferLength);
+            virtual SampleType getNativeSampleType() const;
+            virtual unsigned int decodeFormatted(unsigned int *buffer, unsigned int bufferLength);
         };
     }
 }
@@ -31,16 +31,28 @@
 #define OBPREADSPECTRUMEXCHANGE_H
 
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadRawSpectrumExchange.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 
 namespace seabreeze {
   namespace oceanBinaryProtocol {
-    class OBPReadSpectrumExchange : public OBPReadRawSpectrumExchange {
+    class OBPReadSpectrumExchange : public OBPReadRawSpectrumExchange,
+            public FormattedSpectrumTransferInterface {
     public:
         OBPReadSpectrumExchange(unsigned int readoutLength, unsigned int numberOfPixels);
         virtual ~OBPReadSpectrumExchange();
 
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper);
+
+        /* Inherited from FormattedSpectrumTransferInterface */
+        virtual void receiveFormatted(TransferHelper *helper);
+        virtual unsigned int decodeFormatted(double *buffer, unsigned int bufferLength);
+        virtual bool canDecodeFormattedRange() const;
+        virtual unsigned int decodeFormattedRange(unsigned int firstPixel,
+                double *buffer, unsigned int bufferLength);
+        virtual SampleType getNativeSampleType() const;
+        virtual unsigned int decodeFormatted(unsigned short *buffer, unsigned int bufferLength);
+        virtual unsigned int decodeFormatted(float *buffer, unsigned int bufferLength);
     };
   }
 }
@@ -44,6 +44,14 @@ namespace seabreeze {
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper);
 
+        /* Inherited from FormattedSpectrumTransferInterface */
+        virtual unsigned int decodeFormatted(double *buffer, unsigned int bufferLength);
+        virtual bool canDecodeFormattedRange() const;
+        virtual unsigned int decodeFormattedRange(unsigned int firstPixel,
+                double *buffer, unsigned int bufferLength);
+        virtual SampleType getNativeSampleType() const;
+        virtual unsigned int decodeFormatted(float *buffer, unsigned int bufferLength);
+
     private:
         GainAdjustedSpectrometerFeature *spectrometerFeature;
     };
@@ -76,7 +76,23 @@ namespace seabreeze {
                     unsigned int messageType,
                     std::vector<unsigned char> &data);
 
+            /* This sends one message of the given type per payload and returns
+             * the replies in the same order.  If the helper can queue requests,
+             * several messages are sent back to back, tagged with their index
+             * in the regarding field, before any reply is read.  Otherwise
+             * this falls back to one queryDevice() round trip per payload, and
+             * an entry is NULL wherever queryDevice() returned NULL.  The
+             * caller owns the returned vectors.
+             */
+            virtual std::vector<std::vector<unsigned char> *> *queryDevicePipelined(
+                    TransferHelper *helper, unsigned int messageType,
+                    const std::vector<std::vector<unsigned char> > &data);
+
             std::vector<ProtocolHint *> *hints;
+
+        private:
+            /* Reads one complete message (header and extended payload) */
+            OBPMessage *receiveMessage(TransferHelper *helper);
         };
     }
 }
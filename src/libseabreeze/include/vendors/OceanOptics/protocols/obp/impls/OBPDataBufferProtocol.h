@@ -61,6 +61,11 @@ namespace seabreeze {
                     unsigned char bufferIndex,
                     const unsigned long capacity);
 
+            virtual unsigned int readBufferedSpectra(const Bus &bus,
+                    unsigned char bufferIndex, unsigned int numberOfSpectra,
+                    unsigned int numberOfPixels, unsigned int *pixels,
+                    unsigned int stride, FastBufferSpectrumMetadata *metadata);
+
         };
     } /* end namespace oceanBinaryProtocol */
 } /* end namespace seabreeze */
@@ -32,6 +32,7 @@
 
 #include "common/Data.h"
 #include "vendors/OceanOptics/protocols/ooi/exchanges/ReadSpectrumExchange.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 #include "vendors/OceanOptics/features/spectrometer/GainAdjustedSpectrometerFeature.h"
 
 namespace seabreeze {
@@ -42,7 +43,8 @@ namespace seabreeze {
      * This class was needed because unlike other FX2-era spectrometers,
      * the Flame-NIR does not return a "sync byte" at the end of a spectrum.
      */
-    class FlameNIRSpectrumExchange : public ReadSpectrumExchange {
+    class FlameNIRSpectrumExchange : public ReadSpectrumExchange,
+            public FormattedSpectrumTransferInterface {
     public:
         FlameNIRSpectrumExchange(unsigned int readoutLength,
                 unsigned int numberOfPixels, GainAdjustedSpectrometerFeature *feature);
@@ -50,6 +52,15 @@ namespace seabreeze {
 
         virtual Data *transfer(TransferHelper *helper);
 
+        /* Inherited from FormattedSpectrumTransferInterface */
+        virtual void receiveFormatted(TransferHelper *helper);
+        virtual unsigned int decodeFormatted(double *buffer, unsigned int bufferLength);
+        virtual bool canDecodeFormattedRange() const;
+        virtual unsigned int decodeFormattedRange(unsigned int firstPixel,
+                double *buffer, unsigned int bufferLength);
+        virtual SampleType getNativeSampleType() const;
+        virtual unsigned int decodeFormatted(float *buffer, unsigned int bufferLength);
+
     protected:
         GainAdjustedSpectrometerFeature *spectrometerFeature;
     };
@@ -31,11 +31,13 @@
 #define SEABREEZE_HRFPGASPECTRUMEXCHANGE_H
 
 #include "vendors/OceanOptics/protocols/ooi/exchanges/ReadSpectrumExchange.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 #include "common/Data.h"
 
 namespace seabreeze {
   namespace ooiProtocol {
-    class HRFPGASpectrumExchange : public ReadSpectrumExchange {
+    class HRFPGASpectrumExchange : public ReadSpectrumExchange,
+            public FormattedSpectrumTransferInterface {
     public:
         HRFPGASpectrumExchange(unsigned int readoutLength,
                 unsigned int numberOfPixels);
@@ -43,6 +45,16 @@ namespace seabreeze {
 
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper);
+
+        /* Inherited from FormattedSpectrumTransferInterface */
+        virtual void receiveFormatted(TransferHelper *helper);
+        virtual unsigned int decodeFormatted(double *buffer, unsigned int bufferLength);
+        virtual bool canDecodeFormattedRange() const;
+        virtual unsigned int decodeFormattedRange(unsigned int firstPixel,
+                double *buffer, unsigned int bufferLength);
+        virtual SampleType getNativeSampleType() const;
+        virtual unsigned int decodeFormatted(unsigned short *buffer, unsigned int bufferLength);
+        virtual unsigned int decodeFormatted(float *buffer, unsigned int bufferLength);
     };
   }
 }
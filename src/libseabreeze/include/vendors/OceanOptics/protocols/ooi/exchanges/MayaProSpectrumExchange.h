@@ -31,12 +31,14 @@
 #define SEABREEZE_MAYAPROSPECTRUMEXCHANGE_H
 
 #include "vendors/OceanOptics/protocols/ooi/exchanges/ReadSpectrumExchange.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 #include "vendors/OceanOptics/features/spectrometer/GainAdjustedSpectrometerFeature.h"
 #include "common/Data.h"
 
 namespace seabreeze {
   namespace ooiProtocol {
-    class MayaProSpectrumExchange : public ReadSpectrumExchange {
+    class MayaProSpectrumExchange : public ReadSpectrumExchange,
+            public FormattedSpectrumTransferInterface {
     public:
         MayaProSpectrumExchange(unsigned int readoutLength,
                 unsigned int numberOfPixels,
@@ -46,6 +48,15 @@ namespace seabreeze {
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper);
 
+        /* Inherited from FormattedSpectrumTransferInterface */
+        virtual void receiveFormatted(TransferHelper *helper);
+        virtual unsigned int decodeFormatted(double *buffer, unsigned int bufferLength);
+        virtual bool canDecodeFormattedRange() const;
+        virtual unsigned int decodeFormattedRange(unsigned int firstPixel,
+                double *buffer, unsigned int bufferLength);
+        virtual SampleType getNativeSampleType() const;
+        virtual unsigned int decodeFormatted(float *buffer, unsigned int bufferLength);
+
     private:
         /* This is necessary so that the saturation level which is determined
          * at initialization is available to certain protocol messages.
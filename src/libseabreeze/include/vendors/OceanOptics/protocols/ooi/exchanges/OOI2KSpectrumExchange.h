@@ -34,17 +34,25 @@
 #define SEABREEZE_OOI2KSPECTRUMEXCHANGE_H
 
 #include "vendors/OceanOptics/protocols/ooi/exchanges/ReadSpectrumExchange.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 #include "common/Data.h"
 
 namespace seabreeze {
   namespace ooiProtocol {
-    class OOI2KSpectrumExchange : public ReadSpectrumExchange {
+    class OOI2KSpectrumExchange : public ReadSpectrumExchange,
+            public FormattedSpectrumTransferInterface {
     public:
         OOI2KSpectrumExchange(unsigned int readoutLength, unsigned int numberOfPixels);
         virtual ~OOI2KSpectrumExchange();
 
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper);
+
+        /* Inherited from FormattedSpectrumTransferInterface */
+        virtual void receiveFormatted(TransferHelper *helper);
+        virtual unsigned int decodeFormatted(double *buffer, unsigned int bufferLength);
+        virtual SampleType getNativeSampleType() const;
+        virtual unsigned int decodeFormatted(unsigned short *buffer, unsigned int bufferLength);
     };
   }
 }
@@ -31,15 +31,25 @@
 #define SEABREEZE_READSPECTRUMEXCHANGE_H
 
 #include "common/protocols/Transfer.h"
+#include "common/protocols/UnformattedSpectrumTransferInterface.h"
 
 namespace seabreeze {
   namespace ooiProtocol {
-    class ReadSpectrumExchange : public Transfer {
+    class ReadSpectrumExchange : public Transfer,
+            public UnformattedSpectrumTransferInterface {
     public:
         ReadSpectrumExchange(unsigned int readoutLength, unsigned int numberOfPixels);
         virtual ~ReadSpectrumExchange();
 
+        /* Inherited from UnformattedSpectrumTransferInterface */
+        virtual unsigned int getUnformattedSpectrumLength() const;
+
     protected:
+        /* Receive the readout into this->buffer without copying it out and
+         * verify the trailing synch byte (0x69) that ends the spectrum.
+         */
+        void receiveSynchronizedSpectrum(TransferHelper *helper);
+
         unsigned int numberOfPixels;
     };
   }
@@ -45,6 +45,8 @@ namespace seabreeze {
         virtual std::vector<unsigned char> *readEEPROMSlot(const Bus &bus, int slot);
         virtual int writeEEPROMSlot(const Bus &bus, int slot,
                 const std::vector<unsigned char> &data);
+        virtual std::vector<std::vector<unsigned char> *> *readEEPROMSlots(
+                const Bus &bus, const std::vector<int> &slots);
     };
   }
 }
@@ -36,6 +36,7 @@
 #include "vendors/OceanOptics/protocols/ooi/exchanges/IntegrationTimeExchange.h"
 #include "vendors/OceanOptics/protocols/ooi/exchanges/TriggerModeExchange.h"
 #include "vendors/OceanOptics/protocols/interfaces/SpectrometerProtocolInterface.h"
+#include "common/protocols/FormattedSpectrumTransferInterface.h"
 
 #include <vector>
 
@@ -59,12 +60,29 @@ namespace seabreeze {
          */
 		virtual void requestFormattedSpectrum(const Bus &bus);
         virtual std::vector<double> *readFormattedSpectrum(const Bus &bus);
+        virtual unsigned int readFormattedSpectrum(const Bus &bus, double *buffer,
+                unsigned int bufferLength);
+        virtual void receiveFormattedSpectrum(const Bus &bus);
+        virtual unsigned int decodeFormattedSpectrum(double *buffer,
+                unsigned int bufferLength);
+        virtual bool canDecodeFormattedSpectrumRange();
+        virtual unsigned int decodeFormattedSpectrumRange(unsigned int firstPixel,
+                double *buffer, unsigned int bufferLength);
+        virtual FormattedSpectrumTransferInterface::SampleType getFormattedSampleType();
+        virtual unsigned int decodeFormattedSpectrum(unsigned short *buffer,
+                unsigned int bufferLength);
+        virtual unsigned int decodeFormattedSpectrum(unsigned int *buffer,
+                unsigned int bufferLength);
+        virtual unsigned int decodeFormattedSpectrum(float *buffer,
+                unsigned int bufferLength);
 		virtual void requestUnformattedSpectrum(const Bus &bus);
 		virtual std::vector<unsigned char> *readUnformattedSpectrum(const Bus &bus);
+        virtual unsigned int getUnformattedSpectrumLength();
 		virtual void requestFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve);
 		virtual std::vector<unsigned char> *readFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve);
         virtual void setIntegrationTimeMicros(const Bus &bus, unsigned long time_usec);
         virtual void setTriggerMode(const Bus &bus,  SpectrometerTriggerMode &mode);
+        virtual bool setSpectrumTimeout(const Bus &bus, unsigned int timeoutMillis);
 
     private:
         IntegrationTimeExchange *integrationTimeExchange;
@@ -80,6 +98,19 @@ namespace seabreeze {
 		Transfer *readFastBufferSpectrumExchange;
         TriggerModeExchange *triggerModeExchange;
 
+        /* Non-NULL if readFormattedSpectrumExchange can decode in place */
+        FormattedSpectrumTransferInterface *formattedSpectrumTransfer;
+
+        /* Spectrum received but not yet decoded when formattedSpectrumTransfer
+         * is NULL and the vector version of readFormattedSpectrum() is used.
+         */
+        std::vector<double> *pendingSpectrum;
+
+        /* Throws ProtocolException unless the exchange decodes natively
+         * to the given type.
+         */
+        void checkFormattedSampleType(FormattedSpectrumTransferInterface::SampleType type);
+
     };
   }
 }
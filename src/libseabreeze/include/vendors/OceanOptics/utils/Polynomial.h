@@ -48,6 +48,13 @@ namespace seabreeze {
         Polynomial(T *coefficients, unsigned int length);
         ~Polynomial();
         T evaluate(T x);
+
+        /* Evaluates the polynomial at x = first, first + 1, ...,
+         * first + count - 1 (e.g. at every pixel index) into out.  This uses
+         * Horner's rule with the points in the inner loop, so the compiler
+         * can vectorize it across pixels.
+         */
+        void evaluateRange(T first, T *out, unsigned int count);
     private:
         std::vector<T> *coefficients;
     };
@@ -106,6 +113,32 @@ namespace seabreeze {
         return retval;
     }
 
+    template <class T>
+    void Polynomial<T>::evaluateRange(T first, T *out, unsigned int count) {
+        const T *coeffs;
+        unsigned int order;
+        unsigned int i;
+
+        if(NULL == this->coefficients || 0 == this->coefficients->size()) {
+            for(i = 0; i < count; i++) {
+                out[i] = 0;
+            }
+            return;
+        }
+
+        coeffs = &(*(this->coefficients))[0];
+        order = (unsigned int)this->coefficients->size() - 1;
+        for(i = 0; i < count; i++) {
+            out[i] = coeffs[order];
+        }
+        while(order-- > 0) {
+            const T c = coeffs[order];
+            for(i = 0; i < count; i++) {
+                out[i] = out[i] * (first + (T)i) + c;
+            }
+        }
+    }
+
 }
 
 #endif /* POLYNOMIAL_H */
@@ -58,6 +58,10 @@
 #include "vendors/OceanOptics/devices/USB2000Plus.h"
 #include "vendors/OceanOptics/devices/USB4000.h"
 #include "vendors/OceanOptics/devices/Ventana.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBInterface.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBProductID.h"
+#include "common/buses/usb/USBDeviceLocator.h"
+#include "native/usb/USBDiscovery.h"
 
 using namespace seabreeze;
 using namespace std;
@@ -90,6 +94,8 @@ void DeviceFactory::shutdown() {
 
 DeviceFactory::DeviceFactory()
 {
+    hotplugListener = NULL;
+
     nameToCreator.insert(make_pair("Apex",        (creatorFunction) &deviceFactory<Apex       >));
     nameToCreator.insert(make_pair("FlameX",      (creatorFunction) &deviceFactory<FlameX     >));
     nameToCreator.insert(make_pair("FlameNIR",    (creatorFunction) &deviceFactory<FlameNIR   >));
@@ -111,6 +117,37 @@ DeviceFactory::DeviceFactory()
     nameToCreator.insert(make_pair("USB2000Plus", (creatorFunction) &deviceFactory<USB2000Plus>));
     nameToCreator.insert(make_pair("USB4000",     (creatorFunction) &deviceFactory<USB4000    >));
     nameToCreator.insert(make_pair("Ventana",     (creatorFunction) &deviceFactory<Ventana    >));
+
+    /* The same USB IDs that each device's OOIUSBInterface probes for.  These
+     * let probeUSBDevices() match every type in a single pass over the bus.
+     */
+    addUSBDeviceType("Apex",        OCEAN_OPTICS_USB_VID, APEX_USB_PID);
+    addUSBDeviceType("FlameX",      OCEAN_OPTICS_USB_VID, FLAMEX_USB_PID);
+    addUSBDeviceType("FlameNIR",    OCEAN_OPTICS_USB_VID, FLAMENIR_USB_PID);
+    addUSBDeviceType("HR2000",      OCEAN_OPTICS_USB_VID, HR2000_USB_PID);
+    addUSBDeviceType("HR2000Plus",  OCEAN_OPTICS_USB_VID, HR2000PLUS_USB_PID);
+    addUSBDeviceType("HR4000",      OCEAN_OPTICS_USB_VID, HR4000_USB_PID);
+    addUSBDeviceType("Jaz",         OCEAN_OPTICS_USB_VID, JAZ_USB_PID);
+    addUSBDeviceType("Maya2000",    OCEAN_OPTICS_USB_VID, MAYA2000_USB_PID);
+    addUSBDeviceType("Maya2000Pro", OCEAN_OPTICS_USB_VID, MAYA2000PRO_USB_PID);
+    addUSBDeviceType("MayaLSL",     OCEAN_OPTICS_USB_VID, MAYALSL_USB_PID);
+    addUSBDeviceType("NIRQuest256", OCEAN_OPTICS_USB_VID, NIRQUEST256_USB_PID);
+    addUSBDeviceType("NIRQuest512", OCEAN_OPTICS_USB_VID, NIRQUEST512_USB_PID);
+    addUSBDeviceType("QE65000",     OCEAN_OPTICS_USB_VID, QE65000_USB_PID);
+    addUSBDeviceType("QE-PRO",      OCEAN_OPTICS_USB_VID, QEPRO_USB_PID);
+    addUSBDeviceType("Spark",       OCEAN_OPTICS_USB_VID, SPARK_USB_PID);
+    addUSBDeviceType("STS",         OCEAN_OPTICS_USB_VID, STS_USB_PID);
+    addUSBDeviceType("Torus",       OCEAN_OPTICS_USB_VID, TORUS_USB_PID);
+    addUSBDeviceType("USB2000",     OCEAN_OPTICS_USB_VID, USB2000_USB_PID);
+    addUSBDeviceType("USB2000Plus", OCEAN_OPTICS_USB_VID, USB2000PLUS_USB_PID);
+    addUSBDeviceType("USB4000",     OCEAN_OPTICS_USB_VID, USB4000_USB_PID);
+    addUSBDeviceType("Ventana",     OCEAN_OPTICS_USB_VID, VENTANA_USB_PID);
+}
+
+void DeviceFactory::addUSBDeviceType(const string &name, int vendorID, int productID) {
+    this->usbDeviceNames.push_back(name);
+    this->usbVendorIDs.push_back(vendorID);
+    this->usbProductIDs.push_back(productID);
 }
 
 Device *DeviceFactory::create(const string& className) {
@@ -151,3 +188,62 @@ std::vector<std::string> DeviceFactory::getSupportedModels() {
     }
     return supportedModels;
 }
+
+vector<DeviceLocatorInterface *> *DeviceFactory::probeUSBDevices(
+        vector<string> &deviceTypeNames) {
+    USBDiscovery discovery;
+    vector<unsigned long> *ids;
+    vector<int> matches;
+    vector<DeviceLocatorInterface *> *retval = new vector<DeviceLocatorInterface *>;
+
+    deviceTypeNames.clear();
+
+    ids = discovery.probeDevices(this->usbVendorIDs, this->usbProductIDs, matches);
+    for(unsigned int i = 0; i < ids->size() && i < matches.size(); i++) {
+        retval->push_back(new USBDeviceLocator((*ids)[i]));
+        deviceTypeNames.push_back(this->usbDeviceNames[matches[i]]);
+    }
+    delete ids;
+
+    return retval;
+}
+
+bool DeviceFactory::startUSBHotplug(DeviceHotplugListenerInterface *listener) {
+    USBDiscovery discovery;
+
+    if(NULL != this->hotplugListener || NULL == listener) {
+        return false;
+    }
+
+    this->hotplugListener = listener;
+    if(false == discovery.startHotplug(this->usbVendorIDs, this->usbProductIDs,
+            &DeviceFactory::usbHotplugCallback, this)) {
+        this->hotplugListener = NULL;
+        return false;
+    }
+    return true;
+}
+
+void DeviceFactory::stopUSBHotplug() {
+    USBDiscovery discovery;
+
+    if(NULL == this->hotplugListener) {
+        return;
+    }
+
+    discovery.stopHotplug();
+    this->hotplugListener = NULL;
+}
+
+void DeviceFactory::usbHotplugCallback(int event, unsigned long deviceID,
+        int match, void *context) {
+    DeviceFactory *factory = (DeviceFactory *)context;
+    USBDeviceLocator location(deviceID);
+
+    if(USB_HOTPLUG_ARRIVED == event) {
+        factory->hotplugListener->deviceArrived(location,
+            factory->usbDeviceNames[match]);
+    } else {
+        factory->hotplugListener->deviceLeft(location);
+    }
+}
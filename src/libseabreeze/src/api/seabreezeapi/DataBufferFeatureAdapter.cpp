@@ -152,3 +152,47 @@ void DataBufferFeatureAdapter::setBufferCapacity(int *errorCode, unsigned long c
         SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
     }
 }
+
+int DataBufferFeatureAdapter::getBufferedSpectrumLength(int *errorCode)
+{
+    unsigned int length = this->feature->getBufferedSpectrumLength();
+
+    if(0 == length)
+    {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return 0;
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) length;
+}
+
+int DataBufferFeatureAdapter::readBufferedSpectra(int *errorCode,
+        unsigned int numberOfSpectra, unsigned int *pixels, int stride,
+        FastBufferSpectrumMetadata *metadata)
+{
+    unsigned int retval;
+
+    if(NULL == pixels || NULL == metadata || stride <= 0)
+    {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    if(0 == this->feature->getBufferedSpectrumLength())
+    {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return 0;
+    }
+
+    try
+    {
+        retval = this->feature->readBufferedSpectra(*this->protocol, *this->bus, 0,
+                numberOfSpectra, pixels, (unsigned int) stride, metadata);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return (int) retval;
+    } catch (const FeatureException &fe)
+    {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+}
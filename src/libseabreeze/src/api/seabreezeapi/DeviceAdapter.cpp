@@ -41,6 +41,10 @@ using namespace seabreeze;
 using namespace seabreeze::api;
 using namespace std;
 
+/* Devices store at most an 8th order nonlinearity polynomial */
+#define MAX_NONLINEARITY_COEFFICIENTS   16
+#define MAX_STRAY_LIGHT_COEFFICIENTS    16
+
 template <class T>
 vector<T *> *__sbapi_getFeatures(Device *dev) {
     /* This is a templated function to get all of the features of a particular
@@ -275,6 +279,16 @@ int DeviceAdapter::open(int *errorCode) {
                     SpectrumProcessingFeatureAdapter>(this->device,
             spectrumProcessingFeatures, bus, featureFamilies.SPECTRUM_PROCESSING);
 
+    /* Without on-board processing, average and smooth on the host instead */
+    if(true == spectrumProcessingFeatures.empty()) {
+        for(unsigned short i = 0; i < spectrometerFeatures.size(); i++) {
+            spectrumProcessingFeatures.push_back(new SpectrumProcessingFeatureAdapter(
+                    spectrometerFeatures[i]->getHostSpectrumProcessingFeature(),
+                    featureFamilies.SPECTRUM_PROCESSING,
+                    spectrometerFeatures[i]->getProtocol(), bus, i));
+        }
+    }
+
     /* Create stray light coefficients feature list */
     __create_feature_adapters<StrayLightCoeffsFeatureInterface,
                     StrayLightCoeffsFeatureAdapter>(this->device,
@@ -295,6 +309,15 @@ int DeviceAdapter::open(int *errorCode) {
 		FastBufferFeatureAdapter>(this->device,
 			fastBufferFeatures, bus, featureFamilies.FAST_BUFFER);
 
+    /* The fast buffer drain polls the occupancy of the first data buffer */
+    if(false == dataBufferFeatures.empty()) {
+        vector<SpectrometerFeatureAdapter *>::iterator specIter;
+        for(specIter = spectrometerFeatures.begin();
+                specIter != spectrometerFeatures.end(); specIter++) {
+            (*specIter)->setDataBufferFeature(dataBufferFeatures[0]->getFeature());
+        }
+    }
+
 	/* Create acquisition feature list */
     __create_feature_adapters<AcquisitionDelayFeatureInterface,
                     AcquisitionDelayFeatureAdapter>(this->device,
@@ -316,9 +339,31 @@ int DeviceAdapter::open(int *errorCode) {
 }
 
 void DeviceAdapter::close() {
+    int errorCode;
+    vector<SpectrometerFeatureAdapter *>::iterator iter;
+
+    /* Acquisition threads must not outlive the bus they are reading from */
+    for(iter = spectrometerFeatures.begin(); iter != spectrometerFeatures.end(); iter++) {
+        (*iter)->stopFastBufferDrain(&errorCode);
+        (*iter)->stopContinuousAcquisition(&errorCode);
+    }
     this->device->close();
 }
 
+void DeviceAdapter::cancelTransfers(int *errorCode) {
+    Bus *bus = this->device->getOpenedBus();
+    if(NULL == bus) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    if(false == bus->cancelTransfers()) {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return;
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
 DeviceLocatorInterface *DeviceAdapter::getLocation() {
     return this->device->getLocation();
 }
@@ -532,6 +577,246 @@ double DeviceAdapter::spectrometerGetMaximumIntensity(
     return feature->getMaximumIntensity(errorCode);
 }
 
+void DeviceAdapter::spectrometerSetTransferTimeouts(long featureID, int *errorCode, long spectrumTimeoutMillis, long controlTimeoutMillis) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->setTransferTimeouts(errorCode, spectrumTimeoutMillis, controlTimeoutMillis);
+}
+
+long DeviceAdapter::spectrometerGetSpectrumTimeoutMillis(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getSpectrumTimeoutMillis(errorCode);
+}
+
+long DeviceAdapter::spectrometerGetControlTimeoutMillis(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getControlTimeoutMillis(errorCode);
+}
+
+void DeviceAdapter::spectrometerSetSpectrumCorrection(long featureID, int *errorCode, int correctDarkCounts, int correctNonlinearity, int correctStrayLight) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    if(0 != correctNonlinearity && 0 == feature->hasNonlinearityCoefficients(NULL)) {
+        double coefficients[MAX_NONLINEARITY_COEFFICIENTS];
+        int count;
+        int error = ERROR_SUCCESS;
+
+        /* Read the coefficients from the device once, on first use */
+        if(true == nonlinearityFeatures.empty()) {
+            SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+            return;
+        }
+        count = nonlinearityFeatures[0]->readNonlinearityCoeffs(&error,
+                coefficients, MAX_NONLINEARITY_COEFFICIENTS);
+        if(ERROR_SUCCESS != error) {
+            SET_ERROR_CODE(error);
+            return;
+        }
+        feature->setNonlinearityCoefficients(errorCode, coefficients, count);
+    }
+
+    if(0 != correctStrayLight && 0 == feature->hasStrayLightCoefficients(NULL)) {
+        double coefficients[MAX_STRAY_LIGHT_COEFFICIENTS];
+        int count;
+        int error = ERROR_SUCCESS;
+
+        if(true == strayLightFeatures.empty()) {
+            SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+            return;
+        }
+        count = strayLightFeatures[0]->readStrayLightCoeffs(&error,
+                coefficients, MAX_STRAY_LIGHT_COEFFICIENTS);
+        if(ERROR_SUCCESS != error) {
+            SET_ERROR_CODE(error);
+            return;
+        }
+        feature->setStrayLightCoefficients(errorCode, coefficients, count);
+    }
+
+    feature->setSpectrumCorrection(errorCode, correctDarkCounts, correctNonlinearity,
+            correctStrayLight);
+}
+
+void DeviceAdapter::spectrometerSetCorrectionCoefficients(long featureID, int *errorCode, const double *nonlinearity, int nonlinearityCount, const double *strayLight, int strayLightCount) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    if(nonlinearityCount > 0) {
+        feature->setNonlinearityCoefficients(errorCode, nonlinearity, nonlinearityCount);
+        if(NULL != errorCode && ERROR_SUCCESS != *errorCode) {
+            return;
+        }
+    }
+    if(strayLightCount > 0) {
+        feature->setStrayLightCoefficients(errorCode, strayLight, strayLightCount);
+    }
+}
+
+void DeviceAdapter::spectrometerSetIrradianceOutput(long featureID, int *errorCode, int enable, float collectionArea) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    if(0 != enable) {
+        int error = ERROR_SUCCESS;
+
+        if(true == irradCalFeatures.empty()) {
+            SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+            return;
+        }
+
+        /* Read the calibration from the device once, on first use */
+        if(0 == feature->hasIrradianceCalibration(NULL)) {
+            int pixels = feature->getFormattedSpectrumLength(&error);
+            if(ERROR_SUCCESS != error || pixels <= 0) {
+                SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+                return;
+            }
+            vector<float> calibration(pixels);
+            int count = irradCalFeatures[0]->readIrradCalibration(&error,
+                    &calibration[0], pixels);
+            if(ERROR_SUCCESS != error) {
+                SET_ERROR_CODE(error);
+                return;
+            }
+            feature->setIrradianceCalibration(&error, &calibration[0], count);
+            if(ERROR_SUCCESS != error) {
+                SET_ERROR_CODE(error);
+                return;
+            }
+        }
+
+        /* Without an explicit area, use the one stored with the calibration */
+        if(collectionArea <= 0.0f) {
+            if(0 == irradCalFeatures[0]->hasIrradCollectionArea(&error)) {
+                SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+                return;
+            }
+            collectionArea = irradCalFeatures[0]->readIrradCollectionArea(&error);
+            if(ERROR_SUCCESS != error) {
+                SET_ERROR_CODE(error);
+                return;
+            }
+        }
+    }
+
+    feature->setIrradianceOutput(errorCode, enable, collectionArea);
+}
+
+void DeviceAdapter::spectrometerSetResampleGrid(long featureID, int *errorCode, const double *grid, int gridLength, int method) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->setResampleGrid(errorCode, grid, gridLength, method);
+}
+
+int DeviceAdapter::spectrometerGetResampleGridLength(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getResampleGridLength(errorCode);
+}
+
+int DeviceAdapter::spectrometerGetResampledSpectrum(long featureID, int *errorCode, double *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getResampledSpectrum(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerResampleSpectra(long featureID, int *errorCode, const double *spectra, int count, int stride, double *buffer, int bufferStride) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->resampleSpectra(errorCode, spectra, count, stride, buffer, bufferStride);
+}
+
+void DeviceAdapter::spectrometerSetPixelRanges(long featureID, int *errorCode, const unsigned int *pixelIndexPairs, int length) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->setPixelRanges(errorCode, pixelIndexPairs, length);
+}
+
+int DeviceAdapter::spectrometerGetPixelRanges(long featureID, int *errorCode, unsigned int *pixelIndexPairs, int length) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getPixelRanges(errorCode, pixelIndexPairs, length);
+}
+
+int DeviceAdapter::spectrometerGetPixelRangeLength(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getPixelRangeLength(errorCode);
+}
+
+int DeviceAdapter::spectrometerGetPixelRangeSpectrum(long featureID, int *errorCode, double *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getPixelRangeSpectrum(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetPixelRangeWavelengths(long featureID, int *errorCode, double *wavelengths, int length) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getPixelRangeWavelengths(errorCode, wavelengths, length);
+}
+
 int DeviceAdapter::spectrometerGetUnformattedSpectrumLength(
         long featureID, int *errorCode) {
     SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
@@ -565,6 +850,16 @@ int DeviceAdapter::spectrometerGetFastBufferSpectrum(long featureID,
 	return feature->getFastBufferSpectrum(errorCode, buffer, bufferLength, numberOfSamplesToRetrieve);
 }
 
+int DeviceAdapter::spectrometerGetFastBufferSpectra(long featureID, int *errorCode, unsigned int numberOfSamplesToRetrieve, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFastBufferSpectra(errorCode, numberOfSamplesToRetrieve, pixels, stride, metadata);
+}
+
 int DeviceAdapter::spectrometerGetFormattedSpectrumLength(
         long featureID, int *errorCode) {
     SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
@@ -587,6 +882,66 @@ int DeviceAdapter::spectrometerGetFormattedSpectrum(long featureID, int *errorCo
     return feature->getFormattedSpectrum(errorCode, buffer, bufferLength);
 }
 
+int DeviceAdapter::spectrometerGetFormattedSampleType(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSampleType(errorCode);
+}
+
+int DeviceAdapter::spectrometerGetFormattedSpectrumUInt16(long featureID, int *errorCode, unsigned short *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectrumUInt16(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetFormattedSpectrumUInt32(long featureID, int *errorCode, unsigned int *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectrumUInt32(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetFormattedSpectrumFloat(long featureID, int *errorCode, float *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectrumFloat(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetProcessedSpectrumFloat(long featureID, int *errorCode, float *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getProcessedSpectrumFloat(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetFormattedSpectra(long featureID, int *errorCode, int count, double *buffer, int stride, unsigned long long *timestampsMicros) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectra(errorCode, count, buffer, stride, timestampsMicros);
+}
+
 int DeviceAdapter::spectrometerGetWavelengths(long featureID, int *errorCode,
         double *wavelengths, int length) {
     SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
@@ -620,6 +975,116 @@ int DeviceAdapter::spectrometerGetElectricDarkPixelIndices(
     return feature->getElectricDarkPixelIndices(errorCode, indices, length);
 }
 
+void DeviceAdapter::spectrometerStartContinuousAcquisition(long featureID, int *errorCode, int ringDepth, int pipelined) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->startContinuousAcquisition(errorCode, ringDepth, pipelined);
+}
+
+void DeviceAdapter::spectrometerStopContinuousAcquisition(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->stopContinuousAcquisition(errorCode);
+}
+
+int DeviceAdapter::spectrometerIsContinuousAcquisitionRunning(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->isContinuousAcquisitionRunning(errorCode);
+}
+
+int DeviceAdapter::spectrometerGetContinuousAcquisitionDepth(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getContinuousAcquisitionDepth(errorCode);
+}
+
+int DeviceAdapter::spectrometerReadContinuousSpectrum(long featureID, int *errorCode, double *buffer, int bufferLength, unsigned long long *timestampMicros) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->readContinuousSpectrum(errorCode, buffer, bufferLength, timestampMicros);
+}
+
+void DeviceAdapter::spectrometerGetContinuousAcquisitionStatistics(long featureID, int *errorCode, unsigned long long *framesAcquired, unsigned long long *framesDropped, unsigned long long *overruns, unsigned long long *transferErrors) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->getContinuousAcquisitionStatistics(errorCode, framesAcquired, framesDropped, overruns, transferErrors);
+}
+
+void DeviceAdapter::spectrometerStartFastBufferDrain(long featureID, int *errorCode, int queueDepth, int maxBatch, int pollIntervalMicros) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->startFastBufferDrain(errorCode, queueDepth, maxBatch, pollIntervalMicros);
+}
+
+void DeviceAdapter::spectrometerStopFastBufferDrain(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->stopFastBufferDrain(errorCode);
+}
+
+int DeviceAdapter::spectrometerIsFastBufferDrainRunning(long featureID, int *errorCode) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->isFastBufferDrainRunning(errorCode);
+}
+
+int DeviceAdapter::spectrometerReadFastBufferDrain(long featureID, int *errorCode, int maxSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->readFastBufferDrain(errorCode, maxSpectra, pixels, stride, metadata);
+}
+
+void DeviceAdapter::spectrometerGetFastBufferDrainStatistics(long featureID, int *errorCode, unsigned long long *spectraReceived, unsigned long long *spectraMissed, unsigned long long *sequenceGaps, unsigned long long *spectraDropped, unsigned long long *transferErrors) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->getFastBufferDrainStatistics(errorCode, spectraReceived, spectraMissed, sequenceGaps, spectraDropped, transferErrors);
+}
+
 
 
 /* Pixel binning feature wrappers */
@@ -2113,6 +2578,26 @@ void DeviceAdapter::dataBufferSetBufferCapacity(long featureID, int *errorCode,
     feature->setBufferCapacity(errorCode, capacity);
 }
 
+int DeviceAdapter::dataBufferGetBufferedSpectrumLength(long featureID, int *errorCode) {
+    DataBufferFeatureAdapter *feature = getDataBufferFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getBufferedSpectrumLength(errorCode);
+}
+
+int DeviceAdapter::dataBufferReadBufferedSpectra(long featureID, int *errorCode, unsigned int numberOfSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) {
+    DataBufferFeatureAdapter *feature = getDataBufferFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->readBufferedSpectra(errorCode, numberOfSpectra, pixels, stride, metadata);
+}
+
 /* Fast buffer feature wrappers*/
 
 int DeviceAdapter::getNumberOfFastBufferFeatures() {
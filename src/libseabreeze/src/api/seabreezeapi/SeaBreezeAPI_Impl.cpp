@@ -44,7 +44,6 @@
 #include "common/buses/network/IPv4SocketDeviceLocator.h"
 #include "common/buses/network/IPv4NetworkProtocol.h"
 #include "common/buses/rs232/RS232DeviceLocator.h"
-#include "common/buses/DeviceLocationProberInterface.h"
 #include "native/system/System.h"
 
 #include <ctype.h>
@@ -59,11 +58,32 @@ using namespace std;
 static int __deviceID = 1;
 
 SeaBreezeAPI_Impl::SeaBreezeAPI_Impl() {
+    this->hotplugActive = false;
+    this->hotplugStopRequested = false;
     System::initialize();
 }
 
 SeaBreezeAPI_Impl::~SeaBreezeAPI_Impl() {
     vector<DeviceAdapter *>::iterator dIter;
+    deque<HotplugEvent>::iterator eIter;
+
+    /* Stop the hotplug thread before the bus stops delivering events so
+     * that nothing touches the device list once it is being torn down.
+     */
+    {
+        lock_guard<mutex> lock(this->hotplugQueueMutex);
+        this->hotplugStopRequested = true;
+    }
+    this->hotplugQueueCondition.notify_all();
+    if(this->hotplugThread.joinable()) {
+        this->hotplugThread.join();
+    }
+    if(true == this->hotplugActive) {
+        DeviceFactory::getInstance()->stopUSBHotplug();
+    }
+    for(eIter = this->hotplugQueue.begin(); eIter != this->hotplugQueue.end(); eIter++) {
+        delete eIter->location;
+    }
 
     for(dIter = this->specifiedDevices.begin(); dIter != this->specifiedDevices.end(); dIter++) {
         delete *dIter;
@@ -73,6 +93,10 @@ SeaBreezeAPI_Impl::~SeaBreezeAPI_Impl() {
         delete *dIter;
     }
 
+    for(dIter = this->departedDevices.begin(); dIter != this->departedDevices.end(); dIter++) {
+        delete *dIter;
+    }
+
     System::shutdown();
 }
 
@@ -86,86 +110,84 @@ int SeaBreezeAPI_Impl::probeDevices() {
      * This requires a bit of searching which translates to nested loops.
      * Fortunately, none of these loops has to iterate very long.
      */
-    Device *dev;
     vector<DeviceAdapter *>::iterator devIter;
     vector<DeviceAdapter *>::iterator validIter;
-    int i;
     vector<DeviceAdapter *> validDevices;
+    vector<DeviceLocatorInterface *> *locations;
+    vector<DeviceLocatorInterface *>::iterator locIter;
+    vector<string> deviceTypeNames;
+    unsigned int i;
 
     DeviceFactory* deviceFactory = DeviceFactory::getInstance();
 
-    for(i = 0; i < deviceFactory->getNumberOfDeviceTypes(); i++) {
-        /* Try to create a device by its type index.  This does not require
-         * knowing what type of device is actually being created.  This instance
-         * will be an exemplar and will not actually be tied to real hardware.
+    lock_guard<mutex> lock(this->deviceListMutex);
+
+    for(devIter = this->departedDevices.begin(); devIter != this->departedDevices.end(); devIter++) {
+        delete *devIter;
+    }
+    this->departedDevices.clear();
+
+    if(true == this->hotplugActive) {
+        /* The list is already kept up to date by hotplug events */
+        return (int) this->probedDevices.size();
+    }
+
+    /* Enumerate the bus once for all known device types.  Only the devices
+     * that are actually present get a Device instance, and only if their
+     * location is not already known.
+     */
+    locations = deviceFactory->probeUSBDevices(deviceTypeNames);
+
+    for(    i = 0, locIter = locations->begin();
+            locIter != locations->end();
+            i++, locIter++) {
+        /* For each device location, check whether it is already
+         * known.  If not, add it.  If so, skip over it.
          */
-        dev = deviceFactory->create(i);
-
-        vector<Bus *>::iterator iter;
-        vector<Bus *> buses = dev->getBuses();
-
-        for(iter = buses.begin(); iter != buses.end(); iter++) {
-            DeviceLocationProberInterface *prober = dynamic_cast<DeviceLocationProberInterface *>(*iter);
-            if(NULL != prober) {
-                /* Found a type of Bus that can probe for
-                 * real hardware to associate with this Device
-                 */
-                vector<DeviceLocatorInterface *> *locations;
-                locations = prober->probeDevices();
-                vector<DeviceLocatorInterface *>::iterator locIter;
-                for(    locIter = locations->begin();
-                        locIter != locations->end();
-                        locIter++) {
-                    /* For each device location, check whether it is already
-                     * known.  If not, add it.  If so, skip over it.
-                     */
-                    bool locationKnown = false;
-                    for(    devIter = this->probedDevices.begin();
-                            devIter != this->probedDevices.end();
-                            devIter++) {
-                        /* For each known device, compare to the newly probed
-                         * location and see if they match.
-                         */
-                        DeviceLocatorInterface *knownLoc = (*devIter)->getLocation();
-                        if(true == (*locIter)->equals(*knownLoc)) {
-                            /* This device location is already tracked. */
-                            locationKnown = true;
-                            /* Note that it has just been seen */
-                            validDevices.push_back(*devIter);
-                            break;
-                        }
-                    }
-                    if(false == locationKnown) {
-                        /* The location is not already known.  Create a new
-                         * instance of the type of device in question and
-                         * assign the new instance to this location.  This also
-                         * effectively marks the new instance as being valid.
-                         */
-                        Device *newdev = deviceFactory->create(i);
-                        newdev->setLocation(**locIter);
-                        /* Note that this pre-increments the device ID to
-                         * mitigate any race conditions
-                         */
-                        try {
-                            DeviceAdapter *da = new DeviceAdapter(newdev, ++__deviceID);
-                            this->probedDevices.push_back(da);
-                            validDevices.push_back(da);
-                        } catch (const IllegalArgumentException &iae) {
-                            continue;
-                        }
-                    }
-                }
-                for(vector<DeviceLocatorInterface *>::iterator iter = locations->begin();
-                        iter != locations->end(); iter++) {
-                    delete *iter;
-                }
-                locations->clear();
-                delete locations;
+        bool locationKnown = false;
+        for(    devIter = this->probedDevices.begin();
+                devIter != this->probedDevices.end();
+                devIter++) {
+            /* For each known device, compare to the newly probed
+             * location and see if they match.
+             */
+            DeviceLocatorInterface *knownLoc = (*devIter)->getLocation();
+            if(true == (*locIter)->equals(*knownLoc)) {
+                /* This device location is already tracked. */
+                locationKnown = true;
+                /* Note that it has just been seen */
+                validDevices.push_back(*devIter);
+                break;
             }
         }
-
-        delete dev;
+        if(false == locationKnown) {
+            /* The location is not already known.  Create a new
+             * instance of the type of device in question and
+             * assign the new instance to this location.  This also
+             * effectively marks the new instance as being valid.
+             */
+            Device *newdev = deviceFactory->create(deviceTypeNames[i]);
+            if(NULL == newdev) {
+                continue;
+            }
+            newdev->setLocation(**locIter);
+            /* Note that this pre-increments the device ID to
+             * mitigate any race conditions
+             */
+            try {
+                DeviceAdapter *da = new DeviceAdapter(newdev, ++__deviceID);
+                this->probedDevices.push_back(da);
+                validDevices.push_back(da);
+            } catch (const IllegalArgumentException &iae) {
+                continue;
+            }
+        }
+    }
+    for(locIter = locations->begin(); locIter != locations->end(); locIter++) {
+        delete *locIter;
     }
+    locations->clear();
+    delete locations;
 
     /* Now go through the set of all probed devices and ensure that each of
      * them is still around.
@@ -215,7 +237,9 @@ int SeaBreezeAPI_Impl::addTCPIPv4DeviceLocation(char *deviceTypeName, char *ipAd
 
     try {
         /* Note that this pre-increments the device ID to mitigate any race conditions */
-        this->specifiedDevices.push_back(new DeviceAdapter(dev, ++__deviceID));
+        DeviceAdapter *adapter = new DeviceAdapter(dev, ++__deviceID);
+        lock_guard<mutex> lock(this->deviceListMutex);
+        this->specifiedDevices.push_back(adapter);
     } catch (const IllegalArgumentException &iae) {
         /* Unable to create the adapter */
         return 2;
@@ -239,7 +263,9 @@ int SeaBreezeAPI_Impl::addRS232DeviceLocation(char *deviceTypeName,
 
     try {
         /* Note that this pre-increments the device ID to mitigate any race conditions */
-        this->specifiedDevices.push_back(new DeviceAdapter(dev, ++__deviceID));
+        DeviceAdapter *adapter = new DeviceAdapter(dev, ++__deviceID);
+        lock_guard<mutex> lock(this->deviceListMutex);
+        this->specifiedDevices.push_back(adapter);
     } catch (const IllegalArgumentException &iae) {
         /* Unable to create the adapter */
         return 2;
@@ -250,6 +276,7 @@ int SeaBreezeAPI_Impl::addRS232DeviceLocation(char *deviceTypeName,
 
 
 int SeaBreezeAPI_Impl::getNumberOfDeviceIDs() {
+    lock_guard<mutex> lock(this->deviceListMutex);
     return (int) (this->specifiedDevices.size() + this->probedDevices.size());
 }
 
@@ -259,6 +286,8 @@ int SeaBreezeAPI_Impl::getDeviceIDs(long *ids, unsigned long maxLength) {
     vector<DeviceAdapter *>::iterator iter;
     unsigned int i = 0;
 
+    lock_guard<mutex> lock(this->deviceListMutex);
+
     for(    iter = specifiedDevices.begin();
             iter != specifiedDevices.end() && i < maxLength;
             iter++, i++) {
@@ -279,6 +308,8 @@ int SeaBreezeAPI_Impl::getDeviceIDs(long *ids, unsigned long maxLength) {
 DeviceAdapter *SeaBreezeAPI_Impl::getDeviceByID(unsigned long id) {
     vector<DeviceAdapter *>::iterator iter;
 
+    lock_guard<mutex> lock(this->deviceListMutex);
+
     /* This gives priority to specified devices since they require more specific
      * information to set up.
      */
@@ -294,9 +325,209 @@ DeviceAdapter *SeaBreezeAPI_Impl::getDeviceByID(unsigned long id) {
         }
     }
 
+    for(iter = departedDevices.begin(); iter != departedDevices.end(); iter++) {
+        if((*iter)->getID() == id) {
+            return *iter;
+        }
+    }
+
     return NULL;
 }
 
+int SeaBreezeAPI_Impl::addHotplugCallback(SeaBreezeHotplugCallback callback,
+        void *context, int *errorCode) {
+    lock_guard<recursive_mutex> lock(this->hotplugCallbackMutex);
+
+    if(NULL == callback) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return -1;
+    }
+
+    if(false == this->hotplugActive) {
+        vector<DeviceLocatorInterface *> attached;
+        vector<DeviceLocatorInterface *>::iterator locIter;
+        vector<DeviceAdapter *>::iterator devIter;
+        deque<HotplugEvent> initial;
+        deque<HotplugEvent>::iterator eIter;
+
+        if(false == DeviceFactory::getInstance()->startUSBHotplug(this)) {
+            SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+            return -1;
+        }
+
+        /* The devices that were already attached have been queued by now.
+         * Apply them here so they are listed when this returns, but without
+         * telling any callbacks about them.
+         */
+        {
+            lock_guard<mutex> queueLock(this->hotplugQueueMutex);
+            initial.swap(this->hotplugQueue);
+        }
+        for(eIter = initial.begin(); eIter != initial.end(); eIter++) {
+            applyHotplugEvent(*eIter);
+            if(false == eIter->deviceTypeName.empty()) {
+                attached.push_back(eIter->location);
+            } else {
+                delete eIter->location;
+            }
+        }
+
+        /* Anything found by an earlier probeDevices() that is not attached
+         * any more has left without an event.
+         */
+        {
+            lock_guard<mutex> listLock(this->deviceListMutex);
+            for(    devIter = this->probedDevices.begin();
+                    devIter != this->probedDevices.end();
+                    ) {
+                bool present = false;
+                for(locIter = attached.begin(); locIter != attached.end(); locIter++) {
+                    if(true == (*locIter)->equals(*(*devIter)->getLocation())) {
+                        present = true;
+                        break;
+                    }
+                }
+                if(false == present) {
+                    this->departedDevices.push_back(*devIter);
+                    devIter = this->probedDevices.erase(devIter);
+                } else {
+                    devIter++;
+                }
+            }
+            this->hotplugActive = true;
+        }
+        for(locIter = attached.begin(); locIter != attached.end(); locIter++) {
+            delete *locIter;
+        }
+
+        this->hotplugStopRequested = false;
+        this->hotplugThread = thread(&SeaBreezeAPI_Impl::runHotplug, this);
+    }
+
+    this->hotplugCallbacks.push_back(make_pair(callback, context));
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return 0;
+}
+
+int SeaBreezeAPI_Impl::removeHotplugCallback(SeaBreezeHotplugCallback callback,
+        void *context, int *errorCode) {
+    vector<pair<SeaBreezeHotplugCallback, void *> >::iterator iter;
+
+    lock_guard<recursive_mutex> lock(this->hotplugCallbackMutex);
+
+    for(iter = this->hotplugCallbacks.begin(); iter != this->hotplugCallbacks.end(); iter++) {
+        if(iter->first == callback && iter->second == context) {
+            this->hotplugCallbacks.erase(iter);
+            SET_ERROR_CODE(ERROR_SUCCESS);
+            return 0;
+        }
+    }
+
+    SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+    return -1;
+}
+
+void SeaBreezeAPI_Impl::deviceArrived(const DeviceLocatorInterface &location,
+        const string &deviceTypeName) {
+    HotplugEvent event;
+
+    event.location = location.clone();
+    event.deviceTypeName = deviceTypeName;
+    {
+        lock_guard<mutex> lock(this->hotplugQueueMutex);
+        this->hotplugQueue.push_back(event);
+    }
+    this->hotplugQueueCondition.notify_one();
+}
+
+void SeaBreezeAPI_Impl::deviceLeft(const DeviceLocatorInterface &location) {
+    HotplugEvent event;
+
+    event.location = location.clone();
+    {
+        lock_guard<mutex> lock(this->hotplugQueueMutex);
+        this->hotplugQueue.push_back(event);
+    }
+    this->hotplugQueueCondition.notify_one();
+}
+
+long SeaBreezeAPI_Impl::applyHotplugEvent(HotplugEvent &event) {
+    vector<DeviceAdapter *>::iterator iter;
+
+    lock_guard<mutex> lock(this->deviceListMutex);
+
+    for(iter = this->probedDevices.begin(); iter != this->probedDevices.end(); iter++) {
+        if(true == event.location->equals(*(*iter)->getLocation())) {
+            break;
+        }
+    }
+
+    if(true == event.deviceTypeName.empty()) {
+        if(iter == this->probedDevices.end()) {
+            return 0;
+        }
+        /* Keep the adapter around until the next probeDevices() since the
+         * caller may still be using the device.
+         */
+        DeviceAdapter *adapter = *iter;
+        this->probedDevices.erase(iter);
+        this->departedDevices.push_back(adapter);
+        return adapter->getID();
+    }
+
+    if(iter != this->probedDevices.end()) {
+        /* Already known, e.g. from an earlier probeDevices() */
+        return 0;
+    }
+
+    Device *newdev = DeviceFactory::getInstance()->create(event.deviceTypeName);
+    if(NULL == newdev) {
+        return 0;
+    }
+    newdev->setLocation(*event.location);
+    try {
+        DeviceAdapter *adapter = new DeviceAdapter(newdev, ++__deviceID);
+        this->probedDevices.push_back(adapter);
+        return adapter->getID();
+    } catch (const IllegalArgumentException &iae) {
+        return 0;
+    }
+}
+
+void SeaBreezeAPI_Impl::runHotplug() {
+    unique_lock<mutex> queueLock(this->hotplugQueueMutex);
+
+    while(true) {
+        while(false == this->hotplugStopRequested && true == this->hotplugQueue.empty()) {
+            this->hotplugQueueCondition.wait(queueLock);
+        }
+        if(true == this->hotplugStopRequested) {
+            break;
+        }
+        HotplugEvent event = this->hotplugQueue.front();
+        this->hotplugQueue.pop_front();
+        queueLock.unlock();
+
+        {
+            /* Callbacks may add or remove callbacks, so call a copy */
+            lock_guard<recursive_mutex> lock(this->hotplugCallbackMutex);
+            long id = applyHotplugEvent(event);
+            int arrived = event.deviceTypeName.empty() ? 0 : 1;
+            delete event.location;
+            if(0 != id) {
+                vector<pair<SeaBreezeHotplugCallback, void *> > callbacks(
+                    this->hotplugCallbacks);
+                vector<pair<SeaBreezeHotplugCallback, void *> >::iterator iter;
+                for(iter = callbacks.begin(); iter != callbacks.end(); iter++) {
+                    iter->first(id, arrived, iter->second);
+                }
+            }
+        }
+
+        queueLock.lock();
+    }
+}
+
 
 int SeaBreezeAPI_Impl::getNumberOfSupportedModels() {
     std::vector<std::string> supportedModels = DeviceFactory::getInstance()->getSupportedModels();
@@ -350,6 +581,16 @@ void SeaBreezeAPI_Impl::closeDevice(long deviceID, int *errorCode) {
     SET_ERROR_CODE(ERROR_SUCCESS);
 }
 
+void SeaBreezeAPI_Impl::cancelTransfers(long deviceID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->cancelTransfers(errorCode);
+}
+
 int SeaBreezeAPI_Impl::getDeviceType(long id, int *errorCode,
             char *buffer, unsigned int length) {
     DeviceAdapter *adapter = getDeviceByID(id);
@@ -568,6 +809,173 @@ double SeaBreezeAPI_Impl::spectrometerGetMaximumIntensity(
     return adapter->spectrometerGetMaximumIntensity(featureID, errorCode);
 }
 
+void SeaBreezeAPI_Impl::spectrometerSetTransferTimeouts(long deviceID,
+        long featureID, int *errorCode, long spectrumTimeoutMillis, long controlTimeoutMillis) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerSetTransferTimeouts(featureID, errorCode, spectrumTimeoutMillis, controlTimeoutMillis);
+}
+
+long SeaBreezeAPI_Impl::spectrometerGetSpectrumTimeoutMillis(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetSpectrumTimeoutMillis(featureID, errorCode);
+}
+
+long SeaBreezeAPI_Impl::spectrometerGetControlTimeoutMillis(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetControlTimeoutMillis(featureID, errorCode);
+}
+
+void SeaBreezeAPI_Impl::spectrometerSetSpectrumCorrection(long deviceID,
+        long featureID, int *errorCode, int correctDarkCounts, int correctNonlinearity,
+        int correctStrayLight) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerSetSpectrumCorrection(featureID, errorCode, correctDarkCounts, correctNonlinearity, correctStrayLight);
+}
+
+void SeaBreezeAPI_Impl::spectrometerSetCorrectionCoefficients(long deviceID,
+        long featureID, int *errorCode, const double *nonlinearity,
+        int nonlinearityCount, const double *strayLight, int strayLightCount) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerSetCorrectionCoefficients(featureID, errorCode, nonlinearity, nonlinearityCount, strayLight, strayLightCount);
+}
+
+void SeaBreezeAPI_Impl::spectrometerSetIrradianceOutput(long deviceID,
+        long featureID, int *errorCode, int enable, float collectionArea) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerSetIrradianceOutput(featureID, errorCode, enable, collectionArea);
+}
+
+void SeaBreezeAPI_Impl::spectrometerSetResampleGrid(long deviceID,
+        long featureID, int *errorCode, const double *grid, int gridLength, int method) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerSetResampleGrid(featureID, errorCode, grid, gridLength, method);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetResampleGridLength(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetResampleGridLength(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetResampledSpectrum(long deviceID,
+        long featureID, int *errorCode, double *buffer, int bufferLength) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetResampledSpectrum(featureID, errorCode, buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerResampleSpectra(long deviceID,
+        long featureID, int *errorCode, const double *spectra, int count, int stride, double *buffer, int bufferStride) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerResampleSpectra(featureID, errorCode, spectra, count, stride, buffer, bufferStride);
+}
+
+void SeaBreezeAPI_Impl::spectrometerSetPixelRanges(long deviceID,
+        long featureID, int *errorCode, const unsigned int *pixelIndexPairs, int length) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerSetPixelRanges(featureID, errorCode, pixelIndexPairs, length);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetPixelRanges(long deviceID,
+        long featureID, int *errorCode, unsigned int *pixelIndexPairs, int length) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetPixelRanges(featureID, errorCode, pixelIndexPairs, length);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetPixelRangeLength(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetPixelRangeLength(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetPixelRangeSpectrum(long deviceID,
+        long featureID, int *errorCode, double *buffer, int bufferLength) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetPixelRangeSpectrum(featureID, errorCode, buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetPixelRangeWavelengths(long deviceID,
+        long featureID, int *errorCode, double *wavelengths, int length) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetPixelRangeWavelengths(featureID, errorCode, wavelengths, length);
+}
+
 int SeaBreezeAPI_Impl::spectrometerGetFastBufferSpectrum(long deviceID,
 	long featureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve) {
 	DeviceAdapter *adapter = getDeviceByID(deviceID);
@@ -580,6 +988,17 @@ int SeaBreezeAPI_Impl::spectrometerGetFastBufferSpectrum(long deviceID,
 		buffer, bufferLength, numberOfSamplesToRetrieve);
 }
 
+int SeaBreezeAPI_Impl::spectrometerGetFastBufferSpectra(long deviceID,
+        long featureID, int *errorCode, unsigned int numberOfSamplesToRetrieve, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFastBufferSpectra(featureID, errorCode, numberOfSamplesToRetrieve, pixels, stride, metadata);
+}
+
 int SeaBreezeAPI_Impl::spectrometerGetUnformattedSpectrum(long deviceID,
         long featureID, int *errorCode, unsigned char *buffer, int bufferLength) {
     DeviceAdapter *adapter = getDeviceByID(deviceID);
@@ -604,6 +1023,72 @@ int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrum(long deviceID,
             buffer, bufferLength);
 }
 
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSampleType(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSampleType(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrumUInt16(long deviceID,
+        long featureID, int *errorCode, unsigned short *buffer, int bufferLength) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectrumUInt16(featureID, errorCode, buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrumUInt32(long deviceID,
+        long featureID, int *errorCode, unsigned int *buffer, int bufferLength) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectrumUInt32(featureID, errorCode, buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrumFloat(long deviceID,
+        long featureID, int *errorCode, float *buffer, int bufferLength) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectrumFloat(featureID, errorCode, buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetProcessedSpectrumFloat(long deviceID,
+        long featureID, int *errorCode, float *buffer, int bufferLength) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetProcessedSpectrumFloat(featureID, errorCode, buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectra(long deviceID,
+        long featureID, int *errorCode, int count, double *buffer, int stride, unsigned long long *timestampsMicros) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectra(featureID, errorCode, count, buffer, stride, timestampsMicros);
+}
+
 int SeaBreezeAPI_Impl::spectrometerGetUnformattedSpectrumLength(long deviceID,
         long featureID, int *errorCode) {
     DeviceAdapter *adapter = getDeviceByID(deviceID);
@@ -661,6 +1146,127 @@ int SeaBreezeAPI_Impl::spectrometerGetElectricDarkPixelIndices(long deviceID,
                 indices, length);
 }
 
+void SeaBreezeAPI_Impl::spectrometerStartContinuousAcquisition(long deviceID,
+        long featureID, int *errorCode, int ringDepth, int pipelined) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerStartContinuousAcquisition(featureID, errorCode, ringDepth, pipelined);
+}
+
+void SeaBreezeAPI_Impl::spectrometerStopContinuousAcquisition(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerStopContinuousAcquisition(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerIsContinuousAcquisitionRunning(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerIsContinuousAcquisitionRunning(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetContinuousAcquisitionDepth(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetContinuousAcquisitionDepth(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerReadContinuousSpectrum(long deviceID,
+        long featureID, int *errorCode, double *buffer, int bufferLength, unsigned long long *timestampMicros) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerReadContinuousSpectrum(featureID, errorCode, buffer, bufferLength, timestampMicros);
+}
+
+void SeaBreezeAPI_Impl::spectrometerGetContinuousAcquisitionStatistics(long deviceID,
+        long featureID, int *errorCode, unsigned long long *framesAcquired, unsigned long long *framesDropped, unsigned long long *overruns, unsigned long long *transferErrors) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerGetContinuousAcquisitionStatistics(featureID, errorCode, framesAcquired, framesDropped, overruns, transferErrors);
+}
+
+void SeaBreezeAPI_Impl::spectrometerStartFastBufferDrain(long deviceID,
+        long featureID, int *errorCode, int queueDepth, int maxBatch, int pollIntervalMicros) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerStartFastBufferDrain(featureID, errorCode, queueDepth, maxBatch, pollIntervalMicros);
+}
+
+void SeaBreezeAPI_Impl::spectrometerStopFastBufferDrain(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerStopFastBufferDrain(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerIsFastBufferDrainRunning(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerIsFastBufferDrainRunning(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerReadFastBufferDrain(long deviceID,
+        long featureID, int *errorCode, int maxSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerReadFastBufferDrain(featureID, errorCode, maxSpectra, pixels, stride, metadata);
+}
+
+void SeaBreezeAPI_Impl::spectrometerGetFastBufferDrainStatistics(long deviceID,
+        long featureID, int *errorCode, unsigned long long *spectraReceived, unsigned long long *spectraMissed, unsigned long long *sequenceGaps, unsigned long long *spectraDropped, unsigned long long *transferErrors) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerGetFastBufferDrainStatistics(featureID, errorCode, spectraReceived, spectraMissed, sequenceGaps, spectraDropped, transferErrors);
+}
+
 /**************************************************************************************/
 //  Pixel binning features for the SeaBreeze API class
 /**************************************************************************************/
@@ -2530,6 +3136,28 @@ void SeaBreezeAPI_Impl::dataBufferSetBufferCapacity(long deviceID, long featureI
     adapter->dataBufferSetBufferCapacity(featureID, errorCode, capacity);
 }
 
+int SeaBreezeAPI_Impl::dataBufferGetBufferedSpectrumLength(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->dataBufferGetBufferedSpectrumLength(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::dataBufferReadBufferedSpectra(long deviceID,
+        long featureID, int *errorCode, unsigned int numberOfSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) {
+    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->dataBufferReadBufferedSpectra(featureID, errorCode, numberOfSpectra, pixels, stride, metadata);
+}
+
 
 
 /**************************************************************************************/
@@ -33,26 +33,59 @@
 #include "common/globals.h"
 #include <string>
 #include <string.h>     /* for memcpy() */
+#include <chrono>
+#include <algorithm>
 #include "api/seabreezeapi/SeaBreezeAPIConstants.h"
 #include "api/seabreezeapi/SpectrometerFeatureAdapter.h"
+#include "vendors/OceanOptics/features/spectrometer/FastBufferSpectrumParser.h"
 #include "common/exceptions/IllegalArgumentException.h"
+#include "common/exceptions/FeatureTimeoutException.h"
 
 using namespace seabreeze;
 using namespace seabreeze::api;
 using namespace std;
 
+/* Margin on top of the integration time for an automatic spectrum timeout,
+ * and the automatic timeout for everything else.
+ */
+#define SPECTRUM_TIMEOUT_MARGIN_MILLIS  1000
+#define DEFAULT_CONTROL_TIMEOUT_MILLIS  10000
+
+/* The error code for a failed transfer, which distinguishes timeouts (and
+ * cancellations) from other failures.
+ */
+static int transferErrorCode(const FeatureException &fe) {
+    if(NULL != dynamic_cast<const FeatureTimeoutException *>(&fe)) {
+        return ERROR_TRANSFER_TIMEOUT;
+    }
+    return ERROR_TRANSFER_ERROR;
+}
+
 SpectrometerFeatureAdapter::SpectrometerFeatureAdapter(
         OOISpectrometerFeatureInterface *spec, const FeatureFamily &f,
         seabreeze::Protocol *p, seabreeze::Bus *b, unsigned short instanceID)
             : FeatureAdapterTemplate<OOISpectrometerFeatureInterface>(spec,
                 f, p, b, instanceID) {
 
+    this->acquisition = new ContinuousAcquisition(spec, p, b);
+    this->drain = new FastBufferDrain(spec, NULL, this->acquisition, p, b);
+    this->resampleMethod = WavelengthResampler::METHOD_LINEAR;
+
+    this->spectrumTimeoutMillis = -1;
+    this->controlTimeoutMillis = -1;
+    this->integrationTimeMicros = 0;
+    this->triggerMode = 0;
+    applyTransferTimeouts();
 }
 
 SpectrometerFeatureAdapter::~SpectrometerFeatureAdapter() {
-    /* This is just a wrapper around pointers to instances.  This is not
-     * responsible for destroying anything.
+    /* This is mostly a wrapper around pointers to instances.  The only things
+     * it owns are the continuous acquisition engine and the fast buffer
+     * drain, which stop their threads before going away.  The drain borrows
+     * the acquisition's bus lock, so it must go first.
      */
+    delete this->drain;
+    delete this->acquisition;
 }
 
 #ifdef _WINDOWS
@@ -60,6 +93,7 @@ SpectrometerFeatureAdapter::~SpectrometerFeatureAdapter() {
 #endif
 int SpectrometerFeatureAdapter::getUnformattedSpectrum(int *errorCode,
                     unsigned char *buffer, int bufferLength) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
     vector<unsigned char> *spectrum;
     int bytesCopied = 0;
 
@@ -77,7 +111,7 @@ int SpectrometerFeatureAdapter::getUnformattedSpectrum(int *errorCode,
         delete spectrum;
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (const FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return 0;
     }
 
@@ -86,6 +120,7 @@ int SpectrometerFeatureAdapter::getUnformattedSpectrum(int *errorCode,
 
 int SpectrometerFeatureAdapter::getFastBufferSpectrum(int *errorCode,
 	unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve) {
+	ContinuousAcquisitionBusLock busLock(this->acquisition);
 	vector<unsigned char> *spectrum;
 	int bytesCopied = 0;
 
@@ -107,56 +142,319 @@ int SpectrometerFeatureAdapter::getFastBufferSpectrum(int *errorCode,
 		SET_ERROR_CODE(ERROR_SUCCESS);
 	}
 	catch (const FeatureException &fe) {
-		SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+		SET_ERROR_CODE(transferErrorCode(fe));
 		return 0;
 	}
 
 	return bytesCopied;
 }
 
+int SpectrometerFeatureAdapter::getFastBufferSpectra(int *errorCode,
+        unsigned int numberOfSamplesToRetrieve, unsigned int *pixels, int stride,
+        FastBufferSpectrumMetadata *metadata) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    vector<unsigned char> *data;
+    int spectra = 0;
+
+    if(NULL == pixels || NULL == metadata || stride <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    try {
+        data = this->feature->getFastBufferSpectrum(*this->protocol, *this->bus,
+                numberOfSamplesToRetrieve);
+    } catch (const FeatureException &fe) {
+        SET_ERROR_CODE(transferErrorCode(fe));
+        return 0;
+    }
+
+    try {
+        /* Split the payload straight into the caller's rows and records */
+        spectra = (int) FastBufferSpectrumParser::parse(
+                data->empty() ? NULL : &(*data)[0], (unsigned int) data->size(),
+                numberOfSamplesToRetrieve, pixels, (unsigned int) stride, metadata);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (const IllegalArgumentException &iae) {
+        SET_ERROR_CODE(ERROR_VALUE_NOT_EXPECTED);
+        spectra = 0;
+    }
+    delete data;
+
+    return spectra;
+}
+
 
 int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
                     double* buffer, int bufferLength) {
-    vector<double> *spectrum;
+    if(this->hostProcessing.isActive()) {
+        return getProcessedSpectrum(errorCode, buffer, bufferLength);
+    }
+
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
     int doublesCopied = 0;
 
-    if(NULL == buffer) {
+    if(NULL == buffer || bufferLength < 0) {
         SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
         return 0;
     }
 
     try {
-        spectrum = this->feature->getFormattedSpectrum(*this->protocol, *this->bus);
-        int pixels = (int) spectrum->size();
-        doublesCopied = (pixels < bufferLength) ? pixels : bufferLength;
-        memcpy(buffer, &((*spectrum)[0]), doublesCopied * sizeof (double));
-        delete spectrum;
+        /* The spectrum is decoded straight into the caller's buffer */
+        doublesCopied = (int) this->feature->getFormattedSpectrum(*this->protocol,
+                *this->bus, buffer, (unsigned int) bufferLength);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (const FeatureException &fe) {
 
 		// the get spectrum calls should have an argument for the error string so that fe.what can be used
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return 0;
     }
     return doublesCopied;
 }
 
+int SpectrometerFeatureAdapter::getFormattedSampleType(int *errorCode) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    FormattedSpectrumTransferInterface::SampleType type;
+
+    try {
+        type = this->feature->getFormattedSampleType(*this->protocol);
+    } catch (const FeatureException &fe) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    switch(type) {
+    case FormattedSpectrumTransferInterface::SAMPLE_UINT16:
+        return SPECTRUM_SAMPLE_TYPE_UINT16;
+    case FormattedSpectrumTransferInterface::SAMPLE_UINT32:
+        return SPECTRUM_SAMPLE_TYPE_UINT32;
+    case FormattedSpectrumTransferInterface::SAMPLE_FLOAT:
+        return SPECTRUM_SAMPLE_TYPE_FLOAT;
+    default:
+        return SPECTRUM_SAMPLE_TYPE_DOUBLE;
+    }
+}
+
+template <typename T>
+int SpectrometerFeatureAdapter::getNativeFormattedSpectrum(int *errorCode,
+        FormattedSpectrumTransferInterface::SampleType type,
+        T *buffer, int bufferLength) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    int samplesCopied = 0;
+
+    if(NULL == buffer || bufferLength < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    try {
+        /* Check before the request so that no spectrum is wasted */
+        if(type != this->feature->getFormattedSampleType(*this->protocol)) {
+            SET_ERROR_CODE(ERROR_VALUE_NOT_EXPECTED);
+            return 0;
+        }
+        samplesCopied = (int) this->feature->getFormattedSpectrum(*this->protocol,
+                *this->bus, buffer, (unsigned int) bufferLength);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (const FeatureException &fe) {
+        SET_ERROR_CODE(transferErrorCode(fe));
+        return 0;
+    }
+    return samplesCopied;
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrumUInt16(int *errorCode,
+        unsigned short *buffer, int bufferLength) {
+    return getNativeFormattedSpectrum(errorCode,
+            FormattedSpectrumTransferInterface::SAMPLE_UINT16, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrumUInt32(int *errorCode,
+        unsigned int *buffer, int bufferLength) {
+    return getNativeFormattedSpectrum(errorCode,
+            FormattedSpectrumTransferInterface::SAMPLE_UINT32, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrumFloat(int *errorCode,
+        float *buffer, int bufferLength) {
+    return getNativeFormattedSpectrum(errorCode,
+            FormattedSpectrumTransferInterface::SAMPLE_FLOAT, buffer, bufferLength);
+}
+
+/* Native readouts are never corrected, but double spectra must be read
+ * without corrections so that they are only applied after averaging.
+ */
+template <typename T>
+static unsigned int readUncorrectedSpectrum(OOISpectrometerFeatureInterface *feature,
+        const Protocol &protocol, const Bus &bus, T *buffer, unsigned int bufferLength) {
+    return feature->getFormattedSpectrum(protocol, bus, buffer, bufferLength);
+}
+
+static unsigned int readUncorrectedSpectrum(OOISpectrometerFeatureInterface *feature,
+        const Protocol &protocol, const Bus &bus, double *buffer,
+        unsigned int bufferLength) {
+    return feature->getUncorrectedFormattedSpectrum(protocol, bus, buffer,
+            bufferLength);
+}
+
+template <typename T>
+void SpectrometerFeatureAdapter::accumulateSpectrum(vector<T> &scan) {
+    unsigned int pixels = this->accumulator.getLength();
+    unsigned int length;
+
+    scan.resize(pixels);
+    length = readUncorrectedSpectrum(this->feature, *this->protocol, *this->bus,
+            &scan[0], pixels);
+    if(length < pixels) {
+        fill(scan.begin() + length, scan.end(), (T) 0);
+    }
+    this->accumulator.add(&scan[0]);
+}
+
+template <typename T>
+int SpectrometerFeatureAdapter::getProcessedSpectrum(int *errorCode,
+        T *buffer, int bufferLength) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    FormattedSpectrumTransferInterface::SampleType type;
+    unsigned int scans = this->hostProcessing.getScansToAverage();
+    unsigned int boxcarWidth = this->hostProcessing.getBoxcarWidth();
+    unsigned int pixels;
+    unsigned int i;
+
+    if(NULL == buffer || bufferLength < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    try {
+        type = this->feature->getFormattedSampleType(*this->protocol);
+        pixels = this->feature->getNumberOfPixels();
+        if(0 == pixels) {
+            SET_ERROR_CODE(ERROR_SUCCESS);
+            return 0;
+        }
+
+        /* Sum the scans at the device's native width so that integer
+         * counts are added exactly and without converting every pixel.
+         */
+        this->accumulator.reset(pixels, type, scans);
+        for(i = 0; i < scans; i++) {
+            switch(type) {
+            case FormattedSpectrumTransferInterface::SAMPLE_UINT16:
+                accumulateSpectrum(this->scanUInt16);
+                break;
+            case FormattedSpectrumTransferInterface::SAMPLE_UINT32:
+                accumulateSpectrum(this->scanUInt32);
+                break;
+            case FormattedSpectrumTransferInterface::SAMPLE_FLOAT:
+                accumulateSpectrum(this->scanFloat);
+                break;
+            default:
+                accumulateSpectrum(this->scanDouble);
+                break;
+            }
+        }
+    } catch (const FeatureException &fe) {
+        SET_ERROR_CODE(transferErrorCode(fe));
+        return 0;
+    }
+
+    /* Correct the unsmoothed mean, whatever the sample type, so that the
+     * dark pixels are not mixed with their neighbours before the dark
+     * level is taken from them.  Only then is the boxcar applied, by
+     * running the corrected mean through the accumulator once more.
+     */
+    this->scanDouble.resize(pixels);
+    this->accumulator.finish(0, &this->scanDouble[0]);
+    this->feature->applySpectrumCorrection(&this->scanDouble[0], pixels);
+    if(boxcarWidth > 0) {
+        this->accumulator.reset(pixels, FormattedSpectrumTransferInterface::SAMPLE_DOUBLE, 1);
+        this->accumulator.add(&this->scanDouble[0]);
+        this->accumulator.finish(boxcarWidth, &this->scanDouble[0]);
+    }
+
+    if((unsigned int) bufferLength < pixels) {
+        pixels = (unsigned int) bufferLength;
+    }
+    for(i = 0; i < pixels; i++) {
+        buffer[i] = (T) this->scanDouble[i];
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) pixels;
+}
+
+int SpectrometerFeatureAdapter::getProcessedSpectrumFloat(int *errorCode,
+        float *buffer, int bufferLength) {
+    return getProcessedSpectrum(errorCode, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectra(int *errorCode, int count,
+        double *buffer, int stride, unsigned long long *timestampsMicros) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    int spectra = 0;
+
+    if(NULL == buffer || count < 0 || stride <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    try {
+        /* Each request is written before the previous spectrum is decoded.
+         * The last row is read synchronously, which consumes the request
+         * left outstanding by the pipeline without issuing another one.
+         */
+        if(count > 1) {
+            this->feature->beginPipelinedFormattedSpectra(*this->protocol, *this->bus);
+        }
+        for(spectra = 0; spectra < count; spectra++) {
+            double *row = buffer + (size_t) spectra * (size_t) stride;
+            if(spectra < count - 1) {
+                this->feature->getPipelinedFormattedSpectrum(*this->protocol,
+                        *this->bus, row, (unsigned int) stride);
+            } else {
+                this->feature->getFormattedSpectrum(*this->protocol,
+                        *this->bus, row, (unsigned int) stride);
+            }
+            if(NULL != timestampsMicros) {
+                timestampsMicros[spectra] = (unsigned long long)
+                        chrono::duration_cast<chrono::microseconds>(
+                        chrono::system_clock::now().time_since_epoch()).count();
+            }
+        }
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (const FeatureException &fe) {
+        try {
+            this->feature->endPipelinedFormattedSpectra(*this->protocol, *this->bus);
+        } catch (const FeatureException &fe2) {
+            /* The transfer error below is what the caller needs to see */
+        }
+        SET_ERROR_CODE(transferErrorCode(fe));
+    }
+    return spectra;
+}
+
 int SpectrometerFeatureAdapter::getUnformattedSpectrumLength(int *errorCode) {
-    /* This is, unfortunately, very hard to implement directly.
-     * The readout length from the device is buried inside a particular
-     * protocol message that would require a lot of digging to reach.
-     * Since every protocol could have a different readout length,
-     * this value cannot simply be stored in the spectrometer feature
-     * like the number of pixels.
-     *
-     * This leaves two (not particularly nice) options.  The first is
-     * to simply get an unformatted spectrum, check the length, and
-     * throw it away.  The other is to create a lookup table of all
-     * possible lengths based on the device type.  I am opting for
-     * the former, even though it could have unpleasant side-effects.
+    /* The read exchanges know their readout length, so this is normally
+     * answered without touching the bus.
      */
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
     vector<unsigned char> *spectrum;
 
+    try {
+        int length = (int) this->feature->getUnformattedSpectrumLength(*this->protocol);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return length;
+    } catch (const FeatureException &fe) {
+        /* Fall through to measuring a spectrum */
+    }
+
+    /* The exchange cannot report its length, so get an unformatted
+     * spectrum, check the length, and throw it away.  This costs an
+     * integration and may consume a buffered spectrum.
+     */
     try {
         spectrum = this->feature->getUnformattedSpectrum(
             *this->protocol, *this->bus);
@@ -165,7 +463,7 @@ int SpectrometerFeatureAdapter::getUnformattedSpectrumLength(int *errorCode) {
         SET_ERROR_CODE(ERROR_SUCCESS);
         return length;
     } catch (const FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return 0;
     }
     return 0;
@@ -179,13 +477,14 @@ int SpectrometerFeatureAdapter::getFormattedSpectrumLength(int *errorCode) {
         numberOfPixels = this->feature->getNumberOfPixels();
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (const FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return 0;
     }
     return numberOfPixels;
 }
 
 void SpectrometerFeatureAdapter::setTriggerMode(int *errorCode, int mode) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
     SpectrometerTriggerMode triggerMode(mode);
 
     try {
@@ -195,11 +494,15 @@ void SpectrometerFeatureAdapter::setTriggerMode(int *errorCode, int mode) {
         SET_ERROR_CODE(ERROR_INVALID_TRIGGER_MODE);
         return;
     }
+
+    this->triggerMode = mode;
+    applyTransferTimeouts();
 }
 
 
 int SpectrometerFeatureAdapter::getWavelengths(int *errorCode,
         double *wavelengths, int length) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
     int valuesCopied = 0;
     int i;
     vector<double> *wlVector;
@@ -221,7 +524,7 @@ int SpectrometerFeatureAdapter::getWavelengths(int *errorCode,
 
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (const FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return 0;
     }
     return valuesCopied;
@@ -238,7 +541,7 @@ unsigned short SpectrometerFeatureAdapter::getNumberOfPixels(int *errorCode)
 		SET_ERROR_CODE(ERROR_SUCCESS);
 	}
 	catch (const FeatureException &fe) {
-		SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+		SET_ERROR_CODE(transferErrorCode(fe));
 		return 0;
 	}
 
@@ -344,17 +647,21 @@ int SpectrometerFeatureAdapter::getActivePixelIndices(int *errorCode,
 
 void SpectrometerFeatureAdapter::setIntegrationTimeMicros(int *errorCode,
                     unsigned long integrationTimeMicros) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
     try {
         this->feature->setIntegrationTimeMicros(*this->protocol, *this->bus,
                     integrationTimeMicros);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (const FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return;
     } catch (const IllegalArgumentException &iae) {
         SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
         return;
     }
+
+    this->integrationTimeMicros = integrationTimeMicros;
+    applyTransferTimeouts();
 }
 
 long SpectrometerFeatureAdapter::getMinimumIntegrationTimeMicros(int *errorCode) {
@@ -364,7 +671,7 @@ long SpectrometerFeatureAdapter::getMinimumIntegrationTimeMicros(int *errorCode)
         retval = this->feature->getIntegrationTimeMinimum();
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (const FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return -1;
     }
     return retval;
@@ -377,7 +684,7 @@ long SpectrometerFeatureAdapter::getMaximumIntegrationTimeMicros(int *errorCode)
         retval = this->feature->getIntegrationTimeMaximum();
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return -1;
     }
     return retval;
@@ -392,8 +699,619 @@ double SpectrometerFeatureAdapter::getMaximumIntensity(int *errorCode) {
         retval = this->feature->getMaximumIntensity();
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
-        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        SET_ERROR_CODE(transferErrorCode(fe));
         return -1;
     }
     return retval;
 }
+
+void SpectrometerFeatureAdapter::setTransferTimeouts(int *errorCode,
+        long spectrumTimeoutMillis, long controlTimeoutMillis) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+
+    if(spectrumTimeoutMillis < -1 || controlTimeoutMillis < -1) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return;
+    }
+
+    this->spectrumTimeoutMillis = spectrumTimeoutMillis;
+    this->controlTimeoutMillis = controlTimeoutMillis;
+    if(false == applyTransferTimeouts()) {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return;
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+long SpectrometerFeatureAdapter::getSpectrumTimeoutMillis(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->spectrumTimeoutMillis;
+}
+
+long SpectrometerFeatureAdapter::getControlTimeoutMillis(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->controlTimeoutMillis;
+}
+
+bool SpectrometerFeatureAdapter::applyTransferTimeouts() {
+    unsigned long spectrumMillis;
+    unsigned long controlMillis;
+    unsigned long integrationMicros;
+
+    if(this->spectrumTimeoutMillis >= 0) {
+        spectrumMillis = (unsigned long) this->spectrumTimeoutMillis;
+    } else if(0 != this->triggerMode) {
+        /* An external trigger may not arrive for any length of time */
+        spectrumMillis = 0;
+    } else {
+        /* Until it is set, the device may be using any integration time */
+        integrationMicros = this->integrationTimeMicros;
+        if(0 == integrationMicros) {
+            integrationMicros = (unsigned long) this->feature->getIntegrationTimeMaximum();
+        }
+        /* A request can arrive just after an integration has started, so
+         * allow for two before the spectrum is sent.
+         */
+        spectrumMillis = 2 * (integrationMicros / 1000) + SPECTRUM_TIMEOUT_MARGIN_MILLIS;
+    }
+
+    if(this->controlTimeoutMillis >= 0) {
+        controlMillis = (unsigned long) this->controlTimeoutMillis;
+    } else {
+        controlMillis = DEFAULT_CONTROL_TIMEOUT_MILLIS;
+    }
+
+    /* The spectrum timeout goes second since it overrides the bus-wide one */
+    bool retval = this->bus->setTransferTimeout((unsigned int) controlMillis);
+    try {
+        if(false == this->feature->setSpectrumTimeout(*this->protocol, *this->bus,
+                (unsigned int) spectrumMillis)) {
+            retval = false;
+        }
+    } catch (const FeatureException &fe) {
+        retval = false;
+    }
+    return retval;
+}
+
+void SpectrometerFeatureAdapter::startContinuousAcquisition(int *errorCode,
+        int ringDepth, int pipelined) {
+    if(ringDepth <= 0) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return;
+    }
+
+    if(true == this->drain->isRunning()) {
+        SET_ERROR_CODE(ERROR_VALUE_NOT_EXPECTED);
+        return;
+    }
+
+    try {
+        this->acquisition->start((unsigned int) ringDepth, 0 != pipelined);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (const FeatureException &fe) {
+        /* Already running */
+        SET_ERROR_CODE(ERROR_VALUE_NOT_EXPECTED);
+    } catch (const IllegalArgumentException &iae) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+    }
+}
+
+void SpectrometerFeatureAdapter::stopContinuousAcquisition(int *errorCode) {
+    this->acquisition->stop();
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SpectrometerFeatureAdapter::isContinuousAcquisitionRunning(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->acquisition->isRunning() ? 1 : 0;
+}
+
+int SpectrometerFeatureAdapter::getContinuousAcquisitionDepth(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) this->acquisition->getDepth();
+}
+
+int SpectrometerFeatureAdapter::readContinuousSpectrum(int *errorCode,
+        double *buffer, int bufferLength, unsigned long long *timestampMicros) {
+    if(NULL == buffer || bufferLength <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    /* This never blocks; 0 means that no spectrum is queued yet. */
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) this->acquisition->readSpectrum(buffer,
+            (unsigned int) bufferLength, timestampMicros);
+}
+
+void SpectrometerFeatureAdapter::getContinuousAcquisitionStatistics(
+        int *errorCode, unsigned long long *framesAcquired,
+        unsigned long long *framesDropped, unsigned long long *overruns,
+        unsigned long long *transferErrors) {
+    if(NULL != framesAcquired) {
+        *framesAcquired = this->acquisition->getAcquiredFrameCount();
+    }
+    if(NULL != framesDropped) {
+        *framesDropped = this->acquisition->getDroppedFrameCount();
+    }
+    if(NULL != overruns) {
+        *overruns = this->acquisition->getOverrunCount();
+    }
+    if(NULL != transferErrors) {
+        *transferErrors = this->acquisition->getErrorCount();
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+void SpectrometerFeatureAdapter::setDataBufferFeature(
+        DataBufferFeatureInterface *dataBuffer) {
+    /* The drain holds no state worth keeping until it is started */
+    delete this->drain;
+    this->drain = new FastBufferDrain(this->feature, dataBuffer,
+            this->acquisition, this->protocol, this->bus);
+}
+
+void SpectrometerFeatureAdapter::startFastBufferDrain(int *errorCode,
+        int queueDepth, int maxBatch, int pollIntervalMicros) {
+    if(queueDepth <= 0 || maxBatch <= 0 || pollIntervalMicros < 0) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return;
+    }
+
+    try {
+        this->drain->start((unsigned int) queueDepth, (unsigned int) maxBatch,
+                (unsigned int) pollIntervalMicros);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (const FeatureException &fe) {
+        /* No data buffer, or the bus is already being streamed from */
+        SET_ERROR_CODE(ERROR_VALUE_NOT_EXPECTED);
+    } catch (const IllegalArgumentException &iae) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+    }
+}
+
+void SpectrometerFeatureAdapter::stopFastBufferDrain(int *errorCode) {
+    this->drain->stop();
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SpectrometerFeatureAdapter::isFastBufferDrainRunning(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->drain->isRunning() ? 1 : 0;
+}
+
+int SpectrometerFeatureAdapter::readFastBufferDrain(int *errorCode,
+        int maxSpectra, unsigned int *pixels, int stride,
+        FastBufferSpectrumMetadata *metadata) {
+    if(NULL == pixels || NULL == metadata || maxSpectra <= 0 || stride <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    /* This never blocks; 0 means that no spectrum is queued yet. */
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) this->drain->read((unsigned int) maxSpectra, pixels,
+            (unsigned int) stride, metadata);
+}
+
+void SpectrometerFeatureAdapter::getFastBufferDrainStatistics(int *errorCode,
+        unsigned long long *spectraReceived, unsigned long long *spectraMissed,
+        unsigned long long *sequenceGaps, unsigned long long *spectraDropped,
+        unsigned long long *transferErrors) {
+    if(NULL != spectraReceived) {
+        *spectraReceived = this->drain->getReceivedCount();
+    }
+    if(NULL != spectraMissed) {
+        *spectraMissed = this->drain->getMissedCount();
+    }
+    if(NULL != sequenceGaps) {
+        *sequenceGaps = this->drain->getGapCount();
+    }
+    if(NULL != spectraDropped) {
+        *spectraDropped = this->drain->getDroppedCount();
+    }
+    if(NULL != transferErrors) {
+        *transferErrors = this->drain->getErrorCount();
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+void SpectrometerFeatureAdapter::setNonlinearityCoefficients(int *errorCode,
+        const double *coefficients, int count) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    FormattedSpectrumTransferInterface::SampleType type;
+    unsigned int maxCount = 0;
+
+    if(NULL == coefficients || count <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return;
+    }
+
+    /* Integer detectors get a lookup table over their whole count range */
+    try {
+        type = this->feature->getFormattedSampleType(*this->protocol);
+        if(FormattedSpectrumTransferInterface::SAMPLE_UINT16 == type
+                || FormattedSpectrumTransferInterface::SAMPLE_UINT32 == type) {
+            maxCount = (unsigned int) this->feature->getMaximumIntensity();
+        }
+    } catch (const FeatureException &fe) {
+        maxCount = 0;
+    }
+
+    vector<double> coeffs(coefficients, coefficients + count);
+    this->feature->setNonlinearityCoefficients(coeffs, maxCount);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SpectrometerFeatureAdapter::hasNonlinearityCoefficients(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->feature->hasNonlinearityCoefficients() ? 1 : 0;
+}
+
+void SpectrometerFeatureAdapter::setStrayLightCoefficients(int *errorCode,
+        const double *coefficients, int count) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+
+    if(NULL == coefficients || count <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return;
+    }
+
+    vector<double> coeffs(coefficients, coefficients + count);
+    this->feature->setStrayLightCoefficients(coeffs);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SpectrometerFeatureAdapter::hasStrayLightCoefficients(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->feature->hasStrayLightCoefficients() ? 1 : 0;
+}
+
+void SpectrometerFeatureAdapter::setSpectrumCorrection(int *errorCode,
+        int correctDarkCounts, int correctNonlinearity, int correctStrayLight) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+
+    if(0 != correctDarkCounts
+            && true == this->feature->getElectricDarkPixelIndices().empty()) {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return;
+    }
+
+    if(0 != correctNonlinearity
+            && false == this->feature->hasNonlinearityCoefficients()) {
+        SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+        return;
+    }
+
+    if(0 != correctStrayLight
+            && false == this->feature->hasStrayLightCoefficients()) {
+        SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+        return;
+    }
+
+    this->feature->setSpectrumCorrection(0 != correctDarkCounts,
+            0 != correctNonlinearity, 0 != correctStrayLight);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+void SpectrometerFeatureAdapter::setIrradianceCalibration(int *errorCode,
+        const float *calibration, int count) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    vector<double> *wavelengths;
+
+    if(NULL == calibration || count <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return;
+    }
+
+    /* The bin widths are derived from the wavelengths once, here */
+    try {
+        wavelengths = this->feature->getWavelengths(*this->protocol, *this->bus);
+    } catch (const FeatureException &fe) {
+        SET_ERROR_CODE(transferErrorCode(fe));
+        return;
+    }
+
+    vector<double> coeffs(calibration, calibration + count);
+    this->feature->setIrradianceCalibration(coeffs, *wavelengths);
+    delete wavelengths;
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SpectrometerFeatureAdapter::hasIrradianceCalibration(int *errorCode) {
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->feature->hasIrradianceCalibration() ? 1 : 0;
+}
+
+void SpectrometerFeatureAdapter::setIrradianceOutput(int *errorCode,
+        int enable, float collectionArea) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+
+    if(0 != enable) {
+        if(false == this->feature->hasIrradianceCalibration()) {
+            SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+            return;
+        }
+        if(collectionArea <= 0.0f) {
+            SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+            return;
+        }
+    }
+
+    try {
+        this->feature->setIrradianceOutput(0 != enable, collectionArea);
+    } catch (const IllegalArgumentException &iae) {
+        /* No integration time has been set yet */
+        SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+        return;
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+void SpectrometerFeatureAdapter::setResampleGrid(int *errorCode,
+        const double *grid, int gridLength, int method) {
+    lock_guard<mutex> lock(this->resampleMutex);
+
+    if(gridLength <= 0) {
+        this->resampler.clear();
+        this->resampleGrid.clear();
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
+    if(NULL == grid) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return;
+    }
+
+    if(WavelengthResampler::METHOD_LINEAR != method
+            && WavelengthResampler::METHOD_CUBIC != method) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return;
+    }
+
+    this->resampleGrid.assign(grid, grid + gridLength);
+    this->resampleMethod = (WavelengthResampler::Method) method;
+    configureResampler(errorCode);
+}
+
+bool SpectrometerFeatureAdapter::configureResampler(int *errorCode) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    vector<double> *wavelengths;
+
+    try {
+        wavelengths = this->feature->getWavelengths(*this->protocol, *this->bus);
+    } catch (const FeatureException &fe) {
+        this->resampler.clear();
+        SET_ERROR_CODE(transferErrorCode(fe));
+        return false;
+    }
+
+    try {
+        this->resampler.configure(wavelengths->empty() ? NULL : &(*wavelengths)[0],
+                (unsigned int) wavelengths->size(), &this->resampleGrid[0],
+                (unsigned int) this->resampleGrid.size(), this->resampleMethod);
+    } catch (const IllegalArgumentException &iae) {
+        /* The wavelength calibration is not strictly increasing */
+        delete wavelengths;
+        this->resampler.clear();
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return false;
+    }
+
+    delete wavelengths;
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return true;
+}
+
+int SpectrometerFeatureAdapter::getResampleGridLength(int *errorCode) {
+    lock_guard<mutex> lock(this->resampleMutex);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) this->resampler.getGridLength();
+}
+
+int SpectrometerFeatureAdapter::getResampledSpectrum(int *errorCode,
+        double *buffer, int bufferLength) {
+    int error = ERROR_SUCCESS;
+
+    /* Held across the read so the grid cannot change before it is applied */
+    lock_guard<mutex> lock(this->resampleMutex);
+
+    if(false == this->resampler.isConfigured()) {
+        SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+        return 0;
+    }
+
+    if(NULL == buffer || bufferLength < (int) this->resampler.getGridLength()) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    int pixels = getFormattedSpectrumLength(&error);
+    if(ERROR_SUCCESS != error || pixels <= 0) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+
+    /* This applies any corrections and host processing that are enabled */
+    this->resampleSource.resize(pixels);
+    int length = getFormattedSpectrum(&error, &this->resampleSource[0], pixels);
+    if(ERROR_SUCCESS != error) {
+        SET_ERROR_CODE(error);
+        return 0;
+    }
+
+    /* The calibration changes with the number of pixels, e.g. on binning */
+    if((unsigned int) length != this->resampler.getSourceLength()) {
+        if(false == configureResampler(errorCode)) {
+            return 0;
+        }
+        if((unsigned int) length != this->resampler.getSourceLength()) {
+            SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+            return 0;
+        }
+    }
+
+    this->resampler.apply(&this->resampleSource[0], buffer);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) this->resampler.getGridLength();
+}
+
+int SpectrometerFeatureAdapter::resampleSpectra(int *errorCode,
+        const double *spectra, int count, int stride, double *buffer,
+        int bufferStride) {
+    lock_guard<mutex> lock(this->resampleMutex);
+
+    if(false == this->resampler.isConfigured()) {
+        SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+        return 0;
+    }
+
+    if(NULL == spectra || NULL == buffer || count < 0
+            || stride < (int) this->resampler.getSourceLength()
+            || bufferStride < (int) this->resampler.getGridLength()) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    this->resampler.apply(spectra, (unsigned int) count, (unsigned int) stride,
+            buffer, (unsigned int) bufferStride);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return count;
+}
+
+void SpectrometerFeatureAdapter::setPixelRanges(int *errorCode,
+        const unsigned int *pixelIndexPairs, int length) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+
+    if(length <= 0) {
+        this->feature->clearPixelRanges();
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
+    if(NULL == pixelIndexPairs) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return;
+    }
+
+    try {
+        vector<unsigned int> ranges(pixelIndexPairs, pixelIndexPairs + length);
+        this->feature->setPixelRanges(ranges);
+    } catch (const IllegalArgumentException &iae) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return;
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SpectrometerFeatureAdapter::getPixelRanges(int *errorCode,
+        unsigned int *pixelIndexPairs, int length) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    vector<unsigned int> ranges = this->feature->getPixelRanges();
+    int valuesCopied = (int) ranges.size();
+
+    if(NULL == pixelIndexPairs || length < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    if(length < valuesCopied) {
+        valuesCopied = length;
+    }
+    if(valuesCopied > 0) {
+        memcpy(pixelIndexPairs, &ranges[0], valuesCopied * sizeof(unsigned int));
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return valuesCopied;
+}
+
+int SpectrometerFeatureAdapter::getPixelRangeLength(int *errorCode) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int) this->feature->getPixelRangeLength();
+}
+
+int SpectrometerFeatureAdapter::getPixelRangeSpectrum(int *errorCode,
+        double *buffer, int bufferLength) {
+    int valuesCopied = 0;
+
+    if(NULL == buffer || bufferLength < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    if(this->hostProcessing.isActive()) {
+        /* Averaging and smoothing work on the whole spectrum */
+        int error = ERROR_SUCCESS;
+        int pixels = getFormattedSpectrumLength(&error);
+        if(ERROR_SUCCESS != error || pixels <= 0) {
+            SET_ERROR_CODE(error);
+            return 0;
+        }
+        this->pixelRangeSource.resize(pixels);
+        pixels = getProcessedSpectrum(&error, &this->pixelRangeSource[0], pixels);
+        if(ERROR_SUCCESS != error) {
+            SET_ERROR_CODE(error);
+            return 0;
+        }
+
+        ContinuousAcquisitionBusLock busLock(this->acquisition);
+        valuesCopied = (int) this->feature->gatherPixelRanges(
+                &this->pixelRangeSource[0], (unsigned int) pixels, buffer,
+                (unsigned int) bufferLength);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return valuesCopied;
+    }
+
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+
+    try {
+        valuesCopied = (int) this->feature->getPixelRangeSpectrum(*this->protocol,
+                *this->bus, buffer, (unsigned int) bufferLength);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (const FeatureException &fe) {
+        SET_ERROR_CODE(transferErrorCode(fe));
+        return 0;
+    }
+    return valuesCopied;
+}
+
+int SpectrometerFeatureAdapter::getPixelRangeWavelengths(int *errorCode,
+        double *wavelengths, int length) {
+    ContinuousAcquisitionBusLock busLock(this->acquisition);
+    int valuesCopied = 0;
+    vector<double> *wlVector;
+
+    if(NULL == wavelengths || length < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    try {
+        wlVector = this->feature->getPixelRangeWavelengths(*this->protocol, *this->bus);
+    } catch (const FeatureException &fe) {
+        SET_ERROR_CODE(transferErrorCode(fe));
+        return 0;
+    }
+
+    if(NULL == wlVector) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+
+    valuesCopied = ((int) wlVector->size() < length) ? (int) wlVector->size() : length;
+    if(valuesCopied > 0) {
+        memcpy(wavelengths, &(*wlVector)[0], valuesCopied * sizeof(double));
+    }
+    delete wlVector;
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return valuesCopied;
+}
+
+HostSpectrumProcessingFeature *SpectrometerFeatureAdapter::getHostSpectrumProcessingFeature() {
+    return &this->hostProcessing;
+}
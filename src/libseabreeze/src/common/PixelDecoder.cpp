@@ -0,0 +1,582 @@
+/***************************************************//**
+ * @file    PixelDecoder.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <atomic>
+#include <cstddef>
+#include "common/PixelDecoder.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SEABREEZE_DECODER_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define SEABREEZE_DECODER_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+#endif
+
+using namespace seabreeze;
+using namespace std;
+
+namespace {
+
+    /* ---------------- Portable reference kernels ---------------- */
+
+    template <typename T>
+    void scalarU16(const unsigned char *in, unsigned short xorMask,
+            T *out, unsigned int count) {
+        unsigned int i;
+        for(i = 0; i < count; i++) {
+            out[i] = (T)(unsigned short)(((in[(i * 2) + 1] << 8) | in[i * 2]) ^ xorMask);
+        }
+    }
+
+    template <typename T>
+    void scalarU16Scaled(const unsigned char *in, unsigned short xorMask,
+            double scale, double limit, T *out, unsigned int count) {
+        const T s = (T)scale;
+        const T l = (T)limit;
+        unsigned int i;
+        for(i = 0; i < count; i++) {
+            T value = (T)(unsigned short)(((in[(i * 2) + 1] << 8) | in[i * 2]) ^ xorMask) * s;
+            out[i] = (value > l) ? l : value;
+        }
+    }
+
+    template <typename T>
+    void scalarOOI2K(const unsigned char *in, T *out, unsigned int count) {
+        unsigned int i;
+        unsigned int lsbIndex;
+        for(i = 0; i < count; i++) {
+            lsbIndex = ((i >> 6) << 6) + i;
+            out[i] = (T)(unsigned short)(((in[lsbIndex + 64] & 0x0F) << 8) | in[lsbIndex]);
+        }
+    }
+
+    template <typename T>
+    void scalarU32(const unsigned char *in, T *out, unsigned int count) {
+        unsigned int i;
+        for(i = 0; i < count; i++) {
+            out[i] = (T)(((unsigned int)in[(i * 4) + 3] << 24)
+                       | ((unsigned int)in[(i * 4) + 2] << 16)
+                       | ((unsigned int)in[(i * 4) + 1] << 8)
+                       |  (unsigned int)in[i * 4]);
+        }
+    }
+
+    template <typename S, typename T>
+    void scalarWiden(const S *in, T *out, unsigned int count) {
+        unsigned int i;
+        for(i = 0; i < count; i++) {
+            out[i] = (T)in[i];
+        }
+    }
+
+    /* The SIMD kernels only handle whole vectors and leave the remainder
+     * to the reference kernels.  On a little-endian host, widening an array
+     * of host integers is the same as decoding its bytes.
+     */
+
+#ifdef SEABREEZE_DECODER_SSE2
+    /* ---------------- SSE2: 8 x u16 or 4 x u32 per vector ---------------- */
+
+    inline void sse2Store8(unsigned short *out, __m128i v) {
+        _mm_storeu_si128((__m128i *)out, v);
+    }
+
+    inline void sse2Store8(float *out, __m128i v) {
+        const __m128i zero = _mm_setzero_si128();
+        _mm_storeu_ps(out, _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_ps(out + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)));
+    }
+
+    inline void sse2Store8(double *out, __m128i v) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i lo = _mm_unpacklo_epi16(v, zero);
+        __m128i hi = _mm_unpackhi_epi16(v, zero);
+        _mm_storeu_pd(out, _mm_cvtepi32_pd(lo));
+        _mm_storeu_pd(out + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2))));
+        _mm_storeu_pd(out + 4, _mm_cvtepi32_pd(hi));
+        _mm_storeu_pd(out + 6, _mm_cvtepi32_pd(_mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    inline void sse2Store8Scaled(float *out, __m128i v, double scale, double limit) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 s = _mm_set1_ps((float)scale);
+        const __m128 l = _mm_set1_ps((float)limit);
+        _mm_storeu_ps(out, _mm_min_ps(_mm_mul_ps(
+                _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), s), l));
+        _mm_storeu_ps(out + 4, _mm_min_ps(_mm_mul_ps(
+                _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), s), l));
+    }
+
+    inline void sse2Store8Scaled(double *out, __m128i v, double scale, double limit) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128d s = _mm_set1_pd(scale);
+        const __m128d l = _mm_set1_pd(limit);
+        __m128i lo = _mm_unpacklo_epi16(v, zero);
+        __m128i hi = _mm_unpackhi_epi16(v, zero);
+        _mm_storeu_pd(out, _mm_min_pd(_mm_mul_pd(_mm_cvtepi32_pd(lo), s), l));
+        _mm_storeu_pd(out + 2, _mm_min_pd(_mm_mul_pd(_mm_cvtepi32_pd(
+                _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2))), s), l));
+        _mm_storeu_pd(out + 4, _mm_min_pd(_mm_mul_pd(_mm_cvtepi32_pd(hi), s), l));
+        _mm_storeu_pd(out + 6, _mm_min_pd(_mm_mul_pd(_mm_cvtepi32_pd(
+                _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2))), s), l));
+    }
+
+    inline void sse2Store4(unsigned int *out, __m128i v) {
+        _mm_storeu_si128((__m128i *)out, v);
+    }
+
+    inline void sse2Store4(float *out, __m128i v) {
+        /* There is no unsigned conversion, so convert the two 16-bit halves
+         * separately.  Both products are exact, so the sum is rounded once.
+         */
+        __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(v, 16));
+        __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(v, _mm_set1_epi32(0xFFFF)));
+        _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.0f)), lo));
+    }
+
+    inline void sse2Store4(double *out, __m128i v) {
+        /* Bias into signed range, convert, and add the bias back exactly */
+        const __m128d bias = _mm_set1_pd(2147483648.0);
+        __m128i s = _mm_xor_si128(v, _mm_set1_epi32((int)0x80000000));
+        _mm_storeu_pd(out, _mm_add_pd(_mm_cvtepi32_pd(s), bias));
+        _mm_storeu_pd(out + 2, _mm_add_pd(_mm_cvtepi32_pd(
+                _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2))), bias));
+    }
+
+    template <typename T>
+    void sse2U16(const unsigned char *in, unsigned short xorMask,
+            T *out, unsigned int count) {
+        const __m128i mask = _mm_set1_epi16((short)xorMask);
+        unsigned int i;
+        for(i = 0; i + 8 <= count; i += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(in + (i * 2)));
+            sse2Store8(out + i, _mm_xor_si128(v, mask));
+        }
+        scalarU16(in + (i * 2), xorMask, out + i, count - i);
+    }
+
+    template <typename T>
+    void sse2U16Scaled(const unsigned char *in, unsigned short xorMask,
+            double scale, double limit, T *out, unsigned int count) {
+        const __m128i mask = _mm_set1_epi16((short)xorMask);
+        unsigned int i;
+        for(i = 0; i + 8 <= count; i += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(in + (i * 2)));
+            sse2Store8Scaled(out + i, _mm_xor_si128(v, mask), scale, limit);
+        }
+        scalarU16Scaled(in + (i * 2), xorMask, scale, limit, out + i, count - i);
+    }
+
+    template <typename T>
+    void sse2OOI2K(const unsigned char *in, T *out, unsigned int count) {
+        const __m128i low4 = _mm_set1_epi8(0x0F);
+        unsigned int block;
+        unsigned int j;
+        unsigned int n;
+        for(block = 0; block < count; block += 64) {
+            /* Each block of 64 pixels is 64 LSBs followed by 64 MSBs */
+            const unsigned char *lsb = in + (block * 2);
+            n = (count - block < 64) ? count - block : 64;
+            for(j = 0; j + 16 <= n; j += 16) {
+                __m128i l = _mm_loadu_si128((const __m128i *)(lsb + j));
+                __m128i h = _mm_and_si128(_mm_loadu_si128((const __m128i *)(lsb + 64 + j)), low4);
+                sse2Store8(out + block + j, _mm_unpacklo_epi8(l, h));
+                sse2Store8(out + block + j + 8, _mm_unpackhi_epi8(l, h));
+            }
+            for(; j < n; j++) {
+                out[block + j] = (T)(unsigned short)(((lsb[64 + j] & 0x0F) << 8) | lsb[j]);
+            }
+        }
+    }
+
+    template <typename T>
+    void sse2U32(const unsigned char *in, T *out, unsigned int count) {
+        unsigned int i;
+        for(i = 0; i + 4 <= count; i += 4) {
+            sse2Store4(out + i, _mm_loadu_si128((const __m128i *)(in + (i * 4))));
+        }
+        scalarU32(in + (i * 4), out + i, count - i);
+    }
+#endif /* SEABREEZE_DECODER_SSE2 */
+
+#ifdef SEABREEZE_DECODER_AVX2
+    /* ---------------- AVX2: 16 x u16 or 8 x u32 per vector ---------------- */
+
+    AVX2_TARGET inline void avx2Store8(float *out, __m128i v) {
+        _mm256_storeu_ps(out, _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v)));
+    }
+
+    AVX2_TARGET inline void avx2Store8(double *out, __m128i v) {
+        __m256i w = _mm256_cvtepu16_epi32(v);
+        _mm256_storeu_pd(out, _mm256_cvtepi32_pd(_mm256_castsi256_si128(w)));
+        _mm256_storeu_pd(out + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(w, 1)));
+    }
+
+    AVX2_TARGET inline void avx2Store8Scaled(float *out, __m128i v,
+            double scale, double limit) {
+        __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v));
+        _mm256_storeu_ps(out, _mm256_min_ps(_mm256_mul_ps(f,
+                _mm256_set1_ps((float)scale)), _mm256_set1_ps((float)limit)));
+    }
+
+    AVX2_TARGET inline void avx2Store8Scaled(double *out, __m128i v,
+            double scale, double limit) {
+        const __m256d s = _mm256_set1_pd(scale);
+        const __m256d l = _mm256_set1_pd(limit);
+        __m256i w = _mm256_cvtepu16_epi32(v);
+        _mm256_storeu_pd(out, _mm256_min_pd(_mm256_mul_pd(
+                _mm256_cvtepi32_pd(_mm256_castsi256_si128(w)), s), l));
+        _mm256_storeu_pd(out + 4, _mm256_min_pd(_mm256_mul_pd(
+                _mm256_cvtepi32_pd(_mm256_extracti128_si256(w, 1)), s), l));
+    }
+
+    AVX2_TARGET inline void avx2Store16(unsigned short *out, __m256i v) {
+        _mm256_storeu_si256((__m256i *)out, v);
+    }
+
+    template <typename T>
+    AVX2_TARGET inline void avx2Store16(T *out, __m256i v) {
+        avx2Store8(out, _mm256_castsi256_si128(v));
+        avx2Store8(out + 8, _mm256_extracti128_si256(v, 1));
+    }
+
+    AVX2_TARGET inline void avx2Store8U32(unsigned int *out, __m256i v) {
+        _mm256_storeu_si256((__m256i *)out, v);
+    }
+
+    AVX2_TARGET inline void avx2Store8U32(float *out, __m256i v) {
+        /* See sse2Store4() */
+        __m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(v, 16));
+        __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(v, _mm256_set1_epi32(0xFFFF)));
+        _mm256_storeu_ps(out, _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.0f)), lo));
+    }
+
+    AVX2_TARGET inline void avx2Store8U32(double *out, __m256i v) {
+        const __m256d bias = _mm256_set1_pd(2147483648.0);
+        __m256i s = _mm256_xor_si256(v, _mm256_set1_epi32((int)0x80000000));
+        _mm256_storeu_pd(out, _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(s)), bias));
+        _mm256_storeu_pd(out + 4, _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(s, 1)), bias));
+    }
+
+    template <typename T>
+    AVX2_TARGET void avx2U16(const unsigned char *in, unsigned short xorMask,
+            T *out, unsigned int count) {
+        const __m256i mask = _mm256_set1_epi16((short)xorMask);
+        unsigned int i;
+        for(i = 0; i + 16 <= count; i += 16) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(in + (i * 2)));
+            avx2Store16(out + i, _mm256_xor_si256(v, mask));
+        }
+        scalarU16(in + (i * 2), xorMask, out + i, count - i);
+    }
+
+    template <typename T>
+    AVX2_TARGET void avx2U16Scaled(const unsigned char *in, unsigned short xorMask,
+            double scale, double limit, T *out, unsigned int count) {
+        const __m256i mask = _mm256_set1_epi16((short)xorMask);
+        unsigned int i;
+        for(i = 0; i + 16 <= count; i += 16) {
+            __m256i v = _mm256_xor_si256(
+                    _mm256_loadu_si256((const __m256i *)(in + (i * 2))), mask);
+            avx2Store8Scaled(out + i, _mm256_castsi256_si128(v), scale, limit);
+            avx2Store8Scaled(out + i + 8, _mm256_extracti128_si256(v, 1), scale, limit);
+        }
+        scalarU16Scaled(in + (i * 2), xorMask, scale, limit, out + i, count - i);
+    }
+
+    template <typename T>
+    AVX2_TARGET void avx2OOI2K(const unsigned char *in, T *out, unsigned int count) {
+        const __m256i low4 = _mm256_set1_epi8(0x0F);
+        unsigned int block;
+        unsigned int j;
+        unsigned int n;
+        for(block = 0; block < count; block += 64) {
+            const unsigned char *lsb = in + (block * 2);
+            n = (count - block < 64) ? count - block : 64;
+            for(j = 0; j + 32 <= n; j += 32) {
+                __m256i l = _mm256_loadu_si256((const __m256i *)(lsb + j));
+                __m256i h = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(lsb + 64 + j)), low4);
+                /* The byte unpacks work within 128-bit lanes, so first swap the
+                 * middle quadwords to keep the pixels in order.
+                 */
+                l = _mm256_permute4x64_epi64(l, _MM_SHUFFLE(3, 1, 2, 0));
+                h = _mm256_permute4x64_epi64(h, _MM_SHUFFLE(3, 1, 2, 0));
+                avx2Store16(out + block + j, _mm256_unpacklo_epi8(l, h));
+                avx2Store16(out + block + j + 16, _mm256_unpackhi_epi8(l, h));
+            }
+            for(; j < n; j++) {
+                out[block + j] = (T)(unsigned short)(((lsb[64 + j] & 0x0F) << 8) | lsb[j]);
+            }
+        }
+    }
+
+    template <typename T>
+    AVX2_TARGET void avx2U32(const unsigned char *in, T *out, unsigned int count) {
+        unsigned int i;
+        for(i = 0; i + 8 <= count; i += 8) {
+            avx2Store8U32(out + i, _mm256_loadu_si256((const __m256i *)(in + (i * 4))));
+        }
+        scalarU32(in + (i * 4), out + i, count - i);
+    }
+
+    bool cpuSupportsAVX2() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7) {
+            return false;
+        }
+        /* The OS must also save the YMM registers across context switches */
+        __cpuid(info, 1);
+        if(0 == (info[2] & (1 << 27)) || 0 == (info[2] & (1 << 28))) {
+            return false;
+        }
+        if((_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return 0 != (info[1] & (1 << 5));
+#else
+        __builtin_cpu_init();
+        return 0 != __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif /* SEABREEZE_DECODER_AVX2 */
+
+    /* ---------------- Dispatch ---------------- */
+
+    struct KernelTable {
+        PixelDecoder::Implementation impl;
+        const char *name;
+        void (*u16ToU16)(const unsigned char *, unsigned short, unsigned short *, unsigned int);
+        void (*u16ToDouble)(const unsigned char *, unsigned short, double *, unsigned int);
+        void (*u16ToFloat)(const unsigned char *, unsigned short, float *, unsigned int);
+        void (*u16ScaledToDouble)(const unsigned char *, unsigned short, double, double,
+                double *, unsigned int);
+        void (*u16ScaledToFloat)(const unsigned char *, unsigned short, double, double,
+                float *, unsigned int);
+        void (*ooi2kToU16)(const unsigned char *, unsigned short *, unsigned int);
+        void (*ooi2kToDouble)(const unsigned char *, double *, unsigned int);
+        void (*ooi2kToFloat)(const unsigned char *, float *, unsigned int);
+        void (*u32ToU32)(const unsigned char *, unsigned int *, unsigned int);
+        void (*u32ToDouble)(const unsigned char *, double *, unsigned int);
+        void (*u32ToFloat)(const unsigned char *, float *, unsigned int);
+        bool hostOrderWiden;    /* widen() may reuse the decoders */
+    };
+
+#define SEABREEZE_KERNEL_TABLE(impl, name, u16, u16Scaled, ooi2k, u32, hostOrder) \
+    { impl, name, &u16<unsigned short>, &u16<double>, &u16<float>, \
+      &u16Scaled<double>, &u16Scaled<float>, \
+      &ooi2k<unsigned short>, &ooi2k<double>, &ooi2k<float>, \
+      &u32<unsigned int>, &u32<double>, &u32<float>, hostOrder }
+
+    const KernelTable scalarKernels = SEABREEZE_KERNEL_TABLE(
+            PixelDecoder::IMPL_SCALAR, "scalar", scalarU16, scalarU16Scaled,
+            scalarOOI2K, scalarU32, false);
+#ifdef SEABREEZE_DECODER_SSE2
+    const KernelTable sse2Kernels = SEABREEZE_KERNEL_TABLE(
+            PixelDecoder::IMPL_SSE2, "sse2", sse2U16, sse2U16Scaled,
+            sse2OOI2K, sse2U32, true);
+#endif
+#ifdef SEABREEZE_DECODER_AVX2
+    const KernelTable avx2Kernels = SEABREEZE_KERNEL_TABLE(
+            PixelDecoder::IMPL_AVX2, "avx2", avx2U16, avx2U16Scaled,
+            avx2OOI2K, avx2U32, true);
+#endif
+
+    const KernelTable *findKernels(PixelDecoder::Implementation impl) {
+        switch(impl) {
+        case PixelDecoder::IMPL_SCALAR:
+            return &scalarKernels;
+#ifdef SEABREEZE_DECODER_SSE2
+        case PixelDecoder::IMPL_SSE2:
+            return &sse2Kernels;
+#endif
+#ifdef SEABREEZE_DECODER_AVX2
+        case PixelDecoder::IMPL_AVX2:
+            return cpuSupportsAVX2() ? &avx2Kernels : NULL;
+#endif
+        case PixelDecoder::IMPL_AUTO: {
+            static const PixelDecoder::Implementation preferred[] = {
+                PixelDecoder::IMPL_AVX2, PixelDecoder::IMPL_SSE2
+            };
+            unsigned int i;
+            for(i = 0; i < sizeof(preferred) / sizeof(preferred[0]); i++) {
+                const KernelTable *table = findKernels(preferred[i]);
+                if(NULL != table) {
+                    return table;
+                }
+            }
+            return &scalarKernels;
+        }
+        default:
+            return NULL;
+        }
+    }
+
+    const KernelTable *defaultKernels() {
+        /* CPU detection runs once, on first use */
+        static const KernelTable *table = findKernels(PixelDecoder::IMPL_AUTO);
+        return table;
+    }
+
+    atomic<const KernelTable *> activeKernels(NULL);
+
+    inline const KernelTable *kernels() {
+        const KernelTable *table = activeKernels.load(memory_order_relaxed);
+        return (NULL != table) ? table : defaultKernels();
+    }
+}
+
+void PixelDecoder::decodeU16(const unsigned char *in, unsigned short xorMask,
+        unsigned short *out, unsigned int count) {
+    kernels()->u16ToU16(in, xorMask, out, count);
+}
+
+void PixelDecoder::decodeU16(const unsigned char *in, unsigned short xorMask,
+        double *out, unsigned int count) {
+    kernels()->u16ToDouble(in, xorMask, out, count);
+}
+
+void PixelDecoder::decodeU16(const unsigned char *in, unsigned short xorMask,
+        float *out, unsigned int count) {
+    kernels()->u16ToFloat(in, xorMask, out, count);
+}
+
+void PixelDecoder::decodeU16Scaled(const unsigned char *in,
+        unsigned short xorMask, double scale, double limit,
+        double *out, unsigned int count) {
+    kernels()->u16ScaledToDouble(in, xorMask, scale, limit, out, count);
+}
+
+void PixelDecoder::decodeU16Scaled(const unsigned char *in,
+        unsigned short xorMask, double scale, double limit,
+        float *out, unsigned int count) {
+    kernels()->u16ScaledToFloat(in, xorMask, scale, limit, out, count);
+}
+
+void PixelDecoder::decodeOOI2K(const unsigned char *in, unsigned short *out,
+        unsigned int count) {
+    kernels()->ooi2kToU16(in, out, count);
+}
+
+void PixelDecoder::decodeOOI2K(const unsigned char *in, double *out,
+        unsigned int count) {
+    kernels()->ooi2kToDouble(in, out, count);
+}
+
+void PixelDecoder::decodeOOI2K(const unsigned char *in, float *out,
+        unsigned int count) {
+    kernels()->ooi2kToFloat(in, out, count);
+}
+
+void PixelDecoder::decodeU32(const unsigned char *in, unsigned int *out,
+        unsigned int count) {
+    kernels()->u32ToU32(in, out, count);
+}
+
+void PixelDecoder::decodeU32(const unsigned char *in, double *out,
+        unsigned int count) {
+    kernels()->u32ToDouble(in, out, count);
+}
+
+void PixelDecoder::decodeU32(const unsigned char *in, float *out,
+        unsigned int count) {
+    kernels()->u32ToFloat(in, out, count);
+}
+
+void PixelDecoder::widen(const unsigned short *in, double *out, unsigned int count) {
+    const KernelTable *table = kernels();
+    if(true == table->hostOrderWiden) {
+        table->u16ToDouble((const unsigned char *)in, 0, out, count);
+    } else {
+        scalarWiden(in, out, count);
+    }
+}
+
+void PixelDecoder::widen(const unsigned short *in, float *out, unsigned int count) {
+    const KernelTable *table = kernels();
+    if(true == table->hostOrderWiden) {
+        table->u16ToFloat((const unsigned char *)in, 0, out, count);
+    } else {
+        scalarWiden(in, out, count);
+    }
+}
+
+void PixelDecoder::widen(const unsigned int *in, double *out, unsigned int count) {
+    const KernelTable *table = kernels();
+    if(true == table->hostOrderWiden) {
+        table->u32ToDouble((const unsigned char *)in, out, count);
+    } else {
+        scalarWiden(in, out, count);
+    }
+}
+
+void PixelDecoder::widen(const unsigned int *in, float *out, unsigned int count) {
+    const KernelTable *table = kernels();
+    if(true == table->hostOrderWiden) {
+        table->u32ToFloat((const unsigned char *)in, out, count);
+    } else {
+        scalarWiden(in, out, count);
+    }
+}
+
+bool PixelDecoder::setImplementation(Implementation impl) {
+    const KernelTable *table;
+
+    if(IMPL_AUTO == impl) {
+        activeKernels.store(NULL);
+        return true;
+    }
+
+    table = findKernels(impl);
+    if(NULL == table) {
+        return false;
+    }
+    activeKernels.store(table);
+    return true;
+}
+
+PixelDecoder::Implementation PixelDecoder::getImplementation() {
+    return kernels()->impl;
+}
+
+const char *PixelDecoder::getImplementationName() {
+    return kernels()->name;
+}
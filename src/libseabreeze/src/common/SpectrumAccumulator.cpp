@@ -0,0 +1,191 @@
+/***************************************************//**
+ * @file    SpectrumAccumulator.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This sums spectra on the host and reduces the sums to an
+ * averaged, boxcar-smoothed spectrum.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "common/SpectrumAccumulator.h"
+#include <algorithm>
+
+using namespace seabreeze;
+using namespace std;
+
+SpectrumAccumulator::SpectrumAccumulator() {
+    this->length = 0;
+    this->count = 0;
+    this->width = SUM_DOUBLE;
+}
+
+SpectrumAccumulator::~SpectrumAccumulator() {
+
+}
+
+void SpectrumAccumulator::reset(unsigned int length,
+        FormattedSpectrumTransferInterface::SampleType type,
+        unsigned int maxScans) {
+    unsigned long long maxSample;
+
+    this->length = length;
+    this->count = 0;
+
+    /* Use the narrowest sum that the largest possible total still fits in */
+    switch(type) {
+    case FormattedSpectrumTransferInterface::SAMPLE_UINT16:
+        maxSample = 0xFFFF;
+        break;
+    case FormattedSpectrumTransferInterface::SAMPLE_UINT32:
+        maxSample = 0xFFFFFFFFULL;
+        break;
+    default:
+        maxSample = 0;
+        break;
+    }
+
+    if(0 == maxSample) {
+        this->width = SUM_DOUBLE;
+        this->sumsDouble.assign(length, 0.0);
+    } else if(maxSample * (maxScans > 0 ? maxScans : 1) <= 0xFFFFFFFFULL) {
+        this->width = SUM_UINT32;
+        this->sums32.assign(length, 0);
+    } else {
+        this->width = SUM_UINT64;
+        this->sums64.assign(length, 0);
+    }
+}
+
+template <typename S, typename T>
+void SpectrumAccumulator::addInto(vector<S> &sums, const T *spectrum,
+        unsigned int length) {
+    /* A plain widening add over contiguous arrays, which compilers turn
+     * into SIMD without any help.
+     */
+    S *out = &sums[0];
+    for(unsigned int i = 0; i < length; i++) {
+        out[i] += (S) spectrum[i];
+    }
+}
+
+void SpectrumAccumulator::add(const unsigned short *spectrum) {
+    if(SUM_UINT32 == this->width) {
+        addInto(this->sums32, spectrum, this->length);
+    } else {
+        addInto(this->sums64, spectrum, this->length);
+    }
+    this->count++;
+}
+
+void SpectrumAccumulator::add(const unsigned int *spectrum) {
+    if(SUM_UINT32 == this->width) {
+        addInto(this->sums32, spectrum, this->length);
+    } else {
+        addInto(this->sums64, spectrum, this->length);
+    }
+    this->count++;
+}
+
+void SpectrumAccumulator::add(const float *spectrum) {
+    addInto(this->sumsDouble, spectrum, this->length);
+    this->count++;
+}
+
+void SpectrumAccumulator::add(const double *spectrum) {
+    addInto(this->sumsDouble, spectrum, this->length);
+    this->count++;
+}
+
+unsigned int SpectrumAccumulator::getLength() const {
+    return this->length;
+}
+
+unsigned int SpectrumAccumulator::getCount() const {
+    return this->count;
+}
+
+template <typename W, typename S, typename T>
+void SpectrumAccumulator::finishFrom(const vector<S> &sums,
+        unsigned int boxcarWidth, T *out) const {
+    unsigned int i;
+    unsigned int n = this->length;
+    double scans = (double) (this->count > 0 ? this->count : 1);
+
+    if(0 == n) {
+        return;
+    }
+
+    if(0 == boxcarWidth) {
+        double scale = 1.0 / scans;
+        for(i = 0; i < n; i++) {
+            out[i] = (T) ((double) sums[i] * scale);
+        }
+        return;
+    }
+
+    /* Slide a window [lo, hi) over the sums, adding the pixel that enters
+     * it and subtracting the one that leaves.  Integer sums keep the
+     * running total exact.
+     */
+    W window = 0;
+    unsigned int lo = 0;
+    unsigned int hi = 0;
+    for(i = 0; i < n; i++) {
+        unsigned int newHi = min(n, i + boxcarWidth + 1);
+        unsigned int newLo = (i > boxcarWidth) ? i - boxcarWidth : 0;
+        while(hi < newHi) {
+            window += (W) sums[hi++];
+        }
+        while(lo < newLo) {
+            window -= (W) sums[lo++];
+        }
+        out[i] = (T) ((double) window / (scans * (double) (hi - lo)));
+    }
+}
+
+template <typename T>
+void SpectrumAccumulator::finishInto(unsigned int boxcarWidth, T *out) const {
+    switch(this->width) {
+    case SUM_UINT32:
+        finishFrom<unsigned long long>(this->sums32, boxcarWidth, out);
+        break;
+    case SUM_UINT64:
+        finishFrom<unsigned long long>(this->sums64, boxcarWidth, out);
+        break;
+    default:
+        finishFrom<double>(this->sumsDouble, boxcarWidth, out);
+        break;
+    }
+}
+
+void SpectrumAccumulator::finish(unsigned int boxcarWidth, double *out) const {
+    finishInto(boxcarWidth, out);
+}
+
+void SpectrumAccumulator::finish(unsigned int boxcarWidth, float *out) const {
+    finishInto(boxcarWidth, out);
+}
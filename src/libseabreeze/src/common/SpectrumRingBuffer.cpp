@@ -0,0 +1,142 @@
+/***************************************************//**
+ * @file    SpectrumRingBuffer.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>     /* for memcpy() */
+#include "common/SpectrumRingBuffer.h"
+#include "common/exceptions/IllegalArgumentException.h"
+
+using namespace seabreeze;
+using namespace std;
+
+SpectrumRingBuffer::SpectrumRingBuffer(unsigned int depth,
+        unsigned int frameLength) : head(0), tail(0), committed(0),
+        dropped(0), overruns(0) {
+
+    if(0 == depth || 0 == frameLength) {
+        string error("Spectrum ring buffer depth and frame length must be nonzero");
+        throw IllegalArgumentException(error);
+    }
+
+    this->slots = depth + 1;
+    this->frameLength = frameLength;
+    this->frames.resize((size_t)this->slots * frameLength);
+    this->lengths.resize(this->slots);
+    this->timestamps.resize(this->slots);
+    this->overrunInProgress = false;
+}
+
+SpectrumRingBuffer::~SpectrumRingBuffer() {
+
+}
+
+double *SpectrumRingBuffer::getWriteFrame() {
+    unsigned int h = this->head.load(memory_order_relaxed);
+    return &this->frames[(size_t)h * this->frameLength];
+}
+
+bool SpectrumRingBuffer::commitWriteFrame(unsigned int length,
+        unsigned long long timestampMicros) {
+    unsigned int h = this->head.load(memory_order_relaxed);
+    unsigned int next = (h + 1) % this->slots;
+
+    if(next == this->tail.load(memory_order_acquire)) {
+        /* The consumer has not freed a slot; discard this frame and leave
+         * the write frame where it is for the next attempt.
+         */
+        this->dropped.fetch_add(1, memory_order_relaxed);
+        if(false == this->overrunInProgress) {
+            this->overruns.fetch_add(1, memory_order_relaxed);
+            this->overrunInProgress = true;
+        }
+        return false;
+    }
+
+    this->lengths[h] = (length < this->frameLength) ? length : this->frameLength;
+    this->timestamps[h] = timestampMicros;
+    this->overrunInProgress = false;
+    this->head.store(next, memory_order_release);
+    this->committed.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+unsigned int SpectrumRingBuffer::pop(double *buffer, unsigned int bufferLength,
+        unsigned long long *timestampMicros) {
+    unsigned int t = this->tail.load(memory_order_relaxed);
+    unsigned int copied;
+
+    if(t == this->head.load(memory_order_acquire)) {
+        return 0;
+    }
+
+    copied = (this->lengths[t] < bufferLength) ? this->lengths[t] : bufferLength;
+    memcpy(buffer, &this->frames[(size_t)t * this->frameLength],
+            copied * sizeof(double));
+    if(NULL != timestampMicros) {
+        *timestampMicros = this->timestamps[t];
+    }
+
+    this->tail.store((t + 1) % this->slots, memory_order_release);
+    return copied;
+}
+
+unsigned int SpectrumRingBuffer::getDepth() const {
+    return this->slots - 1;
+}
+
+unsigned int SpectrumRingBuffer::getFrameLength() const {
+    return this->frameLength;
+}
+
+unsigned int SpectrumRingBuffer::getAvailableFrames() const {
+    unsigned int h = this->head.load(memory_order_acquire);
+    unsigned int t = this->tail.load(memory_order_acquire);
+    return (h + this->slots - t) % this->slots;
+}
+
+unsigned long long SpectrumRingBuffer::getCommittedFrameCount() const {
+    return this->committed.load(memory_order_relaxed);
+}
+
+unsigned long long SpectrumRingBuffer::getDroppedFrameCount() const {
+    return this->dropped.load(memory_order_relaxed);
+}
+
+unsigned long long SpectrumRingBuffer::getOverrunCount() const {
+    return this->overruns.load(memory_order_relaxed);
+}
+
+void SpectrumRingBuffer::reset() {
+    this->head.store(0);
+    this->tail.store(0);
+    this->committed.store(0);
+    this->dropped.store(0);
+    this->overruns.store(0);
+    this->overrunInProgress = false;
+}
@@ -0,0 +1,252 @@
+/***************************************************//**
+ * @file    WavelengthResampler.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Implementation of the resampling onto a common wavelength grid.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "common/WavelengthResampler.h"
+#include "common/PixelDecoder.h"
+#include "common/exceptions/IllegalArgumentException.h"
+#include <algorithm>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define SEABREEZE_RESAMPLER_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+#endif
+
+using namespace seabreeze;
+using namespace std;
+
+namespace {
+
+    typedef void (*ResampleKernel)(const double *in, double *out,
+            const int *index, const double *weights, unsigned int taps,
+            unsigned int count);
+
+    /* Grid points [first, count).  The taps are summed in the same order
+     * as the vector kernel so that both give identical results.
+     */
+    void scalarResample(const double *in, double *out, const int *index,
+            const double *weights, unsigned int taps, unsigned int first,
+            unsigned int count) {
+        unsigned int k;
+        unsigned int t;
+        for(k = first; k < count; k++) {
+            const double *src = in + index[k];
+            double sum = weights[k] * src[0];
+            for(t = 1; t < taps; t++) {
+                sum += weights[(t * count) + k] * src[t];
+            }
+            out[k] = sum;
+        }
+    }
+
+    void scalarKernel(const double *in, double *out, const int *index,
+            const double *weights, unsigned int taps, unsigned int count) {
+        scalarResample(in, out, index, weights, taps, 0, count);
+    }
+
+#ifdef SEABREEZE_RESAMPLER_AVX2
+    /* Four grid points per vector, gathering each tap from the spectrum */
+    AVX2_TARGET void avx2Kernel(const double *in, double *out, const int *index,
+            const double *weights, unsigned int taps, unsigned int count) {
+        unsigned int k;
+        unsigned int t;
+        for(k = 0; k + 4 <= count; k += 4) {
+            __m128i idx = _mm_loadu_si128((const __m128i *)(index + k));
+            __m256d sum = _mm256_mul_pd(_mm256_loadu_pd(weights + k),
+                    _mm256_i32gather_pd(in, idx, 8));
+            for(t = 1; t < taps; t++) {
+                sum = _mm256_add_pd(sum, _mm256_mul_pd(
+                        _mm256_loadu_pd(weights + (t * count) + k),
+                        _mm256_i32gather_pd(in + t, idx, 8)));
+            }
+            _mm256_storeu_pd(out + k, sum);
+        }
+        scalarResample(in, out, index, weights, taps, k, count);
+    }
+#endif /* SEABREEZE_RESAMPLER_AVX2 */
+
+    /* Follows the kernel selection of the pixel decoder, so a forced
+     * implementation applies here as well.
+     */
+    ResampleKernel selectKernel() {
+#ifdef SEABREEZE_RESAMPLER_AVX2
+        if(PixelDecoder::IMPL_AVX2 == PixelDecoder::getImplementation()) {
+            return avx2Kernel;
+        }
+#endif
+        return scalarKernel;
+    }
+}
+
+WavelengthResampler::WavelengthResampler() {
+    this->sourceLength = 0;
+    this->gridLength = 0;
+    this->taps = 0;
+    this->method = METHOD_LINEAR;
+}
+
+WavelengthResampler::~WavelengthResampler() {
+
+}
+
+void WavelengthResampler::configure(const double *sourceWavelengths,
+        unsigned int sourceLength, const double *grid, unsigned int gridLength,
+        Method method) {
+
+    unsigned int i;
+    unsigned int k;
+
+    if(NULL == sourceWavelengths || sourceLength < 2) {
+        string error("At least two source wavelengths are required.");
+        throw IllegalArgumentException(error);
+    }
+    for(i = 1; i < sourceLength; i++) {
+        if(!(sourceWavelengths[i] > sourceWavelengths[i - 1])) {
+            string error("Source wavelengths must be strictly increasing.");
+            throw IllegalArgumentException(error);
+        }
+    }
+    if(NULL == grid && gridLength > 0) {
+        string error("No wavelength grid given.");
+        throw IllegalArgumentException(error);
+    }
+    if(METHOD_LINEAR != method && METHOD_CUBIC != method) {
+        string error("Unknown interpolation method.");
+        throw IllegalArgumentException(error);
+    }
+
+    const double *first = sourceWavelengths;
+    const double *last = sourceWavelengths + sourceLength;
+    /* Cubic interpolation needs four pixels; with fewer it is linear */
+    unsigned int taps = (METHOD_CUBIC == method && sourceLength >= 4) ? 4 : 2;
+
+    this->index.assign(gridLength, 0);
+    this->weights.assign(taps * gridLength, 0.0);
+
+    for(k = 0; k < gridLength; k++) {
+        double x = grid[k];
+        double *w = &this->weights[k];
+        unsigned int start;
+
+        if(x <= first[0]) {
+            start = 0;
+            w[0] = 1.0;
+        } else if(x >= last[-1]) {
+            start = sourceLength - taps;
+            w[(taps - 1) * gridLength] = 1.0;
+        } else {
+            /* Pixel i is the last one at or below x */
+            i = (unsigned int)(upper_bound(first, last, x) - first) - 1;
+            if(i > sourceLength - 2) {
+                i = sourceLength - 2;
+            }
+            if(2 == taps) {
+                start = i;
+                double t = (x - first[i]) / (first[i + 1] - first[i]);
+                w[0] = 1.0 - t;
+                w[gridLength] = t;
+            } else {
+                /* Centre the four pixels on the interval where possible */
+                start = (i > 0) ? i - 1 : 0;
+                if(start > sourceLength - 4) {
+                    start = sourceLength - 4;
+                }
+                const double *xs = first + start;
+                for(unsigned int j = 0; j < 4; j++) {
+                    double l = 1.0;
+                    for(unsigned int m = 0; m < 4; m++) {
+                        if(m != j) {
+                            l *= (x - xs[m]) / (xs[j] - xs[m]);
+                        }
+                    }
+                    w[j * gridLength] = l;
+                }
+            }
+        }
+        this->index[k] = (int)start;
+    }
+
+    this->sourceLength = sourceLength;
+    this->gridLength = gridLength;
+    this->taps = taps;
+    this->method = method;
+}
+
+void WavelengthResampler::clear() {
+    this->sourceLength = 0;
+    this->gridLength = 0;
+    this->taps = 0;
+    this->index.clear();
+    this->weights.clear();
+}
+
+bool WavelengthResampler::isConfigured() const {
+    return this->taps > 0;
+}
+
+unsigned int WavelengthResampler::getSourceLength() const {
+    return this->sourceLength;
+}
+
+unsigned int WavelengthResampler::getGridLength() const {
+    return this->gridLength;
+}
+
+WavelengthResampler::Method WavelengthResampler::getMethod() const {
+    return this->method;
+}
+
+void WavelengthResampler::apply(const double *spectrum, double *out) const {
+    apply(spectrum, 1, this->sourceLength, out, this->gridLength);
+}
+
+void WavelengthResampler::apply(const double *spectra, unsigned int count,
+        unsigned int inStride, double *out, unsigned int outStride) const {
+
+    if(0 == this->gridLength) {
+        return;
+    }
+
+    ResampleKernel kernel = selectKernel();
+    for(unsigned int row = 0; row < count; row++) {
+        kernel(spectra + ((size_t)row * inStride), out + ((size_t)row * outStride),
+                &this->index[0], &this->weights[0], this->taps, this->gridLength);
+    }
+}
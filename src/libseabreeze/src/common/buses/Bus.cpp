@@ -39,3 +39,11 @@ Bus::Bus() {
 Bus::~Bus() {
 
 }
+
+bool Bus::setTransferTimeout(unsigned int /* timeoutMillis */) {
+    return false;
+}
+
+bool Bus::cancelTransfers() {
+    return false;
+}
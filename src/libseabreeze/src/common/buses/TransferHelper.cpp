@@ -39,3 +39,11 @@ TransferHelper::TransferHelper() {
 TransferHelper::~TransferHelper() {
 
 }
+
+bool TransferHelper::canQueueRequests() const {
+    return false;
+}
+
+bool TransferHelper::setTimeout(unsigned int /* timeoutMillis */) {
+    return false;
+}
@@ -93,3 +93,8 @@ int TCPIPv4SocketTransferHelper::send(const vector<unsigned char> &buffer,
     }
     return written;
 }
+
+bool TCPIPv4SocketTransferHelper::canQueueRequests() const {
+    /* The socket buffers requests until the device reads them */
+    return true;
+}
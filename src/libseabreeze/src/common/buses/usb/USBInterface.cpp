@@ -63,3 +63,10 @@ BusFamily USBInterface::getBusFamily() const {
     USBBusFamily family;
     return family;
 }
+
+bool USBInterface::cancelTransfers() {
+    if(NULL == this->usb) {
+        return false;
+    }
+    return this->usb->cancelTransfers();
+}
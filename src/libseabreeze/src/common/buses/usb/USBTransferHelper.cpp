@@ -29,6 +29,8 @@
 
 #include "common/globals.h"
 #include "common/buses/usb/USBTransferHelper.h"
+#include "common/exceptions/BusTimeoutException.h"
+#include "native/usb/NativeUSB.h"
 #include <string>
 
 using namespace seabreeze;
@@ -39,10 +41,12 @@ USBTransferHelper::USBTransferHelper(USB *usbDescriptor, int sendEndpoint,
     this->usb = usbDescriptor;
     this->sendEndpoint = sendEndpoint;
     this->receiveEndpoint = receiveEndpoint;
+    this->timeoutMillis = 0;
 }
 
 USBTransferHelper::USBTransferHelper(USB *usbDescriptor) : TransferHelper() {
     this->usb = usbDescriptor;
+    this->timeoutMillis = 0;
 }
 
 USBTransferHelper::~USBTransferHelper() {
@@ -52,11 +56,12 @@ USBTransferHelper::~USBTransferHelper() {
 int USBTransferHelper::receive(vector<unsigned char> &buffer, unsigned int length) {
     int retval = 0;
 
-    retval = this->usb->read(this->receiveEndpoint, (void *)&(buffer[0]), length);
+    retval = this->usb->read(this->receiveEndpoint, (void *)&(buffer[0]), length,
+            this->timeoutMillis);
 
     if((0 == retval && length > 0) || (retval < 0)) {
         string error("Failed to read any data from USB.");
-        throw BusTransferException(error);
+        throwTransferError(retval, error);
     }
 
     return retval;
@@ -65,12 +70,33 @@ int USBTransferHelper::receive(vector<unsigned char> &buffer, unsigned int lengt
 int USBTransferHelper::send(const vector<unsigned char> &buffer, unsigned int length) const {
     int retval = 0;
 
-    retval = this->usb->write(this->sendEndpoint, (void *)&(buffer[0]), length);
+    retval = this->usb->write(this->sendEndpoint, (void *)&(buffer[0]), length,
+            this->timeoutMillis);
 
     if((0 == retval && length > 0) || (retval < 0)) {
         string error("Failed to write any data to USB.");
-        throw BusTransferException(error);
+        throwTransferError(retval, error);
     }
 
     return retval;
 }
+
+bool USBTransferHelper::canQueueRequests() const {
+    /* Bulk OUT transfers are held off by the device until it can take them */
+    return true;
+}
+
+bool USBTransferHelper::setTimeout(unsigned int timeoutMillis) {
+    this->timeoutMillis = timeoutMillis;
+    return true;
+}
+
+void USBTransferHelper::throwTransferError(int result, const string &error) const {
+    if(TRANSFER_TIMEOUT == result) {
+        throw BusTimeoutException(error + " (timed out)");
+    }
+    if(TRANSFER_CANCELLED == result) {
+        throw BusTimeoutException(error + " (cancelled)");
+    }
+    throw BusTransferException(error);
+}
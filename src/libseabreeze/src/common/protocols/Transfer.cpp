@@ -30,6 +30,8 @@
 #include "common/globals.h"
 #include "common/protocols/Transfer.h"
 #include "common/ByteVector.h"
+#include "common/exceptions/BusTimeoutException.h"
+#include "common/exceptions/ProtocolTimeoutException.h"
 #include <string>
 
 #ifdef _WINDOWS
@@ -79,6 +81,8 @@ Data *Transfer::transfer(TransferHelper *helper) {
             if(((unsigned int)flag) != this->length) {
                 /* FIXME: retry, throw exception, something here */
             }
+        } catch (BusTimeoutException &bte) {
+            throw ProtocolTimeoutException(bte.what());
         } catch (BusException &be) {
             string error("Failed to write to bus.");
             /* FIXME: previous exception should probably be bundled up into the new exception */
@@ -87,17 +91,7 @@ Data *Transfer::transfer(TransferHelper *helper) {
         }
         return NULL;
     } else if(Transfer::FROM_DEVICE == this->direction) {
-        try {
-            flag = helper->receive(*(this->buffer), this->length);
-            if(((unsigned int)flag) != this->length) {
-                /* FIXME: retry, throw exception, something here */
-            }
-        } catch (BusException &be) {
-            string error("Failed to write to bus.");
-            /* FIXME: previous exception should probably be bundled up into the new exception */
-            /* FIXME: there is probably a more descriptive type for this than ProtocolException */
-            throw ProtocolException(error);
-        }
+        receiveIntoBuffer(helper);
 
         /* A copy is made of the data before it is sent out for two
          * reasons.  First, this provides safety from the recipient
@@ -118,6 +112,28 @@ Data *Transfer::transfer(TransferHelper *helper) {
     return NULL;
 }
 
+void Transfer::receiveIntoBuffer(TransferHelper *helper) {
+    int flag = 0;
+
+    /* Read from the bus directly into this object's buffer.  Derived classes
+     * that decode the result themselves can call this instead of transfer()
+     * to avoid the defensive copy that transfer() hands back.
+     */
+    try {
+        flag = helper->receive(*(this->buffer), this->length);
+        if(((unsigned int)flag) != this->length) {
+            /* FIXME: retry, throw exception, something here */
+        }
+    } catch (BusTimeoutException &bte) {
+        throw ProtocolTimeoutException(bte.what());
+    } catch (BusException &be) {
+        string error("Failed to read from bus.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        /* FIXME: there is probably a more descriptive type for this than ProtocolException */
+        throw ProtocolException(error);
+    }
+}
+
 void Transfer::checkBufferSize() {
     if(this->buffer->size() < this->length) {
         this->buffer->resize(this->length);
@@ -37,6 +37,7 @@ using namespace seabreeze;
 using namespace std;
 
 bool seabreeze::USB::verbose = false;
+int seabreeze::USB::defaultReadQueueDepth = 4;
 
 USB::USB(unsigned long id) {
     this->opened = false;
@@ -104,6 +105,11 @@ bool USB::close() {
 }
 
 int USB::write(int endpoint, void *data, unsigned int length_bytes) {
+    return write(endpoint, data, length_bytes, 0);
+}
+
+int USB::write(int endpoint, void *data, unsigned int length_bytes,
+        unsigned int timeoutMillis) {
 
     int flag = 0;
 
@@ -120,7 +126,8 @@ int USB::write(int endpoint, void *data, unsigned int length_bytes) {
         return -1;
     }
 
-    flag = USBWrite(this->descriptor, (unsigned char)endpoint, (char *)data, (int)length_bytes);
+    flag = USBWriteTimeout(this->descriptor, (unsigned char)endpoint, (char *)data,
+            (int)length_bytes, timeoutMillis);
 
     if(flag < 0) {
         /* FIXME: throw an exception here */
@@ -128,6 +135,9 @@ int USB::write(int endpoint, void *data, unsigned int length_bytes) {
             fprintf(stderr, "Warning: got error %d while trying to write %d bytes over USB endpoint %d\n",
                     flag, length_bytes, endpoint);
         }
+        if(TRANSFER_TIMEOUT == flag || TRANSFER_CANCELLED == flag) {
+            return flag;
+        }
         return -1;
     }
 
@@ -139,6 +149,11 @@ int USB::write(int endpoint, void *data, unsigned int length_bytes) {
 }
 
 int USB::read(int endpoint, void *data, unsigned int length_bytes) {
+    return read(endpoint, data, length_bytes, 0);
+}
+
+int USB::read(int endpoint, void *data, unsigned int length_bytes,
+        unsigned int timeoutMillis) {
     int flag = 0;
 
     if(true == this->verbose) {
@@ -153,7 +168,8 @@ int USB::read(int endpoint, void *data, unsigned int length_bytes) {
         return -1;
     }
 
-    flag = USBRead(this->descriptor, (unsigned char)endpoint, (char *)data, (int)length_bytes);
+    flag = USBReadTimeout(this->descriptor, (unsigned char)endpoint, (char *)data,
+            (int)length_bytes, timeoutMillis);
 
     if(flag < 0) {
         /* FIXME: throw an exception here */
@@ -161,6 +177,9 @@ int USB::read(int endpoint, void *data, unsigned int length_bytes) {
             fprintf(stderr, "Warning: got error %d while trying to read %d bytes over USB endpoint %d\n",
                     flag, length_bytes, endpoint);
         }
+        if(TRANSFER_TIMEOUT == flag || TRANSFER_CANCELLED == flag) {
+            return flag;
+        }
         return -1;
     }
 
@@ -184,10 +203,46 @@ void USB::clearStall(int endpoint) {
     USBClearStall(this->descriptor, (unsigned char)endpoint);
 }
 
+bool USB::setReadQueueDepth(int endpoint, int depth) {
+
+    if(NULL == this->descriptor || false == this->opened) {
+        if(true == this->verbose) {
+            fprintf(stderr, "ERROR: tried to access a USB device that is not opened.\n");
+        }
+        return false;
+    }
+
+    if(0 != USBSetReadQueue(this->descriptor, (unsigned char)endpoint, depth)) {
+        if(true == this->verbose) {
+            fprintf(stderr, "Reads on USB endpoint 0x%02X will not be queued\n", endpoint);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool USB::cancelTransfers() {
+
+    if(NULL == this->descriptor || false == this->opened) {
+        return false;
+    }
+
+    return 0 == USBCancel(this->descriptor);
+}
+
 void USB::setVerbose(bool v) {
     verbose = v;
 }
 
+void USB::setDefaultReadQueueDepth(int depth) {
+    defaultReadQueueDepth = depth;
+}
+
+int USB::getDefaultReadQueueDepth() {
+    return defaultReadQueueDepth;
+}
+
 int USB::getDeviceDescriptor(struct USBDeviceDescriptor *desc) {
 
     if(NULL == this->descriptor || false == this->opened) {
@@ -72,6 +72,56 @@ vector<unsigned long> *USBDiscovery::probeDevices(int vendorID, int productID) {
     return retval;
 }
 
+vector<unsigned long> *USBDiscovery::probeDevices(const vector<int> &vendorIDs,
+        const vector<int> &productIDs, vector<int> &matches) {
+    int deviceCount;
+    unsigned long *deviceList;
+    int *matchList;
+    vector<unsigned long> *retval;
+    int i;
+
+    matches.clear();
+    if(vendorIDs.empty() || vendorIDs.size() != productIDs.size()) {
+        return new vector<unsigned long>();
+    }
+
+    deviceList = (unsigned long *)calloc(__MAX_USB_DEVICES, sizeof(unsigned long));
+    matchList = (int *)calloc(__MAX_USB_DEVICES, sizeof(int));
+
+    deviceCount = USBProbeDeviceTable(&vendorIDs[0], &productIDs[0],
+        (int) vendorIDs.size(), deviceList, matchList, __MAX_USB_DEVICES);
+
+    if(deviceCount < 0) {
+        /* This masks an error, but the effect is to return an empty vector */
+        deviceCount = 0;
+    }
+
+    retval = new vector<unsigned long>(deviceList, deviceList + deviceCount);
+    for(i = 0; i < deviceCount; i++) {
+        matches.push_back(matchList[i]);
+    }
+
+    free(matchList);
+    free(deviceList);
+
+    return retval;
+}
+
+bool USBDiscovery::startHotplug(const vector<int> &vendorIDs,
+        const vector<int> &productIDs, USBHotplugCallback callback,
+        void *context) {
+    if(vendorIDs.empty() || vendorIDs.size() != productIDs.size()) {
+        return false;
+    }
+
+    return 0 == USBHotplugStart(&vendorIDs[0], &productIDs[0],
+        (int) vendorIDs.size(), callback, context);
+}
+
+void USBDiscovery::stopHotplug() {
+    USBHotplugStop();
+}
+
 USB *USBDiscovery::createUSBInterface(unsigned long deviceID) {
     /* Create a USB instance with the given deviceID.  This constructor for
      * USB is protected, so this class uses a friend relationship to get
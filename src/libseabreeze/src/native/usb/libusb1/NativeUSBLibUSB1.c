@@ -0,0 +1,1495 @@
+/***************************************************//**
+ * @file    NativeUSBLibUSB1.c
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is an implementation of the USB interface using
+ * the libusb-1.0 API.  Writes and most reads are done
+ * synchronously as in the libusb-0.1 implementation, but
+ * bulk IN endpoints that carry spectra may be given a
+ * queue of asynchronous transfers that stay submitted
+ * between reads so that the host is always ready to
+ * accept the next packets from the device.  Every
+ * transfer can be given a timeout and aborted from
+ * another thread with USBCancel().
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <libusb.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include "native/usb/NativeUSB.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+
+/* Definitions and macros */
+#define MAX_USB_DEVICES             127
+#define MAX_ENDPOINTS               16
+#define MAX_READ_QUEUE_DEPTH        16
+#define MAX_ACTIVE_TRANSFERS        8  /* Synchronous transfers per device */
+#define BULK_TIMEOUT                0 /* milliseconds, 0 waits indefinitely */
+#define MAX_HOTPLUG_EVENTS          (2 * MAX_USB_DEVICES)
+#define HOTPLUG_POLL_MILLIS         100
+
+/* struct definitions */
+/* One asynchronous transfer in a read queue.  The completed flag is set by
+ * the libusb callback and consumed by whichever thread is reading from the
+ * queue, so it is only ever tested while libusb is handling events.
+ */
+typedef struct {
+    struct libusb_transfer *transfer;
+    unsigned char *buffer;
+    int bufferSize;
+    int completed;  /* Set when libusb has finished with the transfer */
+    int submitted;  /* Whether the transfer belongs to libusb right now */
+    int offset;     /* Bytes of a completed transfer already returned */
+} __read_transfer_t;
+
+/* A ring of transfers that are kept submitted on one bulk IN endpoint.
+ * Transfers complete in the order they were submitted, so the head of the
+ * ring always holds the next bytes that the device sent.
+ */
+typedef struct {
+    unsigned char endpoint;
+    int depth;
+    int maxPacketSize;
+    int transferSize;   /* Length of every queued transfer, 0 if not primed */
+    int head;           /* Index of the oldest outstanding transfer */
+    __read_transfer_t slots[MAX_READ_QUEUE_DEPTH];
+} __read_queue_t;
+
+typedef struct {
+    long deviceID;  /* Unique ID for device.  Assigned by this driver */
+    libusb_device_handle *dev;
+    int interface;
+    __read_queue_t *queues[MAX_ENDPOINTS];  /* Indexed by endpoint number */
+    /* The lock guards submission and cancellation of transfers, and the
+     * count of calls in progress that USBClose() waits to drain.
+     */
+    pthread_mutex_t lock;
+    pthread_cond_t idle;
+    int inflight;
+    int closing;
+    struct libusb_transfer *active[MAX_ACTIVE_TRANSFERS];
+} __usb_interface_t;
+
+typedef struct {
+    long deviceID;  /* Unique ID for device.  Assigned by this driver. */
+    __usb_interface_t *handle;    /* Pointer to USB interface instance */
+    unsigned char bus_number;
+    unsigned char device_address; /* Unique on the bus until unplugged */
+    unsigned short vendorID;
+    unsigned short productID;
+    unsigned char valid;    /* Whether this struct is valid */
+    unsigned char mark;     /* Used to determine if device is still present */
+    unsigned char removed;  /* Detached while open; freed by USBClose() */
+} __device_instance_t;
+
+/* A hotplug event as libusb reported it.  These are queued by the libusb
+ * callback, which may run in any thread that handles events, and applied
+ * to the device cache by the hotplug thread.
+ */
+typedef struct {
+    int event;
+    unsigned char bus_number;
+    unsigned char device_address;
+    unsigned short vendorID;
+    unsigned short productID;
+} __hotplug_event_t;
+
+
+/* Global variables (mostly static lookup tables) */
+static __device_instance_t __enumerated_devices[MAX_USB_DEVICES] = { { 0 } };
+static int __enumerated_device_count = 0;   /* To keep linear searches short */
+static long __last_assigned_deviceID = 0;   /* To keep device IDs unique */
+
+/**
+ * The libusb context that all devices are opened in.  This is created on
+ * the first call to USBProbeDeviceTable() and then kept for the life of the
+ * process, much like usb_init() was for libusb-0.1.
+ */
+static libusb_context *__context = NULL;
+
+/* Guards __enumerated_devices, since the hotplug thread updates it while
+ * other threads probe, open and close devices.  This is never held while
+ * libusb handles events.
+ */
+static pthread_mutex_t __device_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* State of the watcher started by USBHotplugStart().  Only the pending
+ * events are shared with the libusb callback, under their own lock.
+ */
+static pthread_t __hotplug_thread;
+static int __hotplug_running = 0;
+static libusb_hotplug_callback_handle __hotplug_handle;
+static USBHotplugCallback __hotplug_callback = NULL;
+static void *__hotplug_context = NULL;
+static int *__hotplug_vendorIDs = NULL;
+static int *__hotplug_productIDs = NULL;
+static int __hotplug_num_ids = 0;
+static pthread_mutex_t __hotplug_lock = PTHREAD_MUTEX_INITIALIZER;
+static __hotplug_event_t __hotplug_pending[MAX_HOTPLUG_EVENTS];
+static int __hotplug_pending_count = 0;
+
+/* Function prototypes */
+static __device_instance_t *__lookup_device_instance_by_ID(long deviceID);
+static __device_instance_t *__lookup_device_instance_by_location(
+        unsigned char bus_number, unsigned char device_address);
+static __device_instance_t *__add_device_instance(unsigned char bus_number,
+        unsigned char device_address, int vendorID, int productID);
+static int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids);
+static void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids);
+static int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices);
+static void __remove_device_instance(__device_instance_t *device);
+static void __close_and_dealloc_usb_interface(__usb_interface_t *usb);
+static int __init_context(void);
+static int LIBUSB_CALL __hotplug_callback_fn(libusb_context *context,
+        libusb_device *device, libusb_hotplug_event event, void *user_data);
+static void __dispatch_hotplug_events(void);
+static void *__hotplug_thread_fn(void *arg);
+static int __begin_transfer(__usb_interface_t *usb);
+static void __end_transfer(__usb_interface_t *usb);
+static void __cancel_all_transfers(__usb_interface_t *usb);
+static long long __now_millis(void);
+static int __wait_for_completion(int *completed, long long deadline);
+static void LIBUSB_CALL __sync_transfer_callback(struct libusb_transfer *transfer);
+static int __bulk_transfer(__usb_interface_t *usb, unsigned char endpoint,
+        char *data, int numberOfBytes, unsigned int timeoutMillis);
+static void LIBUSB_CALL __read_transfer_callback(struct libusb_transfer *transfer);
+static int __submit_read_transfer(__usb_interface_t *usb, __read_transfer_t *slot);
+static int __prime_read_queue(__usb_interface_t *usb, __read_queue_t *queue,
+        int transferSize);
+static int __cancel_read_queue(__read_queue_t *queue, char *data, int numberOfBytes,
+        int *ended);
+static void __free_read_queue(__read_queue_t *queue);
+static int __queued_read(__usb_interface_t *usb, __read_queue_t *queue,
+        char *data, int numberOfBytes, unsigned int timeoutMillis);
+
+static __device_instance_t *__lookup_device_instance_by_ID(long deviceID) {
+    int i;
+    int valid;
+    /* The __enumerated_device_count is used to end the search once it is
+     * known that there are no more devices to be found.
+     */
+    for(    i = 0, valid = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count;
+            i++) {
+        if(0 != __enumerated_devices[i].valid) {
+            if(__enumerated_devices[i].deviceID == deviceID) {
+                return &(__enumerated_devices[i]);
+            }
+            valid++;
+        }
+    }
+    return NULL;
+}
+
+static __device_instance_t *__lookup_device_instance_by_location(
+        unsigned char bus_number, unsigned char device_address) {
+    int i;
+    int valid;
+
+    for(    i = 0, valid = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count;
+            i++) {
+        if(0 != __enumerated_devices[i].valid) {
+            if(        __enumerated_devices[i].bus_number == bus_number
+                    && __enumerated_devices[i].device_address == device_address
+                    && 0 == __enumerated_devices[i].removed) {
+                return &(__enumerated_devices[i]);
+            }
+            valid++;
+        }
+    }
+    return NULL;
+}
+
+static __device_instance_t *__add_device_instance(unsigned char bus_number,
+        unsigned char device_address, int vendorID, int productID) {
+    int i;
+
+    /* First need to find an empty slot to store this device descriptor */
+    for(i = 0; i < MAX_USB_DEVICES; i++) {
+        if(0 == __enumerated_devices[i].valid) {
+            /* Found an empty slot */
+            __enumerated_devices[i].valid = 1;
+            __enumerated_devices[i].bus_number = bus_number;
+            __enumerated_devices[i].device_address = device_address;
+            __enumerated_devices[i].deviceID = __last_assigned_deviceID++;
+            __enumerated_devices[i].vendorID = vendorID;
+            __enumerated_devices[i].productID = productID;
+            __enumerated_device_count++;
+            return &(__enumerated_devices[i]);
+        }
+    }
+    return NULL;
+}
+
+/* Returns the index of the given VID and PID in a table of VID/PID pairs,
+ * or -1 if the pair is not in the table.
+ */
+static int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids) {
+    int i;
+
+    for(i = 0; i < num_ids; i++) {
+        if(vendorIDs[i] == vendorID && productIDs[i] == productID) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids) {
+    int new_count = 0;
+    int valid = 0;
+    int i;
+    __device_instance_t *device;
+
+    for(i = 0; i < MAX_USB_DEVICES && valid < __enumerated_device_count; i++) {
+        device = &(__enumerated_devices[i]);
+        if(0 == device->valid) {
+            continue;
+        }
+        valid++;
+
+        /* Only devices of the types that were just probed can be purged */
+        if(0 == device->mark
+                && __match_device_table(device->vendorID, device->productID,
+                        vendorIDs, productIDs, num_ids) >= 0) {
+            if(NULL != device->handle) {
+                /* Clean up the device since it seems to have been disconnected */
+                __close_and_dealloc_usb_interface(device->handle);
+            }
+            memset(&__enumerated_devices[i], (int)0, sizeof(__device_instance_t));
+        } else {
+            __enumerated_devices[i].mark = 0;
+            new_count++;
+        }
+    }
+    __enumerated_device_count = new_count;
+}
+
+/* Wipes a single device from the cache.  It must not be open. */
+static void __remove_device_instance(__device_instance_t *device) {
+    memset(device, (int)0, sizeof(__device_instance_t));
+    __enumerated_device_count--;
+}
+
+/* Copies the IDs of all cached devices that match the table of VID/PID pairs
+ * into output, along with the index of the pair each one matched.  Returns
+ * the number of IDs copied.
+ */
+static int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices) {
+    int i;
+    int index;
+    int valid;
+    int found;
+
+    for(    i = 0, valid = 0, found = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count
+                && found < max_devices;
+            i++) {
+        if(0 == __enumerated_devices[i].valid) {
+            continue;
+        }
+        valid++;
+
+        index = __match_device_table(__enumerated_devices[i].vendorID,
+                __enumerated_devices[i].productID, vendorIDs, productIDs, num_ids);
+        if(index < 0) {
+            continue;
+        }
+        output[found] = __enumerated_devices[i].deviceID;
+        if(NULL != matches) {
+            matches[found] = index;
+        }
+        found++;
+    }
+
+    return found;
+}
+
+/* This will attempt to free up all resources associated with an open
+ * USB descriptor.  This also deallocates the provided pointer.
+ */
+static void __close_and_dealloc_usb_interface(__usb_interface_t *usb) {
+    int i;
+
+    if(NULL == usb) {
+        return;
+    }
+
+    /* Outstanding transfers must be reaped before the handle goes away */
+    for(i = 0; i < MAX_ENDPOINTS; i++) {
+        if(NULL != usb->queues[i]) {
+            __cancel_read_queue(usb->queues[i], NULL, 0, NULL);
+            __free_read_queue(usb->queues[i]);
+            usb->queues[i] = NULL;
+        }
+    }
+
+    if(NULL != usb->dev) {
+        libusb_release_interface(usb->dev, usb->interface);
+
+        /* As with the libusb-0.1 implementation, resetting the device on close
+         * avoids needing to replug a spectrometer before it can be reopened.
+         */
+        libusb_reset_device(usb->dev);
+
+        libusb_close(usb->dev);
+    }
+
+    pthread_cond_destroy(&usb->idle);
+    pthread_mutex_destroy(&usb->lock);
+    free(usb);
+}
+
+/* Every read and write is bracketed by these so that USBClose() can wait for
+ * calls that are still unwinding after it cancelled their transfers.
+ */
+static int __begin_transfer(__usb_interface_t *usb) {
+    int retval = 0;
+
+    pthread_mutex_lock(&usb->lock);
+    if(0 != usb->closing) {
+        retval = -1;
+    } else {
+        usb->inflight++;
+    }
+    pthread_mutex_unlock(&usb->lock);
+    return retval;
+}
+
+static void __end_transfer(__usb_interface_t *usb) {
+    pthread_mutex_lock(&usb->lock);
+    usb->inflight--;
+    if(0 == usb->inflight) {
+        pthread_cond_broadcast(&usb->idle);
+    }
+    pthread_mutex_unlock(&usb->lock);
+}
+
+/* The caller must hold usb->lock.  Cancelled transfers complete with
+ * LIBUSB_TRANSFER_CANCELLED in whichever thread is waiting on them.
+ */
+static void __cancel_all_transfers(__usb_interface_t *usb) {
+    int i;
+    int j;
+    __read_queue_t *queue;
+
+    for(i = 0; i < MAX_ACTIVE_TRANSFERS; i++) {
+        if(NULL != usb->active[i]) {
+            libusb_cancel_transfer(usb->active[i]);
+        }
+    }
+
+    for(i = 0; i < MAX_ENDPOINTS; i++) {
+        queue = usb->queues[i];
+        if(NULL == queue) {
+            continue;
+        }
+        for(j = 0; j < queue->depth; j++) {
+            if(0 != queue->slots[j].submitted && 0 == queue->slots[j].completed) {
+                libusb_cancel_transfer(queue->slots[j].transfer);
+            }
+        }
+    }
+}
+
+static long long __now_millis(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/* Handles libusb events until *completed is set.  The deadline is in
+ * __now_millis() time, or 0 to wait indefinitely.  Returns 0 once the flag
+ * is set, TRANSFER_TIMEOUT if the deadline passed first, or READ_FAILED.
+ */
+static int __wait_for_completion(int *completed, long long deadline) {
+    struct timeval tv;
+    long long remaining;
+    int flag;
+
+    while(0 == *completed) {
+        if(0 == deadline) {
+            flag = libusb_handle_events_completed(__context, completed);
+        } else {
+            remaining = deadline - __now_millis();
+            if(remaining <= 0) {
+                return TRANSFER_TIMEOUT;
+            }
+            tv.tv_sec = (long)(remaining / 1000);
+            tv.tv_usec = (long)(remaining % 1000) * 1000;
+            flag = libusb_handle_events_timeout_completed(__context, &tv, completed);
+        }
+        if(flag < 0 && LIBUSB_ERROR_INTERRUPTED != flag) {
+            return READ_FAILED;
+        }
+    }
+    return 0;
+}
+
+static void LIBUSB_CALL __sync_transfer_callback(struct libusb_transfer *transfer) {
+    *((int *)transfer->user_data) = 1;
+}
+
+/* Performs one bulk transfer in either direction and waits for it.  This is
+ * what libusb_bulk_transfer() does, except that the transfer is listed in
+ * usb->active while it is outstanding so that USBCancel() can abort it.
+ * Returns the number of bytes transferred or a negative NativeUSB code.
+ */
+static int __bulk_transfer(__usb_interface_t *usb, unsigned char endpoint,
+        char *data, int numberOfBytes, unsigned int timeoutMillis) {
+    struct libusb_transfer *transfer;
+    int completed = 0;
+    int index = -1;
+    int retval;
+    int i;
+
+    transfer = libusb_alloc_transfer(0);
+    if(NULL == transfer) {
+        return -1;
+    }
+    libusb_fill_bulk_transfer(transfer, usb->dev, endpoint, (unsigned char *)data,
+            numberOfBytes, __sync_transfer_callback, &completed, timeoutMillis);
+
+    pthread_mutex_lock(&usb->lock);
+    for(i = 0; i < MAX_ACTIVE_TRANSFERS; i++) {
+        if(NULL == usb->active[i]) {
+            usb->active[i] = transfer;
+            index = i;
+            break;
+        }
+    }
+    retval = libusb_submit_transfer(transfer);
+    if(0 != retval && index >= 0) {
+        usb->active[index] = NULL;
+    }
+    pthread_mutex_unlock(&usb->lock);
+
+    if(0 != retval) {
+        libusb_free_transfer(transfer);
+        return -1;
+    }
+
+    while(0 != __wait_for_completion(&completed, 0)) {
+        /* Events could not be handled, so give up on the transfer but keep
+         * going until libusb has let go of it.
+         */
+        libusb_cancel_transfer(transfer);
+    }
+
+    pthread_mutex_lock(&usb->lock);
+    if(index >= 0) {
+        usb->active[index] = NULL;
+    }
+    pthread_mutex_unlock(&usb->lock);
+
+    switch(transfer->status) {
+        case LIBUSB_TRANSFER_COMPLETED:
+            retval = transfer->actual_length;
+            break;
+        case LIBUSB_TRANSFER_TIMED_OUT:
+            retval = TRANSFER_TIMEOUT;
+            break;
+        case LIBUSB_TRANSFER_CANCELLED:
+            retval = TRANSFER_CANCELLED;
+            break;
+        default:
+            retval = -1;
+            break;
+    }
+    libusb_free_transfer(transfer);
+    return retval;
+}
+
+static void LIBUSB_CALL __read_transfer_callback(struct libusb_transfer *transfer) {
+    __read_transfer_t *slot = (__read_transfer_t *)transfer->user_data;
+
+    slot->completed = 1;
+}
+
+/* Queued transfers are submitted under the lock so that USBCancel() either
+ * sees them as submitted or runs before they are.
+ */
+static int __submit_read_transfer(__usb_interface_t *usb, __read_transfer_t *slot) {
+    int flag;
+
+    pthread_mutex_lock(&usb->lock);
+    flag = libusb_submit_transfer(slot->transfer);
+    if(0 == flag) {
+        slot->submitted = 1;
+    }
+    pthread_mutex_unlock(&usb->lock);
+    return flag;
+}
+
+/* Submits every transfer in the queue with the given length.  The queue must
+ * not have any transfers outstanding.  Returns 0 on success.
+ */
+static int __prime_read_queue(__usb_interface_t *usb, __read_queue_t *queue,
+        int transferSize) {
+    int i;
+    __read_transfer_t *slot;
+    unsigned char *buffer;
+
+    for(i = 0; i < queue->depth; i++) {
+        slot = &(queue->slots[i]);
+        if(slot->bufferSize < transferSize) {
+            buffer = (unsigned char *)realloc(slot->buffer, transferSize);
+            if(NULL == buffer) {
+                __cancel_read_queue(queue, NULL, 0, NULL);
+                return -1;
+            }
+            slot->buffer = buffer;
+            slot->bufferSize = transferSize;
+        }
+        libusb_fill_bulk_transfer(slot->transfer, usb->dev, queue->endpoint,
+                slot->buffer, transferSize, __read_transfer_callback, slot,
+                BULK_TIMEOUT);
+        slot->completed = 0;
+        slot->offset = 0;
+        if(0 != __submit_read_transfer(usb, slot)) {
+            __cancel_read_queue(queue, NULL, 0, NULL);
+            return -1;
+        }
+    }
+
+    queue->transferSize = transferSize;
+    queue->head = 0;
+    return 0;
+}
+
+/* Cancels any outstanding transfers and waits for libusb to give them back.
+ * Data that had already arrived is copied into data (if not NULL) in the
+ * order that the device sent it, up to numberOfBytes or the end of the first
+ * short transfer, in which case ended is set.  Returns the number of bytes
+ * copied.  The queue is left unprimed.
+ */
+static int __cancel_read_queue(__read_queue_t *queue, char *data, int numberOfBytes,
+        int *ended) {
+    int i;
+    int index;
+    int length;
+    int copied = 0;
+    __read_transfer_t *slot;
+
+    for(i = 0; i < queue->depth; i++) {
+        slot = &(queue->slots[i]);
+        if(0 != slot->submitted && 0 == slot->completed) {
+            libusb_cancel_transfer(slot->transfer);
+        }
+    }
+
+    for(i = 0; i < queue->depth; i++) {
+        index = (queue->head + i) % queue->depth;
+        slot = &(queue->slots[index]);
+        if(0 == slot->submitted) {
+            continue;
+        }
+        while(0 == slot->completed) {
+            if(libusb_handle_events_completed(__context, &(slot->completed)) < 0) {
+                break;
+            }
+        }
+        slot->submitted = 0;
+
+        if(NULL == data || 0 == slot->completed || 0 != *ended
+                || LIBUSB_TRANSFER_ERROR == slot->transfer->status
+                || LIBUSB_TRANSFER_NO_DEVICE == slot->transfer->status) {
+            continue;
+        }
+        length = slot->transfer->actual_length - slot->offset;
+        if(length > numberOfBytes - copied) {
+            length = numberOfBytes - copied;
+        }
+        if(length > 0) {
+            memcpy(&data[copied], &(slot->buffer[slot->offset]), length);
+            copied += length;
+        }
+        if(LIBUSB_TRANSFER_COMPLETED == slot->transfer->status
+                && slot->transfer->actual_length < slot->transfer->length
+                && copied > 0) {
+            /* The message ended here; anything later is not part of it */
+            *ended = 1;
+        }
+    }
+
+    queue->transferSize = 0;
+    queue->head = 0;
+    return copied;
+}
+
+static void __free_read_queue(__read_queue_t *queue) {
+    int i;
+
+    for(i = 0; i < queue->depth; i++) {
+        if(NULL != queue->slots[i].transfer) {
+            libusb_free_transfer(queue->slots[i].transfer);
+        }
+        free(queue->slots[i].buffer);
+    }
+    free(queue);
+}
+
+/* Reads from a queued endpoint.  Like a synchronous bulk read, this returns
+ * once numberOfBytes have been read or the device ends a transfer with a
+ * short packet.  A completed transfer is resubmitted as soon as its data has
+ * been consumed so that the device never waits on the host.  The queued
+ * transfers themselves never time out; the timeout applies to this call.
+ */
+static int __queued_read(__usb_interface_t *usb, __read_queue_t *queue,
+        char *data, int numberOfBytes, unsigned int timeoutMillis) {
+    long long deadline = 0;
+    int flag;
+    int collected = 0;
+    int wanted;
+    int length;
+    int shortTransfer;
+    int ended = 0;
+    __read_transfer_t *slot;
+    struct libusb_transfer *transfer;
+
+    if(timeoutMillis > 0) {
+        deadline = __now_millis() + timeoutMillis;
+    }
+
+    while(collected < numberOfBytes) {
+        /* Transfers are sized to the message plus any padding to a full
+         * packet, since the device may pad its last packet.
+         */
+        wanted = numberOfBytes - collected;
+        wanted = ((wanted + queue->maxPacketSize - 1) / queue->maxPacketSize)
+                * queue->maxPacketSize;
+
+        slot = &(queue->slots[queue->head]);
+        if(0 != queue->transferSize && 0 == slot->completed
+                && wanted != queue->transferSize) {
+            /* Nothing is waiting in the queue and the caller now expects a
+             * message of a different size, so the queue has to be resized.
+             * The device may already be part way through sending, so keep
+             * anything that the cancelled transfers received.
+             */
+            collected += __cancel_read_queue(queue, &data[collected],
+                    numberOfBytes - collected, &ended);
+            if(0 != ended) {
+                break;
+            }
+            continue;
+        }
+
+        if(0 == queue->transferSize) {
+            if(0 != __prime_read_queue(usb, queue, wanted)) {
+                return READ_FAILED;
+            }
+            slot = &(queue->slots[queue->head]);
+        }
+
+        flag = __wait_for_completion(&(slot->completed), deadline);
+        if(0 != flag) {
+            /* Whatever arrives later belongs to a message nobody will read */
+            __cancel_read_queue(queue, NULL, 0, NULL);
+            return flag;
+        }
+
+        transfer = slot->transfer;
+        if(LIBUSB_TRANSFER_COMPLETED != transfer->status) {
+            flag = (LIBUSB_TRANSFER_CANCELLED == transfer->status)
+                    ? TRANSFER_CANCELLED : READ_FAILED;
+            __cancel_read_queue(queue, NULL, 0, NULL);
+            return flag;
+        }
+
+        length = transfer->actual_length - slot->offset;
+        if(length > numberOfBytes - collected) {
+            length = numberOfBytes - collected;
+        }
+        memcpy(&data[collected], &(slot->buffer[slot->offset]), length);
+        collected += length;
+        slot->offset += length;
+
+        if(slot->offset < transfer->actual_length) {
+            /* The caller asked for less than the device sent; the rest will
+             * be returned by the next read.
+             */
+            break;
+        }
+
+        /* All of this transfer has been consumed, so give it back to libusb */
+        shortTransfer = transfer->actual_length < transfer->length;
+        slot->completed = 0;
+        slot->offset = 0;
+        slot->submitted = 0;
+        if(0 != __submit_read_transfer(usb, slot)) {
+            __cancel_read_queue(queue, NULL, 0, NULL);
+            return (collected > 0) ? collected : READ_FAILED;
+        }
+        queue->head = (queue->head + 1) % queue->depth;
+
+        if(0 != shortTransfer && collected > 0) {
+            /* A short packet marks the end of the message */
+            break;
+        }
+    }
+
+    return collected;
+}
+
+/* Creates the libusb context if it does not exist yet.  Returns 0 on success. */
+static int __init_context(void) {
+    if(NULL == __context) {
+        if(0 != libusb_init(&__context)) {
+            __context = NULL;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Called by libusb from whichever thread is handling events, which may be
+ * one that is waiting for a transfer.  This only queues the event so that
+ * no locks are taken and nothing calls back into libusb from here.
+ */
+static int LIBUSB_CALL __hotplug_callback_fn(libusb_context *context,
+        libusb_device *device, libusb_hotplug_event event, void *user_data) {
+    struct libusb_device_descriptor dd;
+    __hotplug_event_t *pending;
+
+    if(0 != libusb_get_device_descriptor(device, &dd)) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&__hotplug_lock);
+    if(__hotplug_pending_count < MAX_HOTPLUG_EVENTS) {
+        pending = &(__hotplug_pending[__hotplug_pending_count++]);
+        pending->event = (LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED == event)
+                ? USB_HOTPLUG_ARRIVED : USB_HOTPLUG_LEFT;
+        pending->bus_number = libusb_get_bus_number(device);
+        pending->device_address = libusb_get_device_address(device);
+        pending->vendorID = dd.idVendor;
+        pending->productID = dd.idProduct;
+    }
+    pthread_mutex_unlock(&__hotplug_lock);
+
+    /* Returning 0 keeps this callback registered */
+    return 0;
+}
+
+/* Applies the queued hotplug events to the device cache and reports the ones
+ * that match the table to the USBHotplugStart() callback.
+ */
+static void __dispatch_hotplug_events(void) {
+    __hotplug_event_t events[MAX_HOTPLUG_EVENTS];
+    __hotplug_event_t *e;
+    __device_instance_t *instance;
+    long deviceID;
+    int count;
+    int match;
+    int i;
+
+    pthread_mutex_lock(&__hotplug_lock);
+    count = __hotplug_pending_count;
+    memcpy(events, __hotplug_pending, count * sizeof(__hotplug_event_t));
+    __hotplug_pending_count = 0;
+    pthread_mutex_unlock(&__hotplug_lock);
+
+    for(i = 0; i < count; i++) {
+        e = &(events[i]);
+        match = __match_device_table(e->vendorID, e->productID,
+                __hotplug_vendorIDs, __hotplug_productIDs, __hotplug_num_ids);
+        if(match < 0) {
+            continue;
+        }
+
+        pthread_mutex_lock(&__device_lock);
+        instance = __lookup_device_instance_by_location(e->bus_number,
+                e->device_address);
+        deviceID = -1;
+        if(USB_HOTPLUG_ARRIVED == e->event) {
+            if(NULL == instance) {
+                instance = __add_device_instance(e->bus_number,
+                        e->device_address, e->vendorID, e->productID);
+            }
+            if(NULL != instance) {
+                deviceID = instance->deviceID;
+            }
+        } else if(NULL != instance) {
+            deviceID = instance->deviceID;
+            if(NULL == instance->handle) {
+                __remove_device_instance(instance);
+            } else {
+                /* Still open, so USBClose() will free it */
+                instance->removed = 1;
+            }
+        }
+        pthread_mutex_unlock(&__device_lock);
+
+        if(deviceID >= 0) {
+            __hotplug_callback(e->event, deviceID, match, __hotplug_context);
+        }
+    }
+}
+
+/* Handles libusb events, which delivers hotplug events even while no
+ * transfers are in progress, and dispatches the ones that were queued.
+ */
+static void *__hotplug_thread_fn(void *arg) {
+    struct timeval tv;
+    int running = 1;
+
+    while(0 != running) {
+        tv.tv_sec = 0;
+        tv.tv_usec = HOTPLUG_POLL_MILLIS * 1000;
+        libusb_handle_events_timeout_completed(__context, &tv, NULL);
+        __dispatch_hotplug_events();
+
+        pthread_mutex_lock(&__hotplug_lock);
+        running = __hotplug_running;
+        pthread_mutex_unlock(&__hotplug_lock);
+    }
+    return NULL;
+}
+
+int
+USBProbeDevices(int vendorID, int productID, unsigned long *output,
+        int max_devices) {
+
+    return USBProbeDeviceTable(&vendorID, &productID, 1, output, NULL,
+            max_devices);
+}
+
+int
+USBProbeDeviceTable(const int *vendorIDs, const int *productIDs, int num_ids,
+        unsigned long *output, int *matches, int max_devices) {
+
+    /* Local variables */
+    libusb_device **list = NULL;
+    struct libusb_device_descriptor dd;
+    __device_instance_t *instance;
+    ssize_t count;
+    ssize_t d;
+
+    /* This function is the entry point into the API, so the context is
+     * created here if it does not exist yet.
+     */
+    if(0 != __init_context()) {
+        return -1;
+    }
+
+    count = libusb_get_device_list(__context, &list);
+    if(count < 0) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&__device_lock);
+    for(d = 0; d < count; d++) {
+        if(0 != libusb_get_device_descriptor(list[d], &dd)) {
+            continue;
+        }
+        if(__match_device_table(dd.idVendor, dd.idProduct,
+                vendorIDs, productIDs, num_ids) < 0) {
+            continue;
+        }
+
+        /* Got a matching device node.  Determine if this is
+         * already in the cache.
+         */
+        instance = __lookup_device_instance_by_location(
+                libusb_get_bus_number(list[d]), libusb_get_device_address(list[d]));
+        if(NULL != instance) {
+            /* Device is already known, so mark it and keep going */
+            instance->mark = 1;
+            continue;
+        }
+
+        instance = __add_device_instance(libusb_get_bus_number(list[d]),
+                libusb_get_device_address(list[d]), dd.idVendor, dd.idProduct);
+        if(NULL == instance) {
+            /* Could not add the device -- this should not be possible,
+             * so bail out.
+             */
+            pthread_mutex_unlock(&__device_lock);
+            libusb_free_device_list(list, 1);
+            return -1;
+        }
+        instance->mark = 1;     /* Preserve this since it was just seen */
+    }
+
+    /* Purge any devices that are cached but that no longer exist. */
+    __purge_unmarked_device_instances(vendorIDs, productIDs, num_ids);
+
+    count = __list_device_instances(vendorIDs, productIDs, num_ids,
+            output, matches, max_devices);
+    pthread_mutex_unlock(&__device_lock);
+
+    libusb_free_device_list(list, 1);
+
+    return (int) count;
+}
+
+int
+USBHotplugStart(const int *vendorIDs, const int *productIDs, int num_ids,
+        USBHotplugCallback callback, void *context) {
+    int flag;
+
+    if(NULL == callback || num_ids <= 0 || 0 != __hotplug_running) {
+        return -1;
+    }
+
+    if(0 != __init_context() || 0 == libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG)) {
+        return -1;
+    }
+
+    __hotplug_vendorIDs = (int *)malloc(num_ids * sizeof(int));
+    __hotplug_productIDs = (int *)malloc(num_ids * sizeof(int));
+    if(NULL == __hotplug_vendorIDs || NULL == __hotplug_productIDs) {
+        goto error;
+    }
+    memcpy(__hotplug_vendorIDs, vendorIDs, num_ids * sizeof(int));
+    memcpy(__hotplug_productIDs, productIDs, num_ids * sizeof(int));
+    __hotplug_num_ids = num_ids;
+    __hotplug_callback = callback;
+    __hotplug_context = context;
+
+    pthread_mutex_lock(&__hotplug_lock);
+    __hotplug_pending_count = 0;
+    pthread_mutex_unlock(&__hotplug_lock);
+
+    /* Every device is watched and the table is checked when the events are
+     * dispatched, since libusb can only filter on a single VID and PID.
+     * Devices that are already attached are queued during registration.
+     */
+    flag = libusb_hotplug_register_callback(__context,
+            LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT,
+            LIBUSB_HOTPLUG_ENUMERATE, LIBUSB_HOTPLUG_MATCH_ANY,
+            LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+            __hotplug_callback_fn, NULL, &__hotplug_handle);
+    if(0 != flag) {
+        goto error;
+    }
+
+    /* Report the devices that are already attached before returning */
+    __dispatch_hotplug_events();
+
+    __hotplug_running = 1;
+    if(0 != pthread_create(&__hotplug_thread, NULL, __hotplug_thread_fn, NULL)) {
+        __hotplug_running = 0;
+        libusb_hotplug_deregister_callback(__context, __hotplug_handle);
+        goto error;
+    }
+
+    return 0;
+
+error:
+    free(__hotplug_vendorIDs);
+    free(__hotplug_productIDs);
+    __hotplug_vendorIDs = NULL;
+    __hotplug_productIDs = NULL;
+    __hotplug_num_ids = 0;
+    __hotplug_callback = NULL;
+    return -1;
+}
+
+void
+USBHotplugStop(void) {
+    if(0 == __hotplug_running) {
+        return;
+    }
+
+    pthread_mutex_lock(&__hotplug_lock);
+    __hotplug_running = 0;
+    pthread_mutex_unlock(&__hotplug_lock);
+    libusb_hotplug_deregister_callback(__context, __hotplug_handle);
+
+    /* Only the hotplug thread calls back, so once it has exited the
+     * callback will not be called again.
+     */
+    pthread_join(__hotplug_thread, NULL);
+
+    free(__hotplug_vendorIDs);
+    free(__hotplug_productIDs);
+    __hotplug_vendorIDs = NULL;
+    __hotplug_productIDs = NULL;
+    __hotplug_num_ids = 0;
+    __hotplug_callback = NULL;
+    __hotplug_context = NULL;
+}
+
+void *
+USBOpen(unsigned long deviceID, int *errorCode) {
+    // Local variables
+    libusb_device **list = NULL;
+    libusb_device *device = NULL;
+    libusb_device_handle *deviceHandle = NULL;
+    struct libusb_config_descriptor *config = NULL;
+    __usb_interface_t *retval;
+    __device_instance_t *instance;
+    unsigned char bus_number;
+    unsigned char device_address;
+    ssize_t count;
+    ssize_t d;
+    int interface = 0;
+    int claim_err;
+
+    /* Set a default error code in case a premature return is required */
+    SET_ERROR_CODE(NO_DEVICE_FOUND);
+
+    pthread_mutex_lock(&__device_lock);
+    instance = __lookup_device_instance_by_ID(deviceID);
+    if(NULL == instance || NULL == __context || 0 != instance->removed) {
+        /* The caller must only provide IDs that have previously been
+         * provided by the USBProbeDevices() function.
+         */
+        pthread_mutex_unlock(&__device_lock);
+        return 0;
+    }
+
+    if(NULL != instance->handle) {
+        /* It is illegal to try to open a device twice without first closing it. */
+        pthread_mutex_unlock(&__device_lock);
+        return 0;
+    }
+    bus_number = instance->bus_number;
+    device_address = instance->device_address;
+    pthread_mutex_unlock(&__device_lock);
+
+    count = libusb_get_device_list(__context, &list);
+    if(count < 0) {
+        return 0;
+    }
+
+    for(d = 0; d < count; d++) {
+        if(libusb_get_bus_number(list[d]) == bus_number
+                && libusb_get_device_address(list[d]) == device_address) {
+            device = list[d];
+            break;
+        }
+    }
+
+    if(NULL == device || 0 != libusb_open(device, &deviceHandle)) {
+        /* Could not find or open device */
+        libusb_free_device_list(list, 1);
+        return 0;
+    }
+
+    if(0 == libusb_get_active_config_descriptor(device, &config)) {
+        interface = config->interface->altsetting->bInterfaceNumber;
+        libusb_free_config_descriptor(config);
+    }
+    libusb_free_device_list(list, 1);
+
+    claim_err = libusb_claim_interface(deviceHandle, interface);
+    if(claim_err != 0) {
+        /* Could not claim interface */
+        if(claim_err != LIBUSB_ERROR_BUSY) {
+            fprintf(stderr, "libusb_claim_interface() returned %d - did you copy "
+                           "os-support/linux/10-oceanoptics.rules to /etc/udev/rules.d?\n",
+                           claim_err);
+        }
+        libusb_close(deviceHandle);
+        return 0;
+    }
+
+    retval = (__usb_interface_t *)calloc(sizeof(__usb_interface_t), 1);
+    if(NULL == retval) {
+        libusb_release_interface(deviceHandle, interface);
+        libusb_close(deviceHandle);
+        /* Could not allocate memory */
+        SET_ERROR_CODE(CLAIM_INTERFACE_FAILED);
+        return 0;
+    }
+    pthread_mutex_init(&retval->lock, NULL);
+    pthread_cond_init(&retval->idle, NULL);
+    retval->dev = deviceHandle;
+    retval->interface = interface;
+    retval->deviceID = deviceID;
+
+    /* The device may have been detached or opened by another thread while
+     * the lock was released.
+     */
+    pthread_mutex_lock(&__device_lock);
+    instance = __lookup_device_instance_by_ID(deviceID);
+    if(NULL == instance || NULL != instance->handle || 0 != instance->removed) {
+        pthread_mutex_unlock(&__device_lock);
+        __close_and_dealloc_usb_interface(retval);
+        return 0;
+    }
+    instance->handle = retval;
+    pthread_mutex_unlock(&__device_lock);
+
+    SET_ERROR_CODE(OPEN_OK);
+    return (void *)retval;
+}
+
+int
+USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes) {
+    return USBWriteTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBWriteTimeout(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes,
+        unsigned int timeoutMillis) {
+    /* Local variables */
+    int bytesWritten;
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle) {
+        return WRITE_FAILED;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != __begin_transfer(usb)) {
+        return WRITE_FAILED;
+    }
+    bytesWritten = __bulk_transfer(usb, endpoint, data, numberOfBytes, timeoutMillis);
+    __end_transfer(usb);
+
+    if(0 == bytesWritten && 0 != numberOfBytes) {
+        return WRITE_FAILED;
+    }
+    return bytesWritten;
+}
+
+int
+USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes) {
+    return USBReadTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBReadTimeout(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes,
+        unsigned int timeoutMillis) {
+    /* Local variables */
+    int bytesRead;
+    __usb_interface_t *usb;
+    __read_queue_t *queue;
+
+    if(0 == deviceHandle) {
+        return READ_FAILED;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != __begin_transfer(usb)) {
+        return READ_FAILED;
+    }
+    queue = usb->queues[endpoint & 0x0F];
+    if(NULL != queue && numberOfBytes > 0) {
+        bytesRead = __queued_read(usb, queue, data, numberOfBytes, timeoutMillis);
+    } else {
+        bytesRead = __bulk_transfer(usb, endpoint, data, numberOfBytes, timeoutMillis);
+    }
+    __end_transfer(usb);
+
+    if(0 == bytesRead && 0 != numberOfBytes) {
+        return READ_FAILED;
+    }
+    return bytesRead;
+}
+
+int
+USBSetReadQueue(void *deviceHandle, unsigned char endpoint, int depth) {
+    __usb_interface_t *usb;
+    __read_queue_t *queue;
+    int maxPacketSize;
+    int i;
+
+    if(0 == deviceHandle || 0 == (endpoint & 0x80)) {
+        return -1;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    /* Any existing queue is discarded, along with data it had received */
+    pthread_mutex_lock(&usb->lock);
+    queue = usb->queues[endpoint & 0x0F];
+    usb->queues[endpoint & 0x0F] = NULL;
+    pthread_mutex_unlock(&usb->lock);
+    if(NULL != queue) {
+        __cancel_read_queue(queue, NULL, 0, NULL);
+        __free_read_queue(queue);
+    }
+
+    if(depth <= 0) {
+        return 0;
+    }
+    if(depth > MAX_READ_QUEUE_DEPTH) {
+        depth = MAX_READ_QUEUE_DEPTH;
+    }
+
+    maxPacketSize = libusb_get_max_packet_size(libusb_get_device(usb->dev), endpoint);
+    if(maxPacketSize <= 0) {
+        return -1;
+    }
+
+    queue = (__read_queue_t *)calloc(sizeof(__read_queue_t), 1);
+    if(NULL == queue) {
+        return -1;
+    }
+    queue->endpoint = endpoint;
+    queue->depth = depth;
+    queue->maxPacketSize = maxPacketSize;
+
+    for(i = 0; i < depth; i++) {
+        queue->slots[i].transfer = libusb_alloc_transfer(0);
+        if(NULL == queue->slots[i].transfer) {
+            __free_read_queue(queue);
+            return -1;
+        }
+    }
+
+    /* Transfers are only submitted by the first read, once the size of the
+     * messages on this endpoint is known.
+     */
+    pthread_mutex_lock(&usb->lock);
+    usb->queues[endpoint & 0x0F] = queue;
+    pthread_mutex_unlock(&usb->lock);
+    return 0;
+}
+
+int
+USBCancel(void *deviceHandle) {
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle) {
+        return -1;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    pthread_mutex_lock(&usb->lock);
+    __cancel_all_transfers(usb);
+    pthread_mutex_unlock(&usb->lock);
+    return 0;
+}
+
+int
+USBClose(void *deviceHandle) {
+    /* Local variables */
+    __usb_interface_t *usb;
+    __device_instance_t *device;
+
+    if(NULL == deviceHandle) {
+        return CLOSE_ERROR;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    /* Reads and writes blocked in other threads are aborted, and the handle
+     * is only freed once they have returned.
+     */
+    pthread_mutex_lock(&usb->lock);
+    usb->closing = 1;
+    __cancel_all_transfers(usb);
+    while(usb->inflight > 0) {
+        pthread_cond_wait(&usb->idle, &usb->lock);
+    }
+    pthread_mutex_unlock(&usb->lock);
+
+    pthread_mutex_lock(&__device_lock);
+    device = __lookup_device_instance_by_ID(usb->deviceID);
+    if(NULL != device) {
+        /* This had an extra reference to the handle so free it up */
+        device->handle = NULL;
+        if(0 != device->removed) {
+            /* The device was detached while it was open */
+            __remove_device_instance(device);
+        }
+    }
+    pthread_mutex_unlock(&__device_lock);
+
+    __close_and_dealloc_usb_interface(usb);
+    return CLOSE_OK;
+}
+
+void USBClearStall(void *deviceHandle, unsigned char endpoint) {
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle) {
+        return;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    /* Queued transfers cannot survive the halt being cleared, and whatever
+     * they held belongs to the exchange that stalled.
+     */
+    if(NULL != usb->queues[endpoint & 0x0F]
+            && endpoint == usb->queues[endpoint & 0x0F]->endpoint) {
+        __cancel_read_queue(usb->queues[endpoint & 0x0F], NULL, 0, NULL);
+    }
+
+    libusb_clear_halt(usb->dev, endpoint);
+}
+
+int
+USBGetDeviceDescriptor(void *deviceHandle, struct USBDeviceDescriptor *desc) {
+    struct libusb_device_descriptor dd;
+    __usb_interface_t *usb;
+
+    if(0 == desc) {
+        return -1;
+    }
+
+    if(0 == deviceHandle) {
+        return -2;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != libusb_get_device_descriptor(libusb_get_device(usb->dev), &dd)) {
+        return -2;
+    }
+
+    desc->bLength = dd.bLength;
+    desc->bDescriptorType = dd.bDescriptorType;
+    desc->bcdUSB = dd.bcdUSB;
+    desc->bDeviceClass = dd.bDeviceClass;
+    desc->bDeviceSubClass = dd.bDeviceSubClass;
+    desc->bDeviceProtocol = dd.bDeviceProtocol;
+    desc->bMaxPacketSize0 = dd.bMaxPacketSize0;
+    desc->idVendor = dd.idVendor;
+    desc->idProduct = dd.idProduct;
+    desc->bcdDevice = dd.bcdDevice;
+    desc->iManufacturer = dd.iManufacturer;
+    desc->iProduct = dd.iProduct;
+    desc->iSerialNumber = dd.iSerialNumber;
+    desc->bNumConfigurations = dd.bNumConfigurations;
+
+    return 0;
+}
+
+int
+USBGetInterfaceDescriptor(void *deviceHandle, struct USBInterfaceDescriptor *desc) {
+    struct libusb_config_descriptor *config;
+    const struct libusb_interface_descriptor *id;
+    __usb_interface_t *usb;
+
+    if(0 == desc) {
+        return -1;
+    }
+
+    if(0 == deviceHandle) {
+        return -2;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != libusb_get_active_config_descriptor(libusb_get_device(usb->dev), &config)) {
+        return -2;
+    }
+
+    /* FIXME: are there more than one altsetting that should be reachable? */
+    id = config->interface->altsetting;
+    desc->bLength = id->bLength;
+    desc->bDescriptorType = id->bDescriptorType;
+    desc->bInterfaceNumber = id->bInterfaceNumber;
+    desc->bAlternateSetting = id->bAlternateSetting;
+    desc->bNumEndpoints = id->bNumEndpoints;
+    desc->bInterfaceClass = id->bInterfaceClass;
+    desc->bInterfaceSubClass = id->bInterfaceSubClass;
+    desc->bInterfaceProtocol = id->bInterfaceProtocol;
+    desc->iInterface = id->iInterface;
+
+    libusb_free_config_descriptor(config);
+    return 0;
+}
+
+
+int
+USBGetEndpointDescriptor(void *deviceHandle, int endpoint_index,
+        struct USBEndpointDescriptor *desc) {
+    struct libusb_config_descriptor *config;
+    const struct libusb_endpoint_descriptor *ed;
+    __usb_interface_t *usb;
+
+    if(0 == desc) {
+        return -1;
+    }
+
+    if(0 == deviceHandle) {
+        return -2;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != libusb_get_active_config_descriptor(libusb_get_device(usb->dev), &config)) {
+        return -2;
+    }
+
+    if(endpoint_index < 0 || endpoint_index >= config->interface->altsetting->bNumEndpoints) {
+        libusb_free_config_descriptor(config);
+        return -1;
+    }
+
+    /* FIXME: Deal with alternate endpoints or interfaces? */
+    ed = &(config->interface->altsetting->endpoint[endpoint_index]);
+
+    desc->bLength = ed->bLength;
+    desc->bDescriptorType = ed->bDescriptorType;
+    desc->bEndpointAddress = ed->bEndpointAddress;
+    desc->bmAttributes = ed->bmAttributes;
+    desc->wMaxPacketSize = ed->wMaxPacketSize;
+    desc->bInterval = ed->bInterval;
+
+    libusb_free_config_descriptor(config);
+    return 0;
+}
+
+
+int
+USBGetStringDescriptor(void *deviceHandle, unsigned int string_index,
+        char *buffer, int maxLength) {
+    /* Local variables */
+    int length = 0;
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle || 0 == buffer) {
+        /* Invalid device handle or buffer */
+        return 0;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    /* Obtain the string and return it */
+    length = libusb_get_string_descriptor_ascii(usb->dev, (uint8_t)string_index,
+            (unsigned char *)buffer, maxLength);
+    if(length <= 0) {
+        buffer[0] = '\0';
+    }
+
+    return length;
+}
@@ -41,7 +41,7 @@
 
 /* Definitions and macros */
 #define MAX_USB_DEVICES             127
-#define BULK_TIMEOUT                1000000000 /* milliseconds */
+#define BULK_TIMEOUT                1000000000 /* milliseconds, used for "no timeout" */
 /* Tell gcc not to warn about a particular
  * variable being unused.  This is useful for function
  * parameters that are required by an interface prototype, but not
@@ -88,7 +88,12 @@ static __device_instance_t *__lookup_device_instance_by_location(const char *bus
 static __device_instance_t *__add_device_instance(const char *bus_location,
                                            const char *device_location,
                                            int vendorID, int productID);
-static void __purge_unmarked_device_instances(int vendorID, int productID);
+static int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids);
+static void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids);
+static int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices);
 static void __close_and_dealloc_usb_interface(__usb_interface_t *usb);
 static int __probe_devices(void);
 
@@ -164,7 +169,23 @@ static __device_instance_t *__add_device_instance(const char *bus_location,
     return NULL;
 }
 
-static void __purge_unmarked_device_instances(int vendorID, int productID) {
+/* Returns the index of the given VID and PID in a table of VID/PID pairs,
+ * or -1 if the pair is not in the table.
+ */
+static int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids) {
+    int i;
+
+    for(i = 0; i < num_ids; i++) {
+        if(vendorIDs[i] == vendorID && productIDs[i] == productID) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids) {
     int new_count = 0;
     int valid = 0;
     int i;
@@ -179,14 +200,14 @@ static void __purge_unmarked_device_instances(int vendorID, int productID) {
         valid++;
 
         /* Now check whether it was marked as still being present.  Note that
-         * this search is limited just to the type of device that was being
+         * this search is limited just to the types of device that were being
          * probed when this call was made -- otherwise, any devices that were
          * not being probed for just now would be unmarked and would be
          * discarded.
          */
         if(0 == device->mark
-                && (vendorID == device->vendorID)
-                && (productID == device->productID)) {
+                && __match_device_table(device->vendorID, device->productID,
+                        vendorIDs, productIDs, num_ids) >= 0) {
             /* Not marked, so it needs to be purged */
             if(NULL != device->handle) {
                 /* Clean up the device since it seems to have been disconnected */
@@ -204,6 +225,41 @@ static void __purge_unmarked_device_instances(int vendorID, int productID) {
     __enumerated_device_count = new_count;
 }
 
+/* Copies the IDs of all cached devices that match the table of VID/PID pairs
+ * into output, along with the index of the pair each one matched.  Returns
+ * the number of IDs copied.
+ */
+static int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices) {
+    int i;
+    int index;
+    int valid;
+    int found;
+
+    for(    i = 0, valid = 0, found = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count
+                && found < max_devices;
+            i++) {
+        if(0 == __enumerated_devices[i].valid) {
+            continue;
+        }
+        valid++;
+
+        index = __match_device_table(__enumerated_devices[i].vendorID,
+                __enumerated_devices[i].productID, vendorIDs, productIDs, num_ids);
+        if(index < 0) {
+            continue;
+        }
+        output[found] = __enumerated_devices[i].deviceID;
+        if(NULL != matches) {
+            matches[found] = index;
+        }
+        found++;
+    }
+
+    return found;
+}
+
 
 /* This will attempt to free up all resources associated with an open
  * USB descriptor.  This also deallocates the provided pointer.
@@ -254,13 +310,18 @@ int
 USBProbeDevices(int vendorID, int productID, unsigned long *output,
         int max_devices) {
 
+    return USBProbeDeviceTable(&vendorID, &productID, 1, output, NULL,
+            max_devices);
+}
+
+int
+USBProbeDeviceTable(const int *vendorIDs, const int *productIDs, int num_ids,
+        unsigned long *output, int *matches, int max_devices) {
+
     /* Local variables */
     struct usb_bus *bus = NULL;       /* Temp variable to iterate over buses */
     struct usb_device *device = NULL; /* Temp variable to iterate over devices */
     __device_instance_t *instance;
-    int i;
-    int matched = 0;
-    int valid = 0;
 
     /* Check if usb_init() has been called since it must be called before
      * anything else happens.  This will be checked here, but not in any of
@@ -274,11 +335,11 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
 
     /* Update the tree of known devices.  This does not really care if the state
      * has changed since the last call (i.e. the return value is ignored) since
-     * the change may not be relevant to the particular VID/PID that this is
-     * looking for this time, and there is a good chance that this function will
-     * be called again in just a moment for another VID/PID.  If this skipped
-     * the update because it detected no change, then probing for one VID/PID
-     * would cause a subsequent one to be skipped incorrectly.
+     * the change may not be relevant to the particular VID/PIDs that this is
+     * looking for this time, and the caller may probe for other VID/PIDs in a
+     * moment.  If this skipped the update because it detected no change, then
+     * probing for one set of VID/PIDs would cause a subsequent one to be
+     * skipped incorrectly.
      */
     __probe_devices();
 
@@ -288,8 +349,9 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
      */
     for(bus = usb_get_busses(); bus; bus = bus->next) {
         for(device = bus->devices; device; device = device->next) {
-            if(   (device->descriptor.idVendor == vendorID) &&
-                  (device->descriptor.idProduct == productID)) {
+            if(__match_device_table(device->descriptor.idVendor,
+                    device->descriptor.idProduct,
+                    vendorIDs, productIDs, num_ids) >= 0) {
                 /* Got a matching device node.  Determine if this is
                  * already in the cache.
                  */
@@ -302,12 +364,13 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
                 }
 
                 /* At this point, we must be dealing with a newly discovered USB
-                 * device that matches the given VID and PID.  It must now be
-                 * cached for use with the open function.  Note that instance was
-                 * checked above so it must be NULL here.
+                 * device that matches one of the given VID/PID pairs.  It must
+                 * now be cached for use with the open function.  Note that
+                 * instance was checked above so it must be NULL here.
                  */
                 instance = __add_device_instance(bus->dirname, device->filename,
-                                vendorID, productID);
+                                device->descriptor.idVendor,
+                                device->descriptor.idProduct);
                 if(NULL == instance) {
                     /* Could not add the device -- this should not be possible,
                      * so bail out.
@@ -320,33 +383,22 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
     }
 
     /* Purge any devices that are cached but that no longer exist. */
-    __purge_unmarked_device_instances(vendorID, productID);
+    __purge_unmarked_device_instances(vendorIDs, productIDs, num_ids);
 
-    /* Count up how many of this type of device are known */
-    for(    i = 0, matched = 0, valid = 0;
-            i < MAX_USB_DEVICES && valid < __enumerated_device_count;
-            i++) {
-        if(0 != __enumerated_devices[i].valid) {
-            valid++;
-            if(__enumerated_devices[i].vendorID == vendorID
-                        && __enumerated_devices[i].productID == productID) {
-                matched++;
-            }
-        }
-    }
+    return __list_device_instances(vendorIDs, productIDs, num_ids,
+            output, matches, max_devices);
+}
 
-    for(    i = 0, valid = 0;
-            i < MAX_USB_DEVICES && valid < matched && valid < max_devices;
-            i++) {
-        if(0 != __enumerated_devices[i].valid
-                && __enumerated_devices[i].vendorID == vendorID
-                && __enumerated_devices[i].productID == productID) {
-            output[valid] = __enumerated_devices[i].deviceID;
-            valid++;
-        }
-    }
+int
+USBHotplugStart(const int *vendorIDs, const int *productIDs, int num_ids,
+        USBHotplugCallback callback, void *context) {
+    /* libusb-0.1 has no hotplug support, so callers have to keep probing */
+    return -1;
+}
+
+void
+USBHotplugStop(void) {
 
-    return valid;
 }
 
 void *
@@ -428,6 +480,12 @@ USBOpen(unsigned long deviceID, int *errorCode) {
 
 int
 USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes) {
+    return USBWriteTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBWriteTimeout(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes,
+        unsigned int timeoutMillis) {
     /* Local variables */
     int retval;
     int bytesWritten;
@@ -440,12 +498,15 @@ USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfByt
     usb = (__usb_interface_t *)deviceHandle;
 
     /*
-     * Perform the write.  This is effectively blocking (the timeout is large)
+     * Perform the write.  Without a timeout this is effectively blocking
+     * (the timeout is large)
      */
     bytesWritten = usb_bulk_write(usb->dev, endpoint, data,
-        numberOfBytes, BULK_TIMEOUT);
+        numberOfBytes, (0 == timeoutMillis) ? BULK_TIMEOUT : (int)timeoutMillis);
 
-    if(bytesWritten < 0 || (0 == bytesWritten && 0 != numberOfBytes)) {
+    if(-ETIMEDOUT == bytesWritten) {
+        retval = TRANSFER_TIMEOUT;
+    } else if(bytesWritten < 0 || (0 == bytesWritten && 0 != numberOfBytes)) {
         retval = WRITE_FAILED;
     } else {
         retval = bytesWritten;
@@ -455,6 +516,12 @@ USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfByt
 
 int
 USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes) {
+    return USBReadTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBReadTimeout(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes,
+        unsigned int timeoutMillis) {
     /* Local variables */
     int retval;
     int bytesRead;
@@ -467,11 +534,15 @@ USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfByt
     usb = (__usb_interface_t *)deviceHandle;
 
     /*
-     * Perform the read.  This is effectively blocking (the timeout is large)
+     * Perform the read.  Without a timeout this is effectively blocking
+     * (the timeout is large)
      */
-    bytesRead = usb_bulk_read(usb->dev, endpoint, data, numberOfBytes, BULK_TIMEOUT);
+    bytesRead = usb_bulk_read(usb->dev, endpoint, data, numberOfBytes,
+        (0 == timeoutMillis) ? BULK_TIMEOUT : (int)timeoutMillis);
 
-    if(bytesRead < 0 || (0 == bytesRead && 0 != numberOfBytes)) {
+    if(-ETIMEDOUT == bytesRead) {
+        retval = TRANSFER_TIMEOUT;
+    } else if(bytesRead < 0 || (0 == bytesRead && 0 != numberOfBytes)) {
         retval = READ_FAILED;
     } else {
         retval = bytesRead;
@@ -513,6 +584,18 @@ void USBClearStall(void *deviceHandle, unsigned char endpoint) {
     usb_clear_halt(usb->dev, endpoint);
 }
 
+int
+USBSetReadQueue(void *deviceHandle, unsigned char endpoint, int depth) {
+    /* Reads are always synchronous in this implementation */
+    return -1;
+}
+
+int
+USBCancel(void *deviceHandle) {
+    /* libusb-0.1 has no way to abort a synchronous transfer */
+    return -1;
+}
+
 int
 USBGetDeviceDescriptor(void *deviceHandle, struct USBDeviceDescriptor *desc) {
     struct usb_device_descriptor dd;
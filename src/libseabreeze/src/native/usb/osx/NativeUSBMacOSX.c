@@ -95,12 +95,20 @@ __device_instance_t *__lookup_device_instance_by_ID(long deviceID);
 __device_instance_t *__lookup_device_instance_by_location(long busLocation);
 __device_instance_t *__add_device_instance(long busLocation,
                                            int vendorID, int productID);
-void __purge_unmarked_device_instances(int vendorID, int productID);
+int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids);
+void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids);
+int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices);
 void __close_and_dealloc_usb_interface(__usb_interface_t *usb);
 void __setup_endpoint_map(__usb_interface_t *usb);
 __usb_endpoint_t * __get_endpoint_descriptor(__usb_interface_t *usb, unsigned char ep);
 int __read_from_cache(__usb_endpoint_t *endpoint, char *target, int bytesToRead);
-int __read_from_endpoint(__usb_interface_t *usb, __usb_endpoint_t *endpoint);
+int __read_from_endpoint(__usb_interface_t *usb, __usb_endpoint_t *endpoint,
+        unsigned int timeoutMillis);
+int __transfer_result(__usb_interface_t *usb, __usb_endpoint_t *endpoint, IOReturn flag);
+int __get_registry_number(io_service_t service, CFStringRef key, SInt32 *value);
 
 /* This function will iterate over the known devices and attempt to match
  * the given ID.  It might be more efficient for the sake of this search
@@ -169,7 +177,23 @@ __device_instance_t *__add_device_instance(long busLocation,
     return NULL;
 }
 
-void __purge_unmarked_device_instances(int vendorID, int productID) {
+/* Returns the index of the given VID and PID in a table of VID/PID pairs,
+ * or -1 if the pair is not in the table.
+ */
+int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids) {
+    int i;
+
+    for(i = 0; i < num_ids; i++) {
+        if(vendorIDs[i] == vendorID && productIDs[i] == productID) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids) {
     int new_count = 0;
     int valid = 0;
     int i;
@@ -184,14 +208,14 @@ void __purge_unmarked_device_instances(int vendorID, int productID) {
         valid++;
 
         /* Now check whether it was marked as still being present.  Note that
-         * this search is limited just to the type of device that was being
+         * this search is limited just to the types of device that were being
          * probed when this call was made -- otherwise, any devices that were
          * not being probed for just now would be unmarked and would be
          * discarded.
          */
         if(0 == device->mark
-           && (vendorID == device->vendorID)
-           && (productID == device->productID)) {
+           && __match_device_table(device->vendorID, device->productID,
+                        vendorIDs, productIDs, num_ids) >= 0) {
             /* Not marked, so it needs to be purged */
             if(NULL != device->handle) {
                 /* Clean up the device since it seems to have been disconnected */
@@ -209,6 +233,41 @@ void __purge_unmarked_device_instances(int vendorID, int productID) {
     __enumerated_device_count = new_count;
 }
 
+/* Copies the IDs of all cached devices that match the table of VID/PID pairs
+ * into output, along with the index of the pair each one matched.  Returns
+ * the number of IDs copied.
+ */
+int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices) {
+    int i;
+    int index;
+    int valid;
+    int found;
+
+    for(    i = 0, valid = 0, found = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count
+                && found < max_devices;
+            i++) {
+        if(0 == __enumerated_devices[i].valid) {
+            continue;
+        }
+        valid++;
+
+        index = __match_device_table(__enumerated_devices[i].vendorID,
+                __enumerated_devices[i].productID, vendorIDs, productIDs, num_ids);
+        if(index < 0) {
+            continue;
+        }
+        output[found] = __enumerated_devices[i].deviceID;
+        if(NULL != matches) {
+            matches[found] = index;
+        }
+        found++;
+    }
+
+    return found;
+}
+
 /* This will take an open USB device and read out the endpoint descriptors
  * to determine what the mapping of endpoints to pipes is for the device.
  */
@@ -327,9 +386,40 @@ void __close_and_dealloc_usb_interface(__usb_interface_t *usb) {
     free(usb);
 }
 
+/* Reads an integer property such as the VID or PID of a device out of the
+ * IORegistry.  This is much cheaper than creating a plugin interface for the
+ * device, so it is used to skip over devices that are not of interest.
+ * Returns 0 on success.
+ */
+int __get_registry_number(io_service_t service, CFStringRef key, SInt32 *value) {
+    CFTypeRef property;
+    Boolean converted = false;
+
+    property = IORegistryEntryCreateCFProperty(service, key,
+                                               kCFAllocatorDefault, 0);
+    if(NULL == property) {
+        return -1;
+    }
+    if(CFGetTypeID(property) == CFNumberGetTypeID()) {
+        converted = CFNumberGetValue((CFNumberRef)property,
+                                     kCFNumberSInt32Type, value);
+    }
+    CFRelease(property);
+
+    return (true == converted) ? 0 : -1;
+}
+
 int
 USBProbeDevices(int vendorID, int productID, unsigned long *output,
                 int max_devices) {
+
+    return USBProbeDeviceTable(&vendorID, &productID, 1, output, NULL,
+                               max_devices);
+}
+
+int
+USBProbeDeviceTable(const int *vendorIDs, const int *productIDs, int num_ids,
+                    unsigned long *output, int *matches, int max_devices) {
     /* Local variables */
     mach_port_t masterPort;
     io_service_t usbDeviceRef;
@@ -340,52 +430,28 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
     SInt32 idVendor;
     SInt32 idProduct;
     SInt32 score;
-    CFNumberRef numberRef;
     io_iterator_t iterator = 0;
-    int i = 0;
-    int matched;
-    int valid = 0;
     __device_instance_t *instance;
     UInt32 busLocation = 0;
 
-    idVendor = vendorID;
-    idProduct = productID;
-
     /* Attempt to create a master port; throw an IOException if we can't */
     if(IOMasterPort(MACH_PORT_NULL, &masterPort) != kIOReturnSuccess) {
         return -1;
     }
 
-    /* Attempt to create a matching dictionary; throw an IOException if we can't */
+    /* Attempt to create a matching dictionary; throw an IOException if we can't.
+     * This matches every USB device rather than a single VID and PID so that
+     * the whole table can be checked in one pass over the registry.
+     */
     matchingDictionary = IOServiceMatching(kIOUSBDeviceClassName);
     if(NULL == matchingDictionary) {
         /* Failed to get the dictionary, so clean up and bail out. */
         goto error1;
     }
 
-    /* Attempt to create a vendor reference; throw an exception if we can't */
-    numberRef = CFNumberCreate(kCFAllocatorDefault, kCFNumberSInt32Type,
-                               &idVendor);
-    if(NULL == numberRef) {
-        /* Failed to get vendor reference, so clean up and bail out. */
-        goto error1;
-    }
-
-    /* Attempt to create a reference; throw an IOException if we can't */
-    CFDictionaryAddValue(matchingDictionary, CFSTR(kUSBVendorID), numberRef);
-    CFRelease(numberRef);
-    numberRef = 0;
-    numberRef = CFNumberCreate(kCFAllocatorDefault, kCFNumberSInt32Type,
-                               &idProduct);
-    if(NULL == numberRef) {
-        /* Failed to get product reference, so clean up and bail out */
-        goto error1;
-    }
-
-    /* Attempt to create an iterator; throw an IOException if we can't */
-    CFDictionaryAddValue(matchingDictionary, CFSTR(kUSBProductID), numberRef);
-    CFRelease(numberRef);
-    numberRef = 0;
+    /* Attempt to create an iterator; throw an IOException if we can't.  Note
+     * that this consumes the reference to the matching dictionary.
+     */
     if(kIOReturnSuccess != IOServiceGetMatchingServices(masterPort,
                                                         matchingDictionary,
                                                         &iterator)) {
@@ -398,11 +464,23 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
         goto error2;    /* FIXME: does this try to release a null iterator? */
     }
 
-    /* Search using the iterator for the indicated device */
+    /* Search using the iterator for the indicated devices */
     while(0 != (usbDeviceRef = IOIteratorNext(iterator))) {
-        /* The iterator contains all devices matching the VID and PID.
-         * Go through these and determine whether they are already known
-         * (i.e. they exist in the cache) and if not then add them to the cache.
+        /* The iterator contains all USB devices, so skip over any whose
+         * VID and PID are not in the table before doing anything expensive.
+         */
+        if(0 != __get_registry_number(usbDeviceRef, CFSTR(kUSBVendorID),
+                                      &idVendor)
+                || 0 != __get_registry_number(usbDeviceRef, CFSTR(kUSBProductID),
+                                              &idProduct)
+                || __match_device_table(idVendor, idProduct,
+                        vendorIDs, productIDs, num_ids) < 0) {
+            IOObjectRelease(usbDeviceRef);
+            continue;
+        }
+
+        /* Determine whether each matching device is already known
+         * (i.e. it exists in the cache) and if not then add it to the cache.
          * This will then need to build an array of longs out of the cache.
          * Note that every device on the bus is assigned a unique location
          * as an integer by IOKit, and this will be used to distinguish between
@@ -440,7 +518,7 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
         instance = __lookup_device_instance_by_location(busLocation);
         if(NULL == instance) {
             /* This device was not in the cache so it must be added */
-            instance = __add_device_instance(busLocation, vendorID, productID);
+            instance = __add_device_instance(busLocation, idVendor, idProduct);
             if(NULL == instance) {
                 /* Could not add the device -- this should not be possible,
                  * but fail gracefully regardless.
@@ -460,33 +538,10 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
     iterator = 0;
 
     /* Purge any devices that are cached but that no longer exist. */
-    __purge_unmarked_device_instances(vendorID, productID);
-
-    /* Count up how many of this type of device are known */
-    for(    i = 0, matched = 0, valid = 0;
-        i < MAX_USB_DEVICES && valid < __enumerated_device_count;
-        i++) {
-        if(0 != __enumerated_devices[i].valid) {
-            valid++;
-            if(__enumerated_devices[i].vendorID == vendorID
-                    && __enumerated_devices[i].productID == productID) {
-                matched++;
-            }
-        }
-    }
-
-    for(    i = 0, valid = 0;
-            i < MAX_USB_DEVICES && valid < matched && valid < max_devices;
-            i++) {
-        if(0 != __enumerated_devices[i].valid
-           && __enumerated_devices[i].vendorID == vendorID
-           && __enumerated_devices[i].productID == productID) {
-            output[valid] = __enumerated_devices[i].deviceID;
-            valid++;
-        }
-    }
+    __purge_unmarked_device_instances(vendorIDs, productIDs, num_ids);
 
-    return valid;
+    return __list_device_instances(vendorIDs, productIDs, num_ids,
+                                   output, matches, max_devices);
 
     /* If anything goes wrong above, there are a lot of different ways that the
      * accumulated state may need to be unwound.  goto is generally not the
@@ -509,6 +564,20 @@ error3:
     return -1;
 }
 
+int
+USBHotplugStart(const int *vendorIDs, const int *productIDs, int num_ids,
+                USBHotplugCallback callback, void *context) {
+    /* Hotplug events are not implemented on MacOSX yet, so callers have
+     * to keep probing.
+     */
+    return -1;
+}
+
+void
+USBHotplugStop(void) {
+
+}
+
 void *
 USBOpen(unsigned long deviceID, int *errorCode) {
     /* Local variables */
@@ -795,6 +864,12 @@ USBClose(void *deviceHandle) {
 
 int
 USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes) {
+    return USBWriteTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBWriteTimeout(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes,
+        unsigned int timeoutMillis) {
     /* Local variables */
     IOReturn flag;
     __usb_interface_t *usb;
@@ -811,14 +886,32 @@ USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfByt
         return WRITE_FAILED;
     }
 
-    flag = (*usb->intf)->WritePipe(usb->intf, endpoint_desc->pipe, data, numberOfBytes);
+    if(0 == timeoutMillis) {
+        flag = (*usb->intf)->WritePipe(usb->intf, endpoint_desc->pipe, data, numberOfBytes);
+    } else {
+        flag = (*usb->intf)->WritePipeTO(usb->intf, endpoint_desc->pipe, data, numberOfBytes,
+                timeoutMillis, timeoutMillis);
+    }
     if(kIOReturnSuccess != flag) {
-        return WRITE_FAILED;
+        return __transfer_result(usb, endpoint_desc, flag);
     }
 
     return numberOfBytes;
 }
 
+/* Maps a failed IOKit transfer onto the NativeUSB return codes */
+int __transfer_result(__usb_interface_t *usb, __usb_endpoint_t *endpoint, IOReturn flag) {
+    if(kIOUSBTransactionTimeout == flag) {
+        /* The data toggle may be out of step after a timeout */
+        (*usb->intf)->ClearPipeStallBothEnds(usb->intf, endpoint->pipe);
+        return TRANSFER_TIMEOUT;
+    }
+    if(kIOReturnAborted == flag) {
+        return TRANSFER_CANCELLED;
+    }
+    return READ_FAILED;  /* Same value as WRITE_FAILED */
+}
+
 int __read_from_cache(__usb_endpoint_t *endpoint, char *target, int bytesToRead) {
 
     int availableBytes = endpoint->length - endpoint->offset;
@@ -842,7 +935,8 @@ int __read_from_cache(__usb_endpoint_t *endpoint, char *target, int bytesToRead)
     return bytesToCopy;
 }
 
-int __read_from_endpoint(__usb_interface_t *usb, __usb_endpoint_t *endpoint) {
+int __read_from_endpoint(__usb_interface_t *usb, __usb_endpoint_t *endpoint,
+        unsigned int timeoutMillis) {
     IOReturn flag;
 
     /* Need to always read the maximum packet size for the endpoint.  If not,
@@ -851,12 +945,20 @@ int __read_from_endpoint(__usb_interface_t *usb, __usb_endpoint_t *endpoint) {
      */
     UInt32 bytesRead = endpoint->maxPacketSize;  /* Number of bytes to read */
 
-    flag = (*usb->intf)->ReadPipe(usb->intf, endpoint->pipe,
-            endpoint->buffer, &bytesRead);
+    /* The timeout applies to each packet, so it bounds how long the device
+     * may go quiet rather than the length of the whole read.
+     */
+    if(0 == timeoutMillis) {
+        flag = (*usb->intf)->ReadPipe(usb->intf, endpoint->pipe,
+                endpoint->buffer, &bytesRead);
+    } else {
+        flag = (*usb->intf)->ReadPipeTO(usb->intf, endpoint->pipe,
+                endpoint->buffer, &bytesRead, timeoutMillis, timeoutMillis);
+    }
     if(kIOReturnSuccess != flag) {
         endpoint->length = 0;  /* Mark the buffer as empty */
         endpoint->offset = 0;
-        return READ_FAILED;
+        return __transfer_result(usb, endpoint, flag);
     }
 
     endpoint->length = bytesRead;  /* Update the length to what was written */
@@ -867,6 +969,12 @@ int __read_from_endpoint(__usb_interface_t *usb, __usb_endpoint_t *endpoint) {
 
 int
 USBRead(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes) {
+    return USBReadTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBReadTimeout(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes,
+        unsigned int timeoutMillis) {
     __usb_interface_t *usb;
     __usb_endpoint_t *endpoint_desc;
     int bytesCopied = 0;
@@ -903,9 +1011,9 @@ USBRead(void *deviceHandle, unsigned char endpoint, char *data, int numberOfByte
 
     /* Now try to read one packet at a time to satisfy the caller */
     do {
-        result = __read_from_endpoint(usb, endpoint_desc);
+        result = __read_from_endpoint(usb, endpoint_desc, timeoutMillis);
         if(result < 0) {
-            return READ_FAILED;
+            return result;
         }
 
         /* The previous call should have loaded up the cache, so now try
@@ -943,6 +1051,31 @@ USBClearStall(void *deviceHandle, unsigned char endpoint) {
     (*usb->intf)->ClearPipeStallBothEnds(usb->intf, endpoint_desc->pipe);
 }
 
+int
+USBSetReadQueue(void *deviceHandle, unsigned char endpoint, int depth) {
+    /* Reads are always synchronous in this implementation */
+    return -1;
+}
+
+int
+USBCancel(void *deviceHandle) {
+    __usb_interface_t *usb;
+    int i;
+
+    if(NULL == deviceHandle) {
+        return -1;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    /* Blocked ReadPipe() and WritePipe() calls return kIOReturnAborted */
+    for(i = 0; i < usb->endpointCount; i++) {
+        (*usb->intf)->AbortPipe(usb->intf, usb->endpoints[i].pipe);
+    }
+
+    return 0;
+}
+
 
 int USBGetDeviceDescriptor(void *deviceHandle, struct USBDeviceDescriptor *desc) {
     __usb_interface_t *usb;
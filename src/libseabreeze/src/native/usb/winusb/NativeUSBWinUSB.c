@@ -78,13 +78,18 @@ BOOL __getUSBHandle(char *devicePath, HANDLE *dev_out,
                     WINUSB_INTERFACE_HANDLE *winusb_out);
 int __getDeviceDescriptor(WINUSB_INTERFACE_HANDLE handle,
         struct USBDeviceDescriptor *desc);
-int __probeUSBDevices(int vendorID, int productID);
+int __probeUSBDevices(const int *vendorIDs, const int *productIDs, int num_ids);
 __device_instance_t *__lookup_device_instance_by_ID(long deviceID);
 __device_instance_t *__lookup_device_instance_by_location(char *devicePath);
 __device_instance_t *__add_device_instance(char *devicePath,
                                            int vendorID, int productID);
 void __close_and_dealloc_usb_interface(__usb_interface_t *usb);
-void __purge_unmarked_device_instances(int vendorID, int productID);
+int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids);
+void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids);
+int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices);
 
 /* Function definitions */
 
@@ -164,7 +169,23 @@ __device_instance_t *__add_device_instance(char *devicePath,
 }
 
 
-void __purge_unmarked_device_instances(int vendorID, int productID) {
+/* Returns the index of the given VID and PID in a table of VID/PID pairs,
+ * or -1 if the pair is not in the table.
+ */
+int __match_device_table(int vendorID, int productID,
+        const int *vendorIDs, const int *productIDs, int num_ids) {
+    int i;
+
+    for(i = 0; i < num_ids; i++) {
+        if(vendorIDs[i] == vendorID && productIDs[i] == productID) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void __purge_unmarked_device_instances(const int *vendorIDs,
+        const int *productIDs, int num_ids) {
     int new_count = 0;
     int valid = 0;
     int i;
@@ -179,14 +200,14 @@ void __purge_unmarked_device_instances(int vendorID, int productID) {
         valid++;
 
         /* Now check whether it was marked as still being present.  Note that
-         * this search is limited just to the type of device that was being
+         * this search is limited just to the types of device that were being
          * probed when this call was made -- otherwise, any devices that were
          * not being probed for just now would be unmarked and would be
          * discarded.
          */
         if(0 == device->mark
-                && (vendorID == device->vendorID)
-                && (productID == device->productID)) {
+                && __match_device_table(device->vendorID, device->productID,
+                        vendorIDs, productIDs, num_ids) >= 0) {
             /* Not marked, so it needs to be purged */
             if(NULL != device->handle) {
                 /* Clean up the device since it seems to have been disconnected */
@@ -204,6 +225,41 @@ void __purge_unmarked_device_instances(int vendorID, int productID) {
     __enumerated_device_count = new_count;
 }
 
+/* Copies the IDs of all cached devices that match the table of VID/PID pairs
+ * into output, along with the index of the pair each one matched.  Returns
+ * the number of IDs copied.
+ */
+int __list_device_instances(const int *vendorIDs, const int *productIDs,
+        int num_ids, unsigned long *output, int *matches, int max_devices) {
+    int i;
+    int index;
+    int valid;
+    int found;
+
+    for(    i = 0, valid = 0, found = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count
+                && found < max_devices;
+            i++) {
+        if(0 == __enumerated_devices[i].valid) {
+            continue;
+        }
+        valid++;
+
+        index = __match_device_table(__enumerated_devices[i].vendorID,
+                __enumerated_devices[i].productID, vendorIDs, productIDs, num_ids);
+        if(index < 0) {
+            continue;
+        }
+        output[found] = __enumerated_devices[i].deviceID;
+        if(NULL != matches) {
+            matches[found] = index;
+        }
+        found++;
+    }
+
+    return found;
+}
+
 /* This will attempt to free up all resources associated with an open
  * USB descriptor.  This also deallocates the provided pointer.
  */
@@ -226,29 +282,39 @@ void __close_and_dealloc_usb_interface(__usb_interface_t *usb) {
 int
 USBProbeDevices(int vendorID, int productID, unsigned long *output,
                 int max_devices) {
-    int i;
-    int matched;
-    int valid;
 
-    matched = __probeUSBDevices(vendorID, productID);
+    return USBProbeDeviceTable(&vendorID, &productID, 1, output, NULL,
+                               max_devices);
+}
+
+int
+USBProbeDeviceTable(const int *vendorIDs, const int *productIDs, int num_ids,
+                    unsigned long *output, int *matches, int max_devices) {
+    int flag;
+
+    flag = __probeUSBDevices(vendorIDs, productIDs, num_ids);
 
-    if(matched < 0) {
+    if(flag < 0) {
         /* Error occurred when trying to probe devices */
-        return matched;
+        return flag;
     }
 
-    for(    i = 0, valid = 0;
-            i < MAX_USB_DEVICES && valid < matched && valid < max_devices;
-            i++) {
-        if(0 != __enumerated_devices[i].valid
-                && __enumerated_devices[i].vendorID == vendorID
-                && __enumerated_devices[i].productID == productID) {
-            output[valid] = __enumerated_devices[i].deviceID;
-            valid++;
-        }
-    }
+    return __list_device_instances(vendorIDs, productIDs, num_ids,
+                                   output, matches, max_devices);
+}
+
+int
+USBHotplugStart(const int *vendorIDs, const int *productIDs, int num_ids,
+                USBHotplugCallback callback, void *context) {
+    /* Hotplug events are not implemented for WinUSB yet, so callers have
+     * to keep probing.
+     */
+    return -1;
+}
+
+void
+USBHotplugStop(void) {
 
-    return valid;
 }
 
 void *
@@ -355,10 +421,33 @@ USBClose(void *deviceHandle) {
     return CLOSE_OK;
 }
 
+/* Maps a failed WinUSB transfer onto the NativeUSB return codes, or returns
+ * the number of bytes transferred if it did not fail that way.
+ */
+static int __transfer_result(BOOL ok, long transferred) {
+    if(FALSE == ok) {
+        switch(GetLastError()) {
+            case ERROR_SEM_TIMEOUT:
+                return TRANSFER_TIMEOUT;
+            case ERROR_OPERATION_ABORTED:
+                return TRANSFER_CANCELLED;
+        }
+    }
+    return (int)transferred;
+}
+
 int
 USBWrite(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes) {
+    return USBWriteTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBWriteTimeout(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes,
+        unsigned int timeoutMillis) {
     /* Local variables */
     long transferred = 0;
+    ULONG timeout = timeoutMillis;  /* 0 means no timeout to WinUSB as well */
+    BOOL ok;
     __usb_interface_t *usb;
 
     if(0 == deviceHandle) {
@@ -367,16 +456,27 @@ USBWrite(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBy
 
     usb = (__usb_interface_t *)deviceHandle;
 
-    WinUsb_WritePipe(usb->winUSBHandle, endpoint, data, numberOfBytes,
+    WinUsb_SetPipePolicy(usb->winUSBHandle, endpoint, PIPE_TRANSFER_TIMEOUT,
+        sizeof(timeout), &timeout);
+
+    ok = WinUsb_WritePipe(usb->winUSBHandle, endpoint, data, numberOfBytes,
         &transferred, NULL);
 
-    return (int)transferred;
+    return __transfer_result(ok, transferred);
 }
 
 int
 USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes) {
+    return USBReadTimeout(deviceHandle, endpoint, data, numberOfBytes, 0);
+}
+
+int
+USBReadTimeout(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes,
+        unsigned int timeoutMillis) {
     /* Local variables */
     long transferred = 0;
+    ULONG timeout = timeoutMillis;
+    BOOL ok;
     __usb_interface_t *usb;
 
     if(0 == deviceHandle) {
@@ -385,10 +485,13 @@ USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfByt
 
     usb = (__usb_interface_t *)deviceHandle;
 
-    WinUsb_ReadPipe(usb->winUSBHandle, endpoint, data, numberOfBytes,
+    WinUsb_SetPipePolicy(usb->winUSBHandle, endpoint, PIPE_TRANSFER_TIMEOUT,
+        sizeof(timeout), &timeout);
+
+    ok = WinUsb_ReadPipe(usb->winUSBHandle, endpoint, data, numberOfBytes,
             &transferred, NULL);
 
-    return (int)transferred;
+    return __transfer_result(ok, transferred);
 }
 
 void
@@ -406,6 +509,41 @@ USBClearStall(void *deviceHandle, unsigned char endpoint) {
     WinUsb_ResetPipe(usb->winUSBHandle, endpoint);
 }
 
+int
+USBSetReadQueue(void *deviceHandle, unsigned char endpoint, int depth) {
+    /* Reads are always synchronous in this implementation */
+    return -1;
+}
+
+int
+USBCancel(void *deviceHandle) {
+    USB_INTERFACE_DESCRIPTOR interfaceDescriptor;
+    WINUSB_PIPE_INFORMATION pipeInfo;
+    __usb_interface_t *usb;
+    UCHAR i;
+
+    if(0 == deviceHandle) {
+        return -1;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(FALSE == WinUsb_QueryInterfaceSettings(usb->winUSBHandle, 0, &interfaceDescriptor)) {
+        return -1;
+    }
+
+    /* Pending WinUsb_ReadPipe() and WinUsb_WritePipe() calls fail with
+     * ERROR_OPERATION_ABORTED.
+     */
+    for(i = 0; i < interfaceDescriptor.bNumEndpoints; i++) {
+        if(TRUE == WinUsb_QueryPipe(usb->winUSBHandle, 0, i, &pipeInfo)) {
+            WinUsb_AbortPipe(usb->winUSBHandle, pipeInfo.PipeId);
+        }
+    }
+
+    return 0;
+}
+
 int
 USBGetDeviceDescriptor(void *deviceHandle, struct USBDeviceDescriptor *desc) {
     __usb_interface_t *usb;
@@ -584,13 +722,13 @@ USBGetStringDescriptor(void *deviceHandle, unsigned int string_index,
 
 // #pragma warning(disable: 4133)
 /* This is a convenience method that attempts to traverse the set of
- * discoverable USB devices having the given VID and PID and updates the
- * static data structures that track them.  For any device that is found,
+ * discoverable USB devices having any of the given VID/PID pairs and updates
+ * the static data structures that track them.  Returns 0 on success.  For any device that is found,
  * the device path, VID and PID will be cached in __enumerated_devices but
  * the devices will not be left open (though it may be necessary to open
  * them briefly to get the VID and PID, which is a WinUSB requirement).
  */
-int __probeUSBDevices(int vendorID, int productID) {
+int __probeUSBDevices(const int *vendorIDs, const int *productIDs, int num_ids) {
     HANDLE dev = NULL;
     char devicePath[DEVICE_PATH_SIZE];
     BOOL rc;
@@ -598,8 +736,6 @@ int __probeUSBDevices(int vendorID, int productID) {
     WINUSB_INTERFACE_HANDLE usbHandle;
     struct USBDeviceDescriptor desc;
     int i;
-    int matched;
-    int valid;
     BOOL noMoreDevices = FALSE;
     __device_instance_t *instance = NULL;
 
@@ -654,7 +790,7 @@ int __probeUSBDevices(int vendorID, int productID) {
         }
 
         /* Now that usbHandle has been initialized, determine whether the
-         * device matches the requested VID and PID.
+         * device matches any of the requested VID/PID pairs.
          */
         flag = __getDeviceDescriptor(usbHandle, &desc);
 
@@ -672,16 +808,18 @@ int __probeUSBDevices(int vendorID, int productID) {
         }
 
 
-        if((desc.idVendor != vendorID) || (desc.idProduct != productID)) {
+        if(__match_device_table(desc.idVendor, desc.idProduct,
+                vendorIDs, productIDs, num_ids) < 0) {
             continue;   /* No match, so skip to the next one and try again */
         }
 
         /* At this point, we must be dealing with a newly discovered USB
-         * device that matches the given VID and PID.  It must now be
+         * device that matches one of the given VID/PID pairs.  It must now be
          * cached for use with the open function.  Note that instance was
          * checked above so it must be NULL here.
          */
-        instance = __add_device_instance(devicePath, vendorID, productID);
+        instance = __add_device_instance(devicePath, desc.idVendor,
+                                         desc.idProduct);
         if(NULL == instance) {
             /* Could not add the device -- this should not be possible,
              * but fail gracefully regardless.
@@ -692,26 +830,12 @@ int __probeUSBDevices(int vendorID, int productID) {
     }
 
     /* Purge any devices that are cached but that no longer exist. */
-    __purge_unmarked_device_instances(vendorID, productID);
-
-    /* Count up how many of this type of device are known */
-    for(    i = 0, matched = 0, valid = 0;
-            i < MAX_USB_DEVICES && valid < __enumerated_device_count;
-            i++) {
-        if(0 != __enumerated_devices[i].valid) {
-            valid++;
-            if(__enumerated_devices[i].vendorID == vendorID
-                        && __enumerated_devices[i].productID == productID) {
-                matched++;
-            }
-        }
-    }
+    __purge_unmarked_device_instances(vendorIDs, productIDs, num_ids);
 
     /* At this point, the device cache should have the latest information
-     * on this VID/PID combination.  Return the number of devices of this
-     * type that were found.
+     * on these VID/PID combinations.
      */
-    return matched;
+    return 0;
 }
 
 /* This is a convenience method that attempts to open a device with the
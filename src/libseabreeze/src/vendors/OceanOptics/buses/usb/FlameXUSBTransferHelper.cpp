@@ -29,60 +29,88 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/buses/usb/FlameXUSBTransferHelper.h"
+#include <stdio.h>
 #include <string.h> /* for memcpy() */
 
+#ifdef _WINDOWS
+#define snprintf _snprintf
+#endif
+
 using namespace seabreeze;
 using namespace std;
 
 const int FlameXUSBTransferHelper::WORD_SIZE_BYTES = 4;
 
+/* Enough for any control message, so in practice the scratch buffers are
+ * only allocated once.  Spectra are word-aligned and never use them.
+ */
+const unsigned int FlameXUSBTransferHelper::INITIAL_SCRATCH_BYTES = 4096;
+
 FlameXUSBTransferHelper::FlameXUSBTransferHelper(USB *usb,
         const OOIUSBBidrectionalEndpointMap &map) : USBTransferHelper(usb) {
     this->sendEndpoint = map.getPrimaryOutEndpoint();
     this->receiveEndpoint = map.getPrimaryInEndpoint();
+    this->receiveScratch.resize(INITIAL_SCRATCH_BYTES);
+    this->sendScratch.resize(INITIAL_SCRATCH_BYTES);
 }
 
 FlameXUSBTransferHelper::~FlameXUSBTransferHelper() {
 
 }
 
+unsigned int FlameXUSBTransferHelper::getPaddedLength(unsigned int length) {
+    return length + (WORD_SIZE_BYTES - (length % WORD_SIZE_BYTES)) % WORD_SIZE_BYTES;
+}
+
 int FlameXUSBTransferHelper::receive(vector<unsigned char> &buffer,
         unsigned int length) {
-    if(0 != (length % WORD_SIZE_BYTES)) {
-        vector<unsigned char> *inBuffer;
-        int paddedLength;
-
-        paddedLength = length + (WORD_SIZE_BYTES - (length % WORD_SIZE_BYTES));
-        inBuffer = new vector<unsigned char>(paddedLength);
-
-        int result = USBTransferHelper::receive(*inBuffer, paddedLength);
-        if(result != paddedLength) {
-            string error("Failed to read padded message length: ");
-            error += result;
-            error += " != ";
-            error += paddedLength;
-            throw BusTransferException(error);
-        }
-        memcpy(&buffer[0], &inBuffer[0], length);
-        delete inBuffer;
-        return length;
-    } else {
+    unsigned int paddedLength = getPaddedLength(length);
+    int result;
+
+    if(paddedLength == length) {
         return USBTransferHelper::receive(buffer, length);
     }
+
+    if(buffer.size() >= paddedLength) {
+        /* The caller's buffer has room for the padding, so read straight
+         * into it.  Only the bytes past length are overwritten by padding.
+         */
+        result = USBTransferHelper::receive(buffer, paddedLength);
+    } else {
+        if(this->receiveScratch.size() < paddedLength) {
+            this->receiveScratch.resize(paddedLength);
+        }
+        result = USBTransferHelper::receive(this->receiveScratch, paddedLength);
+    }
+
+    if(result != (int) paddedLength) {
+        char message[80];
+        snprintf(message, sizeof(message),
+            "Failed to read padded message length: %d != %u", result, paddedLength);
+        throw BusTransferException(message);
+    }
+
+    if(buffer.size() < paddedLength) {
+        memcpy(&buffer[0], &this->receiveScratch[0], length);
+    }
+    return length;
 }
 
 int FlameXUSBTransferHelper::send(const std::vector<unsigned char> &buffer,
         unsigned int length) const {
+    unsigned int paddedLength = getPaddedLength(length);
 
-    if(0 != (length % WORD_SIZE_BYTES)) {
-        /* Pad up to a multiple of the word size */
-        int paddedLength = length + (WORD_SIZE_BYTES - (length % WORD_SIZE_BYTES));
-        vector<unsigned char> *outBuffer = new vector<unsigned char>(paddedLength);
-        memcpy((unsigned char*) &outBuffer[0], (unsigned char*) &buffer[0], length);
-        int result = USBTransferHelper::send(*outBuffer, paddedLength);
-        delete outBuffer;
-        return result;
-    } else {
+    if(paddedLength == length) {
         return USBTransferHelper::send(buffer, length);
     }
+
+    /* Pad up to a multiple of the word size with zeros.  The caller's buffer
+     * is const, so the message is always staged in the scratch buffer.
+     */
+    if(this->sendScratch.size() < paddedLength) {
+        this->sendScratch.resize(paddedLength);
+    }
+    memcpy(&this->sendScratch[0], &buffer[0], length);
+    memset(&this->sendScratch[length], 0, paddedLength - length);
+    return USBTransferHelper::send(this->sendScratch, paddedLength);
 }
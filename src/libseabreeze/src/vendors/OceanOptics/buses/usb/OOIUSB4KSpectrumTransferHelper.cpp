@@ -29,6 +29,7 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/buses/usb/OOIUSB4KSpectrumTransferHelper.h"
+#include "native/usb/NativeUSB.h"
 #include <string.h> /* for memcpy() */
 
 /* Note that in this mode, the primary high speed endpoint will
@@ -50,6 +51,10 @@ OOIUSB4KSpectrumTransferHelper::OOIUSB4KSpectrumTransferHelper(USB *usb,
     this->secondaryHighSpeedEP = map.getHighSpeedIn2EP();
     this->secondaryReadBuffer.resize(SECONDARY_READ_LENGTH);
     this->primaryReadBuffer.resize(0);
+
+    /* Only spectra arrive on these endpoints, so reads can be queued */
+    this->usb->setReadQueueDepth(this->receiveEndpoint, USB::getDefaultReadQueueDepth());
+    this->usb->setReadQueueDepth(this->secondaryHighSpeedEP, USB::getDefaultReadQueueDepth());
 }
 
 OOIUSB4KSpectrumTransferHelper::~OOIUSB4KSpectrumTransferHelper() {
@@ -74,13 +79,21 @@ int OOIUSB4KSpectrumTransferHelper::receive(vector<unsigned char> &buffer,
 
     /* Read the first 2048 bytes from the secondary high speed endpoint. */
     /* This may throw a BusTransferException. */
-    flag = this->usb->read(this->secondaryHighSpeedEP, &(this->secondaryReadBuffer[0]), SECONDARY_READ_LENGTH);
+    flag = this->usb->read(this->secondaryHighSpeedEP, &(this->secondaryReadBuffer[0]),
+            SECONDARY_READ_LENGTH, this->timeoutMillis);
+    if(TRANSFER_TIMEOUT == flag || TRANSFER_CANCELLED == flag) {
+        throwTransferError(flag, "Failed to read spectrum from USB.");
+    }
     if(flag >= 0) {
         bytesRead = flag;
     }
     /* Read the remainder from the primary high speed endpoint. */
     /* This may throw a BusTransferException. */
-    flag = this->usb->read(this->receiveEndpoint, &(primaryReadBuffer[0]), primaryReadLength);
+    flag = this->usb->read(this->receiveEndpoint, &(primaryReadBuffer[0]),
+            primaryReadLength, this->timeoutMillis);
+    if(TRANSFER_TIMEOUT == flag || TRANSFER_CANCELLED == flag) {
+        throwTransferError(flag, "Failed to read spectrum from USB.");
+    }
     if(flag >= 0) {
         bytesRead += flag;
     }
@@ -46,6 +46,7 @@ OOIUSBInterface::OOIUSBInterface() {
      */
 
     this->usb = NULL;
+    this->transferTimeoutMillis = 0;
 }
 
 OOIUSBInterface::~OOIUSBInterface() {
@@ -136,7 +137,20 @@ void OOIUSBInterface::close() {
     this->usb->close();
 }
 
+bool OOIUSBInterface::setTransferTimeout(unsigned int timeoutMillis) {
+    bool retval = true;
+
+    this->transferTimeoutMillis = timeoutMillis;
+    for(unsigned int i = 0; i < this->helperValues.size(); i++) {
+        if(false == this->helperValues[i]->setTimeout(timeoutMillis)) {
+            retval = false;
+        }
+    }
+    return retval;
+}
+
 void OOIUSBInterface::addHelper(ProtocolHint *hint, TransferHelper *helper) {
+    helper->setTimeout(this->transferTimeoutMillis);
     this->helperKeys.push_back(hint);
     this->helperValues.push_back(helper);
 }
@@ -37,6 +37,9 @@ OOIUSBSpectrumTransferHelper::OOIUSBSpectrumTransferHelper(USB *usb,
 
     this->sendEndpoint = map.getLowSpeedOutEP();
     this->receiveEndpoint = map.getHighSpeedInEP();
+
+    /* Only spectra arrive on this endpoint, so reads can be queued */
+    this->usb->setReadQueueDepth(this->receiveEndpoint, USB::getDefaultReadQueueDepth());
 }
 
 OOIUSBSpectrumTransferHelper::~OOIUSBSpectrumTransferHelper() {
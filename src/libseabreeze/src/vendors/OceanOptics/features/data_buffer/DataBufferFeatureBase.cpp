@@ -45,7 +45,7 @@ using namespace seabreeze::api;
 using namespace std;
 
 DataBufferFeatureBase::DataBufferFeatureBase() {
-
+    this->bufferedSpectrumLength = 0;
 }
 
 DataBufferFeatureBase::~DataBufferFeatureBase() {
@@ -258,6 +258,53 @@ void DataBufferFeatureBase::setBufferCapacity(const Protocol &protocol,
     }
 }
 
+unsigned int DataBufferFeatureBase::getBufferedSpectrumLength() {
+    return this->bufferedSpectrumLength;
+}
+
+unsigned int DataBufferFeatureBase::readBufferedSpectra(const Protocol &protocol,
+        const Bus &bus, const DataBufferIndex_t bufferIndex,
+        const unsigned int numberOfSpectra, unsigned int *pixels,
+        const unsigned int stride, FastBufferSpectrumMetadata *metadata) {
+
+    DataBufferProtocolInterface *buffer = NULL;
+    ProtocolHelper *proto = NULL;
+
+    if(0 == this->bufferedSpectrumLength) {
+        string error("This device cannot read spectra from its data buffer.");
+        throw FeatureControlException(error);
+    }
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        buffer = static_cast<DataBufferProtocolInterface *>(proto);
+    } catch (const FeatureProtocolNotFoundException &fpnfe) {
+        string error(
+                "Could not find matching protocol implementation to read buffered spectra.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    unsigned int retval = 0;
+
+    try {
+        /* A request against an empty buffer would block until the next
+         * acquisition completes, so only ask for what is already there.
+         */
+        unsigned long available = buffer->getNumberOfElements(bus, bufferIndex);
+        unsigned int count = (available < numberOfSpectra)
+                ? (unsigned int) available : numberOfSpectra;
+        retval = buffer->readBufferedSpectra(bus, bufferIndex, count,
+                this->bufferedSpectrumLength, pixels, stride, metadata);
+    } catch (ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureControlException(error);
+    }
+    return retval;
+}
+
 FeatureFamily DataBufferFeatureBase::getFeatureFamily() {
     FeatureFamilies families;
 
@@ -44,6 +44,7 @@ using namespace std;
 
 QEProDataBufferFeature::QEProDataBufferFeature() {
     this->numberOfBuffers = 1;
+    this->bufferedSpectrumLength = 1044;
 
     this->protocols.push_back(new OBPDataBufferProtocol());
 }
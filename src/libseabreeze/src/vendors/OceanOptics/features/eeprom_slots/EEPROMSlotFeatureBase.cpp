@@ -121,11 +121,34 @@ int EEPROMSlotFeatureBase::writeEEPROMSlot(const Protocol &protocol,
     return bytesWritten;
 }
 
+vector<vector<unsigned char> *> *EEPROMSlotFeatureBase::readEEPROMSlots(
+        const Protocol &protocol, const Bus &bus, const vector<int> &slots) {
+
+    EEPROMProtocolInterface *eeprom = NULL;
+    ProtocolHelper *proto;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        eeprom = static_cast<EEPROMProtocolInterface *>(proto);
+    } catch (FeatureProtocolNotFoundException &fpnfe) {
+        string error(
+                "Could not find matching protocol implementation to get read EEPROM.");
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    try {
+        return eeprom->readEEPROMSlots(bus, slots);
+    } catch (ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        throw FeatureControlException(error);
+    }
+}
+
 double EEPROMSlotFeatureBase::readDouble(const Protocol &protocol, const Bus &bus,
         unsigned int slotNumber) {
     LOG(__FUNCTION__);
 
-    char buffer[20];
     double retval = 0.0;
     vector<unsigned char> *slot;
 
@@ -136,31 +159,76 @@ double EEPROMSlotFeatureBase::readDouble(const Protocol &protocol, const Bus &bu
         throw FeatureException("Trying to read and parse invalid slot.");
     }
 
-    /* First, guarantee that the string we parse is null-terminated. 20 bytes is overkill. */
-    strncpy(buffer, ((char *)&((*slot)[0])), 19);
-    buffer[19] = '\0';
-    try
-    {
-        std::istringstream istr(buffer);
-        istr >> retval;
-    }
-    catch (const exception &ex)
-    {
+    bool parsed = parseDouble(*slot, retval);
+    delete slot;
+    if(false == parsed) {
         /* we failed to parse anything, so the EEPROM slot
          * may have been unprogrammed or otherwise corrupted.  Flag an error
          * so that we can drop in some safe default values.
          */
         string error("Could not parse double out of EEPROM slot.");
         logger.error(error.c_str());
-        delete slot;
         throw NumberFormatException(error);
     }
 
-    delete slot;
+    return retval;
+}
+
+vector<double> EEPROMSlotFeatureBase::readDoubles(const Protocol &protocol,
+        const Bus &bus, unsigned int firstSlot, unsigned int count) {
+    LOG(__FUNCTION__);
+
+    unsigned int i;
+    vector<int> slotNumbers(count);
+    for(i = 0; i < count; i++) {
+        slotNumbers[i] = firstSlot + i;
+    }
+
+    /* This may throw a FeatureException */
+    vector<vector<unsigned char> *> *slots = readEEPROMSlots(protocol, bus, slotNumbers);
+
+    vector<double> retval(count, 0.0);
+    bool parsed = true;
+    for(i = 0; i < slots->size() && i < count; i++) {
+        if(false == parseDouble(*(*slots)[i], retval[i])) {
+            parsed = false;
+        }
+    }
+    for(i = 0; i < slots->size(); i++) {
+        delete (*slots)[i];
+    }
+    delete slots;
+
+    if(false == parsed) {
+        string error("Could not parse double out of EEPROM slot.");
+        logger.error(error.c_str());
+        throw NumberFormatException(error);
+    }
 
     return retval;
 }
 
+bool EEPROMSlotFeatureBase::parseDouble(const vector<unsigned char> &slot, double &value) {
+    char buffer[20];
+
+    /* First, guarantee that the string we parse is null-terminated. 20 bytes is overkill. */
+    size_t length = slot.size() < 19 ? slot.size() : 19;
+    if(length > 0) {
+        memcpy(buffer, &slot[0], length);
+    }
+    buffer[length] = '\0';
+    try
+    {
+        std::istringstream istr(buffer);
+        istr >> value;
+    }
+    catch (const exception &ex)
+    {
+        return false;
+    }
+    return true;
+}
+
 
 long EEPROMSlotFeatureBase::readLong(const Protocol &protocol, const Bus &bus,
             unsigned int slotNumber) {
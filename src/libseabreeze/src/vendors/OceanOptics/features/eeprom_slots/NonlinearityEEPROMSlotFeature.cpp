@@ -71,25 +71,24 @@ vector<double> *NonlinearityEEPROMSlotFeature::readNonlinearityCoefficients(
     numberCoeffs = order + 1;
     retval = new vector<double>(numberCoeffs);
 
-    for(i = 0; i < numberCoeffs; i++) {
-        /* Nonlinearity coefficients are stored starting with intercept at slot 6 */
-        try {
-            /* This may throw a FeatureException or NumberFormatException */
-            (*retval)[i] = readDouble(protocol, bus, i + __NONLINEARITY_SLOT_ORDER_ZERO);
-        } catch (NumberFormatException &nfe) {
-            logger.error("Could not parse NLC coeff");
-            for(i = 0; i < numberCoeffs; i++) {
-                /* Set the polynomial such that the correction is negated.
-                 */
-                if(0 == i) {
-                    (*retval)[i] = 1.0;
-                } else {
-                    (*retval)[i] = 0.0;
-                }
+    /* Nonlinearity coefficients are stored starting with intercept at slot 6 */
+    try {
+        /* This may throw a FeatureException or NumberFormatException */
+        *retval = readDoubles(protocol, bus, __NONLINEARITY_SLOT_ORDER_ZERO, numberCoeffs);
+    } catch (NumberFormatException &nfe) {
+        logger.error("Could not parse NLC coeff");
+        for(i = 0; i < numberCoeffs; i++) {
+            /* Set the polynomial such that the correction is negated.
+             */
+            if(0 == i) {
+                (*retval)[i] = 1.0;
+            } else {
+                (*retval)[i] = 0.0;
             }
-            break;
-        } catch (const exception &ex) {
-            logger.error("Caught unknown exception reading NLC coeff");
+        }
+    } catch (const exception &ex) {
+        logger.error("Caught unknown exception reading NLC coeffs");
+        for(i = 0; i < numberCoeffs; i++) {
             (*retval)[i] = 0;
         }
     }
@@ -54,48 +54,43 @@ vector<double> *WavelengthEEPROMSlotFeature::readWavelengths(const Protocol &pro
     double polynomial[4]; /* order of term equals index of term */
     int i;
 
-    for(i = 0; i < 4; i++) {
-        /* Wavelength coefficients are stored starting with intercept at slot 1 */
-        try {
-            /* This may throw a FeatureException or NumberFormatException */
-            polynomial[i] = readDouble(protocol, bus, i + 1);
-        } catch (NumberFormatException &nfe) {
-            /* FIXME: If there were some sort of logging mechanism, this would
-             * be a good thing to warn about.
+    /* Wavelength coefficients are stored starting with intercept at slot 1 */
+    try {
+        /* This may throw a FeatureException or NumberFormatException */
+        vector<double> coeffs = readDoubles(protocol, bus, 1, 4);
+        for(i = 0; i < 4; i++) {
+            polynomial[i] = coeffs[i];
+        }
+    } catch (NumberFormatException &nfe) {
+        /* FIXME: If there were some sort of logging mechanism, this would
+         * be a good thing to warn about.
+         */
+        for(i = 0; i < 4; i++) {
+            /* Set the polynomial such that the reported wavelength equals
+             * the pixel number.
              */
-            for(i = 0; i < 4; i++) {
-                /* Set the polynomial such that the reported wavelength equals
-                 * the pixel number.
-                 */
-                if(1 == i) {
-                    polynomial[i] = 1.0;
-                } else {
-                    polynomial[i] = 0.0;
-                }
+            if(1 == i) {
+                polynomial[i] = 1.0;
+            } else {
+                polynomial[i] = 0.0;
             }
-            break;
         }
     }
 
     return computeWavelengths(polynomial, 4);
 }
 
-/* Note: this should probably be broken out or delegated to a more generic
- * polynomial evaluation function that can be reused.
- */
 vector<double> *WavelengthEEPROMSlotFeature::computeWavelengths(
         double polynomial[], int length) {
 
     vector<double> *retval = new vector<double>(this->numberOfPixels);
-    unsigned int i;
 
-    Polynomial<double> *calibration = new Polynomial<double>(polynomial, length);
+    Polynomial<double> calibration(polynomial, length);
 
     /* Evaluate the given polynomial to generate the wavelength array. */
-    for(i = 0; i < this->numberOfPixels; i++) {
-        (*retval)[i] = calibration->evaluate(i);
+    if(this->numberOfPixels > 0) {
+        calibration.evaluateRange(0.0, &(*retval)[0], this->numberOfPixels);
     }
-    delete calibration;
     return retval;
 }
 
@@ -63,15 +63,14 @@ vector<double> *WavelengthEEPROMSlotFeature_QE65000::computeWavelengths(
         double polynomial[], int length) {
 
     vector<double> *retval = new vector<double>(this->numberOfPixels);
-    unsigned int i;
 
-    Polynomial<double> *calibration = new Polynomial<double>(polynomial, length);
+    Polynomial<double> calibration(polynomial, length);
 
-    /* Evaluate the given polynomial to generate the wavelength array. */
-    for(i = 0; i < this->numberOfPixels; i++) {
-        /* Shift the evaluation by ten pixels */
-        (*retval)[i] = calibration->evaluate(i - 10.0);
+    /* Evaluate the given polynomial to generate the wavelength array,
+     * shifting the evaluation by ten pixels.
+     */
+    if(this->numberOfPixels > 0) {
+        calibration.evaluateRange(-10.0, &(*retval)[0], this->numberOfPixels);
     }
-    delete calibration;
     return retval;
 }
@@ -0,0 +1,223 @@
+/***************************************************//**
+ * @file    ContinuousAcquisition.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <chrono>
+#include <string>
+#include "vendors/OceanOptics/features/spectrometer/ContinuousAcquisition.h"
+#include "common/exceptions/FeatureControlException.h"
+#include "common/exceptions/IllegalArgumentException.h"
+#include "common/Log.h"
+
+using namespace seabreeze;
+using namespace std;
+
+ContinuousAcquisition::ContinuousAcquisition(
+        OOISpectrometerFeatureInterface *spec, Protocol *p, Bus *b)
+        : busWaiters(0), stopRequested(false), running(false), errors(0) {
+    this->feature = spec;
+    this->protocol = p;
+    this->bus = b;
+    this->ring = NULL;
+    this->pipelined = false;
+}
+
+ContinuousAcquisition::~ContinuousAcquisition() {
+    stop();
+    if(NULL != this->ring) {
+        delete this->ring;
+    }
+}
+
+void ContinuousAcquisition::start(unsigned int depth, bool pipelined) {
+    LOG(__FUNCTION__);
+
+    if(0 == depth) {
+        string error("Continuous acquisition requires a ring depth of at least one");
+        throw IllegalArgumentException(error);
+    }
+
+    if(true == this->running.load()) {
+        string error("Continuous acquisition is already running");
+        logger.error(error.c_str());
+        throw FeatureControlException(error);
+    }
+
+    /* The thread may have exited on its own after an error */
+    if(this->worker.joinable()) {
+        this->worker.join();
+    }
+
+    {
+        unsigned int frameLength = this->feature->getNumberOfPixels();
+        lock_guard<mutex> lock(this->ringMutex);
+        if(NULL != this->ring && depth == this->ring->getDepth()
+                && frameLength == this->ring->getFrameLength()) {
+            /* Same capacity as last time, so keep the storage */
+            this->ring->reset();
+        } else {
+            if(NULL != this->ring) {
+                delete this->ring;
+                this->ring = NULL;
+            }
+            this->ring = new SpectrumRingBuffer(depth, frameLength);
+        }
+    }
+
+    this->pipelined = pipelined;
+    this->errors.store(0);
+    this->stopRequested.store(false);
+    this->running.store(true);
+    this->worker = thread(&ContinuousAcquisition::run, this);
+}
+
+void ContinuousAcquisition::stop() {
+    this->stopRequested.store(true);
+    if(this->worker.joinable()) {
+        this->worker.join();
+    }
+    this->running.store(false);
+}
+
+bool ContinuousAcquisition::isRunning() const {
+    return this->running.load();
+}
+
+unsigned int ContinuousAcquisition::readSpectrum(double *buffer,
+        unsigned int bufferLength, unsigned long long *timestampMicros) {
+    lock_guard<mutex> lock(this->ringMutex);
+    if(NULL == this->ring) {
+        return 0;
+    }
+    return this->ring->pop(buffer, bufferLength, timestampMicros);
+}
+
+unsigned int ContinuousAcquisition::getDepth() {
+    lock_guard<mutex> lock(this->ringMutex);
+    return (NULL == this->ring) ? 0 : this->ring->getDepth();
+}
+
+unsigned long long ContinuousAcquisition::getAcquiredFrameCount() {
+    lock_guard<mutex> lock(this->ringMutex);
+    if(NULL == this->ring) {
+        return 0;
+    }
+    return this->ring->getCommittedFrameCount() + this->ring->getDroppedFrameCount();
+}
+
+unsigned long long ContinuousAcquisition::getDroppedFrameCount() {
+    lock_guard<mutex> lock(this->ringMutex);
+    return (NULL == this->ring) ? 0 : this->ring->getDroppedFrameCount();
+}
+
+unsigned long long ContinuousAcquisition::getOverrunCount() {
+    lock_guard<mutex> lock(this->ringMutex);
+    return (NULL == this->ring) ? 0 : this->ring->getOverrunCount();
+}
+
+unsigned long long ContinuousAcquisition::getErrorCount() const {
+    return this->errors.load();
+}
+
+void ContinuousAcquisition::lockBus() {
+    /* Announce the waiter first so that the acquisition thread backs off
+     * instead of immediately retaking the mutex for its next cycle.
+     */
+    this->busWaiters.fetch_add(1);
+    this->busMutex.lock();
+    this->busWaiters.fetch_sub(1);
+
+    /* A pipelined acquisition releases the bus with the next spectrum
+     * already requested.  Read that spectrum back before anyone else
+     * talks to the device, or the reply to their command would arrive
+     * behind it.  The acquisition thread requests a new spectrum once
+     * it gets the bus back.
+     */
+    try {
+        this->feature->endPipelinedFormattedSpectra(*this->protocol, *this->bus);
+    } catch (const FeatureException &fe) {
+        LOG(__FUNCTION__);
+        logger.debug(fe.what());
+    }
+}
+
+void ContinuousAcquisition::unlockBus() {
+    this->busMutex.unlock();
+}
+
+bool ContinuousAcquisition::hasBusWaiters() const {
+    return this->busWaiters.load() > 0;
+}
+
+void ContinuousAcquisition::run() {
+    LOG(__FUNCTION__);
+
+    unsigned int frameLength = this->ring->getFrameLength();
+    unsigned int pixels;
+    unsigned long long timestamp;
+
+    while(false == this->stopRequested.load()) {
+        while(true == hasBusWaiters()) {
+            this_thread::yield();
+        }
+
+        try {
+            lock_guard<mutex> guard(this->busMutex);
+            if(true == this->pipelined) {
+                pixels = this->feature->getPipelinedFormattedSpectrum(*this->protocol,
+                        *this->bus, this->ring->getWriteFrame(), frameLength);
+            } else {
+                pixels = this->feature->getFormattedSpectrum(*this->protocol,
+                        *this->bus, this->ring->getWriteFrame(), frameLength);
+            }
+        } catch (const FeatureException &fe) {
+            string error("Continuous acquisition stopped: ");
+            error += fe.what();
+            logger.error(error.c_str());
+            this->errors.fetch_add(1);
+            break;
+        }
+
+        timestamp = (unsigned long long) chrono::duration_cast<chrono::microseconds>(
+                chrono::system_clock::now().time_since_epoch()).count();
+        this->ring->commitWriteFrame(pixels, timestamp);
+    }
+
+    if(true == this->pipelined) {
+        try {
+            lock_guard<mutex> guard(this->busMutex);
+            this->feature->endPipelinedFormattedSpectra(*this->protocol, *this->bus);
+        } catch (const FeatureException &fe) {
+            /* The device may already be gone; nothing more to drain */
+            logger.debug(fe.what());
+        }
+    }
+
+    this->running.store(false);
+}
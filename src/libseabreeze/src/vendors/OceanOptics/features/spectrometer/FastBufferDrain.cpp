@@ -0,0 +1,273 @@
+/***************************************************//**
+ * @file    FastBufferDrain.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <chrono>
+#include <string>
+#include <string.h>     /* for memcpy() */
+#include "vendors/OceanOptics/features/spectrometer/FastBufferDrain.h"
+#include "vendors/OceanOptics/features/spectrometer/FastBufferSpectrumParser.h"
+#include "common/exceptions/FeatureControlException.h"
+#include "common/exceptions/IllegalArgumentException.h"
+#include "common/Log.h"
+
+using namespace seabreeze;
+using namespace std;
+
+/* The drain reads from the first data buffer of the device */
+#define DATA_BUFFER_INDEX   0
+
+FastBufferDrain::FastBufferDrain(OOISpectrometerFeatureInterface *spec,
+        DataBufferFeatureInterface *buffer, ContinuousAcquisition *owner,
+        Protocol *p, Bus *b)
+        : stopRequested(false), running(false), received(0), missed(0),
+          gaps(0), dropped(0), errors(0) {
+    this->feature = spec;
+    this->dataBuffer = buffer;
+    this->busOwner = owner;
+    this->protocol = p;
+    this->bus = b;
+    this->maxBatch = 0;
+    this->pollIntervalMicros = 0;
+    this->frameLength = 0;
+    this->depth = 0;
+    this->queueHead = 0;
+    this->queueCount = 0;
+    this->haveLastSpectrumCount = false;
+    this->lastSpectrumCount = 0;
+}
+
+FastBufferDrain::~FastBufferDrain() {
+    stop();
+}
+
+void FastBufferDrain::start(unsigned int depth, unsigned int maxBatch,
+        unsigned int pollIntervalMicros) {
+    LOG(__FUNCTION__);
+
+    if(0 == depth || 0 == maxBatch) {
+        string error("The fast buffer drain requires a queue depth and batch size of at least one");
+        throw IllegalArgumentException(error);
+    }
+
+    if(NULL == this->dataBuffer) {
+        string error("The fast buffer drain requires a data buffer feature");
+        logger.error(error.c_str());
+        throw FeatureControlException(error);
+    }
+
+    if(true == this->running.load() || true == this->busOwner->isRunning()) {
+        string error("The fast buffer drain or a continuous acquisition is already running");
+        logger.error(error.c_str());
+        throw FeatureControlException(error);
+    }
+
+    /* The thread may have exited on its own after an error */
+    if(this->worker.joinable()) {
+        this->worker.join();
+    }
+
+    this->frameLength = this->feature->getNumberOfPixels();
+    this->maxBatch = maxBatch;
+    this->pollIntervalMicros = pollIntervalMicros;
+    this->batchPixels.assign((size_t) maxBatch * this->frameLength, 0);
+    this->batchMetadata.assign(maxBatch, FastBufferSpectrumMetadata());
+
+    {
+        lock_guard<mutex> guard(this->queueMutex);
+        this->depth = depth;
+        this->queuePixels.assign((size_t) depth * this->frameLength, 0);
+        this->queueMetadata.assign(depth, FastBufferSpectrumMetadata());
+        this->queueHead = 0;
+        this->queueCount = 0;
+    }
+
+    this->haveLastSpectrumCount = false;
+    this->received.store(0);
+    this->missed.store(0);
+    this->gaps.store(0);
+    this->dropped.store(0);
+    this->errors.store(0);
+    this->stopRequested.store(false);
+    this->running.store(true);
+    this->worker = thread(&FastBufferDrain::run, this);
+}
+
+void FastBufferDrain::stop() {
+    this->stopRequested.store(true);
+    if(this->worker.joinable()) {
+        this->worker.join();
+    }
+    this->running.store(false);
+}
+
+bool FastBufferDrain::isRunning() const {
+    return this->running.load();
+}
+
+unsigned int FastBufferDrain::read(unsigned int maxSpectra, unsigned int *pixels,
+        unsigned int stride, FastBufferSpectrumMetadata *metadata) {
+    lock_guard<mutex> guard(this->queueMutex);
+    unsigned int count = (maxSpectra < this->queueCount) ? maxSpectra : this->queueCount;
+    unsigned int copyLength = (stride < this->frameLength) ? stride : this->frameLength;
+    unsigned int i;
+
+    for(i = 0; i < count; i++) {
+        unsigned int slot = (this->queueHead + i) % this->depth;
+        unsigned int *row = pixels + (size_t) i * stride;
+        memcpy(row, &this->queuePixels[(size_t) slot * this->frameLength],
+                copyLength * sizeof(unsigned int));
+        if(copyLength < stride) {
+            memset(row + copyLength, 0, (stride - copyLength) * sizeof(unsigned int));
+        }
+        metadata[i] = this->queueMetadata[slot];
+    }
+    this->queueHead = (this->queueHead + count) % this->depth;
+    this->queueCount -= count;
+
+    return count;
+}
+
+unsigned long long FastBufferDrain::getReceivedCount() const {
+    return this->received.load();
+}
+
+unsigned long long FastBufferDrain::getMissedCount() const {
+    return this->missed.load();
+}
+
+unsigned long long FastBufferDrain::getGapCount() const {
+    return this->gaps.load();
+}
+
+unsigned long long FastBufferDrain::getDroppedCount() const {
+    return this->dropped.load();
+}
+
+unsigned long long FastBufferDrain::getErrorCount() const {
+    return this->errors.load();
+}
+
+void FastBufferDrain::checkSequence(const FastBufferSpectrumMetadata &metadata) {
+    if(true == this->haveLastSpectrumCount) {
+        /* Unsigned arithmetic so that the 32-bit counter may wrap */
+        unsigned int step = metadata.spectrumCount - this->lastSpectrumCount;
+        if(1 != step) {
+            this->gaps.fetch_add(1);
+            if(0 != step && step < 0x80000000U) {
+                this->missed.fetch_add(step - 1);
+            }
+        }
+    }
+    this->lastSpectrumCount = metadata.spectrumCount;
+    this->haveLastSpectrumCount = true;
+}
+
+void FastBufferDrain::enqueue(unsigned int count) {
+    lock_guard<mutex> guard(this->queueMutex);
+    unsigned int i;
+
+    for(i = 0; i < count; i++) {
+        if(this->queueCount == this->depth) {
+            /* As with the spectrum ring, the newest spectra are dropped */
+            this->dropped.fetch_add(count - i);
+            break;
+        }
+        unsigned int slot = (this->queueHead + this->queueCount) % this->depth;
+        memcpy(&this->queuePixels[(size_t) slot * this->frameLength],
+                &this->batchPixels[(size_t) i * this->frameLength],
+                this->frameLength * sizeof(unsigned int));
+        this->queueMetadata[slot] = this->batchMetadata[i];
+        this->queueCount++;
+    }
+}
+
+void FastBufferDrain::run() {
+    LOG(__FUNCTION__);
+
+    DataBufferElementCount_t available;
+    vector<unsigned char> *data;
+    unsigned int batch;
+    unsigned int count;
+    unsigned int i;
+
+    while(false == this->stopRequested.load()) {
+        while(true == this->busOwner->hasBusWaiters()) {
+            this_thread::yield();
+        }
+
+        data = NULL;
+        batch = 0;
+        try {
+            ContinuousAcquisitionBusLock busLock(this->busOwner);
+            available = this->dataBuffer->getNumberOfElements(*this->protocol,
+                    *this->bus, DATA_BUFFER_INDEX);
+            if(available > 0) {
+                batch = (available < this->maxBatch) ? (unsigned int) available : this->maxBatch;
+                data = this->feature->getFastBufferSpectrum(*this->protocol,
+                        *this->bus, batch);
+            }
+        } catch (const FeatureException &fe) {
+            string error("Fast buffer drain stopped: ");
+            error += fe.what();
+            logger.error(error.c_str());
+            this->errors.fetch_add(1);
+            break;
+        }
+
+        if(0 == batch) {
+            this_thread::sleep_for(chrono::microseconds(this->pollIntervalMicros));
+            continue;
+        }
+
+        /* Parsing happens outside the bus lock */
+        try {
+            count = FastBufferSpectrumParser::parse(
+                    data->empty() ? NULL : &(*data)[0], (unsigned int) data->size(),
+                    batch, &this->batchPixels[0], this->frameLength,
+                    &this->batchMetadata[0]);
+        } catch (const IllegalArgumentException &iae) {
+            string error("Fast buffer drain stopped: ");
+            error += iae.what();
+            logger.error(error.c_str());
+            delete data;
+            this->errors.fetch_add(1);
+            break;
+        }
+        delete data;
+
+        for(i = 0; i < count; i++) {
+            checkSequence(this->batchMetadata[i]);
+        }
+        this->received.fetch_add(count);
+        enqueue(count);
+    }
+
+    this->running.store(false);
+}
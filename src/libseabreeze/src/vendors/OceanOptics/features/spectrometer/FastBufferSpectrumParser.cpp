@@ -0,0 +1,152 @@
+/***************************************************//**
+ * @file    FastBufferSpectrumParser.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>     /* for memset() */
+#include <string>
+#include "vendors/OceanOptics/features/spectrometer/FastBufferSpectrumParser.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "common/PixelDecoder.h"
+#include "common/exceptions/IllegalArgumentException.h"
+
+using namespace seabreeze;
+using namespace std;
+
+/* Bytes of the metadata block that are decoded; newer protocol versions
+ * may send a longer block, which metadataLength accounts for.
+ */
+#define METADATA_DECODED_LENGTH     42
+#define CHECKSUM_LENGTH             4
+
+static inline unsigned short readU16(const unsigned char *p) {
+    return (unsigned short) (p[0] | (p[1] << 8));
+}
+
+static inline unsigned int readU32(const unsigned char *p) {
+    return (unsigned int) p[0] | ((unsigned int) p[1] << 8)
+            | ((unsigned int) p[2] << 16) | ((unsigned int) p[3] << 24);
+}
+
+static inline unsigned long long readU64(const unsigned char *p) {
+    return (unsigned long long) readU32(p)
+            | ((unsigned long long) readU32(p + 4) << 32);
+}
+
+unsigned int FastBufferSpectrumParser::getBytesPerPixel(unsigned int pixelDataFormat) {
+    switch(pixelDataFormat) {
+    case FAST_BUFFER_PIXEL_FORMAT_UINT16:
+        return 2;
+    case FAST_BUFFER_PIXEL_FORMAT_UINT24:
+        return 3;
+    case FAST_BUFFER_PIXEL_FORMAT_UINT32:
+    case FAST_BUFFER_PIXEL_FORMAT_FLOAT:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+unsigned int FastBufferSpectrumParser::parse(const unsigned char *data,
+        unsigned int dataLength, unsigned int maxSpectra,
+        unsigned int *pixels, unsigned int stride,
+        FastBufferSpectrumMetadata *metadata) {
+
+    size_t offset = 0;
+    unsigned int spectra;
+
+    for(spectra = 0; spectra < maxSpectra && offset < dataLength; spectra++) {
+        const unsigned char *block = data + offset;
+        size_t remaining = dataLength - offset;
+        FastBufferSpectrumMetadata *md = &metadata[spectra];
+        unsigned int *row = pixels + (size_t) spectra * stride;
+        unsigned int bytesPerPixel;
+        unsigned int count;
+        unsigned int i;
+
+        if(remaining < METADATA_DECODED_LENGTH) {
+            throw IllegalArgumentException(string("Fast buffer data ends inside spectrum metadata"));
+        }
+
+        md->metadataProtocolVersion = readU16(block + 0);
+        md->metadataLength = readU16(block + 2);
+        md->pixelDataLength = readU32(block + 4);
+        md->microsecondCounter = readU64(block + 8);
+        md->integrationTimeMicros = readU32(block + 16);
+        md->pixelDataFormat = readU32(block + 20);
+        md->spectrumCount = readU32(block + 24);
+        md->lastSpectrumCount = readU32(block + 28);
+        md->lastMicrosecondCount = readU64(block + 32);
+        md->scansToAverage = readU16(block + 40);
+
+        if(md->metadataLength < METADATA_DECODED_LENGTH
+                || remaining < (size_t) md->metadataLength + md->pixelDataLength) {
+            throw IllegalArgumentException(string("Fast buffer spectrum is truncated"));
+        }
+
+        bytesPerPixel = getBytesPerPixel(md->pixelDataFormat);
+        if(0 == bytesPerPixel) {
+            throw IllegalArgumentException(string("Unknown fast buffer pixel data format"));
+        }
+
+        count = md->pixelDataLength / bytesPerPixel;
+        if(count > stride) {
+            count = stride;
+        }
+
+        block += md->metadataLength;
+        switch(md->pixelDataFormat) {
+        case FAST_BUFFER_PIXEL_FORMAT_UINT16:
+            for(i = 0; i < count; i++) {
+                row[i] = readU16(block + 2 * i);
+            }
+            break;
+        case FAST_BUFFER_PIXEL_FORMAT_UINT24:
+            for(i = 0; i < count; i++) {
+                const unsigned char *p = block + 3 * i;
+                row[i] = (unsigned int) p[0] | ((unsigned int) p[1] << 8)
+                        | ((unsigned int) p[2] << 16);
+            }
+            break;
+        default:
+            /* 32-bit integers and floats are both copied bit for bit */
+            PixelDecoder::decodeU32(block, row, count);
+            break;
+        }
+        if(count < stride) {
+            memset(row + count, 0, (stride - count) * sizeof(unsigned int));
+        }
+
+        /* Each spectrum is followed by a checksum, which may be missing
+         * after the last one.
+         */
+        offset += (size_t) md->metadataLength + md->pixelDataLength + CHECKSUM_LENGTH;
+    }
+
+    return spectra;
+}
@@ -107,7 +107,7 @@ FlameXSpectrometerFeature::~FlameXSpectrometerFeature() {
 
 }
 
-vector<double> *FlameXSpectrometerFeature::getWavelengths(const Protocol &protocol,
+vector<double> *FlameXSpectrometerFeature::readWavelengths(const Protocol &protocol,
             const Bus &bus) {
 
     /* FIXME: this probably ought to attempt to create an instance based on
@@ -125,6 +125,10 @@ vector<double> *FlameXSpectrometerFeature::getWavelengths(const Protocol &protoc
 bool FlameXSpectrometerFeature::initialize(const Protocol &protocol, const Bus &bus)
 {
 	bool result = false;
+
+	/* The pixel count is read from the device below */
+	invalidateWavelengths();
+
 	if (myIntrospection != NULL)
 	{
 		this->numberOfPixels = myIntrospection->getNumberOfPixels(protocol, bus);
@@ -40,6 +40,8 @@ using namespace std;
 GainAdjustedSpectrometerFeature::GainAdjustedSpectrometerFeature(
                 ProgrammableSaturationFeature *saturationFeature) {
     this->saturation = saturationFeature;
+    this->saturationLevel = 0;
+    this->gainScale = 1.0;
 }
 
 GainAdjustedSpectrometerFeature::~GainAdjustedSpectrometerFeature() {
@@ -47,19 +49,38 @@ GainAdjustedSpectrometerFeature::~GainAdjustedSpectrometerFeature() {
 }
 
 unsigned int GainAdjustedSpectrometerFeature::getSaturationLevel() {
+    if(0 == this->saturationLevel) {
+        /* Not initialized yet */
+        resolveSaturationLevel();
+    }
+    return this->saturationLevel;
+}
+
+double GainAdjustedSpectrometerFeature::getGainScale() {
+    if(0 == this->saturationLevel) {
+        resolveSaturationLevel();
+    }
+    return this->gainScale;
+}
+
+void GainAdjustedSpectrometerFeature::resolveSaturationLevel() {
+    unsigned int result;
+
     try {
-        unsigned int result = this->saturation->getSaturation();
+        result = this->saturation->getSaturation();
         if(0 == result || result > (unsigned)this->maxIntensity) {
             /* The saturation setting was retrieved but appears to be invalid.
              * Use the max intensity instead.
              */
-            return this->maxIntensity;
+            result = this->maxIntensity;
         }
-        return result;
     } catch (const FeatureException &fe) {
         /* No valid saturation setting, so default to the max intensity */
-        return this->maxIntensity;
+        result = this->maxIntensity;
     }
+
+    this->saturationLevel = result;
+    this->gainScale = (0 == result) ? 1.0 : (double)this->maxIntensity / result;
 }
 
 bool GainAdjustedSpectrometerFeature::initialize(const Protocol &proto, const Bus &bus) {
@@ -71,5 +92,10 @@ bool GainAdjustedSpectrometerFeature::initialize(const Protocol &proto, const Bu
         return false;
     }
 
-    return OOISpectrometerFeature::initialize(proto, bus);
+    result = OOISpectrometerFeature::initialize(proto, bus);
+
+    /* The saturation feature has read its setting from the device by now */
+    resolveSaturationLevel();
+
+    return result;
 }
@@ -32,6 +32,8 @@
 #include "vendors/OceanOptics/features/eeprom_slots/WavelengthEEPROMSlotFeature.h"
 #include "common/exceptions/FeatureProtocolNotFoundException.h"
 #include "common/exceptions/FeatureControlException.h"
+#include "common/exceptions/FeatureTimeoutException.h"
+#include "common/exceptions/ProtocolTimeoutException.h"
 #include "vendors/OceanOptics/protocols/ooi/impls/OOISpectrometerProtocol.h"
 #include "api/seabreezeapi/FeatureFamilies.h"
 #include "common/Log.h"
@@ -43,6 +45,7 @@
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPTriggerModeExchange.h"
 #include "vendors/OceanOptics/protocols/obp/impls/OBPSpectrometerProtocol.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPRequestNumberOfBufferedSpectraWithMetadataExchange.h"
+#include <cstring>
 
 using namespace seabreeze;
 using namespace seabreeze::api;
@@ -53,8 +56,20 @@ using namespace std;
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
 
-OOISpectrometerFeature::OOISpectrometerFeature() {
+/* Exchanges that timed out or were cancelled are reported as the more
+ * specific FeatureTimeoutException rather than FeatureControlException.
+ */
+static void throwIfTimeout(const ProtocolException &pe, const string &error) {
+    if(NULL != dynamic_cast<const ProtocolTimeoutException *>(&pe)) {
+        throw FeatureTimeoutException(error);
+    }
+}
 
+OOISpectrometerFeature::OOISpectrometerFeature() {
+    this->pipelinedRequestOutstanding = false;
+    this->pixelRangesResolved = false;
+    this->wavelengthsValid = false;
+    this->pixelRangeWavelengthsValid = false;
 }
 
 OOISpectrometerFeature::~OOISpectrometerFeature() {
@@ -82,8 +97,13 @@ vector<double> *OOISpectrometerFeature::getFormattedSpectrum(const Protocol &pro
         throw FeatureProtocolNotFoundException(error);
     }
 
-    logger.debug("writing requestSpectrum");
-    writeRequestFormattedSpectrum(protocol, bus);
+    if(true == this->pipelinedRequestOutstanding) {
+        /* Consume the spectrum already requested by the pipeline */
+        this->pipelinedRequestOutstanding = false;
+    } else {
+        logger.debug("writing requestSpectrum");
+        writeRequestFormattedSpectrum(protocol, bus);
+    }
 
     vector<double> *retval = NULL;
 
@@ -94,12 +114,201 @@ vector<double> *OOISpectrometerFeature::getFormattedSpectrum(const Protocol &pro
         string error("Caught protocol exception: ");
         error += pe.what();
         /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
         throw FeatureControlException(error);
     }
 
+    if(NULL != retval && false == retval->empty()) {
+        this->corrector.apply(&(*retval)[0], (unsigned int) retval->size());
+    }
+
     return retval;
 }
 
+template <typename T>
+unsigned int OOISpectrometerFeature::readFormattedSpectrumInto(
+        const Protocol &protocol, const Bus &bus, T *buffer,
+        unsigned int bufferLength) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (const FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get a formatted spectrum.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    if(true == this->pipelinedRequestOutstanding) {
+        /* Consume the spectrum already requested by the pipeline */
+        this->pipelinedRequestOutstanding = false;
+    } else {
+        writeRequestFormattedSpectrum(protocol, bus);
+    }
+
+    try {
+        spec->receiveFormattedSpectrum(bus);
+        return spec->decodeFormattedSpectrum(buffer, bufferLength);
+    } catch (const ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
+        throw FeatureControlException(error);
+    }
+}
+
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, double *buffer, unsigned int bufferLength) {
+    unsigned int pixels = readFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+    this->corrector.apply(buffer, pixels);
+    return pixels;
+}
+
+unsigned int OOISpectrometerFeature::getUncorrectedFormattedSpectrum(
+        const Protocol &protocol, const Bus &bus, double *buffer,
+        unsigned int bufferLength) {
+    return readFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+FormattedSpectrumTransferInterface::SampleType OOISpectrometerFeature::getFormattedSampleType(
+        const Protocol &protocol) {
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (const FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get the sample type.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    return spec->getFormattedSampleType();
+}
+
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, unsigned short *buffer, unsigned int bufferLength) {
+    return readFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, unsigned int *buffer, unsigned int bufferLength) {
+    return readFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, float *buffer, unsigned int bufferLength) {
+    return readFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+void OOISpectrometerFeature::beginPipelinedFormattedSpectra(
+        const Protocol &protocol, const Bus &bus) {
+
+    LOG(__FUNCTION__);
+
+    /* Only one request may be in flight at a time */
+    if(true == this->pipelinedRequestOutstanding) {
+        return;
+    }
+
+    writeRequestFormattedSpectrum(protocol, bus);
+    this->pipelinedRequestOutstanding = true;
+}
+
+unsigned int OOISpectrometerFeature::getPipelinedFormattedSpectrum(
+        const Protocol &protocol, const Bus &bus, double *buffer,
+        unsigned int bufferLength) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (const FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get a formatted spectrum.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    beginPipelinedFormattedSpectra(protocol, bus);
+
+    try {
+        /* Whatever happens here, the outstanding request has been consumed */
+        this->pipelinedRequestOutstanding = false;
+        spec->receiveFormattedSpectrum(bus);
+    } catch (const ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        logger.error(error.c_str());
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
+        throw FeatureControlException(error);
+    }
+
+    /* Let the device start on the next spectrum before decoding this one */
+    writeRequestFormattedSpectrum(protocol, bus);
+    this->pipelinedRequestOutstanding = true;
+
+    try {
+        unsigned int pixels = spec->decodeFormattedSpectrum(buffer, bufferLength);
+        this->corrector.apply(buffer, pixels);
+        return pixels;
+    } catch (const ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        logger.error(error.c_str());
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
+        throw FeatureControlException(error);
+    }
+}
+
+void OOISpectrometerFeature::endPipelinedFormattedSpectra(
+        const Protocol &protocol, const Bus &bus) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    if(false == this->pipelinedRequestOutstanding) {
+        return;
+    }
+    this->pipelinedRequestOutstanding = false;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (const FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get a formatted spectrum.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    try {
+        /* Drain the spectrum that was requested but will never be decoded */
+        spec->receiveFormattedSpectrum(bus);
+    } catch (const ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        logger.error(error.c_str());
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
+        throw FeatureControlException(error);
+    }
+}
+
 vector<unsigned char> *OOISpectrometerFeature::getUnformattedSpectrum(
         const Protocol &protocol, const Bus &bus) {
     LOG(__FUNCTION__);
@@ -107,6 +316,34 @@ vector<unsigned char> *OOISpectrometerFeature::getUnformattedSpectrum(
     return readUnformattedSpectrum(protocol, bus);
 }
 
+unsigned int OOISpectrometerFeature::getUnformattedSpectrumLength(
+        const Protocol &protocol) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (const FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get the unformatted spectrum length.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    try {
+        return spec->getUnformattedSpectrumLength();
+    } catch (const ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
+        throw FeatureControlException(error);
+    }
+}
+
 vector<unsigned char> *OOISpectrometerFeature::getFastBufferSpectrum(
 	const Protocol &protocol, const Bus &bus, unsigned int numberOfSamplesToRetrieve) {
 	LOG(__FUNCTION__);
@@ -140,6 +377,7 @@ void OOISpectrometerFeature::writeRequestFormattedSpectrum(const Protocol &proto
         error += pe.what();
         /* FIXME: previous exception should probably be bundled up into the new exception */
         logger.error(error.c_str());
+        throwIfTimeout(pe, error);
         throw FeatureControlException(error);
     }
 }
@@ -172,6 +410,7 @@ void OOISpectrometerFeature::writeRequestUnformattedSpectrum(const Protocol &pro
 		error += pe.what();
 		/* FIXME: previous exception should probably be bundled up into the new exception */
 		logger.error(error.c_str());
+		throwIfTimeout(pe, error);
 		throw FeatureControlException(error);
 	}
 }
@@ -204,6 +443,7 @@ void OOISpectrometerFeature::writeRequestFastBufferSpectrum(const Protocol &prot
 		error += pe.what();
 		/* FIXME: previous exception should probably be bundled up into the new exception */
 		logger.error(error.c_str());
+		throwIfTimeout(pe, error);
 		throw FeatureControlException(error);
 	}
 }
@@ -235,6 +475,7 @@ vector<unsigned char> *OOISpectrometerFeature::readUnformattedSpectrum(const Pro
         error += pe.what();
         logger.error(error.c_str());
         /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
         throw FeatureControlException(error);
     }
 
@@ -270,6 +511,7 @@ vector<unsigned char> *OOISpectrometerFeature::readFastBufferSpectrum(const Prot
 		error += pe.what();
 		logger.error(error.c_str());
 		/* FIXME: previous exception should probably be bundled up into the new exception */
+		throwIfTimeout(pe, error);
 		throw FeatureControlException(error);
 	}
 
@@ -279,11 +521,49 @@ vector<unsigned char> *OOISpectrometerFeature::readFastBufferSpectrum(const Prot
 vector<double> *OOISpectrometerFeature::getWavelengths(const Protocol &protocol,
         const Bus &bus) {
 
+    lock_guard<mutex> lock(this->wavelengthLock);
+
+    if(false == loadWavelengths(protocol, bus)) {
+        return NULL;
+    }
+
+    return new vector<double>(this->wavelengths);
+}
+
+bool OOISpectrometerFeature::loadWavelengths(const Protocol &protocol,
+        const Bus &bus) {
+
+    if(false == this->wavelengthsValid) {
+        /* This may throw a FeatureException, leaving the cache invalid */
+        vector<double> *wl = readWavelengths(protocol, bus);
+        if(NULL == wl) {
+            return false;
+        }
+        this->wavelengths.swap(*wl);
+        delete wl;
+        this->wavelengthsValid = true;
+    }
+
+    return true;
+}
+
+vector<double> *OOISpectrometerFeature::readWavelengths(const Protocol &protocol,
+        const Bus &bus) {
+
     WavelengthEEPROMSlotFeature wlFeature(this->numberOfPixels);
 
     return wlFeature.readWavelengths(protocol, bus);
 }
 
+void OOISpectrometerFeature::invalidateWavelengths() {
+    lock_guard<mutex> lock(this->wavelengthLock);
+
+    this->wavelengthsValid = false;
+    this->pixelRangeWavelengthsValid = false;
+    /* The default pixel ranges depend on the detector as well */
+    this->pixelRangesResolved = false;
+}
+
 void OOISpectrometerFeature::setIntegrationTimeMicros(const Protocol &protocol,
         const Bus &bus, unsigned long time_usec) {
 
@@ -310,8 +590,11 @@ void OOISpectrometerFeature::setIntegrationTimeMicros(const Protocol &protocol,
             string error("Caught protocol exception: ");
             error += pe.what();
             /* FIXME: previous exception should probably be bundled up into the new exception */
+            throwIfTimeout(pe, error);
             throw FeatureControlException(error);
         }
+        /* Irradiance output is scaled by the integration time */
+        this->corrector.setIntegrationTimeMicros(time_usec);
     } else {
         string error("Specified integration time is out of range.");
         throw IllegalArgumentException(error);
@@ -358,11 +641,32 @@ void OOISpectrometerFeature::setTriggerMode(const Protocol &protocol,
         error += pe.what();
         logger.error(error.c_str());
         /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
         throw FeatureControlException(error);
     }
 
 }
 
+bool OOISpectrometerFeature::setSpectrumTimeout(const Protocol &protocol,
+        const Bus &bus, unsigned int timeoutMillis) {
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to set spectrum timeout.");
+        logger.error(error.c_str());
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    return spec->setSpectrumTimeout(bus, timeoutMillis);
+}
+
 vector<SpectrometerTriggerMode *> OOISpectrometerFeature::getTriggerModes() const {
     return this->triggerModes;
 }
@@ -399,6 +703,309 @@ int OOISpectrometerFeature::getMaximumIntensity() const {
     return this->maxIntensity;
 }
 
+void OOISpectrometerFeature::setNonlinearityCoefficients(
+        const vector<double> &coefficients, unsigned int maxCount) {
+    this->corrector.setNonlinearityCoefficients(coefficients, maxCount);
+}
+
+bool OOISpectrometerFeature::hasNonlinearityCoefficients() const {
+    return this->corrector.hasNonlinearityCoefficients();
+}
+
+void OOISpectrometerFeature::setStrayLightCoefficients(
+        const vector<double> &coefficients) {
+    this->corrector.setStrayLightCoefficients(coefficients, this->numberOfPixels);
+}
+
+bool OOISpectrometerFeature::hasStrayLightCoefficients() const {
+    return this->corrector.hasStrayLightCoefficients();
+}
+
+void OOISpectrometerFeature::setSpectrumCorrection(bool correctDarkCounts,
+        bool correctNonlinearity, bool correctStrayLight) {
+    /* Subclasses fill in the dark pixels after this constructor has run */
+    this->corrector.setDarkPixelIndices(this->electricDarkPixelIndices);
+    this->corrector.setEnabled(correctDarkCounts, correctNonlinearity,
+            correctStrayLight);
+}
+
+void OOISpectrometerFeature::setIrradianceCalibration(
+        const vector<double> &calibration, const vector<double> &wavelengths) {
+    this->corrector.setIrradianceCalibration(calibration, wavelengths);
+}
+
+bool OOISpectrometerFeature::hasIrradianceCalibration() const {
+    return this->corrector.hasIrradianceCalibration();
+}
+
+void OOISpectrometerFeature::setIrradianceOutput(bool enable,
+        double collectionArea) {
+    if(true == enable && 0 == this->corrector.getIntegrationTimeMicros()) {
+        string error("The integration time must be set before irradiance output is enabled.");
+        throw IllegalArgumentException(error);
+    }
+    this->corrector.setIrradianceOutput(enable, collectionArea);
+}
+
+void OOISpectrometerFeature::applySpectrumCorrection(double *buffer,
+        unsigned int length) const {
+    this->corrector.apply(buffer, length);
+}
+
+void OOISpectrometerFeature::setPixelRanges(const vector<unsigned int> &ranges) {
+    unsigned int i;
+
+    if(true == ranges.empty()) {
+        clearPixelRanges();
+        return;
+    }
+
+    if(0 != ranges.size() % 2 || ranges.size() > 2 * (size_t) this->numberOfPixels) {
+        string error("Pixel ranges must be pairs of first and last pixel.");
+        throw IllegalArgumentException(error);
+    }
+
+    for(i = 0; i < ranges.size(); i += 2) {
+        if(ranges[i] > ranges[i + 1] || ranges[i + 1] >= this->numberOfPixels) {
+            string error("Specified pixel range is outside of the detector.");
+            throw IllegalArgumentException(error);
+        }
+    }
+
+    lock_guard<mutex> lock(this->wavelengthLock);
+    this->pixelRanges = ranges;
+    this->pixelRangesResolved = false;
+    this->pixelRangeWavelengthsValid = false;
+}
+
+void OOISpectrometerFeature::clearPixelRanges() {
+    lock_guard<mutex> lock(this->wavelengthLock);
+    this->pixelRanges.clear();
+    this->pixelRangesResolved = false;
+    this->pixelRangeWavelengthsValid = false;
+}
+
+vector<unsigned int> OOISpectrometerFeature::getPixelRanges() {
+    lock_guard<mutex> lock(this->wavelengthLock);
+    return resolvePixelRanges();
+}
+
+unsigned int OOISpectrometerFeature::getPixelRangeLength() {
+    lock_guard<mutex> lock(this->wavelengthLock);
+    return countPixelRanges(resolvePixelRanges());
+}
+
+unsigned int OOISpectrometerFeature::countPixelRanges(
+        const vector<unsigned int> &ranges) {
+    unsigned int length = 0;
+    unsigned int i;
+
+    for(i = 0; i + 1 < ranges.size(); i += 2) {
+        length += ranges[i + 1] - ranges[i] + 1;
+    }
+    return length;
+}
+
+const vector<unsigned int> &OOISpectrometerFeature::resolvePixelRanges() {
+    if(false == this->pixelRangesResolved) {
+        if(true == this->pixelRanges.empty()) {
+            this->resolvedPixelRanges = getDefaultPixelRanges();
+        } else {
+            this->resolvedPixelRanges = this->pixelRanges;
+        }
+        this->pixelRangesResolved = true;
+    }
+    return this->resolvedPixelRanges;
+}
+
+vector<unsigned int> OOISpectrometerFeature::getDefaultPixelRanges() const {
+    vector<unsigned int> ranges;
+    unsigned int first;
+    unsigned int last;
+    unsigned int i;
+
+    if(0 == this->numberOfPixels) {
+        return ranges;
+    }
+
+    /* Devices with introspection report their active pixels as ranges */
+    for(i = 0; i + 1 < this->activePixelIndices.size(); i += 2) {
+        first = this->activePixelIndices[i];
+        last = this->activePixelIndices[i + 1];
+        if(last >= this->numberOfPixels) {
+            last = this->numberOfPixels - 1;
+        }
+        if(first <= last) {
+            ranges.push_back(first);
+            ranges.push_back(last);
+        }
+    }
+    if(false == ranges.empty()) {
+        return ranges;
+    }
+
+    /* Otherwise take the runs of pixels between the dark pixels */
+    vector<bool> dark(this->numberOfPixels, false);
+    for(i = 0; i < this->electricDarkPixelIndices.size(); i++) {
+        if(this->electricDarkPixelIndices[i] < this->numberOfPixels) {
+            dark[this->electricDarkPixelIndices[i]] = true;
+        }
+    }
+    for(i = 0; i < this->opticalDarkPixelIndices.size(); i++) {
+        if(this->opticalDarkPixelIndices[i] < this->numberOfPixels) {
+            dark[this->opticalDarkPixelIndices[i]] = true;
+        }
+    }
+    for(i = 0; i < this->numberOfPixels; i++) {
+        if(true == dark[i]) {
+            continue;
+        }
+        if(false == ranges.empty() && ranges.back() + 1 == i) {
+            ranges.back() = i;
+        } else {
+            ranges.push_back(i);
+            ranges.push_back(i);
+        }
+    }
+    return ranges;
+}
+
+unsigned int OOISpectrometerFeature::getPixelRangeSpectrum(const Protocol &protocol,
+        const Bus &bus, double *buffer, unsigned int bufferLength) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+    unsigned int pixels = 0;
+    unsigned int count;
+    unsigned int i;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (const FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get a formatted spectrum.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    /* Work on a copy so the ranges can be changed during the transfer */
+    vector<unsigned int> ranges;
+    {
+        lock_guard<mutex> lock(this->wavelengthLock);
+        ranges = resolvePixelRanges();
+    }
+
+    if(true == this->pipelinedRequestOutstanding) {
+        /* Consume the spectrum already requested by the pipeline */
+        this->pipelinedRequestOutstanding = false;
+    } else {
+        writeRequestFormattedSpectrum(protocol, bus);
+    }
+
+    try {
+        spec->receiveFormattedSpectrum(bus);
+
+        if(false == this->corrector.isEnabled()
+                && true == spec->canDecodeFormattedSpectrumRange()) {
+            /* Only the selected pixels are decoded */
+            for(i = 0; i + 1 < ranges.size() && pixels < bufferLength; i += 2) {
+                count = ranges[i + 1] - ranges[i] + 1;
+                if(count > bufferLength - pixels) {
+                    count = bufferLength - pixels;
+                }
+                pixels += spec->decodeFormattedSpectrumRange(ranges[i],
+                        buffer + pixels, count);
+            }
+            return pixels;
+        }
+
+        /* Dark and stray light corrections need every pixel, as do
+         * exchanges that cannot address single pixels.
+         */
+        this->pixelRangeSource.resize(this->numberOfPixels);
+        pixels = spec->decodeFormattedSpectrum(this->pixelRangeSource.empty()
+                ? NULL : &this->pixelRangeSource[0],
+                (unsigned int) this->pixelRangeSource.size());
+    } catch (const ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throwIfTimeout(pe, error);
+        throw FeatureControlException(error);
+    }
+
+    if(0 == pixels) {
+        return 0;
+    }
+    this->corrector.apply(&this->pixelRangeSource[0], pixels);
+    return gatherRanges(ranges, &this->pixelRangeSource[0], pixels, buffer,
+            bufferLength);
+}
+
+unsigned int OOISpectrometerFeature::gatherPixelRanges(const double *spectrum,
+        unsigned int length, double *buffer, unsigned int bufferLength) {
+    lock_guard<mutex> lock(this->wavelengthLock);
+    return gatherRanges(resolvePixelRanges(), spectrum, length, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerFeature::gatherRanges(const vector<unsigned int> &ranges,
+        const double *spectrum, unsigned int length, double *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels = 0;
+    unsigned int first;
+    unsigned int count;
+    unsigned int i;
+
+    for(i = 0; i + 1 < ranges.size() && pixels < bufferLength; i += 2) {
+        first = ranges[i];
+        if(first >= length) {
+            /* e.g. the ranges were set before the detector was binned */
+            continue;
+        }
+        count = ((ranges[i + 1] < length) ? ranges[i + 1] + 1 : length) - first;
+        if(count > bufferLength - pixels) {
+            count = bufferLength - pixels;
+        }
+        memcpy(buffer + pixels, spectrum + first, count * sizeof(double));
+        pixels += count;
+    }
+    return pixels;
+}
+
+vector<double> *OOISpectrometerFeature::getPixelRangeWavelengths(
+        const Protocol &protocol, const Bus &bus) {
+
+    lock_guard<mutex> lock(this->wavelengthLock);
+
+    if(false == this->pixelRangeWavelengthsValid) {
+        if(false == loadWavelengths(protocol, bus)) {
+            return NULL;
+        }
+        /* Overlapping ranges may select more values than there are pixels */
+        const vector<unsigned int> &ranges = resolvePixelRanges();
+        unsigned int length = countPixelRanges(ranges);
+        this->pixelRangeWavelengths.resize(length);
+        if(false == this->wavelengths.empty() && 0 != length) {
+            length = gatherRanges(ranges, &this->wavelengths[0],
+                    (unsigned int) this->wavelengths.size(),
+                    &this->pixelRangeWavelengths[0], length);
+        }
+        this->pixelRangeWavelengths.resize(length);
+        this->pixelRangeWavelengthsValid = true;
+    }
+
+    return new vector<double>(this->pixelRangeWavelengths);
+}
+
+
+bool OOISpectrometerFeature::initialize(const Protocol &protocol, const Bus &bus) {
+    /* A different device (or calibration) may be behind this feature now */
+    invalidateWavelengths();
+
+    return FeatureImpl::initialize(protocol, bus);
+}
 
 FeatureFamily OOISpectrometerFeature::getFeatureFamily() {
     FeatureFamilies families;
@@ -94,7 +94,7 @@ QE65000SpectrometerFeature::~QE65000SpectrometerFeature() {
 
 }
 
-vector<double> *QE65000SpectrometerFeature::getWavelengths(
+vector<double> *QE65000SpectrometerFeature::readWavelengths(
             const Protocol &protocol, const Bus &bus) {
 
     WavelengthEEPROMSlotFeature_QE65000 wlFeature(this->numberOfPixels);
@@ -95,9 +95,11 @@ void STSSpectrometerFeature::setPixelBinningFactor(unsigned char factor) {
     readUnformattedSpectrum->setNumberOfPixels(numberOfPixels * 2 + 64, numberOfPixels);
 	readFastBufferSpectrum->setNumberOfPixels(numberOfPixels * 2 + 64, numberOfPixels);
     readFormattedSpectrum->setNumberOfPixels(numberOfPixels * 2 + 64, numberOfPixels);
+    /* Binned wavelengths are averages over the new bins */
+    invalidateWavelengths();
 }
 
-vector<double> *STSSpectrometerFeature::getWavelengths(const Protocol &protocol,
+vector<double> *STSSpectrometerFeature::readWavelengths(const Protocol &protocol,
             const Bus &bus) {
 
     /* FIXME: this probably ought to attempt to create an instance based on
@@ -90,7 +90,7 @@ SparkSpectrometerFeature::~SparkSpectrometerFeature() {
 }
 
 
-vector<double> *SparkSpectrometerFeature::getWavelengths(const Protocol &protocol,
+vector<double> *SparkSpectrometerFeature::readWavelengths(const Protocol &protocol,
             const Bus &bus) {
 
     /* FIXME: this probably ought to attempt to create an instance based on
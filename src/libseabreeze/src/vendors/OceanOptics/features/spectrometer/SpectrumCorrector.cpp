@@ -0,0 +1,329 @@
+/***************************************************//**
+ * @file    SpectrumCorrector.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "vendors/OceanOptics/features/spectrometer/SpectrumCorrector.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SEABREEZE_CORRECTOR_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace seabreeze;
+using namespace std;
+
+/* Beyond this many counts a table costs more memory than it saves time */
+#define MAXIMUM_TABLE_COUNT     (1 << 20)
+
+SpectrumCorrector::SpectrumCorrector() {
+    this->correctDarkCounts = false;
+    this->correctNonlinearity = false;
+    this->correctStrayLight = false;
+    this->collectionArea = 0.0;
+    this->integrationTimeMicros = 0;
+    this->irradianceOutput = false;
+}
+
+SpectrumCorrector::~SpectrumCorrector() {
+
+}
+
+void SpectrumCorrector::setDarkPixelIndices(const vector<unsigned int> &indices) {
+    this->darkPixelIndices = indices;
+}
+
+void SpectrumCorrector::setNonlinearityCoefficients(
+        const vector<double> &coeffs, unsigned int maxCount) {
+    unsigned int i;
+
+    this->coefficients = coeffs;
+    this->reciprocalTable.clear();
+    if(true == this->coefficients.empty() || 0 == maxCount
+            || maxCount > MAXIMUM_TABLE_COUNT) {
+        return;
+    }
+
+    /* One extra entry so that interpolation below maxCount never reads
+     * past the end.
+     */
+    this->reciprocalTable.resize((size_t) maxCount + 2);
+    for(i = 0; i < this->reciprocalTable.size(); i++) {
+        this->reciprocalTable[i] = 1.0 / evaluate((double) i);
+    }
+}
+
+bool SpectrumCorrector::hasNonlinearityCoefficients() const {
+    return false == this->coefficients.empty();
+}
+
+void SpectrumCorrector::setStrayLightCoefficients(
+        const vector<double> &coeffs, unsigned int length) {
+    unsigned int i;
+    size_t k;
+
+    this->strayLightFractions.clear();
+    if(true == coeffs.empty()) {
+        return;
+    }
+
+    this->strayLightFractions.resize(length);
+    for(i = 0; i < length; i++) {
+        double fraction = 0.0;
+        for(k = coeffs.size(); k > 0; k--) {
+            fraction = fraction * (double) i + coeffs[k - 1];
+        }
+        this->strayLightFractions[i] = fraction;
+    }
+}
+
+bool SpectrumCorrector::hasStrayLightCoefficients() const {
+    return false == this->strayLightFractions.empty();
+}
+
+void SpectrumCorrector::setEnabled(bool darkCounts, bool nonlinearity,
+        bool strayLight) {
+    this->correctDarkCounts = darkCounts;
+    this->correctNonlinearity = nonlinearity && hasNonlinearityCoefficients();
+    this->correctStrayLight = strayLight && hasStrayLightCoefficients();
+}
+
+bool SpectrumCorrector::isEnabled() const {
+    return this->correctDarkCounts || this->correctNonlinearity
+            || this->correctStrayLight || this->irradianceOutput;
+}
+
+void SpectrumCorrector::setIrradianceCalibration(
+        const vector<double> &calibration, const vector<double> &wavelengths) {
+    size_t pixels = calibration.size();
+    size_t i;
+
+    if(wavelengths.size() < pixels) {
+        pixels = wavelengths.size();
+    }
+
+    /* Each pixel spans half the distance to either neighbour */
+    this->irradiancePerBin.resize(pixels);
+    for(i = 0; i < pixels; i++) {
+        double width;
+        if(pixels < 2) {
+            width = 1.0;
+        } else if(0 == i) {
+            width = wavelengths[1] - wavelengths[0];
+        } else if(pixels - 1 == i) {
+            width = wavelengths[i] - wavelengths[i - 1];
+        } else {
+            width = (wavelengths[i + 1] - wavelengths[i - 1]) / 2.0;
+        }
+        this->irradiancePerBin[i] = (0.0 != width) ? calibration[i] / width : 0.0;
+    }
+    updateIrradianceFactors();
+}
+
+bool SpectrumCorrector::hasIrradianceCalibration() const {
+    return false == this->irradiancePerBin.empty();
+}
+
+void SpectrumCorrector::setIrradianceOutput(bool enable, double area) {
+    this->collectionArea = area;
+    this->irradianceOutput = enable && hasIrradianceCalibration();
+    updateIrradianceFactors();
+}
+
+void SpectrumCorrector::setIntegrationTimeMicros(unsigned long micros) {
+    if(micros == this->integrationTimeMicros) {
+        return;
+    }
+    this->integrationTimeMicros = micros;
+    updateIrradianceFactors();
+}
+
+unsigned long SpectrumCorrector::getIntegrationTimeMicros() const {
+    return this->integrationTimeMicros;
+}
+
+void SpectrumCorrector::updateIrradianceFactors() {
+    size_t i;
+
+    if(false == this->irradianceOutput || 0 == this->integrationTimeMicros
+            || this->collectionArea <= 0.0) {
+        this->irradianceFactors.clear();
+        return;
+    }
+
+    double scale = 1.0e6 / ((double) this->integrationTimeMicros * this->collectionArea);
+    this->irradianceFactors.resize(this->irradiancePerBin.size());
+    for(i = 0; i < this->irradiancePerBin.size(); i++) {
+        this->irradianceFactors[i] = this->irradiancePerBin[i] * scale;
+    }
+}
+
+double SpectrumCorrector::evaluate(double x) const {
+    double retval = 0.0;
+    size_t i;
+
+    /* Horner's method, highest order first */
+    for(i = this->coefficients.size(); i > 0; i--) {
+        retval = retval * x + this->coefficients[i - 1];
+    }
+    return retval;
+}
+
+double SpectrumCorrector::getReciprocal(double x) const {
+    size_t last = this->reciprocalTable.size();
+
+    if(last > 1 && x >= 0.0 && x < (double) (last - 1)) {
+        size_t index = (size_t) x;
+        double fraction = x - (double) index;
+        double low = this->reciprocalTable[index];
+        return low + fraction * (this->reciprocalTable[index + 1] - low);
+    }
+    return 1.0 / evaluate(x);
+}
+
+void SpectrumCorrector::apply(double *spectrum, unsigned int length) const {
+    double dark = 0.0;
+    unsigned int darkPixels = 0;
+    unsigned int i;
+
+    if(false == isEnabled()) {
+        return;
+    }
+
+    for(i = 0; i < this->darkPixelIndices.size(); i++) {
+        if(this->darkPixelIndices[i] < length) {
+            dark += spectrum[this->darkPixelIndices[i]];
+            darkPixels++;
+        }
+    }
+    if(darkPixels > 0) {
+        dark /= darkPixels;
+    }
+
+    /* The dark level is only added back if it is not being corrected, and
+     * only after the stray light has been estimated without it.
+     */
+    double restore = (true == this->correctDarkCounts) ? 0.0 : dark;
+    double restoreNow = (true == this->correctStrayLight) ? 0.0 : restore;
+
+    if(true == this->correctNonlinearity) {
+        for(i = 0; i < length; i++) {
+            double x = spectrum[i] - dark;
+            spectrum[i] = x * getReciprocal(x) + restoreNow;
+        }
+    } else if(dark != restoreNow) {
+        for(i = 0; i < length; i++) {
+            spectrum[i] -= dark - restoreNow;
+        }
+    }
+
+    if(true == this->correctStrayLight) {
+        subtractStrayLight(spectrum, length);
+        if(0.0 != restore) {
+            for(i = 0; i < length; i++) {
+                spectrum[i] += restore;
+            }
+        }
+    }
+
+    if(true == this->irradianceOutput) {
+        scaleToIrradiance(spectrum, length);
+    }
+}
+
+void SpectrumCorrector::scaleToIrradiance(double *spectrum,
+        unsigned int length) const {
+    unsigned int pixels = (unsigned int) this->irradianceFactors.size();
+    unsigned int i = 0;
+
+    if(length < pixels) {
+        pixels = length;
+    }
+    if(0 == pixels) {
+        return;
+    }
+
+    const double *factors = &this->irradianceFactors[0];
+#ifdef SEABREEZE_CORRECTOR_SSE2
+    for(; i + 4 <= pixels; i += 4) {
+        _mm_storeu_pd(spectrum + i, _mm_mul_pd(_mm_loadu_pd(spectrum + i),
+                _mm_loadu_pd(factors + i)));
+        _mm_storeu_pd(spectrum + i + 2, _mm_mul_pd(_mm_loadu_pd(spectrum + i + 2),
+                _mm_loadu_pd(factors + i + 2)));
+    }
+#endif
+    for(; i < pixels; i++) {
+        spectrum[i] *= factors[i];
+    }
+}
+
+void SpectrumCorrector::subtractStrayLight(double *spectrum,
+        unsigned int length) const {
+    const double *fractions = &this->strayLightFractions[0];
+    unsigned int pixels = (unsigned int) this->strayLightFractions.size();
+    double sum = 0.0;
+    double mean;
+    unsigned int i = 0;
+
+    if(0 == length) {
+        return;
+    }
+    if(length < pixels) {
+        pixels = length;
+    }
+
+#ifdef SEABREEZE_CORRECTOR_SSE2
+    /* Two independent accumulators keep the adds from serializing */
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    for(; i + 4 <= length; i += 4) {
+        sum0 = _mm_add_pd(sum0, _mm_loadu_pd(spectrum + i));
+        sum1 = _mm_add_pd(sum1, _mm_loadu_pd(spectrum + i + 2));
+    }
+    double partial[2];
+    _mm_storeu_pd(partial, _mm_add_pd(sum0, sum1));
+    sum = partial[0] + partial[1];
+#endif
+    for(; i < length; i++) {
+        sum += spectrum[i];
+    }
+    mean = sum / (double) length;
+
+    i = 0;
+#ifdef SEABREEZE_CORRECTOR_SSE2
+    const __m128d scale = _mm_set1_pd(mean);
+    for(; i + 2 <= pixels; i += 2) {
+        __m128d stray = _mm_mul_pd(scale, _mm_loadu_pd(fractions + i));
+        _mm_storeu_pd(spectrum + i, _mm_sub_pd(_mm_loadu_pd(spectrum + i), stray));
+    }
+#endif
+    for(; i < pixels; i++) {
+        spectrum[i] -= mean * fractions[i];
+    }
+}
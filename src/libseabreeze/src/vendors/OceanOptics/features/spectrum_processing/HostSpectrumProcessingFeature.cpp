@@ -0,0 +1,81 @@
+/***************************************************//**
+ * @file    HostSpectrumProcessingFeature.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Scan averaging and boxcar smoothing settings for
+ * spectrometers that cannot do either on board.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2026, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "vendors/OceanOptics/features/spectrum_processing/HostSpectrumProcessingFeature.h"
+
+using namespace seabreeze;
+using namespace std;
+
+HostSpectrumProcessingFeature::HostSpectrumProcessingFeature() {
+    this->boxcarWidth = 0;
+    this->scansToAverage = 1;
+}
+
+HostSpectrumProcessingFeature::~HostSpectrumProcessingFeature() {
+
+}
+
+unsigned char HostSpectrumProcessingFeature::readSpectrumProcessingBoxcarWidth(
+        const Protocol &/* protocol */, const Bus &/* bus */) {
+    return this->boxcarWidth;
+}
+
+unsigned short int HostSpectrumProcessingFeature::readSpectrumProcessingScansToAverage(
+        const Protocol &/* protocol */, const Bus &/* bus */) {
+    return this->scansToAverage;
+}
+
+void HostSpectrumProcessingFeature::writeSpectrumProcessingBoxcarWidth(
+        const Protocol &/* protocol */, const Bus &/* bus */, unsigned char boxcarWidth) {
+    this->boxcarWidth = boxcarWidth;
+}
+
+void HostSpectrumProcessingFeature::writeSpectrumProcessingScansToAverage(
+        const Protocol &/* protocol */, const Bus &/* bus */, unsigned short int scansToAverage) {
+    if(0 == scansToAverage) {
+        throw IllegalArgumentException(string("At least one scan must be averaged"));
+    }
+    this->scansToAverage = scansToAverage;
+}
+
+unsigned char HostSpectrumProcessingFeature::getBoxcarWidth() const {
+    return this->boxcarWidth;
+}
+
+unsigned short int HostSpectrumProcessingFeature::getScansToAverage() const {
+    return this->scansToAverage;
+}
+
+bool HostSpectrumProcessingFeature::isActive() const {
+    return this->scansToAverage > 1 || this->boxcarWidth > 0;
+}
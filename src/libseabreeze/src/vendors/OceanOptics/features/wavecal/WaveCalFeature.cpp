@@ -65,7 +65,6 @@ vector<double> *WaveCalFeature::readWavelengths(const Protocol &protocol,
     WaveCalProtocolInterface *wavecal = NULL;
     vector<double> *coeffs = NULL;
     ProtocolHelper *proto = NULL;
-    Polynomial<double> *calibration = NULL;
     vector<double> *retval = NULL;
 
     try {
@@ -80,13 +79,12 @@ vector<double> *WaveCalFeature::readWavelengths(const Protocol &protocol,
 
     try {
         coeffs = wavecal->readWavelengthCoeffs(bus);
-        calibration = new Polynomial<double>(coeffs);
+        Polynomial<double> calibration(coeffs);
+        delete coeffs;
         retval = new vector<double>(this->numberOfPixels);
-        for(unsigned int i = 0; i < retval->size(); i++) {
-            (*retval)[i] = calibration->evaluate(i);
+        if(this->numberOfPixels > 0) {
+            calibration.evaluateRange(0.0, &(*retval)[0], this->numberOfPixels);
         }
-        delete calibration;
-        delete coeffs;
     } catch (ProtocolException &pe) {
         string error("Caught protocol exception: ");
         error += pe.what();
@@ -31,6 +31,7 @@
 #include "vendors/OceanOptics/protocols/interfaces/EEPROMProtocolInterface.h"
 
 using namespace seabreeze;
+using namespace std;
 
 EEPROMProtocolInterface::EEPROMProtocolInterface(Protocol *protocol)
     : ProtocolHelper(protocol) {
@@ -40,3 +41,25 @@ EEPROMProtocolInterface::EEPROMProtocolInterface(Protocol *protocol)
 EEPROMProtocolInterface::~EEPROMProtocolInterface() {
 
 }
+
+vector<vector<unsigned char> *> *EEPROMProtocolInterface::readEEPROMSlots(
+        const Bus &bus, const vector<int> &slots) {
+
+    vector<vector<unsigned char> *> *retval = new vector<vector<unsigned char> *>;
+    vector<int>::const_iterator iter;
+
+    try {
+        for(iter = slots.begin(); iter != slots.end(); iter++) {
+            retval->push_back(readEEPROMSlot(bus, *iter));
+        }
+    } catch (const ProtocolException &pe) {
+        vector<vector<unsigned char> *>::iterator slot;
+        for(slot = retval->begin(); slot != retval->end(); slot++) {
+            delete *slot;
+        }
+        delete retval;
+        throw;
+    }
+
+    return retval;
+}
@@ -207,6 +207,55 @@ OBPMessage *OBPMessage::parseByteStream(vector<unsigned char> *message)
     return retval;
 }
 
+unsigned int OBPMessage::findPayloadInByteStream(
+        const vector<unsigned char> *message, unsigned int *messageType,
+        unsigned int *payloadLength)
+{
+    const unsigned int offset = 44;
+    const unsigned int trailerLength = OBP_MESSAGE_CHECKSUM_LENGTH + 4;
+    unsigned int bytesRemaining;
+    unsigned int footerStart;
+
+    if(message->size() < offset + trailerLength)
+	{
+        string errorMessage("OBP Message Error: message is too short");
+        throw IllegalArgumentException(errorMessage);
+    }
+
+    if(0xC1 != (*message)[0] || 0xC0 != (*message)[1])
+	{
+        string errorMessage("Could not find message header");
+        throw IllegalArgumentException(errorMessage);
+    }
+
+    *messageType = ((*message)[8] & 0x00FF)
+                | (((*message)[9] & 0x00FF) << 8)
+                | (((*message)[10] & 0x00FF) << 16)
+                | (((*message)[11] & 0x00FF) << 24);
+    bytesRemaining = ((*message)[40] & 0x00FF)
+                  | (((*message)[41] & 0x00FF) << 8)
+                  | (((*message)[42] & 0x00FF) << 16)
+                  | (((*message)[43] & 0x00FF) << 24);
+    if(bytesRemaining < trailerLength
+            || bytesRemaining > message->size() - offset)
+	{
+        string errorMessage("Invalid bytes remaining field");
+        throw IllegalArgumentException(errorMessage);
+    }
+
+    *payloadLength = bytesRemaining - trailerLength;
+    footerStart = offset + *payloadLength + OBP_MESSAGE_CHECKSUM_LENGTH;
+    if(0xC5 != (*message)[footerStart] || 0xC4 != (*message)[footerStart + 1]
+            || 0xC3 != (*message)[footerStart + 2]
+            || 0xC2 != (*message)[footerStart + 3])
+	{
+        string errorMessage("Could not find message footer");
+        throw IllegalArgumentException(errorMessage);
+    }
+
+    return offset;
+}
+
 vector<unsigned char> *OBPMessage::toByteStream()
 {
     vector<unsigned char> *retval = new vector<unsigned char>;
@@ -45,3 +45,9 @@ vector<unsigned char> *OBPQuery::queryDevice(TransferHelper *helper) {
     return OBPTransaction::queryDevice(helper, this->messageType,
                     this->payload);
 }
+
+vector<vector<unsigned char> *> *OBPQuery::queryDevicePipelined(TransferHelper *helper,
+        const vector<vector<unsigned char> > &payloads) {
+    return OBPTransaction::queryDevicePipelined(helper, this->messageType,
+                    payloads);
+}
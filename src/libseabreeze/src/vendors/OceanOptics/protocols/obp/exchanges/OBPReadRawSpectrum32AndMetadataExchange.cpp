@@ -32,7 +32,9 @@
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
 #include "common/ByteVector.h"
+#include <string.h>     /* for memset() */
 
 using namespace seabreeze;
 using namespace seabreeze::oceanBinaryProtocol;
@@ -45,6 +47,11 @@ using namespace std;
 #define METADATA_LENGTH         32
 #define OBP_MESSAGE_OVERHEAD    64
 
+/* Offsets into the QE-PRO metadata block, all fields little-endian */
+#define METADATA_SPECTRUM_COUNT     0
+#define METADATA_TICK_COUNT         4
+#define METADATA_INTEGRATION_TIME   12
+
 OBPReadRawSpectrum32AndMetadataExchange::OBPReadRawSpectrum32AndMetadataExchange(
         unsigned int pixels) {
 
@@ -52,6 +59,7 @@ OBPReadRawSpectrum32AndMetadataExchange::OBPReadRawSpectrum32AndMetadataExchange
     this->direction = Transfer::FROM_DEVICE;
 
     this->metadataLength = METADATA_LENGTH;
+    this->pixelData = NULL;
     setNumberOfPixels(pixels);
 }
 
@@ -68,6 +76,49 @@ void OBPReadRawSpectrum32AndMetadataExchange::setNumberOfPixels(int pixels) {
     this->buffer->resize(readoutLength);
     this->length = readoutLength;
     checkBufferSize();
+
+    /* Resizing may have moved the buffer that this pointed into */
+    this->pixelData = NULL;
+}
+
+unsigned int OBPReadRawSpectrum32AndMetadataExchange::getUnformattedSpectrumLength() const {
+    /* transfer() returns the metadata and pixels, without the OBP framing */
+    return this->length - OBP_MESSAGE_OVERHEAD;
+}
+
+static unsigned long long readLittleEndian(const unsigned char *bytes,
+        unsigned int length) {
+    unsigned long long value = 0;
+    unsigned int i;
+
+    for(i = length; i > 0; i--) {
+        value = (value << 8) | bytes[i - 1];
+    }
+    return value;
+}
+
+void OBPReadRawSpectrum32AndMetadataExchange::decodeMetadata(
+        FastBufferSpectrumMetadata *metadata) const {
+    const unsigned char *block;
+
+    if(NULL == this->pixelData) {
+        string error("No spectrum has been received to decode.");
+        throw ProtocolException(error);
+    }
+    block = this->pixelData - this->metadataLength;
+
+    memset(metadata, 0, sizeof(FastBufferSpectrumMetadata));
+    metadata->metadataLength = (unsigned short) this->metadataLength;
+    metadata->pixelDataLength = this->numberOfPixels * 4;
+    metadata->pixelDataFormat = FAST_BUFFER_PIXEL_FORMAT_UINT32;
+    metadata->spectrumCount = (unsigned int) readLittleEndian(
+            block + METADATA_SPECTRUM_COUNT, 4);
+    /* The tick count is in microseconds since the device powered up */
+    metadata->microsecondCounter = readLittleEndian(
+            block + METADATA_TICK_COUNT, 8);
+    metadata->integrationTimeMicros = (unsigned int) readLittleEndian(
+            block + METADATA_INTEGRATION_TIME, 4);
+    metadata->scansToAverage = 1;
 }
 
 unsigned int OBPReadRawSpectrum32AndMetadataExchange::isLegalMessageType(unsigned int t) {
@@ -83,6 +134,37 @@ unsigned int OBPReadRawSpectrum32AndMetadataExchange::isLegalMessageType(unsigne
     return 0;
 }
 
+const unsigned char *OBPReadRawSpectrum32AndMetadataExchange::receivePixelData(TransferHelper *helper) {
+    unsigned int offset;
+    unsigned int messageType;
+    unsigned int payloadLength;
+
+    receiveIntoBuffer(helper);
+
+    /* Validate the message in place rather than parsing it into an
+     * OBPMessage, which would copy the payload.
+     */
+    try {
+        offset = OBPMessage::findPayloadInByteStream(this->buffer,
+                &messageType, &payloadLength);
+    } catch (IllegalArgumentException &iae) {
+        string error("Failed to parse message transferred from device");
+        throw ProtocolException(error);
+    }
+
+    if(0 == isLegalMessageType(messageType)) {
+        string error("Did not get expected message type");
+        throw ProtocolException(error);
+    }
+
+    if(payloadLength < (this->numberOfPixels * 4) + METADATA_LENGTH) {
+        string error("Spectrum response does not have enough data.");
+        throw ProtocolException(error);
+    }
+
+    return &(*this->buffer)[offset + this->metadataLength];
+}
+
 Data *OBPReadRawSpectrum32AndMetadataExchange::transfer(TransferHelper *helper) {
     Data *xfer;
     OBPMessage *message = NULL;
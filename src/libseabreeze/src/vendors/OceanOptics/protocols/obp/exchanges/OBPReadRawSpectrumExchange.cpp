@@ -42,11 +42,14 @@ using namespace std;
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
 
+#define OBP_MESSAGE_OVERHEAD    64
+
 OBPReadRawSpectrumExchange::OBPReadRawSpectrumExchange(
         unsigned int readoutLength, unsigned int numPixels) {
 
     this->hints->push_back(new OBPSpectrumHint());
     this->direction = Transfer::FROM_DEVICE;
+    this->pixelData = NULL;
     setNumberOfPixels(readoutLength, numPixels);
 }
 
@@ -60,6 +63,16 @@ void OBPReadRawSpectrumExchange::setNumberOfPixels(unsigned int readoutLength, u
     checkBufferSize();
 
     numberOfPixels = numPixels;
+    /* Resizing may have moved the buffer that this pointed into */
+    this->pixelData = NULL;
+}
+
+unsigned int OBPReadRawSpectrumExchange::getUnformattedSpectrumLength() const {
+    /* transfer() returns the message payload without the OBP header and footer */
+    if(this->length < OBP_MESSAGE_OVERHEAD) {
+        return 0;
+    }
+    return this->length - OBP_MESSAGE_OVERHEAD;
 }
 
 unsigned int OBPReadRawSpectrumExchange::isLegalMessageType(unsigned int t) {
@@ -76,6 +89,37 @@ unsigned int OBPReadRawSpectrumExchange::isLegalMessageType(unsigned int t) {
     return 0;
 }
 
+const unsigned char *OBPReadRawSpectrumExchange::receivePixelData(TransferHelper *helper) {
+    unsigned int offset;
+    unsigned int messageType;
+    unsigned int payloadLength;
+
+    receiveIntoBuffer(helper);
+
+    /* Validate the message in place rather than parsing it into an
+     * OBPMessage, which would copy the payload.
+     */
+    try {
+        offset = OBPMessage::findPayloadInByteStream(this->buffer,
+                &messageType, &payloadLength);
+    } catch (IllegalArgumentException &iae) {
+        string error("Failed to parse message transferred from device");
+        throw ProtocolException(error);
+    }
+
+    if(0 == isLegalMessageType(messageType)) {
+        string error("Did not get expected message type");
+        throw ProtocolException(error);
+    }
+
+    if(payloadLength < (this->numberOfPixels * 2)) {
+        string error("Spectrum response does not have enough data.");
+        throw ProtocolException(error);
+    }
+
+    return &(*this->buffer)[offset];
+}
+
 Data *OBPReadRawSpectrumExchange::transfer(TransferHelper *helper) {
     Data *xfer;
     OBPMessage *message = NULL;
@@ -33,6 +33,7 @@
 
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrum32AndMetadataExchange.h"
 #include "common/U32Vector.h"
+#include "common/PixelDecoder.h"
 #include "common/ByteVector.h"
 
 using namespace seabreeze;
@@ -50,10 +51,6 @@ OBPReadSpectrum32AndMetadataExchange::~OBPReadSpectrum32AndMetadataExchange() {
 
 Data *OBPReadSpectrum32AndMetadataExchange::transfer(TransferHelper *helper) {
     Data *xfer;
-    unsigned char lswlsb;
-    unsigned char lswmsb;
-    unsigned char mswlsb;
-    unsigned char mswmsb;
 
     /* This will use the superclass to transfer data from the device, and will
      * then strip off the message header and footer so that only the
@@ -73,19 +70,65 @@ Data *OBPReadSpectrum32AndMetadataExchange::transfer(TransferHelper *helper) {
     vector<unsigned char> bytes = bv->getByteVector();
 
     vector<unsigned int> formatted(this->numberOfPixels);
-    for(unsigned int i = 0; i < this->numberOfPixels; i++) {
-        lswlsb = bytes[i * 4 + this->metadataLength];
-        lswmsb = bytes[(i * 4) + 1 + this->metadataLength];
-        mswlsb = bytes[(i * 4) + 2 + this->metadataLength];
-        mswmsb = bytes[(i * 4) + 3 + this->metadataLength];
-        formatted[i] =    ((mswmsb & 0x00FF) << 24)
-                        | ((mswlsb & 0x00FF) << 16)
-                        | ((lswmsb & 0x00FF) << 8)
-                        |  (lswlsb & 0x00FF);
-    }
+    PixelDecoder::decodeU32(&bytes[this->metadataLength], &formatted[0],
+            this->numberOfPixels);
     delete xfer;  /* Equivalent to deleting bv and bytes */
 
     U32Vector *retval = new U32Vector(formatted);
 
     return retval;
 }
+
+void OBPReadSpectrum32AndMetadataExchange::receiveFormatted(TransferHelper *helper) {
+    /* The message stays in this->buffer until decodeFormatted() */
+    this->pixelData = receivePixelData(helper);
+}
+
+unsigned int OBPReadSpectrum32AndMetadataExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool OBPReadSpectrum32AndMetadataExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int OBPReadSpectrum32AndMetadataExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+    unsigned int pixels;
+    const unsigned char *raw = this->pixelData;
+
+    if(NULL == raw) {
+        string error("No spectrum has been received to decode.");
+        throw ProtocolException(error);
+    }
+
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    PixelDecoder::decodeU32(raw + 4 * firstPixel, buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType OBPReadSpectrum32AndMetadataExchange::getNativeSampleType() const {
+    return SAMPLE_UINT32;
+}
+
+unsigned int OBPReadSpectrum32AndMetadataExchange::decodeFormatted(unsigned int *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+    const unsigned char *raw = this->pixelData;
+
+    if(NULL == raw) {
+        string error("No spectrum has been received to decode.");
+        throw ProtocolException(error);
+    }
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU32(raw, buffer, pixels);
+
+    return pixels;
+}
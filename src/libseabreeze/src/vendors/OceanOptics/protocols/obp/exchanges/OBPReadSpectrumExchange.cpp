@@ -33,6 +33,7 @@
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
 #include "common/UShortVector.h"
+#include "common/PixelDecoder.h"
 #include "common/ByteVector.h"
 
 using namespace seabreeze;
@@ -51,8 +52,6 @@ OBPReadSpectrumExchange::~OBPReadSpectrumExchange() {
 
 Data *OBPReadSpectrumExchange::transfer(TransferHelper *helper) {
     Data *xfer;
-    unsigned char lsb;
-    unsigned char msb;
 
     /* This will use the superclass to transfer data from the device, and will
      * then strip off the message header and footer so that only the
@@ -72,14 +71,80 @@ Data *OBPReadSpectrumExchange::transfer(TransferHelper *helper) {
     vector<unsigned char> bytes = bv->getByteVector();
 
     vector<unsigned short> formatted(this->numberOfPixels);
-    for(unsigned int i = 0; i < this->numberOfPixels; i++) {
-        lsb = bytes[i * 2];
-        msb = bytes[(i * 2) + 1];
-        formatted[i] = ((msb & 0x00FF) << 8) | (lsb & 0x00FF);
-    }
+    PixelDecoder::decodeU16(&bytes[0], 0, &formatted[0], this->numberOfPixels);
     delete xfer;  /* Equivalent to deleting bv and bytes */
 
     UShortVector *retval = new UShortVector(formatted);
 
     return retval;
 }
+
+void OBPReadSpectrumExchange::receiveFormatted(TransferHelper *helper) {
+    /* The message stays in this->buffer until decodeFormatted() */
+    this->pixelData = receivePixelData(helper);
+}
+
+unsigned int OBPReadSpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool OBPReadSpectrumExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int OBPReadSpectrumExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+    unsigned int pixels;
+    const unsigned char *raw = this->pixelData;
+
+    if(NULL == raw) {
+        string error("No spectrum has been received to decode.");
+        throw ProtocolException(error);
+    }
+
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    PixelDecoder::decodeU16(raw + 2 * firstPixel, 0, buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType OBPReadSpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_UINT16;
+}
+
+unsigned int OBPReadSpectrumExchange::decodeFormatted(unsigned short *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+    const unsigned char *raw = this->pixelData;
+
+    if(NULL == raw) {
+        string error("No spectrum has been received to decode.");
+        throw ProtocolException(error);
+    }
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(raw, 0, buffer, pixels);
+
+    return pixels;
+}
+
+unsigned int OBPReadSpectrumExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+    const unsigned char *raw = this->pixelData;
+
+    if(NULL == raw) {
+        string error("No spectrum has been received to decode.");
+        throw ProtocolException(error);
+    }
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(raw, 0, buffer, pixels);
+
+    return pixels;
+}
@@ -32,8 +32,8 @@
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
-#include "common/UShortVector.h"
 #include "common/DoubleVector.h"
+#include "common/PixelDecoder.h"
 
 using namespace seabreeze;
 using namespace seabreeze::oceanBinaryProtocol;
@@ -52,52 +52,92 @@ OBPReadSpectrumWithGainExchange::~OBPReadSpectrumWithGainExchange() {
 
 Data *OBPReadSpectrumWithGainExchange::transfer(TransferHelper *helper) {
 
-    unsigned int i;
-    Data *xfer;
-    double maxIntensity;
-    double saturationLevel;
-
-    /* This will use the superclass to transfer data from the device, and will
-     * then apply the intensity gain to the result.
-     */
-    xfer = OBPReadSpectrumExchange::transfer(helper);
-    if(NULL == xfer) {
-        string error("Expected Transfer::transfer to produce a non-null result "
-                        "containing spectral data.  Without this data, it is not "
-                        "possible to generate a valid formatted spectrum.");
+    DoubleVector *retval;
+
+    if(NULL == this->spectrometerFeature) {
+        /* FIXME: should this throw an illegal state exception instead? */
+        return OBPReadSpectrumExchange::transfer(helper);
+    }
+
+    /* Validate the message and find the pixels in the receive buffer */
+    this->pixelData = receivePixelData(helper);
+
+    /* Decode and gain-adjust in one pass, straight into the result */
+    retval = new DoubleVector();
+    vector<double> &adjusted = retval->getDoubleVector();
+    adjusted.resize(this->numberOfPixels);
+    PixelDecoder::decodeU16Scaled(this->pixelData, 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            &adjusted[0], this->numberOfPixels);
+
+    return retval;
+}
+
+unsigned int OBPReadSpectrumWithGainExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool OBPReadSpectrumWithGainExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int OBPReadSpectrumWithGainExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+
+    unsigned int pixels;
+
+    if(NULL == this->pixelData) {
+        string error("No spectrum has been received to decode.");
         throw ProtocolException(error);
     }
-    /* xfer should contain a UShortVector */
 
     if(NULL == this->spectrometerFeature) {
         /* FIXME: should this throw an illegal state exception instead? */
-        return xfer;
+        return OBPReadSpectrumExchange::decodeFormattedRange(firstPixel, buffer,
+                bufferLength);
     }
 
-    maxIntensity = this->spectrometerFeature->getMaximumIntensity();
-    saturationLevel = this->spectrometerFeature->getSaturationLevel();
+    /* Decode, gain-adjust and clip in one pass */
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    PixelDecoder::decodeU16Scaled(this->pixelData + 2 * firstPixel, 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType OBPReadSpectrumWithGainExchange::getNativeSampleType() const {
+    return SAMPLE_FLOAT;
+}
 
-    /* Cast the formatted values so that we can get to the array of shorts */
-    UShortVector *usv = static_cast<UShortVector *>(xfer);
-    vector<unsigned short> shortVec = usv->getUShortVector();
+unsigned int OBPReadSpectrumWithGainExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
 
-    /* Create a buffer to store the gain-adjusted values.  This is local. */
-    vector<double> adjusted(this->numberOfPixels);
+    unsigned int pixels;
 
-    for(i = 0; i < this->numberOfPixels; i++) {
-        double temp = shortVec[i] * maxIntensity / saturationLevel;
-        if(temp > maxIntensity) {
-            temp = maxIntensity;
-        }
-        adjusted[i] = temp;
+    if(NULL == this->pixelData) {
+        string error("No spectrum has been received to decode.");
+        throw ProtocolException(error);
     }
 
-    /* It might speed things up to dynamically allocate the buffer and
-     * hand it off to retval rather than letting it make a copy.
-     */
-    DoubleVector *retval = new DoubleVector(adjusted);
+    if(NULL == this->spectrometerFeature) {
+        /* FIXME: should this throw an illegal state exception instead? */
+        return OBPReadSpectrumExchange::decodeFormatted(buffer, bufferLength);
+    }
 
-    delete xfer;
+    /* Decode, gain-adjust and clip in one pass */
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16Scaled(this->pixelData, 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
 
-    return retval;
+    return pixels;
 }
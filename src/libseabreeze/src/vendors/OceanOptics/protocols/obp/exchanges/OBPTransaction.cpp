@@ -39,6 +39,8 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPTransaction.h"
+#include "common/exceptions/BusTimeoutException.h"
+#include "common/exceptions/ProtocolTimeoutException.h"
 
 using namespace seabreeze;
 using namespace seabreeze::oceanBinaryProtocol;
@@ -53,6 +55,17 @@ using namespace std;
 #endif
 
 #define MINIMUM_TRANSFER_SIZE   64
+/* Most messages the device may have to buffer before it answers one */
+#define PIPELINE_DEPTH          8
+
+/* Bus transfers that timed out or were cancelled are reported as the more
+ * specific ProtocolTimeoutException so that callers can tell them apart.
+ */
+static void throwIfTimeout(const BusException &be, const string &error) {
+    if(NULL != dynamic_cast<const BusTimeoutException *>(&be)) {
+        throw ProtocolTimeoutException(error + " " + be.what());
+    }
+}
 
 OBPTransaction::OBPTransaction() {
     this->hints = new vector<ProtocolHint *>;
@@ -106,6 +119,7 @@ vector<unsigned char> *OBPTransaction::queryDevice(TransferHelper *helper,
         string error("Failed to write to bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
+        throwIfTimeout(be, error);
         throw ProtocolException(error);
     }
 
@@ -202,6 +216,7 @@ vector<unsigned char> *OBPTransaction::queryDevice(TransferHelper *helper,
         string error("Failed to read from bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
+        throwIfTimeout(be, error);
         throw ProtocolException(error);
     }
     if(NULL == response) {
@@ -253,6 +268,7 @@ bool OBPTransaction::sendCommandToDevice(TransferHelper *helper,
         string error("Failed to write to bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
+        throwIfTimeout(be, error);
         throw ProtocolException(error);
     }
 
@@ -281,6 +297,7 @@ bool OBPTransaction::sendCommandToDevice(TransferHelper *helper,
         string error("Failed to read from bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
+        throwIfTimeout(be, error);
         throw ProtocolException(error);
     }
 
@@ -299,3 +316,136 @@ bool OBPTransaction::sendCommandToDevice(TransferHelper *helper,
     delete response;
     return retval;
 }
+
+vector<vector<unsigned char> *> *OBPTransaction::queryDevicePipelined(
+        TransferHelper *helper, unsigned int messageType,
+        const vector<vector<unsigned char> > &data) {
+
+    unsigned int i;
+    vector<vector<unsigned char> *> *retval
+        = new vector<vector<unsigned char> *>(data.size(), (vector<unsigned char> *)NULL);
+
+    try {
+        if(false == helper->canQueueRequests()) {
+            for(i = 0; i < data.size(); i++) {
+                vector<unsigned char> payload(data[i]);
+                (*retval)[i] = queryDevice(helper, messageType, payload);
+            }
+            return retval;
+        }
+
+        vector<bool> answered(data.size(), false);
+        for(unsigned int first = 0; first < data.size(); first += PIPELINE_DEPTH) {
+            unsigned int last = first + PIPELINE_DEPTH;
+            if(last > data.size()) {
+                last = (unsigned int) data.size();
+            }
+
+            for(i = first; i < last; i++) {
+                OBPMessage message;
+                message.setMessageType(messageType);
+                message.setRegarding(i);
+                message.setData(new vector<unsigned char>(data[i]));
+                vector<unsigned char> *bytes = message.toByteStream();
+                try {
+                    helper->send(*bytes, (unsigned) bytes->size());
+                } catch (const BusException &be) {
+                    delete bytes;
+                    string error("Failed to write to bus.");
+                    throwIfTimeout(be, error);
+                    throw ProtocolException(error);
+                }
+                delete bytes;
+            }
+
+            /* Every queued message gets a reply, so read all of them before
+             * reporting a failure to keep the bus in step.
+             */
+            string error;
+            for(i = first; i < last; i++) {
+                OBPMessage *response = receiveMessage(helper);
+                unsigned int index = response->getRegarding();
+                if(index < first || index >= last || true == answered[index]) {
+                    /* Firmware that does not echo the regarding field still
+                     * answers in order.
+                     */
+                    index = i;
+                }
+                answered[index] = true;
+
+                if(true == response->isNackFlagSet()
+                        || response->getMessageType() != messageType) {
+                    if(true == error.empty()) {
+                        char message[64];
+                        if(response->getMessageType() == messageType) {
+                            snprintf(message, sizeof(message), "OBP Flags indicated an error: %x",
+                                response->getFlags());
+                        } else {
+                            snprintf(message, sizeof(message), "Expected message type 0x%x, but got %x",
+                                messageType, response->getMessageType());
+                        }
+                        error = message;
+                    }
+                } else {
+                    (*retval)[index] = new vector<unsigned char>(*response->getData());
+                }
+                delete response;
+            }
+            if(false == error.empty()) {
+                throw ProtocolException(error);
+            }
+        }
+    } catch (const ProtocolException &pe) {
+        for(i = 0; i < retval->size(); i++) {
+            delete (*retval)[i];
+        }
+        delete retval;
+        throw;
+    }
+
+    return retval;
+}
+
+OBPMessage *OBPTransaction::receiveMessage(TransferHelper *helper) {
+    OBPMessage *header = NULL;
+    OBPMessage *message = NULL;
+    unsigned int bytesRemaining;
+
+    /* Read the 64-byte OBP header, then any extended payload it announces */
+    vector<unsigned char> bytes(64);
+    try {
+        helper->receive(bytes, (unsigned) bytes.size());
+        try {
+            header = OBPMessage::parseHeaderFromByteStream(&bytes);
+        } catch (const IllegalArgumentException &iae) {
+            header = NULL;
+        }
+        if(NULL == header) {
+            string error("Failed to parse message header");
+            throw ProtocolException(error);
+        }
+        bytesRemaining = header->getBytesRemaining();
+        delete header;
+
+        if(bytesRemaining > 20) { /* omit footer and checksum */
+            vector<unsigned char> remainder(bytesRemaining - 20);
+            helper->receive(remainder, (unsigned) remainder.size());
+            bytes.insert(bytes.end(), remainder.begin(), remainder.end());
+        }
+    } catch (const BusException &be) {
+        string error("Failed to read from bus.");
+        throwIfTimeout(be, error);
+        throw ProtocolException(error);
+    }
+
+    try {
+        message = OBPMessage::parseByteStream(&bytes);
+    } catch (const IllegalArgumentException &iae) {
+        message = NULL;
+    }
+    if(NULL == message) {
+        string error("Failed to parse extended message");
+        throw ProtocolException(error);
+    }
+    return message;
+}
@@ -36,6 +36,8 @@
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetConsecutiveSampleCountExchange.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetDataBufferElementCountExchange.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetDataBufferMaximumCapacityExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrum32AndMetadataExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPRequestBufferedSpectrum32AndMetadataExchange.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPSetDataBufferCapacityExchange.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPSetFastBufferingEnableExchange.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPSetConsecutiveSampleCountExchange.h"
@@ -236,3 +238,69 @@ void OBPDataBufferProtocol::setBufferCapacity(const Bus &bus,
     exchange.setBufferCapacity(capacity);
     exchange.sendCommandToDevice(helper);
 }
+
+unsigned int OBPDataBufferProtocol::readBufferedSpectra(const Bus &bus,
+        unsigned char bufferIndex, unsigned int numberOfSpectra,
+        unsigned int numberOfPixels, unsigned int *pixels, unsigned int stride,
+        FastBufferSpectrumMetadata *metadata) {
+
+    if(0 != bufferIndex) {
+        /* At present, this protocol only knows how to deal with one buffer
+         * in the device.  Just do a sanity check to make sure it is zero.
+         */
+        string error("This protocol only supports a single buffer.  The buffer "
+                     "index should be zero.");
+        throw ProtocolException(error);
+    }
+
+    if(0 == numberOfSpectra) {
+        return 0;
+    }
+
+    OBPRequestBufferedSpectrum32AndMetadataExchange request;
+    OBPReadSpectrum32AndMetadataExchange reply(numberOfPixels);
+    unsigned int spectra = 0;
+    unsigned int pending = 0;
+
+    TransferHelper *helper = bus.getHelper(request.getHints());
+    if(NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        throw ProtocolBusMismatchException(error);
+    }
+
+    /* The firmware returns one buffered spectrum per request.  To keep the
+     * bus busy, the request for the next spectrum is written before the
+     * current one is read, so at most one reply is ever outstanding.  Each
+     * reply is decoded straight into the caller's row from the exchange's
+     * receive buffer.
+     */
+    try {
+        request.transfer(helper);
+        pending = 1;
+        while(spectra < numberOfSpectra) {
+            reply.receiveFormatted(helper);
+            pending = 0;
+            if(spectra + 1 < numberOfSpectra) {
+                request.transfer(helper);
+                pending = 1;
+            }
+            reply.decodeFormatted(pixels + (size_t) spectra * stride,
+                    (numberOfPixels < stride) ? numberOfPixels : stride);
+            reply.decodeMetadata(&metadata[spectra]);
+            spectra++;
+        }
+    } catch (const ProtocolException &pe) {
+        if(0 != pending) {
+            /* Do not leave a reply behind for the next command to trip on */
+            try {
+                reply.receiveFormatted(helper);
+            } catch (const ProtocolException &ignored) {
+            }
+        }
+        if(0 == spectra) {
+            throw;
+        }
+    }
+
+    return spectra;
+}
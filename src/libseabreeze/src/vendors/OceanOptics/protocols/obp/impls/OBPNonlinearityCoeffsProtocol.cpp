@@ -74,14 +74,24 @@ vector<double> *OBPNonlinearityCoeffsProtocol::readNonlinearityCoeffs(const Bus
     count = (*countResult)[0];
     delete countResult;
 
+    /* Ask for every coefficient before collecting any of the replies */
+    vector<vector<unsigned char> > requests(count, vector<unsigned char>(1));
+    for(i = 0; i < requests.size(); i++) {
+        requests[i][0] = (unsigned char) i;
+    }
+    vector<vector<unsigned char> *> *results = xchange.queryDevicePipelined(helper, requests);
+
     retval = new vector<double>(count);
     for(i = 0; i < retval->size(); i++) {
-        xchange.setCoefficientIndex(i);
-        result = xchange.queryDevice(helper);
+        result = (*results)[i];
         if(NULL == result) {
             string error("Expected Transfer::transfer to produce a non-null result "
                 "containing linearity coefficient.  Without this data, it is not possible to "
                 "continue.");
+            for(; i < results->size(); i++) {
+                delete (*results)[i];
+            }
+            delete results;
             delete retval;
             throw ProtocolException(error);
         }
@@ -95,6 +105,7 @@ vector<double> *OBPNonlinearityCoeffsProtocol::readNonlinearityCoeffs(const Bus
 
         delete result;
     }
+    delete results;
 
     return retval;
 }
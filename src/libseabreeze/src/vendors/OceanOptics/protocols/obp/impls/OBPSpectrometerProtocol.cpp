@@ -59,6 +59,9 @@ OBPSpectrometerProtocol::OBPSpectrometerProtocol(
 	this->requestFastBufferSpectrumExchange = requestFastBufferSpectrum;
 	this->readFastBufferSpectrumExchange = readFastBufferSpectrum;
     this->triggerModeExchange = triggerMode;
+    this->formattedSpectrumTransfer =
+        dynamic_cast<FormattedSpectrumTransferInterface *>(readFormattedSpectrum);
+    this->pendingSpectrum = NULL;
 }
 
 OBPSpectrometerProtocol::~OBPSpectrometerProtocol() {
@@ -70,6 +73,7 @@ OBPSpectrometerProtocol::~OBPSpectrometerProtocol() {
 	delete this->requestFastBufferSpectrumExchange;
 	delete this->readFastBufferSpectrumExchange;
     delete this->triggerModeExchange;
+    delete this->pendingSpectrum;
 }
 
 void OBPSpectrometerProtocol::Initialize(
@@ -102,6 +106,10 @@ void OBPSpectrometerProtocol::Initialize(
 		delete readFormattedSpectrumExchange;
 	}
 	this->readFormattedSpectrumExchange = readFormattedSpectrum;
+	this->formattedSpectrumTransfer =
+		dynamic_cast<FormattedSpectrumTransferInterface *>(readFormattedSpectrum);
+	delete this->pendingSpectrum;
+	this->pendingSpectrum = NULL;
 
 
 	if (this->requestUnformattedSpectrumExchange != NULL)
@@ -175,6 +183,18 @@ vector<unsigned char> *OBPSpectrometerProtocol::readUnformattedSpectrum(const Bu
     return retval;
 }
 
+unsigned int OBPSpectrometerProtocol::getUnformattedSpectrumLength() {
+    UnformattedSpectrumTransferInterface *unformatted =
+        dynamic_cast<UnformattedSpectrumTransferInterface *>(this->readUnformattedSpectrumExchange);
+
+    if(NULL == unformatted) {
+        string error("Unformatted spectrum length is not known without a readout.");
+        throw ProtocolException(error);
+    }
+
+    return unformatted->getUnformattedSpectrumLength();
+}
+
 vector<unsigned char> *OBPSpectrometerProtocol::readFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve)
 {
 	Data *result;
@@ -271,6 +291,119 @@ vector<double> *OBPSpectrometerProtocol::readFormattedSpectrum(const Bus &bus) {
     return retval;
 }
 
+unsigned int OBPSpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        double *buffer, unsigned int bufferLength) {
+
+    /* These may cause a ProtocolException to be thrown. */
+    receiveFormattedSpectrum(bus);
+    return decodeFormattedSpectrum(buffer, bufferLength);
+}
+
+void OBPSpectrometerProtocol::receiveFormattedSpectrum(const Bus &bus) {
+    TransferHelper *helper;
+
+    /* Discard anything that was received but never decoded */
+    delete this->pendingSpectrum;
+    this->pendingSpectrum = NULL;
+
+    if(NULL == this->formattedSpectrumTransfer) {
+        /* This exchange cannot decode into a caller-supplied buffer, so
+         * fall back to the vector version and copy out of that later.
+         */
+        this->pendingSpectrum = readFormattedSpectrum(bus);
+        if(NULL == this->pendingSpectrum) {
+            string error("Got NULL when expecting spectral data which was unexpected.");
+            throw ProtocolException(error);
+        }
+        return;
+    }
+
+    helper = bus.getHelper(this->readFormattedSpectrumExchange->getHints());
+    if (NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        throw ProtocolBusMismatchException(error);
+    }
+
+    /* This may cause a ProtocolException to be thrown. */
+    this->formattedSpectrumTransfer->receiveFormatted(helper);
+}
+
+unsigned int OBPSpectrometerProtocol::decodeFormattedSpectrum(double *buffer,
+        unsigned int bufferLength) {
+    unsigned int i;
+    unsigned int pixels;
+
+    if(NULL == this->pendingSpectrum) {
+        if(NULL == this->formattedSpectrumTransfer) {
+            string error("No spectrum has been received to decode.");
+            throw ProtocolException(error);
+        }
+        /* This may cause a ProtocolException to be thrown. */
+        return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+    }
+
+    pixels = ((unsigned int)this->pendingSpectrum->size() < bufferLength)
+            ? (unsigned int)this->pendingSpectrum->size() : bufferLength;
+    for(i = 0; i < pixels; i++) {
+        buffer[i] = (*this->pendingSpectrum)[i];
+    }
+    delete this->pendingSpectrum;
+    this->pendingSpectrum = NULL;
+    return pixels;
+}
+
+bool OBPSpectrometerProtocol::canDecodeFormattedSpectrumRange() {
+    /* A spectrum held in pendingSpectrum is consumed by decoding it */
+    return NULL != this->formattedSpectrumTransfer
+            && this->formattedSpectrumTransfer->canDecodeFormattedRange();
+}
+
+unsigned int OBPSpectrometerProtocol::decodeFormattedSpectrumRange(
+        unsigned int firstPixel, double *buffer, unsigned int bufferLength) {
+    if(false == canDecodeFormattedSpectrumRange()) {
+        string error("Formatted spectra from this device cannot be decoded by range.");
+        throw ProtocolException(error);
+    }
+
+    /* This may cause a ProtocolException to be thrown. */
+    return this->formattedSpectrumTransfer->decodeFormattedRange(firstPixel,
+            buffer, bufferLength);
+}
+
+FormattedSpectrumTransferInterface::SampleType OBPSpectrometerProtocol::getFormattedSampleType() {
+    if(NULL == this->formattedSpectrumTransfer) {
+        /* Only the vector version of readFormattedSpectrum() is available */
+        return FormattedSpectrumTransferInterface::SAMPLE_DOUBLE;
+    }
+    return this->formattedSpectrumTransfer->getNativeSampleType();
+}
+
+void OBPSpectrometerProtocol::checkFormattedSampleType(
+        FormattedSpectrumTransferInterface::SampleType type) {
+    if(type != getFormattedSampleType()) {
+        string error("Formatted spectra from this device cannot be decoded to the requested type.");
+        throw ProtocolException(error);
+    }
+}
+
+unsigned int OBPSpectrometerProtocol::decodeFormattedSpectrum(unsigned short *buffer,
+        unsigned int bufferLength) {
+    checkFormattedSampleType(FormattedSpectrumTransferInterface::SAMPLE_UINT16);
+    return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+}
+
+unsigned int OBPSpectrometerProtocol::decodeFormattedSpectrum(unsigned int *buffer,
+        unsigned int bufferLength) {
+    checkFormattedSampleType(FormattedSpectrumTransferInterface::SAMPLE_UINT32);
+    return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+}
+
+unsigned int OBPSpectrometerProtocol::decodeFormattedSpectrum(float *buffer,
+        unsigned int bufferLength) {
+    checkFormattedSampleType(FormattedSpectrumTransferInterface::SAMPLE_FLOAT);
+    return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+}
+
 void OBPSpectrometerProtocol::requestFormattedSpectrum(const Bus &bus) {
     TransferHelper *helper;
 
@@ -348,3 +481,23 @@ void OBPSpectrometerProtocol::setTriggerMode(const Bus &bus,
     /* This may cause a ProtocolException to be thrown. */
     this->triggerModeExchange->sendCommandToDevice(helper);
 }
+
+bool OBPSpectrometerProtocol::setSpectrumTimeout(const Bus &bus, unsigned int timeoutMillis) {
+    Transfer *exchanges[] = {
+        this->readFormattedSpectrumExchange,
+        this->readUnformattedSpectrumExchange,
+        this->readFastBufferSpectrumExchange
+    };
+    bool retval = true;
+
+    for(unsigned int i = 0; i < sizeof(exchanges) / sizeof(exchanges[0]); i++) {
+        if(NULL == exchanges[i]) {
+            continue;
+        }
+        TransferHelper *helper = bus.getHelper(exchanges[i]->getHints());
+        if(NULL == helper || false == helper->setTimeout(timeoutMillis)) {
+            retval = false;
+        }
+    }
+    return retval;
+}
@@ -32,6 +32,7 @@
 #include <vector>
 #include "vendors/OceanOptics/protocols/ooi/exchanges/FPGASpectrumExchange.h"
 #include "common/UShortVector.h"
+#include "common/PixelDecoder.h"
 #include "common/exceptions/ProtocolFormatException.h"
 
 using namespace seabreeze;
@@ -51,10 +52,7 @@ FPGASpectrumExchange::~FPGASpectrumExchange() {
 Data *FPGASpectrumExchange::transfer(TransferHelper *helper) {
     LOG(__FUNCTION__);
 
-    unsigned int i;
     Data *xfer;
-    unsigned char lsb;
-    unsigned char msb;
 
     /* Use the superclass to move the data into a local buffer. */
     xfer = Transfer::transfer(helper);
@@ -87,14 +85,64 @@ Data *FPGASpectrumExchange::transfer(TransferHelper *helper) {
 
     /* Get a local variable by reference to point to that buffer */
     vector<unsigned short> formatted(this->numberOfPixels);
-
-    for(i = 0; i < this->numberOfPixels; i++) {
-        lsb = (*(this->buffer))[i * 2];
-        msb = ((*(this->buffer))[(i * 2) + 1]);
-        formatted[i] = ((msb << 8) & 0x00FF00) | (lsb & 0x00FF);
-    }
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0, &formatted[0],
+            this->numberOfPixels);
 
     UShortVector *retval = new UShortVector(formatted);
 
     return retval;
 }
+
+void FPGASpectrumExchange::receiveFormatted(TransferHelper *helper) {
+    /* The spectrum stays in this->buffer until decodeFormatted() */
+    receiveSynchronizedSpectrum(helper);
+}
+
+unsigned int FPGASpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool FPGASpectrumExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int FPGASpectrumExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+    LOG(__FUNCTION__);
+
+    unsigned int pixels;
+
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    PixelDecoder::decodeU16(&((*(this->buffer))[2 * firstPixel]), 0, buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType FPGASpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_UINT16;
+}
+
+unsigned int FPGASpectrumExchange::decodeFormatted(unsigned short *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0, buffer, pixels);
+
+    return pixels;
+}
+
+unsigned int FPGASpectrumExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0, buffer, pixels);
+
+    return pixels;
+}
@@ -31,9 +31,8 @@
 
 #include "common/globals.h"
 #include "common/Log.h"
-#include "common/UShortVector.h"
+#include "common/PixelDecoder.h"
 #include "common/DoubleVector.h"
-#include "common/exceptions/ProtocolFormatException.h"
 
 #include "vendors/OceanOptics/protocols/ooi/exchanges/FlameNIRSpectrumExchange.h"
 
@@ -54,69 +53,92 @@ Data *FlameNIRSpectrumExchange::transfer(TransferHelper *helper) {
 
     LOG(__FUNCTION__);
 
-    unsigned int i;
-    Data *xfer;
-    double maxIntensity;
-    double saturationLevel;
-    unsigned char lsb;
-    unsigned char msb;
-
-    // Use the superclass to move the data into a local buffer.
-    // This transfer() may cause a ProtocolException to be thrown.
-    xfer = Transfer::transfer(helper);
-    if(NULL == xfer) {
-        string error("FlameNIRSpectrumExchange::transfer: "
-            "Expected Transfer::transfer to produce a non-null result "
-            "containing raw spectral data.  Without this data, it is not possible to "
-            "generate a valid formatted spectrum.");
-        logger.error(error.c_str());
-        throw ProtocolException(error);
+    DoubleVector *retval;
+
+    if(NULL == this->spectrometerFeature) {
+        // FIXME: should this throw an illegal state exception instead?
+        return Transfer::transfer(helper);
     }
 
-    // At this point, this->buffer should have the raw spectrum data.
+    // There is no synchronization byte to check on the Flame-NIR.
+    receiveIntoBuffer(helper);
 
-    // We would normally check for synchronization byte here, but Flame-NIR
-    // does not send one.
+    // Decode and gain-adjust in one pass, straight into the result
+    retval = new DoubleVector();
+    vector<double> &adjusted = retval->getDoubleVector();
+    adjusted.resize(this->numberOfPixels);
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[0]), 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            &adjusted[0], this->numberOfPixels);
 
-    // Get a local variable by reference to point to that buffer
-    logger.debug("demarshalling");
-    vector<unsigned short> formatted(this->numberOfPixels);
-    for(i = 0; i < this->numberOfPixels; i++) {
-        lsb = (*(this->buffer))[i * 2];
-        msb = ((*(this->buffer))[(i * 2) + 1]);
-        formatted[i] = ((msb << 8) & 0x00ff00) | (lsb & 0x00ff);
-    }
+    return retval;
+}
+
+void FlameNIRSpectrumExchange::receiveFormatted(TransferHelper *helper) {
+    // There is no synchronization byte to check on the Flame-NIR.
+    receiveIntoBuffer(helper);
+}
+
+unsigned int FlameNIRSpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool FlameNIRSpectrumExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int FlameNIRSpectrumExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
 
-    // confirm we can gain-adjust
+    LOG(__FUNCTION__);
+
+    unsigned int pixels;
+
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
     if(NULL == this->spectrometerFeature) {
         // FIXME: should this throw an illegal state exception instead?
-        return xfer;
+        PixelDecoder::decodeU16(&((*(this->buffer))[2 * firstPixel]), 0, buffer, pixels);
+        return pixels;
     }
 
-    // xfer is just a copy of what is already stored in this, so delete it.
-    delete xfer;
+    // Decode, gain-adjust and clip in one pass
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[2 * firstPixel]), 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType FlameNIRSpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_FLOAT;
+}
 
-    maxIntensity = this->spectrometerFeature->getMaximumIntensity();
-    saturationLevel = this->spectrometerFeature->getSaturationLevel();
+unsigned int FlameNIRSpectrumExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
 
-    // Cast the formatted values so that we can get to the array of shorts
-    UShortVector *usv = new UShortVector(formatted);
-    vector<unsigned short> shortVec = usv->getUShortVector();
+    LOG(__FUNCTION__);
 
-    // Create a local buffer to store the gain-adjusted values
-    vector<double> adjusted(this->numberOfPixels);
+    unsigned int pixels;
 
-    for(i = 0; i < this->numberOfPixels; i++) {
-        double temp = shortVec[i] * maxIntensity / saturationLevel;
-        if(temp > maxIntensity) {
-            temp = maxIntensity;
-        }
-        adjusted[i] = temp;
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    if(NULL == this->spectrometerFeature) {
+        // FIXME: should this throw an illegal state exception instead?
+        PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0, buffer, pixels);
+        return pixels;
     }
 
-    // It might speed things up to dynamically allocate the buffer and
-    // hand it off to retval rather than letting it make a copy.
-    DoubleVector *retval = new DoubleVector(adjusted);
+    // Decode, gain-adjust and clip in one pass
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[0]), 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
 
-    return retval;
+    return pixels;
 }
@@ -31,6 +31,7 @@
 #include <vector>
 #include "vendors/OceanOptics/protocols/ooi/exchanges/HRFPGASpectrumExchange.h"
 #include "common/UShortVector.h"
+#include "common/PixelDecoder.h"
 #include "common/exceptions/ProtocolFormatException.h"
 
 using namespace seabreeze;
@@ -48,10 +49,7 @@ HRFPGASpectrumExchange::~HRFPGASpectrumExchange() {
 }
 
 Data *HRFPGASpectrumExchange::transfer(TransferHelper *helper) {
-    unsigned int i;
     Data *xfer;
-    unsigned char lsb;
-    unsigned char msb;
 
     /* Use the superclass to move the data into a local buffer. */
     xfer = Transfer::transfer(helper);
@@ -83,14 +81,64 @@ Data *HRFPGASpectrumExchange::transfer(TransferHelper *helper) {
     /* Get a local variable by reference to point to that buffer */
     vector<unsigned short> formatted(this->numberOfPixels);
 
-    for(i = 0; i < this->numberOfPixels; i++) {
-        lsb = (*(this->buffer))[i * 2];
-        /* Flip bit 13 as it is copied out.
-         */
-        msb = ((*(this->buffer))[(i * 2) + 1]) ^ 0x20;
-        formatted[i] = ((msb << 8) & 0x00FF00) | (lsb & 0x00FF);
-    }
+    /* Flip bit 13 as it is copied out.
+     */
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0x2000, &formatted[0],
+            this->numberOfPixels);
     UShortVector *retval = new UShortVector(formatted);
 
     return retval;
 }
+
+void HRFPGASpectrumExchange::receiveFormatted(TransferHelper *helper) {
+    /* The spectrum stays in this->buffer until decodeFormatted() */
+    receiveSynchronizedSpectrum(helper);
+}
+
+unsigned int HRFPGASpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool HRFPGASpectrumExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int HRFPGASpectrumExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+    unsigned int pixels;
+
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    /* Flip bit 13 as it is copied out. */
+    PixelDecoder::decodeU16(&((*(this->buffer))[2 * firstPixel]), 0x2000, buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType HRFPGASpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_UINT16;
+}
+
+unsigned int HRFPGASpectrumExchange::decodeFormatted(unsigned short *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0x2000, buffer, pixels);
+
+    return pixels;
+}
+
+unsigned int HRFPGASpectrumExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0x2000, buffer, pixels);
+
+    return pixels;
+}
@@ -32,9 +32,8 @@
 #include "common/globals.h"
 #include <vector>
 #include "vendors/OceanOptics/protocols/ooi/exchanges/JazSpectrumExchange.h"
-#include "common/UShortVector.h"
 #include "common/DoubleVector.h"
-#include "common/exceptions/ProtocolFormatException.h"
+#include "common/PixelDecoder.h"
 
 using namespace seabreeze;
 using namespace seabreeze::ooiProtocol;
@@ -52,49 +51,24 @@ JazSpectrumExchange::~JazSpectrumExchange() {
 }
 
 Data *JazSpectrumExchange::transfer(TransferHelper *helper) {
-    unsigned int i;
-    Data *xfer;
-    double maxIntensity;
-    double saturationLevel;
-
-    /* Use the superclass to move the data into a local buffer. */
-    xfer = Transfer::transfer(helper);
-    if(NULL == xfer) {
-        string error("Expected Transfer::transfer to produce a non-null result "
-                "containing raw spectral data.  Without this data, it is not possible to "
-                "generate a valid formatted spectrum.");
-        throw ProtocolException(error);
-    }
+    DoubleVector *retval;
 
     if(NULL == this->spectrometerFeature) {
         /* FIXME: should this throw an illegal state exception instead? */
-        return xfer;
-    }
-
-    maxIntensity = this->spectrometerFeature->getMaximumIntensity();
-    saturationLevel = this->spectrometerFeature->getSaturationLevel();
-
-    /* Cast the formatted values so that we can get to the array of shorts */
-    UShortVector *usv = static_cast<UShortVector *>(xfer);
-    vector<unsigned short> shortVec = usv->getUShortVector();
-
-    /* Create a buffer to store the gain-adjusted values.  This is local. */
-    vector<double> adjusted(this->numberOfPixels);
-
-    for(i = 0; i < this->numberOfPixels; i++) {
-        double temp = shortVec[i] * maxIntensity / saturationLevel;
-        if(temp > maxIntensity) {
-            temp = maxIntensity;
-        }
-        adjusted[i] = temp;
+        return Transfer::transfer(helper);
     }
 
-    /* It might speed things up to dynamically allocate the buffer and
-     * hand it off to retval rather than letting it make a copy.
-     */
-    DoubleVector *retval = new DoubleVector(adjusted);
+    /* This may cause a ProtocolException to be thrown. */
+    receiveIntoBuffer(helper);
 
-    delete xfer;
+    /* Decode and gain-adjust in one pass, straight into the result */
+    retval = new DoubleVector();
+    vector<double> &adjusted = retval->getDoubleVector();
+    adjusted.resize(this->numberOfPixels);
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[0]), 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            &adjusted[0], this->numberOfPixels);
 
     return retval;
 }
@@ -31,7 +31,7 @@
 #include <vector>
 #include "vendors/OceanOptics/protocols/ooi/exchanges/MayaProSpectrumExchange.h"
 #include "common/DoubleVector.h"
-#include "common/exceptions/ProtocolFormatException.h"
+#include "common/PixelDecoder.h"
 #include "common/Log.h"
 
 using namespace seabreeze;
@@ -52,79 +52,93 @@ MayaProSpectrumExchange::~MayaProSpectrumExchange() {
 Data *MayaProSpectrumExchange::transfer(TransferHelper *helper) {
     LOG(__FUNCTION__);
 
-    unsigned int i;
-    Data *xfer;
-    unsigned char lsb;
-    unsigned char msb;
-    double maxIntensity;
-    double saturationLevel;
-    double scalingFactor;
-
-    /* Use the superclass to move the data into a local buffer. */
-    xfer = Transfer::transfer(helper);
-    if(NULL == xfer) {
-        string error("MayaProSpectrumExchange::transfer: "
-                "Expected Transfer::transfer to produce a non-null result "
-                "containing raw spectral data.  Without this data, it is not possible to "
-                "generate a valid formatted spectrum.");
-        logger.error(error.c_str());
-        throw ProtocolException(error);
-    }
+    DoubleVector *retval;
 
     if(NULL == this->spectrometerFeature) {
         /* FIXME: should this throw an illegal state exception instead? */
         logger.error("no spectrometerFeature");
-        return xfer;
+        return Transfer::transfer(helper);
     }
 
-    maxIntensity = this->spectrometerFeature->getMaximumIntensity();
-    saturationLevel = this->spectrometerFeature->getSaturationLevel();
-
-    scalingFactor = maxIntensity/(double)saturationLevel;
-
-    /* xfer is just a copy of what is already stored in this, so delete it. */
-    delete xfer;
-    /* At this point, this->buffer should have the raw spectrum data. */
-
-    /* In this style of transfer, the last byte should be 0x69.  If it is not, then
-     * we have probably lost synchronization with the data stream.
-     */
-    if((*(this->buffer))[this->length - 1] != 0x69) {
-        string synchError("MayaProSpectrumExchange::transfer: "
-                "Did not find expected synch byte (0x69) at the end of spectral data "
-                "transfer.  This suggests that the data stream is now out of synchronization, "
-                "or possibly that an underlying read operation failed prematurely due to bus "
-                "issues.");
-        logger.error(synchError.c_str());
-        throw ProtocolFormatException(synchError);
+    /* This may cause a ProtocolException to be thrown. */
+    receiveSynchronizedSpectrum(helper);
+
+    /* Decode and gain-adjust in one pass, straight into the result */
+    retval = new DoubleVector();
+    vector<double> &adjusted = retval->getDoubleVector();
+    adjusted.resize(this->numberOfPixels);
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[0]), 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            &adjusted[0], this->numberOfPixels);
+
+    return retval;
+}
+
+void MayaProSpectrumExchange::receiveFormatted(TransferHelper *helper) {
+    /* The spectrum stays in this->buffer until decodeFormatted() */
+    receiveSynchronizedSpectrum(helper);
+}
+
+unsigned int MayaProSpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool MayaProSpectrumExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int MayaProSpectrumExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+    LOG(__FUNCTION__);
+
+    unsigned int pixels;
+
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    if(NULL == this->spectrometerFeature) {
+        /* FIXME: should this throw an illegal state exception instead? */
+        logger.error("no spectrometerFeature");
+        PixelDecoder::decodeU16(&((*(this->buffer))[2 * firstPixel]), 0, buffer, pixels);
+        return pixels;
     }
 
-    /* Get a local variable by reference to point to that buffer */
-    vector<double> formatted(this->numberOfPixels);
-
-    for(i = 0; i < this->numberOfPixels; i++) {
-        unsigned int pixel;
-        double processedPixel;
-        lsb = (*(this->buffer))[i * 2];
-        msb = ((*(this->buffer))[(i * 2) + 1]);
-        /* Assemble the MSB and LSB into a single 16-bit integer */
-        pixel = ((msb << 8) & 0x00FF00) | (lsb & 0x00FF);
-        /* Cleanly convert to a double */
-        processedPixel = pixel;
-        if(processedPixel >= saturationLevel) {
-            /* If we had a saturation indicator, it would be set here */
-            processedPixel = saturationLevel;
-        }
-        /* Apply the gain adjustment */
-        processedPixel =  pixel * scalingFactor;
-        if(processedPixel > maxIntensity) {
-            processedPixel = maxIntensity;
-        }
-
-        formatted[i] = processedPixel;
-        // logger.debug("MayaProSpectrumExchange::transfer: autonulling changed pixel %4u from %8u to %8.2lf (%5.2lf%%)", i, pixel, formatted[i], 100.0 * formatted[i] / pixel);
+    /* Decode, gain-adjust and clip in one pass */
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[2 * firstPixel]), 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType MayaProSpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_FLOAT;
+}
+
+unsigned int MayaProSpectrumExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
+    LOG(__FUNCTION__);
+
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    if(NULL == this->spectrometerFeature) {
+        /* FIXME: should this throw an illegal state exception instead? */
+        logger.error("no spectrometerFeature");
+        PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0, buffer, pixels);
+        return pixels;
     }
-    DoubleVector *retval = new DoubleVector(formatted);
 
-    return retval;
+    /* Decode, gain-adjust and clip in one pass */
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[0]), 0,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
+
+    return pixels;
 }
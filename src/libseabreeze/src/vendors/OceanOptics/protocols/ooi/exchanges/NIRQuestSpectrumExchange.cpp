@@ -31,9 +31,8 @@
 #include "common/Log.h"
 #include <vector>
 #include "vendors/OceanOptics/protocols/ooi/exchanges/NIRQuestSpectrumExchange.h"
-#include "common/UShortVector.h"
 #include "common/DoubleVector.h"
-#include "common/exceptions/ProtocolFormatException.h"
+#include "common/PixelDecoder.h"
 
 using namespace seabreeze;
 using namespace seabreeze::ooiProtocol;
@@ -54,51 +53,86 @@ Data *NIRQuestSpectrumExchange::transfer(TransferHelper *helper) {
 
     LOG(__FUNCTION__);
 
-    unsigned int i;
-    Data *xfer;
-    double maxIntensity;
-    double saturationLevel;
-
-    /* Use the superclass to get an array of formatted by uncorrected values. */
-    xfer = QESpectrumExchange::transfer(helper);
-    if(NULL == xfer) {
-        string error("NIRQuestSpectrumExchange::transfer: "
-                "Expected QESpectrumExchange::transfer to produce a non-null result "
-                "containing raw spectral data.  Without this data, it is not possible to "
-                "generate a valid formatted spectrum.");
-        logger.error(error.c_str());
-        throw ProtocolException(error);
-    }
+    DoubleVector *retval;
 
     if(NULL == this->spectrometerFeature) {
         /* FIXME: should this throw an illegal state exception instead? */
-        return xfer;
+        return QESpectrumExchange::transfer(helper);
     }
 
-    maxIntensity = this->spectrometerFeature->getMaximumIntensity();
-    saturationLevel = this->spectrometerFeature->getSaturationLevel();
+    /* This may cause a ProtocolException to be thrown. */
+    receiveSynchronizedSpectrum(helper);
+
+    /* Flip bit 15, decode and gain-adjust in one pass, straight into the result */
+    retval = new DoubleVector();
+    vector<double> &adjusted = retval->getDoubleVector();
+    adjusted.resize(this->numberOfPixels);
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[0]), 0x8000,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            &adjusted[0], this->numberOfPixels);
 
-    /* Cast the formatted values so that we can get to the array of shorts */
-    UShortVector *usv = static_cast<UShortVector *>(xfer);
-    vector<unsigned short> shortVec = usv->getUShortVector();
+    return retval;
+}
 
-    /* Create a buffer to store the gain-adjusted values.  This is local. */
-    vector<double> adjusted(this->numberOfPixels);
+unsigned int NIRQuestSpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool NIRQuestSpectrumExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int NIRQuestSpectrumExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+
+    LOG(__FUNCTION__);
+
+    unsigned int pixels;
+
+    if(NULL == this->spectrometerFeature) {
+        /* FIXME: should this throw an illegal state exception instead? */
+        return QESpectrumExchange::decodeFormattedRange(firstPixel, buffer,
+                bufferLength);
+    }
 
-    for(i = 0; i < this->numberOfPixels; i++) {
-        double temp = shortVec[i] * maxIntensity / saturationLevel;
-        if(temp > maxIntensity) {
-            temp = maxIntensity;
-        }
-        adjusted[i] = temp;
+    /* Flip bit 15, decode, gain-adjust and clip in one pass */
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
     }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[2 * firstPixel]), 0x8000,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
+
+    return pixels;
+}
 
-    /* It might speed things up to dynamically allocate the buffer and
-     * hand it off to retval rather than letting it make a copy.
-     */
-    DoubleVector *retval = new DoubleVector(adjusted);
+FormattedSpectrumTransferInterface::SampleType NIRQuestSpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_FLOAT;
+}
 
-    delete xfer;
+unsigned int NIRQuestSpectrumExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
 
-    return retval;
+    LOG(__FUNCTION__);
+
+    unsigned int pixels;
+
+    if(NULL == this->spectrometerFeature) {
+        /* FIXME: should this throw an illegal state exception instead? */
+        return QESpectrumExchange::decodeFormatted(buffer, bufferLength);
+    }
+
+    /* Flip bit 15, decode, gain-adjust and clip in one pass */
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16Scaled(&((*(this->buffer))[0]), 0x8000,
+            this->spectrometerFeature->getGainScale(),
+            this->spectrometerFeature->getMaximumIntensity(),
+            buffer, pixels);
+
+    return pixels;
 }
@@ -31,6 +31,7 @@
 #include <vector>
 #include "vendors/OceanOptics/protocols/ooi/exchanges/OOI2KSpectrumExchange.h"
 #include "common/UShortVector.h"
+#include "common/PixelDecoder.h"
 #include "common/exceptions/ProtocolFormatException.h"
 
 using namespace seabreeze;
@@ -48,12 +49,7 @@ OOI2KSpectrumExchange::~OOI2KSpectrumExchange() {
 }
 
 Data *OOI2KSpectrumExchange::transfer(TransferHelper *helper) {
-    unsigned int i;
     Data *xfer;
-    int lsbPacket;
-    int msbPacket;
-    unsigned char lsb;
-    unsigned char msb;
 
     /* Use the superclass to move the data into a local buffer. */
     xfer = Transfer::transfer(helper);
@@ -84,18 +80,43 @@ Data *OOI2KSpectrumExchange::transfer(TransferHelper *helper) {
     /* Get a local variable by reference to point to that buffer */
     vector<unsigned short> formatted(this->numberOfPixels);
 
-    for(i = 0; i < this->numberOfPixels; i++) {
-        lsbPacket = i >> 6;
-        msbPacket = lsbPacket + 1;
-        lsb = (*(this->buffer))[(lsbPacket << 6) + i];
-        /* Strip everything beyond the 12th bit of the MSB since the
-         * high-order bits are not guaranteed to be pulled low.
-         */
-        msb = ((*(this->buffer))[(msbPacket << 6) + i]) & 0x0F;
-        formatted[i] = (msb << 8) | (lsb & 0x00FF);
-    }
+    /* LSBs and MSBs arrive in alternating 64-byte packets.  Everything
+     * beyond the 12th bit is stripped since the high-order bits of the
+     * MSB are not guaranteed to be pulled low.
+     */
+    PixelDecoder::decodeOOI2K(&((*(this->buffer))[0]), &formatted[0],
+            this->numberOfPixels);
 
     UShortVector *retval = new UShortVector(formatted);
 
     return retval;
 }
+
+void OOI2KSpectrumExchange::receiveFormatted(TransferHelper *helper) {
+    /* The spectrum stays in this->buffer until decodeFormatted() */
+    receiveSynchronizedSpectrum(helper);
+}
+
+unsigned int OOI2KSpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeOOI2K(&((*(this->buffer))[0]), buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType OOI2KSpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_UINT16;
+}
+
+unsigned int OOI2KSpectrumExchange::decodeFormatted(unsigned short *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeOOI2K(&((*(this->buffer))[0]), buffer, pixels);
+
+    return pixels;
+}
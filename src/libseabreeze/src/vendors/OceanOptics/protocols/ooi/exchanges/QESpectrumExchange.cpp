@@ -31,6 +31,7 @@
 #include <vector>
 #include "vendors/OceanOptics/protocols/ooi/exchanges/QESpectrumExchange.h"
 #include "common/UShortVector.h"
+#include "common/PixelDecoder.h"
 #include "common/exceptions/ProtocolFormatException.h"
 #include "common/Log.h"
 
@@ -52,10 +53,7 @@ Data *QESpectrumExchange::transfer(TransferHelper *helper) {
 
     LOG(__FUNCTION__);
 
-    unsigned int i;
     Data *xfer;
-    unsigned char lsb;
-    unsigned char msb;
 
     /* Use the superclass to move the data into a local buffer. */
     /* This transfer() may cause a ProtocolException to be thrown. */
@@ -89,15 +87,67 @@ Data *QESpectrumExchange::transfer(TransferHelper *helper) {
     /* Get a local variable by reference to point to that buffer */
     logger.debug("demarshalling");
     vector<unsigned short> formatted(this->numberOfPixels);
-    for(i = 0; i < this->numberOfPixels; i++) {
-        lsb = (*(this->buffer))[i * 2];
-        /* Flip bit 15 as it is copied out.
-         */
-        msb = ((*(this->buffer))[(i * 2) + 1]) ^ 0x80;
-        formatted[i] = ((msb << 8) & 0x00FF00) | (lsb & 0x00FF);
-    }
+    /* Flip bit 15 as it is copied out.
+     */
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0x8000, &formatted[0],
+            this->numberOfPixels);
 
     UShortVector *retval = new UShortVector(formatted);
 
     return retval;
 }
+
+void QESpectrumExchange::receiveFormatted(TransferHelper *helper) {
+    /* The spectrum stays in this->buffer until decodeFormatted() */
+    receiveSynchronizedSpectrum(helper);
+}
+
+unsigned int QESpectrumExchange::decodeFormatted(double *buffer,
+        unsigned int bufferLength) {
+    return decodeFormattedRange(0, buffer, bufferLength);
+}
+
+bool QESpectrumExchange::canDecodeFormattedRange() const {
+    return true;
+}
+
+unsigned int QESpectrumExchange::decodeFormattedRange(unsigned int firstPixel,
+        double *buffer, unsigned int bufferLength) {
+    LOG(__FUNCTION__);
+
+    unsigned int pixels;
+
+    if(firstPixel >= this->numberOfPixels) {
+        return 0;
+    }
+    pixels = (this->numberOfPixels - firstPixel < bufferLength)
+            ? this->numberOfPixels - firstPixel : bufferLength;
+    /* Flip bit 15 as it is copied out. */
+    PixelDecoder::decodeU16(&((*(this->buffer))[2 * firstPixel]), 0x8000, buffer, pixels);
+
+    return pixels;
+}
+
+FormattedSpectrumTransferInterface::SampleType QESpectrumExchange::getNativeSampleType() const {
+    return SAMPLE_UINT16;
+}
+
+unsigned int QESpectrumExchange::decodeFormatted(unsigned short *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0x8000, buffer, pixels);
+
+    return pixels;
+}
+
+unsigned int QESpectrumExchange::decodeFormatted(float *buffer,
+        unsigned int bufferLength) {
+    unsigned int pixels;
+
+    pixels = (this->numberOfPixels < bufferLength) ? this->numberOfPixels : bufferLength;
+    PixelDecoder::decodeU16(&((*(this->buffer))[0]), 0x8000, buffer, pixels);
+
+    return pixels;
+}
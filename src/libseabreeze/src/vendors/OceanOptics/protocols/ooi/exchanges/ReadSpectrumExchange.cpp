@@ -29,10 +29,13 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/protocols/ooi/exchanges/ReadSpectrumExchange.h"
+#include "common/Log.h"
+#include "common/exceptions/ProtocolFormatException.h"
 #include "vendors/OceanOptics/protocols/ooi/hints/SpectrumHint.h"
 
 using namespace seabreeze;
 using namespace seabreeze::ooiProtocol;
+using namespace std;
 
 
 ReadSpectrumExchange::ReadSpectrumExchange(
@@ -50,3 +53,28 @@ ReadSpectrumExchange::ReadSpectrumExchange(
 ReadSpectrumExchange::~ReadSpectrumExchange() {
 
 }
+
+unsigned int ReadSpectrumExchange::getUnformattedSpectrumLength() const {
+    /* The whole readout, including any synch byte, is returned */
+    return this->length;
+}
+
+void ReadSpectrumExchange::receiveSynchronizedSpectrum(TransferHelper *helper) {
+    LOG(__FUNCTION__);
+
+    /* This may cause a ProtocolException to be thrown. */
+    receiveIntoBuffer(helper);
+
+    /* In this style of transfer, the last byte should be 0x69.  If it is not, then
+     * we have probably lost synchronization with the data stream.
+     */
+    if((*(this->buffer))[this->length - 1] != 0x69) {
+        string synchError("ReadSpectrumExchange::receiveSynchronizedSpectrum: "
+                "Did not find expected synch byte (0x69) at the end of spectral data "
+                "transfer.  This suggests that the data stream is now out of synchronization, "
+                "or possibly that an underlying read operation failed prematurely due to bus "
+                "issues.");
+        logger.error(synchError.c_str());
+        throw ProtocolFormatException(synchError);
+    }
+}
@@ -35,6 +35,7 @@
 #include "vendors/OceanOptics/protocols/ooi/exchanges/ReadEEPROMSlotExchange.h"
 #include "vendors/OceanOptics/protocols/ooi/exchanges/WriteEEPROMSlotExchange.h"
 #include "vendors/OceanOptics/protocols/ooi/impls/OOIProtocol.h"
+#include "vendors/OceanOptics/protocols/ooi/constants/OpCodes.h"
 #include "common/ByteVector.h"
 #include "common/exceptions/ProtocolBusMismatchException.h"
 
@@ -42,6 +43,9 @@ using namespace seabreeze;
 using namespace seabreeze::ooiProtocol;
 using namespace std;
 
+/* Each reply echoes the 2-byte request, followed by the slot contents */
+#define EEPROM_SLOT_REPLY_LENGTH    17
+
 OOIEEPROMProtocol::OOIEEPROMProtocol() : EEPROMProtocolInterface(new OOIProtocol()) {
 
 }
@@ -97,3 +101,59 @@ int OOIEEPROMProtocol::writeEEPROMSlot(const Bus &bus, int slot, const vector<un
 
     return (int) data.size();
 }
+
+vector<vector<unsigned char> *> *OOIEEPROMProtocol::readEEPROMSlots(const Bus &bus,
+        const vector<int> &slots) {
+
+    unsigned int i;
+    ReadEEPROMSlotExchange xchange(0);
+
+    TransferHelper *helper = bus.getHelper(xchange.getHints());
+    if(NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        throw ProtocolBusMismatchException(error);
+    }
+
+    if(slots.size() < 2 || false == helper->canQueueRequests()) {
+        return EEPROMProtocolInterface::readEEPROMSlots(bus, slots);
+    }
+
+    /* Send every request before reading any reply.  The device answers in
+     * order, and each reply echoes its slot number so that can be checked.
+     */
+    vector<unsigned char> request(2);
+    vector<unsigned char> replies(slots.size() * EEPROM_SLOT_REPLY_LENGTH);
+    try {
+        for(i = 0; i < slots.size(); i++) {
+            request[0] = OpCodes::OP_GETINFO;
+            request[1] = (unsigned char) slots[i];
+            helper->send(request, (unsigned) request.size());
+        }
+        vector<unsigned char> reply(EEPROM_SLOT_REPLY_LENGTH);
+        for(i = 0; i < slots.size(); i++) {
+            helper->receive(reply, (unsigned) reply.size());
+            copy(reply.begin(), reply.end(), replies.begin() + i * EEPROM_SLOT_REPLY_LENGTH);
+        }
+    } catch (const BusException &be) {
+        string error("Failed to read EEPROM slots.");
+        throw ProtocolException(error);
+    }
+
+    vector<vector<unsigned char> *> *retval = new vector<vector<unsigned char> *>;
+    for(i = 0; i < slots.size(); i++) {
+        vector<unsigned char>::iterator reply = replies.begin() + i * EEPROM_SLOT_REPLY_LENGTH;
+        if(reply[0] != OpCodes::OP_GETINFO || reply[1] != (unsigned char) slots[i]) {
+            for(unsigned int j = 0; j < retval->size(); j++) {
+                delete (*retval)[j];
+            }
+            delete retval;
+            string error("EEPROM slot reply does not match its request.");
+            throw ProtocolException(error);
+        }
+        // strip off leading two bytes (echoed request)
+        retval->push_back(new vector<unsigned char>(reply + 2,
+            reply + EEPROM_SLOT_REPLY_LENGTH));
+    }
+
+    return retval;
+}
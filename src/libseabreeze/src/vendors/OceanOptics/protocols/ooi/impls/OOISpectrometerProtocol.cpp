@@ -60,7 +60,9 @@ OOISpectrometerProtocol::OOISpectrometerProtocol(
 	this->requestFastBufferSpectrumExchange = requestFastBufferSpectrum;
 	this->readFastBufferSpectrumExchange = readFastBufferSpectrum;
     this->triggerModeExchange = triggerMode;
-
+    this->formattedSpectrumTransfer =
+        dynamic_cast<FormattedSpectrumTransferInterface *>(readFormattedSpectrum);
+    this->pendingSpectrum = NULL;
 }
 
 OOISpectrometerProtocol::~OOISpectrometerProtocol() {
@@ -72,6 +74,7 @@ OOISpectrometerProtocol::~OOISpectrometerProtocol() {
 	delete this->requestFastBufferSpectrumExchange;
 	delete this->readFastBufferSpectrumExchange;
     delete this->triggerModeExchange;
+    delete this->pendingSpectrum;
 }
 
 vector<unsigned char> *OOISpectrometerProtocol::readUnformattedSpectrum(const Bus &bus) {
@@ -111,6 +114,18 @@ vector<unsigned char> *OOISpectrometerProtocol::readUnformattedSpectrum(const Bu
     return retval;
 }
 
+unsigned int OOISpectrometerProtocol::getUnformattedSpectrumLength() {
+    UnformattedSpectrumTransferInterface *unformatted =
+        dynamic_cast<UnformattedSpectrumTransferInterface *>(this->readUnformattedSpectrumExchange);
+
+    if(NULL == unformatted) {
+        string error("Unformatted spectrum length is not known without a readout.");
+        throw ProtocolException(error);
+    }
+
+    return unformatted->getUnformattedSpectrumLength();
+}
+
 vector<unsigned char> *OOISpectrometerProtocol::readFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve) {
 	LOG(__FUNCTION__);
 
@@ -205,6 +220,129 @@ vector<double> *OOISpectrometerProtocol::readFormattedSpectrum(const Bus &bus) {
     return retval;
 }
 
+unsigned int OOISpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        double *buffer, unsigned int bufferLength) {
+
+    /* These may cause a ProtocolException to be thrown. */
+    receiveFormattedSpectrum(bus);
+    return decodeFormattedSpectrum(buffer, bufferLength);
+}
+
+void OOISpectrometerProtocol::receiveFormattedSpectrum(const Bus &bus) {
+    LOG(__FUNCTION__);
+
+    TransferHelper *helper;
+
+    /* Discard anything that was received but never decoded */
+    delete this->pendingSpectrum;
+    this->pendingSpectrum = NULL;
+
+    if(NULL == this->formattedSpectrumTransfer) {
+        /* This exchange cannot decode into a caller-supplied buffer, so
+         * fall back to the vector version and copy out of that later.
+         */
+        this->pendingSpectrum = readFormattedSpectrum(bus);
+        if(NULL == this->pendingSpectrum) {
+            string error("Got NULL when expecting spectral data which was unexpected.");
+            logger.error(error.c_str());
+            throw ProtocolException(error);
+        }
+        return;
+    }
+
+    helper = bus.getHelper(this->readFormattedSpectrumExchange->getHints());
+    if (NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        logger.error(error.c_str());
+        throw ProtocolBusMismatchException(error);
+    }
+
+    /* This may cause a ProtocolException to be thrown. */
+    this->formattedSpectrumTransfer->receiveFormatted(helper);
+}
+
+unsigned int OOISpectrometerProtocol::decodeFormattedSpectrum(double *buffer,
+        unsigned int bufferLength) {
+    LOG(__FUNCTION__);
+
+    unsigned int i;
+    unsigned int pixels;
+
+    if(NULL == this->pendingSpectrum) {
+        if(NULL == this->formattedSpectrumTransfer) {
+            string error("No spectrum has been received to decode.");
+            logger.error(error.c_str());
+            throw ProtocolException(error);
+        }
+        /* This may cause a ProtocolException to be thrown. */
+        return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+    }
+
+    pixels = ((unsigned int)this->pendingSpectrum->size() < bufferLength)
+            ? (unsigned int)this->pendingSpectrum->size() : bufferLength;
+    for(i = 0; i < pixels; i++) {
+        buffer[i] = (*this->pendingSpectrum)[i];
+    }
+    delete this->pendingSpectrum;
+    this->pendingSpectrum = NULL;
+    return pixels;
+}
+
+bool OOISpectrometerProtocol::canDecodeFormattedSpectrumRange() {
+    /* A spectrum held in pendingSpectrum is consumed by decoding it */
+    return NULL != this->formattedSpectrumTransfer
+            && this->formattedSpectrumTransfer->canDecodeFormattedRange();
+}
+
+unsigned int OOISpectrometerProtocol::decodeFormattedSpectrumRange(
+        unsigned int firstPixel, double *buffer, unsigned int bufferLength) {
+    LOG(__FUNCTION__);
+
+    if(false == canDecodeFormattedSpectrumRange()) {
+        string error("Formatted spectra from this device cannot be decoded by range.");
+        logger.error(error.c_str());
+        throw ProtocolException(error);
+    }
+
+    /* This may cause a ProtocolException to be thrown. */
+    return this->formattedSpectrumTransfer->decodeFormattedRange(firstPixel,
+            buffer, bufferLength);
+}
+
+FormattedSpectrumTransferInterface::SampleType OOISpectrometerProtocol::getFormattedSampleType() {
+    if(NULL == this->formattedSpectrumTransfer) {
+        /* Only the vector version of readFormattedSpectrum() is available */
+        return FormattedSpectrumTransferInterface::SAMPLE_DOUBLE;
+    }
+    return this->formattedSpectrumTransfer->getNativeSampleType();
+}
+
+void OOISpectrometerProtocol::checkFormattedSampleType(
+        FormattedSpectrumTransferInterface::SampleType type) {
+    if(type != getFormattedSampleType()) {
+        string error("Formatted spectra from this device cannot be decoded to the requested type.");
+        throw ProtocolException(error);
+    }
+}
+
+unsigned int OOISpectrometerProtocol::decodeFormattedSpectrum(unsigned short *buffer,
+        unsigned int bufferLength) {
+    checkFormattedSampleType(FormattedSpectrumTransferInterface::SAMPLE_UINT16);
+    return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerProtocol::decodeFormattedSpectrum(unsigned int *buffer,
+        unsigned int bufferLength) {
+    checkFormattedSampleType(FormattedSpectrumTransferInterface::SAMPLE_UINT32);
+    return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerProtocol::decodeFormattedSpectrum(float *buffer,
+        unsigned int bufferLength) {
+    checkFormattedSampleType(FormattedSpectrumTransferInterface::SAMPLE_FLOAT);
+    return this->formattedSpectrumTransfer->decodeFormatted(buffer, bufferLength);
+}
+
 void OOISpectrometerProtocol::requestFormattedSpectrum(const Bus &bus) {
     LOG(__FUNCTION__);
 
@@ -291,3 +429,23 @@ void OOISpectrometerProtocol::setTriggerMode(const Bus &bus,
     /* This transfer() may cause a ProtocolException to be thrown. */
     this->triggerModeExchange->transfer(helper);
 }
+
+bool OOISpectrometerProtocol::setSpectrumTimeout(const Bus &bus, unsigned int timeoutMillis) {
+    Transfer *exchanges[] = {
+        this->readFormattedSpectrumExchange,
+        this->readUnformattedSpectrumExchange,
+        this->readFastBufferSpectrumExchange
+    };
+    bool retval = true;
+
+    for(unsigned int i = 0; i < sizeof(exchanges) / sizeof(exchanges[0]); i++) {
+        if(NULL == exchanges[i]) {
+            continue;
+        }
+        TransferHelper *helper = bus.getHelper(exchanges[i]->getHints());
+        if(NULL == helper || false == helper->setTimeout(timeoutMillis)) {
+            retval = false;
+        }
+    }
+    return retval;
+}
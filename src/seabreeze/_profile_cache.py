@@ -0,0 +1,159 @@
+"""
+seabreeze._profile_cache
+========================
+
+on-disk cache for the per-device values read when opening a spectrometer
+
+Each device gets one compact binary file, named by model and serial number.
+It starts with a validation key, followed by a table of sections and then the
+section data as little-endian arrays. Files are memory-mapped when read, and
+replaced atomically when written.
+
+"""
+
+from __future__ import annotations
+
+import mmap
+import os
+import struct
+import tempfile
+from typing import TYPE_CHECKING
+from typing import Mapping
+from typing import Sequence
+
+import numpy
+
+if TYPE_CHECKING:
+    from numpy.typing import NDArray
+
+__all__ = [
+    "ProfileCache",
+]
+
+_MAGIC = b"SBPROF\x00\x01"
+# magic, key length, number of sections
+_HEADER = struct.Struct("<8sII")
+# name, dtype code, padding, data offset, item count
+_SECTION = struct.Struct("<16sc7xQQ")
+_DTYPES = {
+    b"d": numpy.dtype("<f8"),
+    b"q": numpy.dtype("<i8"),
+}
+_ALIGNMENT = 8
+
+
+class ProfileCache:
+    """a directory of cached device profiles
+
+    A profile maps section names (at most 16 ascii characters) to 1D float64
+    or int64 arrays. A profile is only returned if it was stored with the
+    same key, so the key should include everything that invalidates the
+    cached values, e.g. the firmware revision, the number of pixels and a
+    digest of the calibration.
+    """
+
+    def __init__(self, directory: str | os.PathLike[str]) -> None:
+        self.directory = os.fspath(directory)
+
+    def path(self, model: str, serial_number: str) -> str:
+        """return the profile filename for a device"""
+        name = "".join(
+            c if c.isalnum() or c in "-_." else "_"
+            for c in f"{model}-{serial_number}"
+        )
+        return os.path.join(self.directory, f"{name}.sbprofile")
+
+    def load(
+        self, model: str, serial_number: str, key: str
+    ) -> dict[str, NDArray[numpy.generic]] | None:
+        """return the cached profile or None if missing, invalid or stale
+
+        The returned arrays are read-only views of the memory-mapped file.
+        """
+        try:
+            with open(self.path(model, serial_number), "rb") as f:
+                buffer = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        except (OSError, ValueError):
+            # missing, unreadable or empty
+            return None
+        profile = _parse(buffer, key.encode("utf8"))
+        if profile is None:
+            # release the mapping so a fresh profile can replace the file
+            buffer.close()
+        return profile
+
+    def store(
+        self,
+        model: str,
+        serial_number: str,
+        key: str,
+        profile: Mapping[str, Sequence[float] | NDArray[numpy.generic]],
+    ) -> None:
+        """write a profile, replacing any previous one for the device"""
+        encoded_key = key.encode("utf8")
+        arrays = []
+        for name, values in profile.items():
+            arr = numpy.asarray(values)
+            if arr.dtype.kind in "biu":
+                arr = arr.astype("<i8")
+                code = b"q"
+            else:
+                arr = arr.astype("<f8")
+                code = b"d"
+            encoded_name = name.encode("ascii")
+            if len(encoded_name) > 16:
+                raise ValueError(f"section name too long: {name!r}")
+            arrays.append((encoded_name, code, arr.ravel()))
+
+        offset = _HEADER.size + len(encoded_key) + _SECTION.size * len(arrays)
+        table = []
+        for encoded_name, code, arr in arrays:
+            offset += -offset % _ALIGNMENT
+            table.append(_SECTION.pack(encoded_name, code, offset, arr.size))
+            offset += arr.nbytes
+
+        data = bytearray(_HEADER.pack(_MAGIC, len(encoded_key), len(arrays)))
+        data += encoded_key
+        for entry in table:
+            data += entry
+        for _, _, arr in arrays:
+            data += bytes(-len(data) % _ALIGNMENT)
+            data += arr.tobytes()
+
+        os.makedirs(self.directory, exist_ok=True)
+        fd, tmp = tempfile.mkstemp(dir=self.directory, suffix=".tmp")
+        try:
+            with os.fdopen(fd, "wb") as f:
+                f.write(data)
+            os.replace(tmp, self.path(model, serial_number))
+        except BaseException:
+            os.unlink(tmp)
+            raise
+
+
+def _parse(buffer: mmap.mmap, key: bytes) -> dict[str, NDArray[numpy.generic]] | None:
+    """return the sections of a profile if it is valid and matches key"""
+    try:
+        magic, key_length, num_sections = _HEADER.unpack_from(buffer, 0)
+        if magic != _MAGIC:
+            return None
+        pos = _HEADER.size
+        if buffer[pos : pos + key_length] != key:
+            return None
+        pos += key_length
+        sections = []
+        for _ in range(num_sections):
+            name, code, offset, count = _SECTION.unpack_from(buffer, pos)
+            pos += _SECTION.size
+            dtype = _DTYPES[code]
+            if offset + count * dtype.itemsize > len(buffer):
+                return None
+            name = name.rstrip(b"\x00").decode("ascii")
+            sections.append((name, dtype, offset, count))
+    except (struct.error, KeyError, UnicodeDecodeError):
+        return None
+    # only create views once the whole table is valid
+    return {
+        name: numpy.frombuffer(buffer, dtype=dtype, count=count, offset=offset)
+        for name, dtype, offset, count in sections
+    }
@@ -20,7 +20,76 @@ cdef extern from "api/USBEndpointTypes.h":
         kEndpointTypeSecondaryIn2  # generally high speed
 
 
+cdef extern from "api/seabreezeapi/SeaBreezeAPIConstants.h":
+    int SPECTRUM_SAMPLE_TYPE_UINT16
+    int SPECTRUM_SAMPLE_TYPE_UINT32
+    int SPECTRUM_SAMPLE_TYPE_FLOAT
+    int SPECTRUM_SAMPLE_TYPE_DOUBLE
+    int FAST_BUFFER_PIXEL_FORMAT_UINT16
+    int FAST_BUFFER_PIXEL_FORMAT_UINT24
+    int FAST_BUFFER_PIXEL_FORMAT_UINT32
+    int FAST_BUFFER_PIXEL_FORMAT_FLOAT
+
+
+cdef extern from "api/FastBufferSpectrumMetadata.h":
+    ctypedef struct FastBufferSpectrumMetadata:
+        unsigned short metadataProtocolVersion
+        unsigned short metadataLength
+        unsigned int pixelDataLength
+        unsigned long long microsecondCounter
+        unsigned int integrationTimeMicros
+        unsigned int pixelDataFormat
+        unsigned int spectrumCount
+        unsigned int lastSpectrumCount
+        unsigned long long lastMicrosecondCount
+        unsigned short scansToAverage
+
+
+cdef extern from "common/PixelDecoder.h" namespace "seabreeze":
+    cdef cppclass PixelDecoder:
+        enum Implementation:
+            IMPL_AUTO "seabreeze::PixelDecoder::IMPL_AUTO"
+            IMPL_SCALAR "seabreeze::PixelDecoder::IMPL_SCALAR"
+            IMPL_SSE2 "seabreeze::PixelDecoder::IMPL_SSE2"
+            IMPL_AVX2 "seabreeze::PixelDecoder::IMPL_AVX2"
+
+        @staticmethod
+        void decodeU16(const unsigned char *inp, unsigned short xorMask, unsigned short *out, unsigned int count) nogil
+        @staticmethod
+        void decodeU16(const unsigned char *inp, unsigned short xorMask, double *out, unsigned int count) nogil
+        @staticmethod
+        void decodeU16(const unsigned char *inp, unsigned short xorMask, float *out, unsigned int count) nogil
+        @staticmethod
+        void decodeU16Scaled(const unsigned char *inp, unsigned short xorMask, double scale, double limit, double *out, unsigned int count) nogil
+        @staticmethod
+        void decodeU16Scaled(const unsigned char *inp, unsigned short xorMask, double scale, double limit, float *out, unsigned int count) nogil
+        @staticmethod
+        void decodeOOI2K(const unsigned char *inp, unsigned short *out, unsigned int count) nogil
+        @staticmethod
+        void decodeOOI2K(const unsigned char *inp, double *out, unsigned int count) nogil
+        @staticmethod
+        void decodeOOI2K(const unsigned char *inp, float *out, unsigned int count) nogil
+        @staticmethod
+        void decodeU32(const unsigned char *inp, unsigned int *out, unsigned int count) nogil
+        @staticmethod
+        void decodeU32(const unsigned char *inp, double *out, unsigned int count) nogil
+        @staticmethod
+        void decodeU32(const unsigned char *inp, float *out, unsigned int count) nogil
+        @staticmethod
+        void widen(const unsigned short *inp, double *out, unsigned int count) nogil
+        @staticmethod
+        void widen(const unsigned short *inp, float *out, unsigned int count) nogil
+        @staticmethod
+        void widen(const unsigned int *inp, double *out, unsigned int count) nogil
+        @staticmethod
+        void widen(const unsigned int *inp, float *out, unsigned int count) nogil
+        @staticmethod
+        bool setImplementation(Implementation impl) nogil
+
+
 cdef extern from "api/seabreezeapi/SeaBreezeAPI.h":
+    ctypedef void (*SeaBreezeHotplugCallback)(long deviceID, int arrived, void *context) noexcept
+
     # noinspection PyPep8Naming,PyShadowingBuiltins
     cdef cppclass SeaBreezeAPI:
 
@@ -28,20 +97,23 @@ cdef extern from "api/seabreezeapi/SeaBreezeAPI.h":
         SeaBreezeAPI* getInstance() except +
 
         @staticmethod
-        void shutdown() except +
+        void shutdown() except + nogil
 
         int probeDevices()
         int addTCPIPv4DeviceLocation(char *deviceTypeName, char *ipAddr, int port)
         int addRS232DeviceLocation(char *deviceTypeName, char *deviceBusPath, unsigned int baud)
         int getNumberOfDeviceIDs()
         int getDeviceIDs(long *ids, unsigned long maxLength)
+        int addHotplugCallback(SeaBreezeHotplugCallback callback, void *context, int *errorCode) nogil
+        int removeHotplugCallback(SeaBreezeHotplugCallback callback, void *context, int *errorCode) nogil
         int getDeviceType(long id, int *errorCode, char *buffer, unsigned int length)
 
         int getNumberOfSupportedModels()
         int getSupportedModelName(int index, int *errorCode, char *buffer, int bufferLength)
 
         int openDevice(long id, int *errorCode)
-        void closeDevice(long id, int *errorCode)
+        void closeDevice(long id, int *errorCode) nogil
+        void cancelTransfers(long id, int *errorCode) nogil
 
         # Serial number capabilities
         int getNumberOfSerialNumberFeatures(long deviceID, int *errorCode)
@@ -64,14 +136,47 @@ cdef extern from "api/seabreezeapi/SeaBreezeAPI.h":
         unsigned long spectrometerGetMinimumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode)
         unsigned long spectrometerGetMaximumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode)
         double spectrometerGetMaximumIntensity(long deviceID, long spectrometerFeatureID, int *errorCode)
+        void spectrometerSetTransferTimeouts(long deviceID, long spectrometerFeatureID, int *errorCode, long spectrumTimeoutMillis, long controlTimeoutMillis) nogil
+        long spectrometerGetSpectrumTimeoutMillis(long deviceID, long spectrometerFeatureID, int *errorCode)
+        long spectrometerGetControlTimeoutMillis(long deviceID, long spectrometerFeatureID, int *errorCode)
+        void spectrometerSetSpectrumCorrection(long deviceID, long spectrometerFeatureID, int *errorCode, int correctDarkCounts, int correctNonlinearity, int correctStrayLight)
+        void spectrometerSetCorrectionCoefficients(long deviceID, long spectrometerFeatureID, int *errorCode, const double *nonlinearity, int nonlinearityCount, const double *strayLight, int strayLightCount)
+        void spectrometerSetIrradianceOutput(long deviceID, long spectrometerFeatureID, int *errorCode, int enable, float collectionArea)
+        void spectrometerSetResampleGrid(long deviceID, long spectrometerFeatureID, int *errorCode, const double *grid, int gridLength, int method)
+        int spectrometerGetResampleGridLength(long deviceID, long spectrometerFeatureID, int *errorCode)
+        int spectrometerGetResampledSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength) nogil
+        int spectrometerResampleSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, const double *spectra, int count, int stride, double *buffer, int bufferStride) nogil
+        void spectrometerSetPixelRanges(long deviceID, long spectrometerFeatureID, int *errorCode, const unsigned int *pixelIndexPairs, int length)
+        int spectrometerGetPixelRanges(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *pixelIndexPairs, int length)
+        int spectrometerGetPixelRangeLength(long deviceID, long spectrometerFeatureID, int *errorCode)
+        int spectrometerGetPixelRangeSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength) nogil
+        int spectrometerGetPixelRangeWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length)
         int spectrometerGetUnformattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode)
         # int spectrometerGetUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength)
         int spectrometerGetFastBufferSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *dataBuffer, int dataMaxLength, unsigned int numberOfSampleToRetrieve)  # currently 15 max
+        int spectrometerGetFastBufferSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int numberOfSamplesToRetrieve, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) nogil
         int spectrometerGetFormattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode)
         int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength) nogil
+        int spectrometerGetFormattedSampleType(long deviceID, long spectrometerFeatureID, int *errorCode)
+        int spectrometerGetFormattedSpectrumUInt16(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned short *buffer, int bufferLength) nogil
+        int spectrometerGetFormattedSpectrumUInt32(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *buffer, int bufferLength) nogil
+        int spectrometerGetFormattedSpectrumFloat(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength) nogil
+        int spectrometerGetProcessedSpectrumFloat(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength) nogil
+        int spectrometerGetFormattedSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, int count, double *buffer, int stride, unsigned long long *timestampsMicros) nogil
         int spectrometerGetWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length) nogil
         int spectrometerGetElectricDarkPixelCount(long deviceID, long spectrometerFeatureID, int *errorCode)
         int spectrometerGetElectricDarkPixelIndices(long deviceID, long spectrometerFeatureID, int *errorCode, int *indices, int length)
+        void spectrometerStartContinuousAcquisition(long deviceID, long spectrometerFeatureID, int *errorCode, int ringDepth, int pipelined) nogil
+        void spectrometerStopContinuousAcquisition(long deviceID, long spectrometerFeatureID, int *errorCode) nogil
+        int spectrometerIsContinuousAcquisitionRunning(long deviceID, long spectrometerFeatureID, int *errorCode)
+        int spectrometerGetContinuousAcquisitionDepth(long deviceID, long spectrometerFeatureID, int *errorCode)
+        int spectrometerReadContinuousSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, unsigned long long *timestampMicros) nogil
+        void spectrometerGetContinuousAcquisitionStatistics(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long long *framesAcquired, unsigned long long *framesDropped, unsigned long long *overruns, unsigned long long *transferErrors)
+        void spectrometerStartFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode, int queueDepth, int maxBatch, int pollIntervalMicros) nogil
+        void spectrometerStopFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode) nogil
+        int spectrometerIsFastBufferDrainRunning(long deviceID, long spectrometerFeatureID, int *errorCode)
+        int spectrometerReadFastBufferDrain(long deviceID, long spectrometerFeatureID, int *errorCode, int maxSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) nogil
+        void spectrometerGetFastBufferDrainStatistics(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long long *spectraReceived, unsigned long long *spectraMissed, unsigned long long *sequenceGaps, unsigned long long *spectraDropped, unsigned long long *transferErrors)
 
         # Pixel binning capabilities
         int getNumberOfPixelBinningFeatures(long id, int *errorCode)
@@ -265,6 +370,8 @@ cdef extern from "api/seabreezeapi/SeaBreezeAPI.h":
         unsigned long dataBufferGetBufferCapacityMaximum(long deviceID, long featureID, int *errorCode)
         unsigned long dataBufferGetBufferCapacityMinimum(long deviceID, long featureID, int *errorCode)
         void dataBufferSetBufferCapacity(long deviceID, long featureID, int *errorCode, unsigned long capacity)
+        int dataBufferGetBufferedSpectrumLength(long deviceID, long featureID, int *errorCode)
+        int dataBufferReadBufferedSpectra(long deviceID, long featureID, int *errorCode, unsigned int numberOfSpectra, unsigned int *pixels, int stride, FastBufferSpectrumMetadata *metadata) nogil
 
         # Fast Buffer capabilities
         int getNumberOfFastBufferFeatures(long deviceID, int *errorCode)
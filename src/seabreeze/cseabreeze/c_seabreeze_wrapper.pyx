@@ -10,7 +10,7 @@ from libcpp cimport bool as bool_t
 
 cimport seabreeze.cseabreeze.c_seabreeze as csb
 
-import struct
+import traceback
 import weakref
 from collections import namedtuple
 
@@ -34,6 +34,7 @@ class _ErrorCode(object):
     VALUE_NOT_FOUND = 10
     VALUE_NOT_EXPECTED = 11
     INVALID_TRIGGER_MODE = 12
+    TRANSFER_TIMEOUT = 13
 
 
 # define max length for some strings
@@ -57,6 +58,50 @@ SpectrumMetadata = namedtuple(
     ],
 )
 
+# numpy mirror of the FastBufferSpectrumMetadata struct, field for field.
+SpectrumMetadataDType = np.dtype(
+    [
+        ("metadata_protocol_version", np.uint16),
+        ("metadata_length", np.uint16),
+        ("pixel_data_length", np.uint32),
+        ("microsecond_counter", np.uint64),
+        ("integration_time_micros", np.uint32),
+        ("pixel_data_format", np.uint32),
+        ("spectrum_count", np.uint32),
+        ("last_spectrum_count", np.uint32),
+        ("last_microsecond_count", np.uint64),
+        ("scans_to_average", np.uint16),
+    ],
+    align=True,
+)
+assert SpectrumMetadataDType.itemsize == sizeof(csb.FastBufferSpectrumMetadata)
+
+# Define ContinuousAcquisitionStatus structure for the background acquisition thread.
+ContinuousAcquisitionStatus = namedtuple(
+    "ContinuousAcquisitionStatus",
+    [
+        "running",
+        "ring_depth",
+        "frames_acquired",
+        "frames_dropped",
+        "overruns",
+        "transfer_errors"
+    ],
+)
+
+# Define FastBufferDrainStatus structure for the background fast buffer drain.
+FastBufferDrainStatus = namedtuple(
+    "FastBufferDrainStatus",
+    [
+        "running",
+        "spectra_received",
+        "spectra_missed",
+        "sequence_gaps",
+        "spectra_dropped",
+        "transfer_errors"
+    ],
+)
+
 
 # DO NOT DIRECTLY IMPORT EXCEPTIONS FROM HERE!
 # ALWAYS IMPORT FROM `seabreeze.spectrometers`
@@ -75,7 +120,8 @@ class SeaBreezeError(_SeaBreezeError):
         "Error: Spectrometer was saturated",
         "Error: Value not found",
         "Error: Value not expected",
-        "Error: Invalid trigger mode"
+        "Error: Invalid trigger mode",
+        "Error: Transfer timed out or was cancelled"
     )
 
     def __init__(self, message=None, error_code=None):
@@ -119,13 +165,140 @@ class SeaBreezeNotSupported(SeaBreezeError):
     pass
 
 
+# SeaBreezeAPI instances with hotplug callbacks registered in libseabreeze.
+# This keeps them alive while libseabreeze holds a pointer to them.
+_hotplug_api_instances = set()
+
+
+cdef void _hotplug_trampoline(long device_id, int arrived, void *context) noexcept with gil:
+    """call the python hotplug callbacks of a SeaBreezeAPI (internal)"""
+    cdef SeaBreezeAPI api = <SeaBreezeAPI> context
+    if not api._hotplug_callbacks:
+        return
+    dev = _seabreeze_device_factory(device_id)
+    for callback in list(api._hotplug_callbacks):
+        try:
+            callback(dev, bool(arrived))
+        except Exception:
+            traceback.print_exc()
+
+
+_pixel_decoder_implementations = {
+    "scalar": csb.PixelDecoder.Implementation.IMPL_SCALAR,
+    "sse2": csb.PixelDecoder.Implementation.IMPL_SSE2,
+    "avx2": csb.PixelDecoder.Implementation.IMPL_AVX2,
+}
+
+
+@cython.boundscheck(False)
+def _decode_pixels(implementation, pixel_format, raw, int count, int xor_mask=0,
+                   double scale=1.0, double limit=65535.0):
+    """decode raw pixel data with a given set of libseabreeze kernels (internal)
+
+    Meant for checking the SIMD kernels against the scalar ones. Must not be
+    called while other threads are decoding spectra.
+
+    Parameters
+    ----------
+    implementation : str
+        one of 'scalar', 'sse2' or 'avx2'
+    pixel_format : str
+        'u16', 'u16_scaled', 'ooi2k', 'u32', 'widen16' or 'widen32'
+    raw : bytes
+        pixel data as sent by the spectrometer, or host order integers
+        for the widen formats
+    count : int
+        number of pixels to decode
+
+    Returns
+    -------
+    decoded : list[np.ndarray] or None
+        the pixels decoded into each output type the format supports, or
+        None if the kernels are not available on this CPU or build
+
+    Raises
+    ------
+    RuntimeError
+        if a kernel wrote past the last pixel
+    """
+    cdef const unsigned char[::1] inp
+    cdef unsigned short[::1] out_u16
+    cdef unsigned int[::1] out_u32
+    cdef double[::1] out_double
+    cdef float[::1] out_float
+    cdef const unsigned short[::1] in_u16
+    cdef const unsigned int[::1] in_u32
+    cdef unsigned short mask = xor_mask
+
+    required = {
+        "u16": 2 * count,
+        "u16_scaled": 2 * count,
+        "ooi2k": 128 * ((count + 63) // 64),
+        "u32": 4 * count,
+        "widen16": 2 * count,
+        "widen32": 4 * count,
+    }
+    if pixel_format not in required:
+        raise ValueError("unknown pixel format {!r}".format(pixel_format))
+    if count < 0 or len(raw) < required[pixel_format]:
+        raise ValueError("raw data too short for {:d} pixels".format(count))
+
+    native = {"u16": np.uint16, "ooi2k": np.uint16, "u32": np.uint32}.get(pixel_format)
+    outputs = [np.zeros((count + 1, ), dtype=t) for t in (native, np.double, np.single) if t is not None]
+    # padding keeps &inp[0] valid when count is 0
+    raw = bytes(raw) + bytes(4)
+    inp = raw
+
+    if not csb.PixelDecoder.setImplementation(_pixel_decoder_implementations[implementation]):
+        return None
+    try:
+        if pixel_format == "u16":
+            out_u16, out_double, out_float = outputs
+            csb.PixelDecoder.decodeU16(&inp[0], mask, &out_u16[0], count)
+            csb.PixelDecoder.decodeU16(&inp[0], mask, &out_double[0], count)
+            csb.PixelDecoder.decodeU16(&inp[0], mask, &out_float[0], count)
+        elif pixel_format == "u16_scaled":
+            out_double, out_float = outputs
+            csb.PixelDecoder.decodeU16Scaled(&inp[0], mask, scale, limit, &out_double[0], count)
+            csb.PixelDecoder.decodeU16Scaled(&inp[0], mask, scale, limit, &out_float[0], count)
+        elif pixel_format == "ooi2k":
+            out_u16, out_double, out_float = outputs
+            csb.PixelDecoder.decodeOOI2K(&inp[0], &out_u16[0], count)
+            csb.PixelDecoder.decodeOOI2K(&inp[0], &out_double[0], count)
+            csb.PixelDecoder.decodeOOI2K(&inp[0], &out_float[0], count)
+        elif pixel_format == "u32":
+            out_u32, out_double, out_float = outputs
+            csb.PixelDecoder.decodeU32(&inp[0], &out_u32[0], count)
+            csb.PixelDecoder.decodeU32(&inp[0], &out_double[0], count)
+            csb.PixelDecoder.decodeU32(&inp[0], &out_float[0], count)
+        elif pixel_format == "widen16":
+            in_u16 = np.frombuffer(raw, dtype=np.uint16, count=max(count, 1)).copy()
+            out_double, out_float = outputs
+            csb.PixelDecoder.widen(&in_u16[0], &out_double[0], count)
+            csb.PixelDecoder.widen(&in_u16[0], &out_float[0], count)
+        else:
+            in_u32 = np.frombuffer(raw, dtype=np.uint32, count=max(count, 1)).copy()
+            out_double, out_float = outputs
+            csb.PixelDecoder.widen(&in_u32[0], &out_double[0], count)
+            csb.PixelDecoder.widen(&in_u32[0], &out_float[0], count)
+    finally:
+        csb.PixelDecoder.setImplementation(csb.PixelDecoder.Implementation.IMPL_AUTO)
+
+    # each output has one extra element to catch kernels writing past the end
+    if any(out[count] != 0 for out in outputs):
+        raise RuntimeError("{} kernel wrote past {:d} pixels".format(implementation, count))
+    return [out[:count] for out in outputs]
+
+
 cdef class SeaBreezeAPI(object):
     """SeaBreeze API interface"""
 
     cdef csb.SeaBreezeAPI *sbapi
+    cdef list _hotplug_callbacks
 
     def __init__(self, initialize=True):
         self.sbapi = NULL
+        self._hotplug_callbacks = []
         if initialize:
             self.initialize()
 
@@ -143,8 +316,14 @@ cdef class SeaBreezeAPI(object):
         """
         _seabreeze_device_instance_registry.clear()
         if self.sbapi:
-            csb.SeaBreezeAPI.shutdown()
+            # the hotplug thread might be waiting for the GIL
+            with nogil:
+                csb.SeaBreezeAPI.shutdown()
             self.sbapi = NULL
+        # shutting down drops the callbacks of every instance
+        for api in list(_hotplug_api_instances):
+            (<SeaBreezeAPI> api)._hotplug_callbacks = []
+        _hotplug_api_instances.clear()
 
     def add_rs232_device_location(self, device_type, bus_path, baudrate):
         """add RS232 device location
@@ -266,6 +445,66 @@ cdef class SeaBreezeAPI(object):
             devices.append(dev)
         return devices
 
+    def add_hotplug_callback(self, callback):
+        """call a function whenever a spectrometer is attached or detached
+
+        The first callback starts watching the usb bus for hotplug events.
+        From then on the device list is updated as devices come and go, so
+        `list_devices` no longer needs to rescan the bus. Callbacks are
+        called from a background thread as ``callback(device, arrived)``
+        with a SeaBreezeDevice and a bool. A detached device can still be
+        closed, but not used otherwise.
+
+        Parameters
+        ----------
+        callback : callable
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        cdef int ret
+        cdef void *context = <void *> self
+        if not self.sbapi:
+            raise RuntimeError("SeaBreezeAPI not initialized")
+        if not callable(callback):
+            raise TypeError("callback must be callable")
+        if not self._hotplug_callbacks:
+            # a single registration in libseabreeze dispatches to all callbacks
+            with nogil:
+                ret = self.sbapi.addHotplugCallback(_hotplug_trampoline, context, &error_code)
+            if ret != 0:
+                if error_code == _ErrorCode.NOT_IMPLEMENTED:
+                    raise SeaBreezeNotSupported("hotplug events are not supported on this platform")
+                raise SeaBreezeError(error_code=error_code)
+            _hotplug_api_instances.add(self)
+        self._hotplug_callbacks.append(callback)
+
+    def remove_hotplug_callback(self, callback):
+        """stop calling a function registered with `add_hotplug_callback`
+
+        Parameters
+        ----------
+        callback : callable
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        cdef void *context = <void *> self
+        if not self.sbapi:
+            raise RuntimeError("SeaBreezeAPI not initialized")
+        try:
+            self._hotplug_callbacks.remove(callback)
+        except ValueError:
+            raise ValueError("callback is not registered")
+        if not self._hotplug_callbacks:
+            with nogil:
+                self.sbapi.removeHotplugCallback(_hotplug_trampoline, context, &error_code)
+            _hotplug_api_instances.discard(self)
+
     def supported_models(self):
         """returns SeaBreezeDevices supported by the backend
 
@@ -369,13 +608,35 @@ cdef class SeaBreezeDevice(object):
     def close(self):
         """close the spectrometer usb connection
 
+        A transfer blocked in another thread is cancelled first, so that
+        call raises a SeaBreezeError instead of holding up the close.
+
         Returns
         -------
         None
         """
         cdef int error_code
-        # always returns 1
-        self.sbapi.closeDevice(self.handle, &error_code)
+        with nogil:
+            # not every bus can cancel, which is not an error here
+            self.sbapi.cancelTransfers(self.handle, &error_code)
+            # always returns 1
+            self.sbapi.closeDevice(self.handle, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def cancel_transfers(self):
+        """abort any transfer that is blocked on the device
+
+        The blocked call, usually in another thread, raises a SeaBreezeError
+        with the transfer timeout error code. The device stays open.
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        with nogil:
+            self.sbapi.cancelTransfers(self.handle, &error_code)
         if error_code != 0:
             raise SeaBreezeError(error_code=error_code)
 
@@ -758,6 +1019,368 @@ cdef class SeaBreezeSpectrometerFeature(SeaBreezeFeature):
             raise SeaBreezeError(error_code=error_code)
         return float(max_intensity)
 
+    def set_transfer_timeouts(self, spectrum_ms=None, control_ms=None):
+        """limit how long a transfer to or from the spectrometer may block
+
+        A transfer that runs out of time raises a SeaBreezeError with the
+        transfer timeout error code. By default the spectrum timeout is
+        twice the integration time plus a second, or unlimited while an
+        external trigger mode is set, and the control timeout is ten seconds.
+
+        Parameters
+        ----------
+        spectrum_ms : int or None
+            timeout for reading a spectrum in milliseconds, 0 to wait
+            indefinitely, or None for the default
+        control_ms : int or None
+            timeout for all other transfers in milliseconds, 0 to wait
+            indefinitely, or None for the default
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        cdef long cspectrum, ccontrol
+        cspectrum = -1 if spectrum_ms is None else int(spectrum_ms)
+        ccontrol = -1 if control_ms is None else int(control_ms)
+        if (spectrum_ms is not None and cspectrum < 0) or (control_ms is not None and ccontrol < 0):
+            raise ValueError("timeouts must be non-negative or None")
+        with nogil:
+            self.sbapi.spectrometerSetTransferTimeouts(self.device_id, self.feature_id, &error_code,
+                                                       cspectrum, ccontrol)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def get_transfer_timeouts(self):
+        """returns the configured spectrum and control timeouts
+
+        Returns
+        -------
+        spectrum_ms: int or None
+            spectrum timeout in milliseconds, or None for the default
+        control_ms: int or None
+            control timeout in milliseconds, or None for the default
+        """
+        cdef int error_code
+        cdef long cspectrum, ccontrol
+        cspectrum = self.sbapi.spectrometerGetSpectrumTimeoutMillis(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        ccontrol = self.sbapi.spectrometerGetControlTimeoutMillis(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return (None if cspectrum < 0 else int(cspectrum),
+                None if ccontrol < 0 else int(ccontrol))
+
+    def set_spectrum_correction(self, bint correct_dark_counts, bint correct_nonlinearity,
+                                bint correct_stray_light=False):
+        """enable dark count, nonlinearity and stray light correction in the library
+
+        Once enabled, the corrections are applied to every spectrum returned
+        as float64 (`get_intensities`, `get_intensities_batch`, continuous
+        acquisition). The native width spectra stay uncorrected. The
+        nonlinearity and stray light coefficients are read from the device
+        on first use, unless they were supplied with
+        `set_correction_coefficients`.
+
+        Parameters
+        ----------
+        correct_dark_counts : bool
+            subtract the mean of the electric dark pixels
+        correct_nonlinearity : bool
+            linearize the readings with the stored coefficients
+        correct_stray_light : bool
+            subtract the mean intensity times the stray light fraction of
+            each pixel, a polynomial in the pixel index whose coefficients
+            are the stored stray light coefficients
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        self.sbapi.spectrometerSetSpectrumCorrection(self.device_id, self.feature_id, &error_code,
+                                                     correct_dark_counts, correct_nonlinearity,
+                                                     correct_stray_light)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def set_correction_coefficients(self, nonlinearity=None, stray_light=None):
+        """supply the coefficients used by `set_spectrum_correction`
+
+        Coefficients supplied here, e.g. from a cached device profile, are
+        used instead of reading them from the device. None or an empty
+        sequence leaves that set of coefficients unchanged.
+
+        Parameters
+        ----------
+        nonlinearity : array_like or None
+            nonlinearity coefficients, lowest order first
+        stray_light : array_like or None
+            stray light coefficients, lowest order first
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        cdef const double[::1] cnl
+        cdef const double[::1] csl
+        cdef int nl_count, sl_count
+
+        if nonlinearity is None:
+            nonlinearity = ()
+        if stray_light is None:
+            stray_light = ()
+        cnl = np.ascontiguousarray(nonlinearity, dtype=np.double).ravel()
+        csl = np.ascontiguousarray(stray_light, dtype=np.double).ravel()
+        nl_count = cnl.shape[0]
+        sl_count = csl.shape[0]
+        self.sbapi.spectrometerSetCorrectionCoefficients(self.device_id, self.feature_id, &error_code,
+                                                         &cnl[0] if nl_count > 0 else NULL, nl_count,
+                                                         &csl[0] if sl_count > 0 else NULL, sl_count)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def set_irradiance_output(self, bint enable, float collection_area=0.0):
+        """return spectra as irradiance in uW/cm^2/nm
+
+        Once enabled, every spectrum returned as float64 is multiplied by
+        calibration / (integration time * collection area * bin width)
+        after the other corrections. The calibration is read from the
+        device's irradiance calibration feature on first use and the bin
+        widths are derived from the wavelengths once. The factors follow
+        later changes of the integration time automatically.
+
+        Parameters
+        ----------
+        enable : bool
+            turn the irradiance output on or off
+        collection_area : float
+            collection area in cm^2, or 0 to use the area stored on the device
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        self.sbapi.spectrometerSetIrradianceOutput(self.device_id, self.feature_id, &error_code,
+                                                   enable, collection_area)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def set_resample_grid(self, grid, str method="linear"):
+        """resample spectra onto a common wavelength grid
+
+        The source pixels and interpolation weights of every grid point are
+        computed once from the device's wavelengths, so resampling a
+        spectrum is a single weighted gather in the library. Grid points
+        outside the calibrated range take the value of the nearest end pixel.
+
+        Parameters
+        ----------
+        grid : array_like or None
+            target wavelengths in nm, or None to turn resampling off
+        method : {"linear", "cubic"}
+            interpolation between the two neighbouring pixels, or along
+            the cubic through the four nearest pixels
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        cdef double[::1] cgrid
+        cdef int cmethod
+        cdef int length
+
+        try:
+            cmethod = {"linear": 1, "cubic": 2}[method]
+        except KeyError:
+            raise ValueError("method must be 'linear' or 'cubic'")
+        if grid is None:
+            grid = np.empty((0,), dtype=np.double)
+        cgrid = np.ascontiguousarray(grid, dtype=np.double).ravel()
+        length = cgrid.shape[0]
+        self.sbapi.spectrometerSetResampleGrid(self.device_id, self.feature_id, &error_code,
+                                               &cgrid[0] if length > 0 else NULL, length, cmethod)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def get_resampled_intensities(self):
+        """acquires a spectrum and returns it resampled onto the grid
+
+        Returns
+        -------
+        intensities: `np.ndarray`
+            the measured intensities at the wavelengths set with
+            `set_resample_grid`
+        """
+        cdef int error_code
+        cdef int length
+        cdef int values_written
+        cdef double[::1] out
+
+        length = self.sbapi.spectrometerGetResampleGridLength(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        if length == 0:
+            raise SeaBreezeError("no resample grid set")
+        intensities = np.empty((length, ), dtype=np.double)
+        out = intensities
+        with nogil:
+            values_written = self.sbapi.spectrometerGetResampledSpectrum(self.device_id, self.feature_id, &error_code,
+                                                                         &out[0], length)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        assert values_written == length
+        return intensities
+
+    def resample_spectra(self, spectra):
+        """resamples already acquired spectra onto the grid
+
+        Parameters
+        ----------
+        spectra : array_like
+            spectra of this device as rows, shape (n, spectrum_length)
+
+        Returns
+        -------
+        intensities: `np.ndarray`
+            the resampled spectra, shape (n, grid_length)
+        """
+        cdef int error_code
+        cdef int length
+        cdef int n
+        cdef int spectra_written
+        cdef const double[:, ::1] cin
+        cdef double[:, ::1] out
+
+        length = self.sbapi.spectrometerGetResampleGridLength(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        if length == 0:
+            raise SeaBreezeError("no resample grid set")
+        cin = np.ascontiguousarray(spectra, dtype=np.double).reshape(-1, np.shape(spectra)[-1])
+        n = cin.shape[0]
+        intensities = np.empty((n, length), dtype=np.double)
+        if n == 0:
+            return intensities
+        out = intensities
+        with nogil:
+            spectra_written = self.sbapi.spectrometerResampleSpectra(self.device_id, self.feature_id, &error_code,
+                                                                     &cin[0, 0], n, cin.shape[1], &out[0, 0], length)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        assert spectra_written == n
+        return intensities
+
+    def set_pixel_ranges(self, ranges=None):
+        """restrict `get_pixel_range_intensities` to ranges of pixels
+
+        Only the selected pixels are decoded from the spectrum unless
+        corrections are enabled, which need the whole spectrum.
+
+        Parameters
+        ----------
+        ranges : sequence of (int, int) or None
+            pairs of first and last pixel (inclusive), or None for the
+            active pixels, which are also used until ranges are set
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        cdef unsigned int[::1] cpairs
+        cdef int length
+
+        if ranges is None:
+            ranges = ()
+        cpairs = np.ascontiguousarray(ranges, dtype=np.uintc).ravel()
+        length = cpairs.shape[0]
+        if length % 2:
+            raise ValueError("ranges must be pairs of first and last pixel")
+        self.sbapi.spectrometerSetPixelRanges(self.device_id, self.feature_id, &error_code,
+                                              &cpairs[0] if length > 0 else NULL, length)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def get_pixel_ranges(self):
+        """return the pixel ranges in effect
+
+        Returns
+        -------
+        ranges : tuple of (int, int)
+            pairs of first and last pixel (inclusive)
+        """
+        cdef int error_code
+        cdef int length
+        cdef unsigned int[::1] cpairs
+
+        pairs = np.empty((2 * self.number_of_pixels(), ), dtype=np.uintc)
+        cpairs = pairs
+        length = self.sbapi.spectrometerGetPixelRanges(self.device_id, self.feature_id, &error_code,
+                                                       &cpairs[0], cpairs.shape[0])
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return tuple((int(pairs[i]), int(pairs[i + 1])) for i in range(0, length - 1, 2))
+
+    def get_pixel_range_intensities(self):
+        """acquires a spectrum and returns the intensities of the pixel ranges
+
+        Returns
+        -------
+        intensities: `np.ndarray`
+            the intensities of the pixels set with `set_pixel_ranges`,
+            concatenated in order
+        """
+        cdef int error_code
+        cdef int length
+        cdef int values_written
+        cdef double[::1] out
+
+        length = self.sbapi.spectrometerGetPixelRangeLength(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        intensities = np.empty((length, ), dtype=np.double)
+        if length == 0:
+            return intensities
+        out = intensities
+        with nogil:
+            values_written = self.sbapi.spectrometerGetPixelRangeSpectrum(self.device_id, self.feature_id, &error_code,
+                                                                          &out[0], length)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return intensities[:values_written]
+
+    def get_pixel_range_wavelengths(self):
+        """returns the wavelengths of the pixel ranges
+
+        Returns
+        -------
+        wavelengths: `np.ndarray`
+            the wavelengths in nm matching `get_pixel_range_intensities`
+        """
+        cdef int error_code
+        cdef int length
+        cdef int values_written
+        cdef double[::1] out
+
+        length = self.sbapi.spectrometerGetPixelRangeLength(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        wavelengths = np.empty((length, ), dtype=np.double)
+        if length == 0:
+            return wavelengths
+        out = wavelengths
+        values_written = self.sbapi.spectrometerGetPixelRangeWavelengths(self.device_id, self.feature_id, &error_code,
+                                                                          &out[0], length)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return wavelengths[:values_written]
+
     def get_electric_dark_pixel_indices(self):
         """returns the electric dark pixel indices for the spectrometer
 
@@ -846,17 +1469,33 @@ cdef class SeaBreezeSpectrometerFeature(SeaBreezeFeature):
             raise SeaBreezeError(error_code=error_code)
         return wavelengths
 
-    @cython.boundscheck(False)
-    def get_intensities(self):
+    def get_intensities(self, timeout_ms=None):
         """acquires a spectrum and returns the measured intensities
 
         In this mode, auto-nulling should be automatically performed
         for devices that support it.
 
+        Parameters
+        ----------
+        timeout_ms : int or None
+            spectrum timeout for this call only, see `set_transfer_timeouts`
+
         Returns
         -------
         intensities: `np.ndarray`
         """
+        if timeout_ms is None:
+            return self._get_intensities()
+        spectrum_ms, control_ms = self.get_transfer_timeouts()
+        self.set_transfer_timeouts(timeout_ms, control_ms)
+        try:
+            return self._get_intensities()
+        finally:
+            self.set_transfer_timeouts(spectrum_ms, control_ms)
+
+    @cython.boundscheck(False)
+    def _get_intensities(self):
+        """acquires a spectrum with the configured timeouts (internal)"""
         cdef int error_code
         cdef int bytes_written
         cdef double[::1] out
@@ -873,6 +1512,144 @@ cdef class SeaBreezeSpectrometerFeature(SeaBreezeFeature):
         assert bytes_written == self._spectrum_length
         return intensities
 
+    @cython.boundscheck(False)
+    def get_intensities_batch(self, int n):
+        """acquires n spectra back to back and returns them as rows of one array
+
+        All spectra are acquired in a single call into the library, the
+        request for each spectrum is sent before the previous one is
+        decoded.
+
+        Parameters
+        ----------
+        n : int
+            number of spectra to acquire
+
+        Returns
+        -------
+        timestamps: `np.ndarray`
+            host timestamps in microseconds since the epoch at which each
+            readout completed, shape (n,)
+        intensities: `np.ndarray`
+            the measured intensities, shape (n, spectrum_length)
+        """
+        cdef int error_code
+        cdef int spectra_written
+        cdef double[:, ::1] out
+        cdef unsigned long long[::1] out_timestamps
+        cdef int stride
+
+        if n < 0:
+            raise ValueError("n must be >= 0")
+        intensities = np.empty((n, self._spectrum_length), dtype=np.double)
+        timestamps = np.empty((n, ), dtype=np.uint64)
+        if n == 0:
+            return timestamps, intensities
+        out = intensities
+        out_timestamps = timestamps
+        stride = self._spectrum_length
+        with nogil:
+            spectra_written = self.sbapi.spectrometerGetFormattedSpectra(self.device_id, self.feature_id, &error_code,
+                                                                         n, &out[0, 0], stride, &out_timestamps[0])
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        assert spectra_written == n
+        return timestamps, intensities
+
+    def get_native_sample_dtype(self):
+        """returns the dtype of the spectra returned by `get_intensities_native`
+
+        Returns
+        -------
+        dtype: `np.dtype`
+        """
+        cdef int error_code
+        cdef int sample_type
+        sample_type = self.sbapi.spectrometerGetFormattedSampleType(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        if sample_type == csb.SPECTRUM_SAMPLE_TYPE_UINT16:
+            return np.dtype(np.uint16)
+        elif sample_type == csb.SPECTRUM_SAMPLE_TYPE_UINT32:
+            return np.dtype(np.uint32)
+        elif sample_type == csb.SPECTRUM_SAMPLE_TYPE_FLOAT:
+            return np.dtype(np.float32)
+        else:
+            return np.dtype(np.double)
+
+    @cython.boundscheck(False)
+    def get_intensities_native(self):
+        """acquires a spectrum and returns the intensities at the device's native width
+
+        Counts are not widened to double: spectrometers with 16 bit
+        pixels return uint16, 32 bit pixels return uint32 and devices
+        that apply a gain correction return float32.  This is always a
+        single scan; averaging and boxcar smoothing done on the host for
+        devices without on-board processing are not applied.
+
+        Returns
+        -------
+        intensities: `np.ndarray`
+        """
+        cdef int error_code
+        cdef int bytes_written
+        cdef unsigned short[::1] out_u16
+        cdef unsigned int[::1] out_u32
+        cdef float[::1] out_float
+        cdef int out_length
+
+        dtype = self.get_native_sample_dtype()
+        if dtype == np.double:
+            return self.get_intensities()
+        intensities = np.zeros((self._spectrum_length, ), dtype=dtype)
+        out_length = intensities.size
+        if dtype == np.uint16:
+            out_u16 = intensities
+            with nogil:
+                bytes_written = self.sbapi.spectrometerGetFormattedSpectrumUInt16(self.device_id, self.feature_id,
+                                                                                  &error_code, &out_u16[0], out_length)
+        elif dtype == np.uint32:
+            out_u32 = intensities
+            with nogil:
+                bytes_written = self.sbapi.spectrometerGetFormattedSpectrumUInt32(self.device_id, self.feature_id,
+                                                                                  &error_code, &out_u32[0], out_length)
+        else:
+            out_float = intensities
+            with nogil:
+                bytes_written = self.sbapi.spectrometerGetFormattedSpectrumFloat(self.device_id, self.feature_id,
+                                                                                 &error_code, &out_float[0], out_length)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        assert bytes_written == self._spectrum_length
+        return intensities
+
+    @cython.boundscheck(False)
+    def get_intensities_float32(self):
+        """acquires a spectrum and returns the intensities as float32
+
+        Like `get_intensities`, this includes scan averaging and boxcar
+        smoothing, which libseabreeze performs on the host when the device
+        has no on-board spectrum processing, but halves the output size.
+
+        Returns
+        -------
+        intensities: `np.ndarray`
+        """
+        cdef int error_code
+        cdef int bytes_written
+        cdef float[::1] out
+        cdef int out_length
+        intensities = np.zeros((self._spectrum_length, ), dtype=np.float32)
+        out = intensities
+        out_length = intensities.size
+        with nogil:
+            bytes_written = self.sbapi.spectrometerGetProcessedSpectrumFloat(self.device_id, self.feature_id,
+                                                                             &error_code, &out[0], out_length)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        assert bytes_written == self._spectrum_length
+        return intensities
+
     def _get_spectrum_raw(self):
         # int spectrometerGetUnformattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode)
         # int spectrometerGetUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode,
@@ -880,6 +1657,62 @@ cdef class SeaBreezeSpectrometerFeature(SeaBreezeFeature):
         raise NotImplementedError("unformatted spectrum")
 
     @cython.boundscheck(False)
+    def _get_fast_buffer_spectra_raw(self, int number_of_samples):
+        # returns the metadata records and the pixels widened to uint32
+        cdef int error_code
+        cdef int spectra_written
+        cdef unsigned int[:, ::1] out
+        cdef unsigned char[::1] out_metadata
+        cdef int stride
+
+        if number_of_samples < 0:
+            raise ValueError("number_of_samples must be >= 0")
+        stride = self._spectrum_length
+        pixels = np.empty((number_of_samples, stride), dtype=np.uint32)
+        metadata = np.zeros((number_of_samples, ), dtype=SpectrumMetadataDType)
+        if number_of_samples == 0:
+            return metadata, pixels
+        out = pixels
+        out_metadata = metadata.view(np.uint8)
+        with nogil:
+            spectra_written = self.sbapi.spectrometerGetFastBufferSpectra(
+                self.device_id,
+                self.feature_id,
+                &error_code,
+                number_of_samples,
+                &out[0, 0],
+                stride,
+                <csb.FastBufferSpectrumMetadata*> &out_metadata[0],
+            )
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return metadata[:spectra_written], pixels[:spectra_written]
+
+    def get_fast_buffer_spectra(self, int number_of_samples):
+        """acquires spectra with metadata from the buffer as one 2D array
+
+        The metadata and pixel data are parsed in the library, without a
+        per-spectrum loop in python.  Pixels are returned as uint32, 24 bit
+        pixels included, or as float32 if the device sends floats.
+
+        Parameters
+        ----------
+        number_of_samples : int
+            the number of samples to be retrieved from the spectrometer buffer.
+            the maximum allowed number depends on the spectrometer (e.g. OceanFX: max. 15).
+
+        Returns
+        -------
+        metadata: `np.ndarray`
+            structured array with the fields of `SpectrumMetadata`, shape (n,)
+        intensities: `np.ndarray`
+            the spectra, shape (n, spectrum_length)
+        """
+        metadata, pixels = self._get_fast_buffer_spectra_raw(number_of_samples)
+        if metadata.size and np.all(metadata["pixel_data_format"] == csb.FAST_BUFFER_PIXEL_FORMAT_FLOAT):
+            pixels = pixels.view(np.float32)
+        return metadata, pixels
+
     def get_fast_buffer_spectrum(self, int number_of_samples):
         """acquires raw spectra with metadata from the buffer and returns the spectra with metadata as a list of namedtuples.
 
@@ -893,67 +1726,241 @@ cdef class SeaBreezeSpectrometerFeature(SeaBreezeFeature):
         -------
         list[tuple[SpectrumMetadata, np.ndarray]]
         """
+        metadata, pixels = self._get_fast_buffer_spectra_raw(number_of_samples)
+
+        buffer_data = []
+        for record, row in zip(metadata.tolist(), pixels):
+            sm = SpectrumMetadata(*record)
+            # the library widened all pixel data formats to 32 bit
+            if sm.pixel_data_format == csb.FAST_BUFFER_PIXEL_FORMAT_UINT16:
+                intensities = row[: sm.pixel_data_length // 2].astype(np.uint16)
+            elif sm.pixel_data_format == csb.FAST_BUFFER_PIXEL_FORMAT_UINT24:
+                intensities = row[: sm.pixel_data_length // 3]
+            elif sm.pixel_data_format == csb.FAST_BUFFER_PIXEL_FORMAT_UINT32:
+                intensities = row[: sm.pixel_data_length // 4]
+            else:
+                intensities = row[: sm.pixel_data_length // 4].view(np.single)
+            buffer_data.append((sm, intensities))
+        return buffer_data
+
+    def start_continuous_acquisition(self, int ring_depth=16, bint pipelined=True):
+        """starts acquiring spectra continuously in a background thread
+
+        Spectra are queued in a ring buffer holding up to `ring_depth` spectra.
+        If the ring is full when a new spectrum arrives, the new spectrum is
+        dropped and counted in `get_continuous_acquisition_status`.
+        Other spectrometer calls remain usable while acquisition is running.
+
+        Parameters
+        ----------
+        ring_depth : int
+            number of spectra that can be queued before spectra are dropped
+        pipelined : bool
+            request the next spectrum before decoding the current one, so the
+            spectrometer starts integrating while the host is still busy
+
+        Returns
+        -------
+        None
+        """
         cdef int error_code
-        cdef int bytes_written
-        cdef unsigned char* c_buffer = NULL
+        with nogil:
+            self.sbapi.spectrometerStartContinuousAcquisition(self.device_id, self.feature_id, &error_code, ring_depth, pipelined)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def stop_continuous_acquisition(self):
+        """stops the background acquisition thread
+
+        Spectra that are already queued can still be read afterwards.
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        with nogil:
+            self.sbapi.spectrometerStopContinuousAcquisition(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    @cython.boundscheck(False)
+    def read_continuous_spectrum(self):
+        """returns the oldest queued spectrum without waiting
+
+        Returns
+        -------
+        spectrum: tuple[int, np.ndarray] or None
+            host timestamp in microseconds since the epoch at which the
+            readout completed and the intensities, or None if no spectrum
+            is queued
+        """
+        cdef int error_code
+        cdef int values_written
+        cdef double[::1] out
         cdef int out_length
-        cdef int sample_number
-        sample_number = int(number_of_samples)
+        cdef unsigned long long timestamp_micros = 0
 
-        out_length = (64 + self._raw_spectrum_length + 4) * number_of_samples
+        intensities = np.empty((self._spectrum_length, ), dtype=np.double)
+        out = intensities
+        out_length = intensities.size
+        with nogil:
+            values_written = self.sbapi.spectrometerReadContinuousSpectrum(self.device_id, self.feature_id, &error_code,
+                                                                           &out[0], out_length, &timestamp_micros)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        if values_written == 0:
+            return None
+        return int(timestamp_micros), intensities[:values_written]
 
-        c_buffer = <unsigned char*> PyMem_Malloc(out_length * sizeof(unsigned char))
-        if not c_buffer:
-            raise MemoryError("could not allocate memory for buffer")
-        try:
-            bytes_written = self.sbapi.spectrometerGetFastBufferSpectrum(
+    def get_continuous_acquisition_status(self):
+        """returns the state and counters of the background acquisition
+
+        `frames_dropped` counts spectra discarded because the ring was full,
+        `overruns` counts how often the ring became full. The acquisition
+        thread stops after a failed transfer, which is counted in
+        `transfer_errors`.
+
+        Returns
+        -------
+        status: ContinuousAcquisitionStatus
+        """
+        cdef int error_code
+        cdef int running, ring_depth
+        cdef unsigned long long acquired, dropped, overruns, errors
+        running = self.sbapi.spectrometerIsContinuousAcquisitionRunning(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        ring_depth = self.sbapi.spectrometerGetContinuousAcquisitionDepth(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        self.sbapi.spectrometerGetContinuousAcquisitionStatistics(self.device_id, self.feature_id, &error_code,
+                                                                  &acquired, &dropped, &overruns, &errors)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return ContinuousAcquisitionStatus(
+            bool(running), int(ring_depth), int(acquired), int(dropped), int(overruns), int(errors)
+        )
+
+    def start_fast_buffer_drain(self, int queue_depth=256, int max_batch=15, int poll_interval_us=1000):
+        """starts draining the spectrometer's fast buffer in a background thread
+
+        The thread polls how many spectra the data buffer holds, requests up
+        to `max_batch` of them at a time and queues them on the host. When the
+        buffer is empty it sleeps for `poll_interval_us`. Gaps in the spectrum
+        counter of the metadata, i.e. spectra discarded by the spectrometer,
+        are reported by `get_fast_buffer_drain_status`.
+
+        Parameters
+        ----------
+        queue_depth : int
+            number of spectra that can be queued before new spectra are dropped
+        max_batch : int
+            largest number of spectra per request (e.g. OceanFX: max. 15)
+        poll_interval_us : int
+            microseconds to wait before polling an empty buffer again
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        with nogil:
+            self.sbapi.spectrometerStartFastBufferDrain(self.device_id, self.feature_id, &error_code,
+                                                        queue_depth, max_batch, poll_interval_us)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    def stop_fast_buffer_drain(self):
+        """stops the background fast buffer drain
+
+        Spectra that are already queued can still be read afterwards.
+
+        Returns
+        -------
+        None
+        """
+        cdef int error_code
+        with nogil:
+            self.sbapi.spectrometerStopFastBufferDrain(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+
+    @cython.boundscheck(False)
+    def read_fast_buffer_drain(self, int max_spectra):
+        """returns up to `max_spectra` of the oldest drained spectra without waiting
+
+        Parameters
+        ----------
+        max_spectra : int
+            the largest number of spectra to return
+
+        Returns
+        -------
+        metadata: `np.ndarray`
+            structured array with the fields of `SpectrumMetadata`, shape (n,)
+        intensities: `np.ndarray`
+            the spectra as in `get_fast_buffer_spectra`, shape (n, spectrum_length)
+        """
+        cdef int error_code
+        cdef int spectra_written
+        cdef unsigned int[:, ::1] out
+        cdef unsigned char[::1] out_metadata
+        cdef int stride
+
+        if max_spectra < 0:
+            raise ValueError("max_spectra must be >= 0")
+        stride = self._spectrum_length
+        pixels = np.empty((max_spectra, stride), dtype=np.uint32)
+        metadata = np.zeros((max_spectra, ), dtype=SpectrumMetadataDType)
+        if max_spectra == 0:
+            return metadata, pixels
+        out = pixels
+        out_metadata = metadata.view(np.uint8)
+        with nogil:
+            spectra_written = self.sbapi.spectrometerReadFastBufferDrain(
                 self.device_id,
                 self.feature_id,
                 &error_code,
-                &c_buffer[0],
-                out_length,
-                sample_number,
-            )
-            if error_code != 0:
-                raise SeaBreezeError(error_code=error_code)
-            data = c_buffer[:bytes_written]
-        finally:
-            PyMem_Free(c_buffer)
-
-        buffer_data = []
-        offset = 0
-        for _ in range(sample_number):
-            # decode metadata
-            sm = SpectrumMetadata(
-                *struct.unpack("HHIQIIIIQH", data[offset : offset + 42])
+                max_spectra,
+                &out[0, 0],
+                stride,
+                <csb.FastBufferSpectrumMetadata*> &out_metadata[0],
             )
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        metadata, pixels = metadata[:spectra_written], pixels[:spectra_written]
+        if metadata.size and np.all(metadata["pixel_data_format"] == csb.FAST_BUFFER_PIXEL_FORMAT_FLOAT):
+            pixels = pixels.view(np.float32)
+        return metadata, pixels
 
-            # determine pixel data format from metadata and decode spectrum
-            intensities_raw = data[
-                offset + sm.metadata_length
-                : offset + sm.metadata_length + sm.pixel_data_length
-            ]
-            if sm.pixel_data_format == 1:
-                intensities = np.frombuffer(intensities_raw, dtype=np.uint16)
-            elif sm.pixel_data_format == 2:
-                # note:
-                #   we could create a 32bit view and use stride tricks and
-                #   bit-masking 0x00ffffff to get 24bit data into a 32bit array...
-                raise NotImplementedError("Numpy lacks support for 24bit unsigned integers")
-            elif sm.pixel_data_format == 3:
-                intensities = np.frombuffer(intensities_raw, dtype=np.uint32)
-            elif sm.pixel_data_format == 4:
-                intensities = np.frombuffer(intensities_raw, dtype=np.single)
-            else:
-                raise SeaBreezeError(f"Unknown Pixel Data Format {sm.pixel_data_format!r}")
+    def get_fast_buffer_drain_status(self):
+        """returns the state and counters of the background fast buffer drain
 
-            # add data to return list
-            buffer_data.append((sm, intensities))
+        `spectra_missed` counts spectra missing from the spectrum counter
+        sequence, which were discarded by the spectrometer, spread over
+        `sequence_gaps` gaps. A counter that jumps backwards counts as a gap
+        of zero spectra. `spectra_dropped` counts spectra discarded because
+        the host queue was full. The thread stops after a failed transfer,
+        which is counted in `transfer_errors`.
 
-            # depending on the individual Dataset length, add offset to next Dataset.
-            # There is 4 bytes of unused data after every spectrum for some reason. So add that as well.
-            offset += sm.metadata_length + sm.pixel_data_length + 4
-        return buffer_data
+        Returns
+        -------
+        status: FastBufferDrainStatus
+        """
+        cdef int error_code
+        cdef int running
+        cdef unsigned long long received, missed, gaps, dropped, errors
+        running = self.sbapi.spectrometerIsFastBufferDrainRunning(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        self.sbapi.spectrometerGetFastBufferDrainStatistics(self.device_id, self.feature_id, &error_code,
+                                                            &received, &missed, &gaps, &dropped, &errors)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return FastBufferDrainStatus(
+            bool(running), int(received), int(missed), int(gaps), int(dropped), int(errors)
+        )
 
 cdef class SeaBreezePixelBinningFeature(SeaBreezeFeature):
 
@@ -3587,6 +4594,59 @@ cdef class SeaBreezeDataBufferFeature(SeaBreezeFeature):
             raise SeaBreezeError(error_code=error_code)
         return int(output)
 
+    @cython.boundscheck(False)
+    def read_buffered_spectra(self, int number_of_spectra):
+        """read and remove the oldest spectra in the buffer in one call
+
+        Spectra are removed from the buffer in the same order as
+        remove_oldest_spectra() discards them. At most as many spectra as
+        get_number_of_elements() reports are read, so this never waits for
+        a new acquisition. Supported by devices with 32-bit buffered spectra
+        (e.g. QE-PRO).
+
+        Parameters
+        ----------
+        number_of_spectra : int
+            the largest number of spectra to read
+
+        Returns
+        -------
+        metadata: `np.ndarray`
+            structured array with the fields of `SpectrumMetadata`, shape (n,)
+        intensities: `np.ndarray`
+            the spectra as uint32, shape (n, spectrum_length)
+        """
+        cdef int error_code
+        cdef int spectra_written
+        cdef int stride
+        cdef unsigned int[:, ::1] out
+        cdef unsigned char[::1] out_metadata
+
+        if number_of_spectra < 0:
+            raise ValueError("number_of_spectra must be >= 0")
+        stride = self.sbapi.dataBufferGetBufferedSpectrumLength(self.device_id, self.feature_id, &error_code)
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        pixels = np.empty((number_of_spectra, stride), dtype=np.uint32)
+        metadata = np.zeros((number_of_spectra, ), dtype=SpectrumMetadataDType)
+        if number_of_spectra == 0:
+            return metadata, pixels
+        out = pixels
+        out_metadata = metadata.view(np.uint8)
+        with nogil:
+            spectra_written = self.sbapi.dataBufferReadBufferedSpectra(
+                self.device_id,
+                self.feature_id,
+                &error_code,
+                number_of_spectra,
+                &out[0, 0],
+                stride,
+                <csb.FastBufferSpectrumMetadata*> &out_metadata[0],
+            )
+        if error_code != 0:
+            raise SeaBreezeError(error_code=error_code)
+        return metadata[:spectra_written], pixels[:spectra_written]
+
 
 cdef class SeaBreezeFastBufferFeature(SeaBreezeFeature):
 
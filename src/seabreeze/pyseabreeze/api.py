@@ -13,9 +13,11 @@ import logging
 import weakref
 from typing import TYPE_CHECKING
 from typing import Any
+from typing import Callable
 
 from seabreeze.pyseabreeze.devices import SeaBreezeDevice
 from seabreeze.pyseabreeze.devices import _model_class_registry
+from seabreeze.pyseabreeze.exceptions import SeaBreezeNotSupported
 from seabreeze.pyseabreeze.transport import DeviceIdentity
 from seabreeze.pyseabreeze.transport import IPv4Transport
 from seabreeze.pyseabreeze.transport import IPv4TransportHandle
@@ -147,6 +149,18 @@ class SeaBreezeAPI(_SeaBreezeAPIProtocol):
             devices.append(dev)  # type: ignore
         return devices
 
+    def add_hotplug_callback(
+        self, callback: Callable[[_SeaBreezeDevice, bool], None]
+    ) -> None:
+        """call a function whenever a spectrometer is attached or detached"""
+        raise SeaBreezeNotSupported("hotplug events require cseabreeze")
+
+    def remove_hotplug_callback(
+        self, callback: Callable[[_SeaBreezeDevice, bool], None]
+    ) -> None:
+        """stop calling a function registered with `add_hotplug_callback`"""
+        raise SeaBreezeNotSupported("hotplug events require cseabreeze")
+
     # note: to be fully consistent with cseabreeze this shouldn't be a staticmethod
     @staticmethod
     def supported_models() -> list[str]:
@@ -14,6 +14,7 @@ from typing import TypeVar
 
 from seabreeze.pyseabreeze import features as sbf
 from seabreeze.pyseabreeze.exceptions import SeaBreezeError
+from seabreeze.pyseabreeze.exceptions import SeaBreezeNotSupported
 from seabreeze.pyseabreeze.features import SeaBreezeFeature
 from seabreeze.pyseabreeze.protocol import ADCProtocol
 from seabreeze.pyseabreeze.protocol import OBP2Protocol
@@ -394,6 +395,10 @@ class SeaBreezeDevice(metaclass=_SeaBreezeDeviceMeta):
         if self.is_open:
             self._transport.close_device()
 
+    def cancel_transfers(self) -> None:
+        """abort any transfer that is blocked on the device"""
+        raise SeaBreezeNotSupported("cancelling transfers requires cseabreeze")
+
     @property
     def is_open(self) -> bool:
         """returns if the spectrometer device usb connection is opened
@@ -1,3 +1,5 @@
+from typing import Any
+
 from seabreeze.pyseabreeze.features._base import SeaBreezeFeature
 
 
@@ -29,3 +31,6 @@ class SeaBreezeDataBufferFeature(SeaBreezeFeature):
 
     def get_buffer_capacity_minimum(self) -> int:
         raise NotImplementedError("implement in derived class")
+
+    def read_buffered_spectra(self, number_of_spectra: int) -> Any:
+        raise NotImplementedError("implement in derived class")
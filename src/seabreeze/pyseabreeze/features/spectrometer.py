@@ -4,6 +4,7 @@ import struct
 import warnings
 from typing import TYPE_CHECKING
 from typing import Any
+from typing import Sequence
 
 import numpy
 
@@ -58,11 +59,101 @@ class SeaBreezeSpectrometerFeature(SeaBreezeFeature):
     def _get_spectrum_raw(self) -> NDArray[np.uint8]:
         raise NotImplementedError("implement in derived class")
 
+    def get_intensities_batch(self, n: int) -> Any:
+        raise SeaBreezeNotSupported("batch acquisition requires cseabreeze")
+
+    def set_transfer_timeouts(
+        self, spectrum_ms: int | None = None, control_ms: int | None = None
+    ) -> None:
+        raise SeaBreezeNotSupported("transfer timeouts require cseabreeze")
+
+    def get_transfer_timeouts(self) -> tuple[int | None, int | None]:
+        raise SeaBreezeNotSupported("transfer timeouts require cseabreeze")
+
+    def set_spectrum_correction(
+        self,
+        correct_dark_counts: bool,
+        correct_nonlinearity: bool,
+        correct_stray_light: bool = False,
+    ) -> None:
+        raise SeaBreezeNotSupported("spectrum correction requires cseabreeze")
+
+    def set_correction_coefficients(
+        self,
+        nonlinearity: Sequence[float] | None = None,
+        stray_light: Sequence[float] | None = None,
+    ) -> None:
+        raise SeaBreezeNotSupported("spectrum correction requires cseabreeze")
+
+    def set_irradiance_output(self, enable: bool, collection_area: float = 0.0) -> None:
+        raise SeaBreezeNotSupported("irradiance output requires cseabreeze")
+
+    def set_resample_grid(self, grid: Any, method: str = "linear") -> None:
+        raise SeaBreezeNotSupported("resampling requires cseabreeze")
+
+    def get_resampled_intensities(self) -> NDArray[np.float64]:
+        raise SeaBreezeNotSupported("resampling requires cseabreeze")
+
+    def resample_spectra(self, spectra: Any) -> NDArray[np.float64]:
+        raise SeaBreezeNotSupported("resampling requires cseabreeze")
+
+    def set_pixel_ranges(self, ranges: Any = None) -> None:
+        raise SeaBreezeNotSupported("pixel range readout requires cseabreeze")
+
+    def get_pixel_ranges(self) -> tuple[tuple[int, int], ...]:
+        raise SeaBreezeNotSupported("pixel range readout requires cseabreeze")
+
+    def get_pixel_range_intensities(self) -> NDArray[np.float64]:
+        raise SeaBreezeNotSupported("pixel range readout requires cseabreeze")
+
+    def get_pixel_range_wavelengths(self) -> NDArray[np.float64]:
+        raise SeaBreezeNotSupported("pixel range readout requires cseabreeze")
+
+    def get_native_sample_dtype(self) -> Any:
+        raise SeaBreezeNotSupported("native width spectra require cseabreeze")
+
+    def get_intensities_native(self) -> Any:
+        raise SeaBreezeNotSupported("native width spectra require cseabreeze")
+
+    def get_intensities_float32(self) -> NDArray[np.float32]:
+        return self.get_intensities().astype(numpy.float32)
+
     def get_fast_buffer_spectrum(self) -> Any:
         raise SeaBreezeNotSupported(
             "needs to be provided in the specific implementation if supported"
         )
 
+    def get_fast_buffer_spectra(self, number_of_samples: int) -> Any:
+        raise SeaBreezeNotSupported("fast buffer parsing requires cseabreeze")
+
+    def start_continuous_acquisition(
+        self, ring_depth: int = 16, pipelined: bool = True
+    ) -> None:
+        raise SeaBreezeNotSupported("continuous acquisition requires cseabreeze")
+
+    def stop_continuous_acquisition(self) -> None:
+        raise SeaBreezeNotSupported("continuous acquisition requires cseabreeze")
+
+    def read_continuous_spectrum(self) -> Any:
+        raise SeaBreezeNotSupported("continuous acquisition requires cseabreeze")
+
+    def get_continuous_acquisition_status(self) -> Any:
+        raise SeaBreezeNotSupported("continuous acquisition requires cseabreeze")
+
+    def start_fast_buffer_drain(
+        self, queue_depth: int = 256, max_batch: int = 15, poll_interval_us: int = 1000
+    ) -> None:
+        raise SeaBreezeNotSupported("fast buffer drain requires cseabreeze")
+
+    def stop_fast_buffer_drain(self) -> None:
+        raise SeaBreezeNotSupported("fast buffer drain requires cseabreeze")
+
+    def read_fast_buffer_drain(self, max_spectra: int) -> Any:
+        raise SeaBreezeNotSupported("fast buffer drain requires cseabreeze")
+
+    def get_fast_buffer_drain_status(self) -> Any:
+        raise SeaBreezeNotSupported("fast buffer drain requires cseabreeze")
+
 
 # Spectrometer Features based on USBCommOOI
 # =========================================
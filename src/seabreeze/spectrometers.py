@@ -9,12 +9,17 @@ Email: andreas@poehlmann.io
 
 from __future__ import annotations
 
+import hashlib
+import os
+import warnings
 from typing import TYPE_CHECKING
+from typing import Any
 
 import numpy
 
 import seabreeze.backends
 from seabreeze._exc import SeaBreezeError
+from seabreeze._profile_cache import ProfileCache
 from seabreeze.types import SeaBreezeAPI
 from seabreeze.types import SeaBreezeBackend
 from seabreeze.types import SeaBreezeFeatureAccessor
@@ -100,7 +105,11 @@ class Spectrometer:
     # store reference to backend to allow backend switching in tests
     _backend = _SeabreezeBackendDescriptor()
 
-    def __init__(self, device: SeaBreezeDevice) -> None:
+    def __init__(
+        self,
+        device: SeaBreezeDevice,
+        profile_cache: str | os.PathLike[str] | None = None,
+    ) -> None:
         """create a Spectrometer instance for the provided device
 
         The Spectrometer class provides a thin abstraction layer for the
@@ -110,6 +119,17 @@ class Spectrometer:
         ----------
         device : `seabreeze.spectrometers.SeaBreezeDevice`
             a SeaBreezeDevice as returned from `list_devices`
+        profile_cache : `str` or `os.PathLike`, optional
+            a directory for cached device profiles. The nonlinearity and
+            stray light coefficients and the dark pixel indices are loaded
+            from the device's profile if it matches the firmware revision,
+            the number of pixels and the wavelength calibration, and are
+            read from the device and stored there otherwise. Either way the
+            coefficients are handed to the backend, so that `intensities`
+            does not read them again. The wavelengths are always read, so
+            that recalibrating a device invalidates its profile even if it
+            does not report a firmware revision. Reads libseabreeze does
+            itself while opening the device are not affected.
         """
         if not isinstance(device, self._backend.SeaBreezeDevice):
             raise TypeError(
@@ -118,28 +138,94 @@ class Spectrometer:
         self._dev = device
         self.open()  # always open the device here to allow caching values
 
+        # cache wavelengths on open
+        self._wavelengths = numpy.array(
+            self._dev.f.spectrometer.get_wavelengths(), dtype=numpy.float64
+        )
+
+        profile = None
+        if profile_cache is not None:
+            cache = ProfileCache(profile_cache)
+            key = self._profile_key(self._wavelengths)
+            profile = cache.load(self._dev.model, self._dev.serial_number, key)
+        if profile is None:
+            profile = self._read_profile()
+            if profile_cache is not None:
+                try:
+                    cache.store(self._dev.model, self._dev.serial_number, key, profile)
+                except OSError as err:
+                    warnings.warn(f"could not store the device profile: {err}")
+
         # check for nonlinearity correction support
+        nc = profile.get("nonlinearity")
+        self._nc = None if nc is None else numpy.poly1d(nc[::-1])
+        # check for stray light correction support
+        slc = profile.get("stray_light")
+        self._slc = None if slc is None else [float(c) for c in slc] or None
+        # check for dark pixel correction support
+        self._dp = [int(i) for i in profile["dark_pixels"]]
+        # corrections are applied by the backend if it supports them, using
+        # the coefficients above instead of reading them from the device again
+        self._backend_corrections = True
+        if nc is not None or slc is not None:
+            try:
+                self._dev.f.spectrometer.set_correction_coefficients(nc, slc)
+            except self._backend.SeaBreezeError:
+                # pyseabreeze can't, so the corrections are done in numpy
+                self._backend_corrections = False
+
+    def _read_profile(self) -> dict[str, Any]:
+        """read the values that are cached on open from the device"""
+        profile: dict[str, Any] = {}
         nc_feature = self._dev.f.nonlinearity_coefficients
-        self._nc = None
         if nc_feature is not None:
             try:
                 # NOTE: the spark spectrometer raises a transport error when trying
                 # to receive the nc coefficients. In this case continue with disabled
                 # nonlinearity correction support
-                self._nc = numpy.poly1d(
-                    nc_feature.get_nonlinearity_coefficients()[::-1]
-                )
+                profile["nonlinearity"] = nc_feature.get_nonlinearity_coefficients()
             except self._backend.SeaBreezeError:
                 pass
-        # check for dark pixel correction support
-        self._dp = self._dev.f.spectrometer.get_electric_dark_pixel_indices()
-        # cache wavelengths on open
-        self._wavelengths = self._dev.f.spectrometer.get_wavelengths()
+        sl_feature = self._dev.f.stray_light_coefficients
+        if sl_feature is not None:
+            try:
+                profile["stray_light"] = sl_feature.get_stray_light_coefficients()
+            except self._backend.SeaBreezeError:
+                pass
+        spectrometer = self._dev.f.spectrometer
+        profile["dark_pixels"] = spectrometer.get_electric_dark_pixel_indices()
+        return profile
+
+    def _profile_key(self, wavelengths: NDArray[numpy.float64]) -> str:
+        """describe the device state that a cached profile depends on
+
+        Most devices don't report a firmware revision, so the key includes a
+        digest of the wavelengths. Rewriting the calibration changes them.
+        """
+        firmware = None
+        revision = self._dev.f.revision
+        if revision is not None:
+            try:
+                firmware = revision.revision_firmware_get()
+            except (self._backend.SeaBreezeError, NotImplementedError):
+                pass
+        pixels = self._dev.f.spectrometer._spectrum_length
+        digest = hashlib.sha1(
+            numpy.ascontiguousarray(wavelengths, dtype="<f8").tobytes()
+        ).hexdigest()
+        return f"firmware={firmware};pixels={pixels};wavelengths={digest}"
 
     @classmethod
-    def from_first_available(cls) -> Spectrometer:
+    def from_first_available(
+        cls, profile_cache: str | os.PathLike[str] | None = None
+    ) -> Spectrometer:
         """open first available spectrometer
 
+        Parameters
+        ----------
+        profile_cache : `str` or `os.PathLike`, optional
+            see `Spectrometer`
+
         Returns
         -------
         spectrometer : `Spectrometer`
@@ -147,12 +233,16 @@ class Spectrometer:
         """
         for dev in list_devices():
             if not dev.is_open:
-                return cls(dev)
+                return cls(dev, profile_cache=profile_cache)
         else:
             raise cls._backend.SeaBreezeError("No unopened device found.")
 
     @classmethod
-    def from_serial_number(cls, serial: str | None = None) -> Spectrometer:
+    def from_serial_number(
+        cls,
+        serial: str | None = None,
+        profile_cache: str | os.PathLike[str] | None = None,
+    ) -> Spectrometer:
         """open the spectrometer matching the provided serial number
 
         Allows to open a specific spectrometer if multiple are connected.
@@ -164,6 +254,8 @@ class Spectrometer:
         serial : `str`, optional
             the spectrometer's serial number. If `None` (default) it
             returns the first available unopened spectrometer.
+        profile_cache : `str` or `os.PathLike`, optional
+            see `Spectrometer`
 
         Returns
         -------
@@ -171,14 +263,14 @@ class Spectrometer:
             the spectrometer with the requested serial number
         """
         if serial is None:  # pick first spectrometer
-            return cls.from_first_available()
+            return cls.from_first_available(profile_cache=profile_cache)
 
         for dev in list_devices():
             if dev.serial_number == str(serial):
                 if dev.is_open:
                     raise cls._backend.SeaBreezeError("Device already opened.")
                 else:
-                    return cls(dev)
+                    return cls(dev, profile_cache=profile_cache)
         else:
             raise cls._backend.SeaBreezeError(
                 "No device attached with serial number '%s'." % serial
@@ -197,7 +289,10 @@ class Spectrometer:
         return self._wavelengths
 
     def intensities(
-        self, correct_dark_counts: bool = False, correct_nonlinearity: bool = False
+        self,
+        correct_dark_counts: bool = False,
+        correct_nonlinearity: bool = False,
+        correct_stray_light: bool = False,
     ) -> NDArray[numpy.float64]:
         """measured intensity array in (a.u.)
 
@@ -234,6 +329,11 @@ class Spectrometer:
             in their eeprom. If requested and supported by the spectrometer
             the readings returned by the spectrometer will be linearized
             using the stored coefficients.
+        correct_stray_light : `bool`
+            Some spectrometers store stray light coefficients. If requested
+            and supported, the mean intensity times each pixel's stray light
+            fraction (a polynomial in the pixel index with the stored
+            coefficients) is subtracted after linearization.
 
         Returns
         -------
@@ -248,15 +348,33 @@ class Spectrometer:
             raise self._backend.SeaBreezeError(
                 "This device does not support nonlinearity correction."
             )
+        if correct_stray_light and not self._slc:
+            raise self._backend.SeaBreezeError(
+                "This device does not support stray light correction."
+            )
+        spectrometer = self._dev.f.spectrometer
+        if self._backend_corrections:
+            try:
+                spectrometer.set_spectrum_correction(
+                    correct_dark_counts, correct_nonlinearity, correct_stray_light
+                )
+            except self._backend.SeaBreezeError:
+                # pyseabreeze can't, so the corrections are done in numpy
+                self._backend_corrections = False
+            else:
+                return spectrometer.get_intensities()
         # Get the intensities
-        out = self._dev.f.spectrometer.get_intensities()
+        out = spectrometer.get_intensities()
         # Do corrections if requested
-        if correct_nonlinearity or correct_dark_counts:
+        if correct_nonlinearity or correct_dark_counts or correct_stray_light:
             dark_offset = numpy.mean(out[self._dp]) if self._dp else 0.0
             out -= dark_offset
         if correct_nonlinearity and self._nc:
-            out = out / numpy.polyval(self._nc, out)
-        if correct_nonlinearity and (not correct_dark_counts):
+            out /= numpy.polyval(self._nc, out)
+        if correct_stray_light:
+            fractions = numpy.polyval(self._slc[::-1], numpy.arange(out.size))
+            out -= out.mean() * fractions
+        if (correct_nonlinearity or correct_stray_light) and (not correct_dark_counts):
             # noinspection PyUnboundLocalVariable
             out += dark_offset
         return out
@@ -274,7 +392,10 @@ class Spectrometer:
         return self._dev.f.spectrometer.get_maximum_intensity()
 
     def spectrum(
-        self, correct_dark_counts: bool = False, correct_nonlinearity: bool = False
+        self,
+        correct_dark_counts: bool = False,
+        correct_nonlinearity: bool = False,
+        correct_stray_light: bool = False,
     ) -> NDArray[numpy.float64]:
         """returns wavelengths and intensities as single array
 
@@ -289,6 +410,8 @@ class Spectrometer:
             see `Spectrometer.intensities`
         correct_nonlinearity : `bool`
             see `Spectrometer.intensities`
+        correct_stray_light : `bool`
+            see `Spectrometer.intensities`
 
         Returns
         -------
@@ -298,7 +421,9 @@ class Spectrometer:
         return numpy.vstack(
             (
                 self._wavelengths,
-                self.intensities(correct_dark_counts, correct_nonlinearity),
+                self.intensities(
+                    correct_dark_counts, correct_nonlinearity, correct_stray_light
+                ),
             )
         )
 
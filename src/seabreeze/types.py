@@ -7,6 +7,7 @@ from __future__ import annotations
 
 from typing import TYPE_CHECKING
 from typing import Any
+from typing import Callable
 from typing import Literal
 from typing import Protocol
 from typing import TypedDict
@@ -60,6 +61,14 @@ class SeaBreezeAPI(Protocol):
 
     def list_devices(self) -> list[SeaBreezeDevice]: ...
 
+    def add_hotplug_callback(
+        self, callback: Callable[[SeaBreezeDevice, bool], None]
+    ) -> None: ...
+
+    def remove_hotplug_callback(
+        self, callback: Callable[[SeaBreezeDevice, bool], None]
+    ) -> None: ...
+
     @staticmethod
     def supported_models() -> list[str]: ...
 
@@ -60,6 +60,60 @@ def test_seabreeze_pyseabreeze_api_init(pyseabreeze, pyseabreeze_pyusb_backend):
             pytest.skip(f"pyusb_backend {pyseabreeze_pyusb_backend} not available")
 
 
+def test_seabreeze_pyseabreeze_hotplug_not_supported(pyseabreeze):
+    """hotplug callbacks are only implemented by cseabreeze"""
+    from seabreeze.pyseabreeze.exceptions import SeaBreezeNotSupported
+
+    api = pyseabreeze.SeaBreezeAPI(initialize=False)
+    with pytest.raises(SeaBreezeNotSupported):
+        api.add_hotplug_callback(lambda device, arrived: None)
+
+
+def test_seabreeze_cseabreeze_hotplug_callback_not_callable(cseabreeze):
+    """check that hotplug callbacks are validated before registering"""
+    api = cseabreeze.SeaBreezeAPI()
+    with pytest.raises(TypeError):
+        api.add_hotplug_callback(None)
+    with pytest.raises(ValueError):
+        api.remove_hotplug_callback(print)
+
+
+@pytest.mark.parametrize("implementation", ["sse2", "avx2"])
+@pytest.mark.parametrize(
+    "pixel_format, options",
+    [
+        ("u16", {}),
+        ("u16", {"xor_mask": 0x8000}),
+        ("u16", {"xor_mask": 0x2000}),
+        ("u16_scaled", {"scale": 1.37, "limit": 50000.0}),
+        ("u16_scaled", {"xor_mask": 0x8000, "scale": 0.5, "limit": 65535.0}),
+        ("ooi2k", {}),
+        ("u32", {}),
+        ("widen16", {}),
+        ("widen32", {}),
+    ],
+)
+def test_seabreeze_cseabreeze_pixel_decoder_kernels(
+    cseabreeze, implementation, pixel_format, options
+):
+    """check that each available SIMD decoder matches the scalar one"""
+    import numpy as np
+
+    from seabreeze.cseabreeze._wrapper import _decode_pixels
+
+    rng = np.random.default_rng(0)
+    # lengths around and between the 4, 8 and 16 pixel vector widths
+    for count in (0, 1, 3, 7, 8, 9, 15, 17, 31, 33, 63, 65, 127, 1023, 2048):
+        raw = rng.integers(0, 256, size=4 * count + 128, dtype=np.uint8).tobytes()
+        expected = _decode_pixels("scalar", pixel_format, raw, count, **options)
+        result = _decode_pixels(implementation, pixel_format, raw, count, **options)
+        if result is None:
+            pytest.skip(f"{implementation} kernels not available")
+        for exp, res in zip(expected, result):
+            assert res.dtype == exp.dtype and res.size == count
+            np.testing.assert_array_equal(res, exp, err_msg=f"{count} pixels")
+
+
 def _get_class_public_interface_dict(backend):
     """return a dictionary with a set of all public functions for each feature"""
     base_class = backend.SeaBreezeFeature
@@ -0,0 +1,62 @@
+import numpy
+import pytest
+
+from seabreeze._profile_cache import ProfileCache
+
+
+@pytest.fixture
+def cache(tmp_path):
+    return ProfileCache(tmp_path / "profiles")
+
+
+def test_profile_roundtrip(cache):
+    wavelengths = numpy.linspace(200.0, 1100.0, 2048)
+    cache.store(
+        "USB2000PLUS",
+        "USB2+F0001",
+        "firmware=1.0;pixels=2048",
+        {"wavelengths": wavelengths, "dark_pixels": [2, 3, 4], "stray_light": []},
+    )
+    profile = cache.load("USB2000PLUS", "USB2+F0001", "firmware=1.0;pixels=2048")
+    assert profile is not None
+    assert numpy.array_equal(profile["wavelengths"], wavelengths)
+    assert profile["dark_pixels"].dtype == numpy.int64
+    assert profile["dark_pixels"].tolist() == [2, 3, 4]
+    assert profile["stray_light"].size == 0
+    assert not profile["wavelengths"].flags.writeable
+
+
+def test_profile_stale_key(cache):
+    cache.store("STS", "S00001", "firmware=1.0;pixels=1024", {"dark_pixels": [1]})
+    assert cache.load("STS", "S00001", "firmware=1.1;pixels=1024") is None
+    assert cache.load("STS", "S00002", "firmware=1.0;pixels=1024") is None
+
+
+def test_profile_corrupt(cache):
+    cache.store("STS", "S00001", "key", {"wavelengths": numpy.arange(16.0)})
+    path = cache.path("STS", "S00001")
+    with open(path, "r+b") as f:
+        f.truncate(64)
+    assert cache.load("STS", "S00001", "key") is None
+    with open(path, "wb") as f:
+        f.write(b"not a profile")
+    assert cache.load("STS", "S00001", "key") is None
+
+
+def test_profile_key_follows_wavelength_calibration():
+    from types import SimpleNamespace
+
+    from seabreeze.spectrometers import Spectrometer
+
+    # an OOI protocol device, which reports no firmware revision
+    spec = SimpleNamespace(
+        _dev=SimpleNamespace(
+            f=SimpleNamespace(
+                revision=None, spectrometer=SimpleNamespace(_spectrum_length=2048)
+            )
+        )
+    )
+    wavelengths = numpy.linspace(200.0, 1100.0, 2048)
+    key = Spectrometer._profile_key(spec, wavelengths)
+    assert key == Spectrometer._profile_key(spec, wavelengths.copy())
+    assert key != Spectrometer._profile_key(spec, wavelengths + 0.01)
@@ -325,6 +325,36 @@ class TestHardware:
         spec.integration_time_micros(10000)
         spec.intensities()
 
+    @skip_if_serial_unsupported_by_backend()
+    def test_integration_time_during_pipelined_acquisition(self, serial_number):
+        from seabreeze.spectrometers import Spectrometer
+
+        spec = Spectrometer.from_serial_number(serial_number)
+        spectrometer = spec.f.spectrometer
+        if not hasattr(spectrometer, "start_continuous_acquisition"):
+            pytest.skip("backend does not support continuous acquisition")
+
+        spectrometer.start_continuous_acquisition(ring_depth=4, pipelined=True)
+        try:
+            for integration_time in (10000, 20000, 10000):
+                time.sleep(0.1)
+                spec.integration_time_micros(integration_time)
+                assert spec.intensities().size == spec.pixels
+            status = spectrometer.get_continuous_acquisition_status()
+            assert status.running
+            assert status.transfer_errors == 0
+        finally:
+            spectrometer.stop_continuous_acquisition()
+
+        spectra = []
+        while True:
+            item = spectrometer.read_continuous_spectrum()
+            if item is None:
+                break
+            spectra.append(item[1])
+        assert spectra
+        assert all(s.size == spec.pixels for s in spectra)
+
     @skip_if_serial_unsupported_by_backend()
     def test_trigger_mode(self, serial_number):
         from seabreeze.spectrometers import Spectrometer